@@ -76,6 +76,18 @@ extern "C" {                                              //
 ACR_Info_t ACR_AlignedBufferNew(
 	ACR_AlignedBuffer_t** mePtr);
 
+/** prepare a buffer allocated from an allocator
+	\param mePtr location to store the pointer for the new buffer
+	\param allocator the allocator for the buffer object or ACR_NULL
+	       to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: the allocator must stay valid until ACR_AlignedBufferDelete()
+*/
+ACR_Info_t ACR_AlignedBufferNewWithAllocator(
+	ACR_AlignedBuffer_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free an aligned buffer allocated on the heap
 	\param mePtr location of the pointer for the buffer, which will
 	       be set to ACR_NULL after the memory is freed
@@ -101,7 +113,52 @@ void ACR_AlignedBufferInit(
 void ACR_AlignedBufferDeInit(
 	ACR_AlignedBuffer_t* me);
 
-/// \todo ACR_AlignedBufferAllocate
+/** allocate aligned memory for the buffer
+	\param me the aligned buffer
+	\param length value 1 to ACR_MAX_LENGTH
+	\param alignment a power of two number of bytes such as 32 or 64
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: if the buffer already has memory allocated,
+	      the memory will be freed before any new memory is allocated
+*/
+ACR_Info_t ACR_AlignedBufferAllocate(
+	ACR_AlignedBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t alignment);
+
+/** allocate memory for the buffer aligned to a cache line, a page,
+	or a huge page. large or page aligned memory is mapped directly
+	from the system and all other memory comes from ACR_MALLOC_ALIGNED
+	\param me the aligned buffer
+	\param length value 1 to ACR_MAX_LENGTH
+	\param alignment a power of two number of bytes such as
+	                 ACR_ALIGN_TO_CACHE_LINE, ACR_AlignedBufferGetPageLength(),
+	                 or ACR_ALIGN_TO_HUGE_PAGE
+	\param options ACR_ALIGNED_BUFFER_OPTIONS_NONE or any of
+	               ACR_ALIGNED_BUFFER_HUGE_PAGES and ACR_ALIGNED_BUFFER_PREFAULT
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: if the buffer already has memory allocated,
+	      the memory will be freed before any new memory is allocated
+	Note: ACR_ALIGNED_BUFFER_HUGE_PAGES is only advice. it is ignored
+	      where the system does not support transparent huge pages
+	Note: memory mapped from the system is only released by
+	      ACR_AlignedBufferDeInit(), ACR_AlignedBufferDelete(), or by
+	      allocating or setting new memory with these functions.
+	      ACR_ALIGNED_BUFFER_FREE() and ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO()
+	      cannot unmap it so they leave the buffer unchanged
+*/
+ACR_Info_t ACR_AlignedBufferAllocatePages(
+	ACR_AlignedBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t alignment,
+	ACR_Flags_t options);
+
+/** get the number of bytes in a page of the system
+	\returns the page length
+*/
+ACR_Length_t ACR_AlignedBufferGetPageLength(void);
 
 /** set aligned memory by reference
 	\param ptr pointer to the start of the memory to access
@@ -0,0 +1,147 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file allocator.h
+
+    public functions to allocate memory through an ACR_AllocatorInterface_t
+
+    objects created with an allocator use ACR_AllocatorNew(),
+    which remembers the allocator just before the memory so
+    that ACR_AllocatorDelete() gives it back to the same one.
+
+    example:
+
+        ACR_ALLOCATOR_INTERFACE(allocator);
+        ACR_BufferObj_t* buffer;
+        ACR_ArenaInitAllocator(arena, &allocator);
+        if(ACR_BufferNewWithAllocator(&buffer, &allocator) == ACR_INFO_OK)
+        {
+            // use the buffer
+            ACR_BufferDelete(&buffer);
+        }
+
+    Note: the allocator interface must stay valid until
+          all of the memory from it has been freed
+
+*/
+#ifndef _ACR_ALLOCATOR_H_
+#define _ACR_ALLOCATOR_H_
+
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** allocate memory
+    \param me the allocator or ACR_NULL to use ACR_MALLOC()
+    \param bytes the number of bytes to allocate
+    \returns a pointer to the memory or ACR_NULL on failure
+*/
+void* ACR_AllocatorAlloc(
+    const ACR_AllocatorInterface_t* me,
+    ACR_Length_t bytes);
+
+/** free memory from ACR_AllocatorAlloc() or ACR_AllocatorRealloc()
+    \param me the allocator or ACR_NULL to use ACR_FREE()
+    \param ptr the memory
+*/
+void ACR_AllocatorFree(
+    const ACR_AllocatorInterface_t* me,
+    void* ptr);
+
+/** change the size of memory from ACR_AllocatorAlloc()
+    \param me the allocator or ACR_NULL to use ACR_REALLOC()
+    \param ptr the memory or ACR_NULL to allocate new memory
+    \param bytes the new number of bytes
+    \returns either a pointer to the memory and ptr is no longer valid
+             or on failure ACR_NULL and ptr remains valid
+*/
+void* ACR_AllocatorRealloc(
+    const ACR_AllocatorInterface_t* me,
+    void* ptr,
+    ACR_Length_t bytes);
+
+/** allocate cleared memory for an object that remembers its allocator
+    \param me the allocator or ACR_NULL to use ACR_MALLOC()
+    \param bytes the number of bytes to allocate
+    \returns a pointer to the memory or ACR_NULL on failure
+
+    Note: ACR_ALLOCATOR_NEW_BYTES(bytes) are taken from the allocator
+*/
+void* ACR_AllocatorNew(
+    const ACR_AllocatorInterface_t* me,
+    ACR_Length_t bytes);
+
+/** free memory from ACR_AllocatorNew() with the allocator it came from
+    \param ptr the memory or ACR_NULL
+*/
+void ACR_AllocatorDelete(
+    void* ptr);
+
+/** get the allocator of memory from ACR_AllocatorNew()
+    \param ptr the memory
+    \returns the allocator or ACR_NULL for ACR_MALLOC()
+*/
+const ACR_AllocatorInterface_t* ACR_AllocatorOf(
+    const void* ptr);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,180 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file arena.h
+
+    public functions for access to the ACR_ArenaObj_t type
+
+    An arena hands out memory by moving a position forward
+    so each allocation is very fast. Individual allocations
+    are never freed. Instead, save the position with
+    ACR_ArenaMark() before making temporary allocations and
+    then release all of them at once with ACR_ArenaRewind().
+
+    example:
+
+        ACR_ArenaObj_t* arena;
+        if(ACR_ArenaNew(&arena, 4096) == ACR_INFO_OK)
+        {
+            ACR_ArenaMark_t mark = ACR_ArenaMark(arena);
+            ACR_NEW_BY_TYPE_FROM(row, MyRow_t, ACR_Arena, arena);
+            // use row
+            ACR_ArenaRewind(arena, mark);
+            ACR_ArenaDelete(&arena);
+        }
+
+*/
+#ifndef _ACR_ARENA_H_
+#define _ACR_ARENA_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
+/** predefined object type
+*/
+typedef struct ACR_ArenaObj_s ACR_ArenaObj_t;
+
+/** a saved arena position
+    \see ACR_ArenaMark()
+*/
+typedef ACR_Length_t ACR_ArenaMark_t;
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare an arena allocated on the heap
+    \param mePtr location to store the pointer for the new arena
+    \param length the number of bytes the arena can hand out
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+
+    Note: the arena and its memory are a single allocation
+*/
+ACR_Info_t ACR_ArenaNew(
+    ACR_ArenaObj_t** mePtr,
+    ACR_Length_t length);
+
+/** free an arena allocated on the heap along with
+    every allocation made from it
+    \param mePtr location of the pointer for the arena, which will
+           be set to ACR_NULL after the memory is freed
+*/
+void ACR_ArenaDelete(
+    ACR_ArenaObj_t** mePtr);
+
+/** allocate this many bytes from the arena
+    \param me the arena
+    \param bytes the number of bytes to allocate
+    \returns a pointer to the memory or ACR_NULL if the arena is full
+*/
+void* ACR_ArenaAlloc(
+    ACR_ArenaObj_t* me,
+    ACR_Length_t bytes);
+
+/** does nothing because arena memory is only released
+    by ACR_ArenaRewind() or ACR_ArenaReset().
+    this exists so that ACR_DELETE_FROM() can be used with an arena
+*/
+void ACR_ArenaFree(
+    ACR_ArenaObj_t* me,
+    void* ptr);
+
+/** get the current position of the arena
+    \param me the arena
+    \returns a mark to pass to ACR_ArenaRewind()
+*/
+ACR_ArenaMark_t ACR_ArenaMark(
+    ACR_ArenaObj_t* me);
+
+/** release every allocation made since the mark was taken
+    \param me the arena
+    \param mark value returned by ACR_ArenaMark(). marks taken
+           after this one are no longer valid
+*/
+void ACR_ArenaRewind(
+    ACR_ArenaObj_t* me,
+    ACR_ArenaMark_t mark);
+
+/** release every allocation made from the arena
+    \param me the arena
+*/
+void ACR_ArenaReset(
+    ACR_ArenaObj_t* me);
+
+/** get the number of bytes that can still be allocated
+    \param me the arena
+*/
+ACR_Length_t ACR_ArenaAvailable(
+    ACR_ArenaObj_t* me);
+
+/** set an allocator interface to allocate from the arena.
+    memory is not freed until the arena is rewound or reset
+    and cannot be reallocated
+    \param me the arena
+    \param allocator the allocator interface
+*/
+void ACR_ArenaInitAllocator(
+    ACR_ArenaObj_t* me,
+    ACR_AllocatorInterface_t* allocator);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,379 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file binary.h
+
+    public functions to read and write typed values in a
+    chosen byte order through an ACR_Binary_t
+
+    The binary codec wraps an ACR_Cursor_t. Every read or write
+    checks the range, but a failure is remembered instead of
+    returned, so a sequence of fields can be read without
+    checking each one and the result checked once at the end.
+    Once a read or write fails, all of the following reads
+    return 0 and all of the following writes do nothing.
+
+    Values are assembled from bytes so the byte order of the
+    data never needs to match the system. Arrays in the same
+    byte order as the system are copied with ACR_MEMCPY when
+    the byte order is known at compile time.
+
+    example:
+
+        ACR_BINARY(reader);
+        ACR_BinaryInit(&reader, buffer, ACR_BOOL_TRUE);
+        ACR_Unsigned_16bit_t type = ACR_BinaryReadU16(&reader);
+        ACR_Unsigned_32bit_t count = ACR_BinaryReadU32(&reader);
+        ACR_Decimal_t scale = ACR_BinaryReadF32(&reader);
+        if(ACR_BinaryResult(&reader) == ACR_INFO_OK)
+        {
+            // all three fields were in the buffer
+        }
+
+*/
+#ifndef _ACR_BINARY_H_
+#define _ACR_BINARY_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t and ACR_USE_64BIT
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+// included for ACR_Cursor_t
+#include "ACR/public/public_cursor.h"
+
+// included for ACR_Unsigned_16bit_t, ACR_Unsigned_32bit_t,
+// and ACR_Unsigned_64bit_t
+#include "ACR/public/public_byte_order.h"
+
+// included for ACR_Decimal_t
+#include "ACR/public/public_decimal.h"
+
+/** type for reading or writing typed values in a range of memory
+*/
+typedef struct ACR_Binary_s
+{
+    /** the next byte to read or write
+    */
+    ACR_Cursor_t m_Cursor;
+
+    /** ACR_BOOL_TRUE when values are stored most significant byte first
+    */
+    ACR_Bool_t m_IsBigEndian;
+
+    /** ACR_INFO_OK until a read or write does not fit
+    */
+    ACR_Info_t m_Result;
+
+} ACR_Binary_t;
+
+/** define a binary codec on the stack with the specified name and no memory
+*/
+#define ACR_BINARY(name) ACR_Binary_t name = {{ACR_NULL,ACR_NULL},ACR_BOOL_FALSE,ACR_INFO_OK}
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare to read or write the memory of a buffer
+    \param me the binary codec
+    \param buffer the memory to read or write
+    \param isBigEndian ACR_BOOL_TRUE if values are stored most
+           significant byte first or ACR_BOOL_FALSE if values
+           are stored least significant byte first
+*/
+void ACR_BinaryInit(
+    ACR_Binary_t* me,
+    ACR_Buffer_t buffer,
+    ACR_Bool_t isBigEndian);
+
+/** get the result of all reads and writes since ACR_BinaryInit()
+    \returns ACR_INFO_OK if every read and write fit in the memory
+             or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_BinaryResult(
+    ACR_Binary_t* me);
+
+/** get the number of bytes that have not been read or written
+*/
+ACR_Length_t ACR_BinaryRemaining(
+    ACR_Binary_t* me);
+
+/** move past the specified number of bytes without reading them
+*/
+void ACR_BinarySkip(
+    ACR_Binary_t* me,
+    ACR_Length_t length);
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS - READ
+//
+// Note: each function returns 0 if the value does not fit
+//
+////////////////////////////////////////////////////////////
+
+/** read an unsigned 8 bit value
+*/
+ACR_Byte_t ACR_BinaryReadU8(
+    ACR_Binary_t* me);
+
+/** read a signed 8 bit value
+*/
+signed char ACR_BinaryReadI8(
+    ACR_Binary_t* me);
+
+/** read an unsigned 16 bit value
+*/
+ACR_Unsigned_16bit_t ACR_BinaryReadU16(
+    ACR_Binary_t* me);
+
+/** read a signed 16 bit value
+*/
+ACR_16bit_t ACR_BinaryReadI16(
+    ACR_Binary_t* me);
+
+/** read an unsigned 32 bit value
+*/
+ACR_Unsigned_32bit_t ACR_BinaryReadU32(
+    ACR_Binary_t* me);
+
+/** read a signed 32 bit value
+*/
+ACR_32bit_t ACR_BinaryReadI32(
+    ACR_Binary_t* me);
+
+/** read a 32 bit IEEE 754 floating point value
+*/
+ACR_Decimal_t ACR_BinaryReadF32(
+    ACR_Binary_t* me);
+
+/** read bytes into dest
+    \param me the binary codec
+    \param dest the location to copy the bytes to
+    \param length the number of bytes to read
+*/
+void ACR_BinaryReadBytes(
+    ACR_Binary_t* me,
+    void* dest,
+    ACR_Length_t length);
+
+/** read a blob that is stored as an unsigned 32 bit length
+    followed by that many bytes without copying the bytes
+    \param me the binary codec
+    \param view set to reference the bytes of the blob
+*/
+void ACR_BinaryReadBlob(
+    ACR_Binary_t* me,
+    ACR_Buffer_t* view);
+
+/** read an array of unsigned 16 bit values
+    \param me the binary codec
+    \param dest the location to store the values
+    \param count the number of values to read
+*/
+void ACR_BinaryReadU16Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_16bit_t* dest,
+    ACR_Length_t count);
+
+/** read an array of unsigned 32 bit values
+    \param me the binary codec
+    \param dest the location to store the values
+    \param count the number of values to read
+*/
+void ACR_BinaryReadU32Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_32bit_t* dest,
+    ACR_Length_t count);
+
+#if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+/** read an unsigned 64 bit value
+*/
+ACR_Unsigned_64bit_t ACR_BinaryReadU64(
+    ACR_Binary_t* me);
+
+/** read a signed 64 bit value
+*/
+ACR_64bit_t ACR_BinaryReadI64(
+    ACR_Binary_t* me);
+
+/** read a 64 bit IEEE 754 floating point value
+*/
+double ACR_BinaryReadF64(
+    ACR_Binary_t* me);
+
+/** read an array of unsigned 64 bit values
+    \param me the binary codec
+    \param dest the location to store the values
+    \param count the number of values to read
+*/
+void ACR_BinaryReadU64Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_64bit_t* dest,
+    ACR_Length_t count);
+
+#endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS - WRITE
+//
+// Note: signed values are written with the unsigned
+//       function of the same size
+//
+////////////////////////////////////////////////////////////
+
+/** write an unsigned 8 bit value
+*/
+void ACR_BinaryWriteU8(
+    ACR_Binary_t* me,
+    ACR_Byte_t value);
+
+/** write an unsigned 16 bit value
+*/
+void ACR_BinaryWriteU16(
+    ACR_Binary_t* me,
+    ACR_Unsigned_16bit_t value);
+
+/** write an unsigned 32 bit value
+*/
+void ACR_BinaryWriteU32(
+    ACR_Binary_t* me,
+    ACR_Unsigned_32bit_t value);
+
+/** write a 32 bit IEEE 754 floating point value
+*/
+void ACR_BinaryWriteF32(
+    ACR_Binary_t* me,
+    ACR_Decimal_t value);
+
+/** write bytes from src
+    \param me the binary codec
+    \param src the location to copy the bytes from
+    \param length the number of bytes to write
+*/
+void ACR_BinaryWriteBytes(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length);
+
+/** write a blob as an unsigned 32 bit length followed by the bytes
+    \param me the binary codec
+    \param src the location to copy the bytes from
+    \param length the number of bytes in the blob
+*/
+void ACR_BinaryWriteBlob(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length);
+
+/** write an array of unsigned 16 bit values
+    \param me the binary codec
+    \param src the values to write
+    \param count the number of values to write
+*/
+void ACR_BinaryWriteU16Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_16bit_t* src,
+    ACR_Length_t count);
+
+/** write an array of unsigned 32 bit values
+    \param me the binary codec
+    \param src the values to write
+    \param count the number of values to write
+*/
+void ACR_BinaryWriteU32Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_32bit_t* src,
+    ACR_Length_t count);
+
+#if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+/** write an unsigned 64 bit value
+*/
+void ACR_BinaryWriteU64(
+    ACR_Binary_t* me,
+    ACR_Unsigned_64bit_t value);
+
+/** write a 64 bit IEEE 754 floating point value
+*/
+void ACR_BinaryWriteF64(
+    ACR_Binary_t* me,
+    double value);
+
+/** write an array of unsigned 64 bit values
+    \param me the binary codec
+    \param src the values to write
+    \param count the number of values to write
+*/
+void ACR_BinaryWriteU64Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_64bit_t* src,
+    ACR_Length_t count);
+
+#endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -57,6 +57,12 @@
 // included for ACR_FileInterface_t
 #include "ACR/public/public_file.h"
 
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
+// included for ACR_Cursor_t
+#include "ACR/public/public_cursor.h"
+
 /** predefined object type
 */
 typedef struct ACR_BufferObj_s ACR_BufferObj_t;
@@ -89,6 +95,21 @@ extern "C" {                                              //
 ACR_Info_t ACR_BufferNew(
 	ACR_BufferObj_t** mePtr);
 
+/** prepare a buffer allocated from an allocator
+	\param mePtr location to store the pointer for the new buffer
+	\param allocator the allocator for the buffer object or ACR_NULL
+	       to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: the allocator must stay valid until ACR_BufferDelete()
+	Note: the memory from ACR_BufferAllocate() uses ACR_MALLOC()
+	      unless ACR_BufferSetDataAllocator() is called so that
+	      a pool of fixed size objects can be used for the object
+*/
+ACR_Info_t ACR_BufferNewWithAllocator(
+	ACR_BufferObj_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free a buffer allocated on the heap
     Note: this automatically calls ACR_BufferDeInit() on
 	      the buffer before freeing its memory
@@ -110,6 +131,19 @@ ACR_Info_t ACR_BufferAllocate(
 	ACR_BufferObj_t* me,
 	ACR_Length_t length);
 
+/** set the allocator for the memory from ACR_BufferAllocate()
+	\param me the buffer
+	\param allocator the allocator or ACR_NULL to use ACR_MALLOC()
+
+	IMPORTANT: if the buffer already has memory allocated,
+	           the memory will be freed before the allocator is changed
+
+	Note: the allocator must stay valid until the memory is freed
+*/
+void ACR_BufferSetDataAllocator(
+	ACR_BufferObj_t* me,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** use the specified memory for the buffer
 	\param me the buffer
 	\param ptr pointer to the start of the memory to access
@@ -207,6 +241,25 @@ ACR_Info_t ACR_BufferGetByteAt(
 	ACR_Length_t pos,
 	ACR_Byte_t* value);
 
+/** get a cursor over part of the buffer so that many bytes can be
+    read or written without checking the buffer for each one
+	\param me the buffer
+	\param pos the position in the buffer where the cursor starts
+	\param length the number of bytes the cursor may access
+	\param cursor the location to store the cursor
+	\returns ACR_INFO_OK
+	         or ACR_INFO_GREATER if pos + length is too large
+			 or ACR_INFO_INVALID if the buffer has no memory
+	         or ACR_INFO_ERROR
+
+	Note: the cursor is only valid until the buffer memory changes
+*/
+ACR_Info_t ACR_BufferGetCursor(
+	ACR_BufferObj_t* me,
+	ACR_Length_t pos,
+	ACR_Length_t length,
+	ACR_Cursor_t* cursor);
+
 /** shift all data in the buffer
 	\param me the buffer
 	\param shiftBytes the number of bytes to shift by
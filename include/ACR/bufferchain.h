@@ -0,0 +1,213 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bufferchain.h
+
+    public functions to refer to several separate buffers
+    in order through an ACR_BufferChain_t
+
+    A chain only stores references so building a message from
+    a header, a payload, and a trailer copies none of them.
+    The links can be visited one at a time, sliced into a
+    smaller chain that still refers to the same memory, or
+    copied into one contiguous buffer when that is required.
+    ACR_FileWriteChain() writes a chain to a file in one call.
+
+    example:
+
+        ACR_Buffer_t links[3];
+        ACR_BUFFER_CHAIN(message, links, 3);
+        ACR_BufferChainAppend(&message, header, headerLength);
+        ACR_BufferChainAppend(&message, payload, payloadLength);
+        ACR_BufferChainAppend(&message, trailer, trailerLength);
+        ACR_Count_t index;
+        for(index = 0; index < ACR_BufferChainGetCount(&message); index++)
+        {
+            ACR_BUFFER(link);
+            ACR_BufferChainGetLink(&message, index, &link);
+            // link refers to header, payload, or trailer
+        }
+
+*/
+#ifndef _ACR_BUFFERCHAIN_H_
+#define _ACR_BUFFERCHAIN_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Count_t
+#include "ACR/public/public_count.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+// included for ACR_VarBuffer_t
+#include "ACR/public/public_varbuffer.h"
+
+// included for ACR_BufferChain_t
+#include "ACR/public/public_bufferchain.h"
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare an empty chain
+    \param me the chain
+    \param links memory for up to maxCount links
+    \param maxCount the max number of links in the chain
+*/
+void ACR_BufferChainInit(
+    ACR_BufferChain_t* me,
+    ACR_Buffer_t* links,
+    ACR_Count_t maxCount);
+
+/** remove all links without changing the memory they refer to
+    \param me the chain
+*/
+void ACR_BufferChainClear(
+    ACR_BufferChain_t* me);
+
+/** add a reference to data at the end of the chain
+    \param me the chain
+    \param data the memory to refer to, which must stay valid
+                and unchanged for as long as the chain is used
+    \param length the number of bytes at data
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if there are no links left
+
+    Note: no link is added when length is 0
+*/
+ACR_Info_t ACR_BufferChainAppend(
+    ACR_BufferChain_t* me,
+    void* data,
+    ACR_Length_t length);
+
+/** get the total number of bytes in all links
+    \param me the chain
+    \returns the number of bytes
+*/
+ACR_Length_t ACR_BufferChainGetLength(
+    ACR_BufferChain_t* me);
+
+/** get the number of links
+    \param me the chain
+    \returns the number of links
+*/
+ACR_Count_t ACR_BufferChainGetCount(
+    ACR_BufferChain_t* me);
+
+/** get a reference to the memory of one link
+    \param me the chain
+    \param index the link from 0 to ACR_BufferChainGetCount()-1
+    \param link set to refer to the memory of the link
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if index is not a link
+*/
+ACR_Info_t ACR_BufferChainGetLink(
+    ACR_BufferChain_t* me,
+    ACR_Count_t index,
+    ACR_Buffer_t* link);
+
+/** refer to a range of bytes in the chain from another chain
+    without copying them
+    \param me the chain
+    \param pos the position of the first byte in the range
+    \param length the number of bytes in the range
+    \param slice the chain to replace with the range. its links
+                 refer to the same memory as the links of me
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if the range is not
+             in the chain or slice does not have enough links
+*/
+ACR_Info_t ACR_BufferChainSlice(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    ACR_Length_t length,
+    ACR_BufferChain_t* slice);
+
+/** copy a range of bytes in the chain to contiguous memory
+    \param me the chain
+    \param pos the position of the first byte to copy
+    \param dest the memory to copy to
+    \param length the max number of bytes to copy
+    \returns the number of bytes copied, which is less than
+             length when the chain ends first
+*/
+ACR_Length_t ACR_BufferChainCopyTo(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    void* dest,
+    ACR_Length_t length);
+
+/** get all bytes of the chain in contiguous memory, copying
+    them only when there is more than one link
+    \param me the chain
+    \param scratch memory to copy into when there is more than one link.
+                   its data is replaced and its max length is increased
+                   with ACR_VarBufferReserve() if needed
+    \param view set to all bytes of the chain. it points either into
+                the only link or into scratch and is a reference in both cases
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if scratch is too small
+             and could not be increased
+    Note: view is only valid until scratch is reused
+*/
+ACR_Info_t ACR_BufferChainLinearize(
+    ACR_BufferChain_t* me,
+    ACR_VarBuffer_t* scratch,
+    ACR_Buffer_t* view);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -48,6 +48,9 @@
 // included for ACR_String_t
 #include "ACR/public/public_string.h"
 
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
 // included for ACR_Info_t
 #include "ACR/public/public_info.h"
 
@@ -89,6 +92,22 @@ ACR_Info_t ACR_CsvNew(
 	ACR_CsvObj_t** mePtr,
     ACR_FileInterface_t* fileInterface);
 
+/** allocate data from an allocator.
+	\param mePtr location to store the pointer
+    \param fileInterface the file interface to use.
+                         this must exist for the life of
+                         this object
+    \param allocator the allocator for all memory of this
+                     object or ACR_NULL to use ACR_MALLOC().
+                     this must exist for the life of
+                     this object
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_CsvNewWithAllocator(
+	ACR_CsvObj_t** mePtr,
+    ACR_FileInterface_t* fileInterface,
+    const ACR_AllocatorInterface_t* allocator);
+
 /** free data
 	\param mePtr location of the pointer, which will
 	       be set to ACR_NULL after the memory is freed
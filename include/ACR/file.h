@@ -60,6 +60,9 @@
 // included for ACR_Length_t
 #include "ACR/public/public_memory.h"
 
+// included for ACR_BufferChain_t
+#include "ACR/public/public_bufferchain.h"
+
 ////////////////////////////////////////////////////////////
 // ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
 ////////////////////////////////////////////////////////////
@@ -103,6 +106,42 @@ ACR_Info_t ACR_FileReadAll(
 	ACR_FileInterface_t* me,
     ACR_Buffer_t* buffer);
 
+/** read the next bytes of the file without copying them when possible.
+    uses me->m_Borrow when the file can lend memory and
+    falls back to me->m_Read otherwise
+    \param me the file interface, which must be ready to read
+    \param scratch memory to read into when the file cannot lend memory.
+                   scratch->m_MaxLength limits the number of bytes in view
+                   even when the file lends memory
+    \param view set to the bytes that were read. it points either into
+                the file or into scratch and is a reference in both cases
+    \returns ACR_INFO_OK if 0 or more bytes are in view
+             ACR_INFO_ERROR if any error occurs.
+    Note: view is only valid until the file is written, closed,
+          or scratch is reused
+*/
+ACR_Info_t ACR_FileReadView(
+	ACR_FileInterface_t* me,
+    ACR_VarBuffer_t* scratch,
+    ACR_Buffer_t* view);
+
+/** write every buffer in a chain to the file in order without
+    copying them together first.
+    uses me->m_WriteChain when the file can write a chain in one call
+    and falls back to me->m_Write for each buffer otherwise
+    \param me the file interface, which must be ready to write
+    \param src the buffers to write
+    \param written set to the number of bytes actually written
+    \returns ACR_INFO_OK if 0 or more bytes are written
+             Note: written is less than ACR_BufferChainGetLength()
+                   when the file could not take every byte
+             ACR_INFO_ERROR if any error occurs.
+*/
+ACR_Info_t ACR_FileWriteChain(
+	ACR_FileInterface_t* me,
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written);
+
 ////////////////////////////////////////////////////////////
 // ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
 ////////////////////////////////////////////////////////////
@@ -48,6 +48,9 @@
 // included for ACR_String_t
 #include "ACR/public/public_string.h"
 
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
 /** predefined object type for the filesystem
 */
 typedef struct ACR_FilesystemObj_s ACR_FilesystemObj_t;
@@ -81,6 +84,16 @@ extern "C" {                                              //
 ACR_Info_t ACR_FilesystemNew(
 	ACR_FilesystemObj_t** mePtr);
 
+/** allocate filesystem data from an allocator
+	\param mePtr location to store the pointer
+	\param allocator the allocator for all memory of the
+	       filesystem data or ACR_NULL to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_FilesystemNewWithAllocator(
+	ACR_FilesystemObj_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free a filesystem data
 	\param mePtr location of the pointer, which will
 	       be set to ACR_NULL after the memory is freed
@@ -55,6 +55,9 @@
 // included for ACR_Length_t
 #include "ACR/public/public_memory.h"
 
+// included for ACR_Decimal_t
+#include "ACR/public/public_decimal.h"
+
 // remove ACR_HAS_MALLOC if it is FALSE
 #ifdef ACR_HAS_MALLOC
     #if ACR_HAS_MALLOC == ACR_BOOL_FALSE
@@ -67,6 +70,8 @@
         #undef ACR_MALLOC
         #undef ACR_FREE
         #undef ACR_REALLOC
+        #undef ACR_MALLOC_ALIGNED
+        #undef ACR_FREE_ALIGNED
     #endif
 #endif
 
@@ -77,6 +82,12 @@
     #define ACR_MALLOC(s) ACR_GlobalHeapAlloc((ACR_Length_t)s)
     #define ACR_FREE(p) ACR_GlobalHeapFree(p)
     #define ACR_REALLOC(p,s) ACR_GlobalHeapRealloc(p, (ACR_Length_t)s)
+    #define ACR_MALLOC_ALIGNED(s,a) ACR_GlobalHeapAllocAligned((ACR_Length_t)s, (ACR_Length_t)a)
+    #define ACR_FREE_ALIGNED(p) ACR_GlobalHeapFreeAligned(p)
+
+    // included to send ACR_MALLOC(), ACR_FREE(), and ACR_REALLOC()
+    // through ACR/heaptrace.h when ACR_CONFIG_HEAP_TRACE is defined
+    #include "ACR/public/public_heap_trace.h"
 #else
     // ACR_HAS_MALLOC is already ACR_BOOL_TRUE
     // so the macros do not need to be redefined.
@@ -125,13 +136,40 @@ void* ACR_GlobalHeapRealloc(
     void* ptr,
     ACR_Length_t bytes);
 
+/** allocate this many bytes on the global heap
+    with the memory aligned to the specified number of bytes
+    \param bytes the number of bytes to attempt to allocated
+    \param alignment a power of two such as 32 or 64
+    \returns a pointer to the newly allocated memory or ACR_NULL on failure
+
+    Note: the memory must be freed with ACR_GlobalHeapFreeAligned()
+*/
+void* ACR_GlobalHeapAllocAligned(
+    ACR_Length_t bytes,
+    ACR_Length_t alignment);
+
+/** free memory allocated by ACR_GlobalHeapAllocAligned()
+    \param ptr existing allocated memory pointer
+*/
+void ACR_GlobalHeapFreeAligned(
+    void* ptr);
+
 #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
 
 /** non-standard but very fast function to free all
     allocated global heap memory.
+    Note: when ACR_CONFIG_HEAP_THREADS is defined no other
+          thread can be using the global heap at the same time
 */
 void ACR_GlobalHeapFreeAll(void);
 
+/** get how fragmented the free memory in the global heap is
+    \returns a value from 0.0 when all free memory can be
+             used by a single allocation up to 1.0 when
+             the free memory is split into many small pieces
+*/
+ACR_Decimal_t ACR_GlobalHeapFragmentation(void);
+
 #endif
 
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,277 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file heapfile.h
+
+    public functions to keep a heap in a memory mapped file
+    so that a restarted program can attach to the memory it
+    allocated before instead of loading it again
+
+    The file starts with an ACR_HeapFileHeader_t, which holds
+    the heap object and a root pointer, followed by the heap
+    memory. Heaps store positions instead of pointers so the
+    file can be mapped at any address. Attaching checks the
+    header and sets the one pointer to the heap memory, which
+    takes the same amount of time no matter how much memory
+    has been allocated.
+
+    Pointers stored inside the heap are only valid until the
+    file is closed. Use ACR_HeapFilePos() to store a position
+    instead and ACR_HeapFilePointer() to get the pointer back.
+
+    example:
+
+        ACR_HEAP_FILE(file);
+        if(ACR_HeapFileOpen(&file, "state.heap", 1024*1024) == ACR_INFO_NEW)
+        {
+            ACR_HeapFileSetRoot(file.m_Header, ACR_HeapAlloc(ACR_HeapFileHeap(file.m_Header), sizeof(State_t)));
+        }
+        state = (State_t*)ACR_HeapFileGetRoot(file.m_Header);
+        // use the state
+        ACR_HeapFileClose(&file);
+
+    Note: the heap never grows and must not be used by more
+          than one program at a time. a program that stops while
+          changing the heap may leave it in a state that is not valid.
+
+*/
+#ifndef _ACR_HEAP_FILE_H_
+#define _ACR_HEAP_FILE_H_
+
+// included for ACR_HeapObj_t
+#include "ACR/private/private_heap.h"
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t, ACR_Byte_t, and ACR_PointerValue_t
+#include "ACR/public/public_memory.h"
+
+/** the bytes at the start of every heap file
+*/
+#define ACR_HEAP_FILE_MAGIC "ACRHF1"
+
+/** the number of bytes in ACR_HEAP_FILE_MAGIC
+*/
+#define ACR_HEAP_FILE_MAGIC_LENGTH 6
+
+/** the number of bytes kept for ACR_HEAP_FILE_MAGIC, which is
+    ACR_HEAP_FILE_MAGIC_LENGTH rounded up to ACR_HEAP_ALIGNMENT
+*/
+#define ACR_HEAP_FILE_MAGIC_SIZE (((ACR_HEAP_FILE_MAGIC_LENGTH + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
+/** the data at the start of a heap file
+
+    m_Layout changes when the file was written by a program
+    with a different heap layout, alignment, or byte order.
+    m_Length is the number of bytes in the file.
+    m_RootPos is the position of the root pointer from the
+    start of the file or 0 when there is no root.
+*/
+typedef struct ACR_HeapFileHeader_s
+{
+    ACR_Byte_t m_Magic[ACR_HEAP_FILE_MAGIC_SIZE];
+    ACR_Length_t m_Layout;
+    ACR_Length_t m_Length;
+    ACR_Length_t m_RootPos;
+    ACR_HeapObj_t m_Heap;
+} ACR_HeapFileHeader_t;
+
+/** the number of bytes used by the header, which is the size
+    of ACR_HeapFileHeader_t rounded up to ACR_HEAP_ALIGNMENT
+*/
+#define ACR_HEAP_FILE_HEADER_SIZE (((sizeof(ACR_HeapFileHeader_t) + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
+#ifdef ACR_CONFIG_NO_HEAP_STATS
+    // heaps in the file have no m_Stats
+    #define ACR_HEAP_FILE_LAYOUT_STATS 0
+#else
+    #define ACR_HEAP_FILE_LAYOUT_STATS 1
+#endif
+
+/** value of m_Layout for this program, which holds every
+    setting that changes where the heap data is in the file:
+    bits 0 to 7 are ACR_HEAP_ALIGNMENT,
+    bits 8 to 15 are the size of ACR_HeapHeader_t,
+    bits 16 to 22 are ACR_CONFIG_HEAP_MAX_BLOCK_BITS,
+    bit 23 is set unless ACR_CONFIG_NO_HEAP_STATS is defined, and
+    bits 24 to 31 are the number of ACR_HEAP_ALIGNMENT blocks
+    in ACR_HeapFileHeader_t
+*/
+#define ACR_HEAP_FILE_LAYOUT ((ACR_Length_t)( \
+            ((((ACR_Length_t)sizeof(ACR_HeapFileHeader_t) / ACR_HEAP_ALIGNMENT) & 0xFF) << 24) | \
+            ((ACR_Length_t)ACR_HEAP_FILE_LAYOUT_STATS << 23) | \
+            (((ACR_Length_t)ACR_CONFIG_HEAP_MAX_BLOCK_BITS & 0x7F) << 16) | \
+            (((ACR_Length_t)sizeof(ACR_HeapHeader_t) & 0xFF) << 8) | \
+            ((ACR_Length_t)ACR_HEAP_ALIGNMENT & 0xFF)))
+
+/** a heap file mapped into memory
+
+    m_Header is ACR_NULL when the file is not open.
+    m_File and m_Mapping are the handles used by the system.
+*/
+typedef struct ACR_HeapFile_s
+{
+    ACR_HeapFileHeader_t* m_Header;
+    ACR_Length_t m_Length;
+    ACR_PointerValue_t m_File;
+    ACR_PointerValue_t m_Mapping;
+} ACR_HeapFile_t;
+
+/** define a heap file on the stack with the specified name
+*/
+#define ACR_HEAP_FILE(name) ACR_HeapFile_t name = {ACR_NULL, ACR_ZERO_LENGTH, 0, 0}
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** open a heap file, creating it if it does not exist
+    \param me the heap file
+    \param path the file name
+    \param length the number of bytes of a new file. an existing
+           file keeps its length
+    \returns ACR_INFO_NEW if the file was created with an empty heap,
+             ACR_INFO_OLD if the heap in an existing file was attached,
+             ACR_INFO_INVALID if an existing file does not have a heap
+             that can be attached, or ACR_INFO_ERROR if the file could
+             not be mapped or ACR_CONFIG_NO_LIBC is defined
+*/
+ACR_Info_t ACR_HeapFileOpen(
+    ACR_HeapFile_t* me,
+    const char* path,
+    ACR_Length_t length);
+
+/** write all changes to the heap file to storage
+    \param me the heap file
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_HeapFileSync(
+    ACR_HeapFile_t* me);
+
+/** close the heap file
+    \param me the heap file
+    Note: changes are written to storage by the system
+          but may not be written before this returns
+*/
+void ACR_HeapFileClose(
+    ACR_HeapFile_t* me);
+
+/** put an empty heap in memory
+    \param memory memory aligned to ACR_HEAP_ALIGNMENT
+    \param length the number of bytes at memory
+    \returns the header at the start of memory or ACR_NULL if
+             memory is not aligned or length is too small
+*/
+ACR_HeapFileHeader_t* ACR_HeapFileInitMemory(
+    void* memory,
+    ACR_Length_t length);
+
+/** attach to a heap that was put in memory by ACR_HeapFileInitMemory()
+    even if the memory has moved since then
+    \param memory memory aligned to ACR_HEAP_ALIGNMENT
+    \param length the number of bytes at memory
+    \returns the header at the start of memory or ACR_NULL
+             if the header is not valid
+*/
+ACR_HeapFileHeader_t* ACR_HeapFileAttachMemory(
+    void* memory,
+    ACR_Length_t length);
+
+/** get the heap to allocate from
+    \param me the header
+    \returns the heap
+*/
+ACR_HeapObj_t* ACR_HeapFileHeap(
+    ACR_HeapFileHeader_t* me);
+
+/** set the pointer that is kept when the heap is attached again
+    \param me the header
+    \param root memory allocated from the heap or ACR_NULL
+*/
+void ACR_HeapFileSetRoot(
+    ACR_HeapFileHeader_t* me,
+    const void* root);
+
+/** get the pointer set by ACR_HeapFileSetRoot()
+    \param me the header
+    \returns the root or ACR_NULL if there is no root
+*/
+void* ACR_HeapFileGetRoot(
+    ACR_HeapFileHeader_t* me);
+
+/** get the position of a pointer that stays the same
+    when the heap is attached at a different address
+    \param me the header
+    \param ptr the pointer
+    \returns the number of bytes from the start of the header
+             or 0 if ptr is ACR_NULL or outside of the heap
+*/
+ACR_Length_t ACR_HeapFilePos(
+    ACR_HeapFileHeader_t* me,
+    const void* ptr);
+
+/** get the pointer at a position from ACR_HeapFilePos()
+    \param me the header
+    \param pos the position
+    \returns the pointer or ACR_NULL if pos is 0 or outside of the heap
+*/
+void* ACR_HeapFilePointer(
+    ACR_HeapFileHeader_t* me,
+    ACR_Length_t pos);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
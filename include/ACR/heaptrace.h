@@ -0,0 +1,204 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file heaptrace.h
+
+    public functions to record every ACR_MALLOC(), ACR_FREE(),
+    and ACR_REALLOC() call as a compact binary trace
+
+    Define ACR_CONFIG_HEAP_TRACE in your project settings to
+    send those macros through this module. Each allocation is
+    then given an id, which is stored just before the memory,
+    and a record is written for every call while recording.
+
+    A trace starts with ACR_HEAP_TRACE_MAGIC followed by
+    one record per call. Each record is an operation byte
+    followed by the size, id, and the number of microseconds
+    since the previous record as unsigned LEB128 values.
+    Reallocation keeps the id of the original allocation.
+
+    example:
+
+        ACR_HeapTraceStart(fileInterface);
+        // run the workload
+        ACR_HeapTraceStop();
+
+    Note: recording is not thread safe
+
+*/
+#ifndef _ACR_HEAP_TRACE_H_
+#define _ACR_HEAP_TRACE_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t and ACR_Byte_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+// included for ACR_Time_t
+#include "ACR/public/public_clock.h"
+
+// included for ACR_FileInterface_t
+#include "ACR/public/public_file.h"
+
+/** the bytes at the start of every trace
+*/
+#define ACR_HEAP_TRACE_MAGIC "ACRHT1"
+
+/** the number of bytes in ACR_HEAP_TRACE_MAGIC
+*/
+#define ACR_HEAP_TRACE_MAGIC_LENGTH 6
+
+/** record of a successful ACR_MALLOC() call
+*/
+#define ACR_HEAP_TRACE_ALLOC 1
+
+/** record of an ACR_FREE() call
+*/
+#define ACR_HEAP_TRACE_FREE 2
+
+/** record of a successful ACR_REALLOC() call
+*/
+#define ACR_HEAP_TRACE_REALLOC 3
+
+/** the most bytes a single record uses
+*/
+#define ACR_HEAP_TRACE_MAX_RECORD_LENGTH (1 + (3 * 10))
+
+/** a single record of a trace
+*/
+typedef struct ACR_HeapTraceRecord_s
+{
+    ACR_Byte_t m_Op;
+    ACR_Length_t m_Size;
+    ACR_Length_t m_Id;
+    ACR_Time_t m_Micro;
+} ACR_HeapTraceRecord_t;
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** start recording a trace
+    \param file the file interface, which must be ready to write
+           and must stay valid until ACR_HeapTraceStop()
+    \returns ACR_INFO_OK if the trace was started or ACR_INFO_ERROR
+             if ACR_CONFIG_HEAP_TRACE is not defined or the
+             trace could not be written
+*/
+ACR_Info_t ACR_HeapTraceStart(
+    ACR_FileInterface_t* file);
+
+/** stop recording and write any records that are not yet written
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if any record could not be written
+*/
+ACR_Info_t ACR_HeapTraceStop(void);
+
+/** check that memory starts with ACR_HEAP_TRACE_MAGIC
+    \param data the trace
+    \param length the number of bytes of data
+    \param pos stores the position of the first record
+    \returns ACR_BOOL_TRUE if the data is a trace
+*/
+ACR_Bool_t ACR_HeapTraceReadStart(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos);
+
+/** read the next record of a trace
+    \param data the trace
+    \param length the number of bytes of data
+    \param pos the position of the record, which is
+               moved to the next record
+    \param record stores the record. m_Micro is the number of
+                  microseconds since the trace was started
+                  Note: set m_Micro to 0 before the first record
+    \returns ACR_BOOL_TRUE if a complete record was read
+*/
+ACR_Bool_t ACR_HeapTraceRead(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos,
+    ACR_HeapTraceRecord_t* record);
+
+#ifdef ACR_CONFIG_HEAP_TRACE
+
+/** allocate memory and record it
+    \see ACR_MALLOC
+*/
+void* ACR_HeapTraceAlloc(
+    ACR_Length_t bytes);
+
+/** free memory and record it
+    \see ACR_FREE
+*/
+void ACR_HeapTraceFree(
+    void* ptr);
+
+/** reallocate memory and record it
+    \see ACR_REALLOC
+*/
+void* ACR_HeapTraceRealloc(
+    void* ptr,
+    ACR_Length_t bytes);
+
+#endif // #ifdef ACR_CONFIG_HEAP_TRACE
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
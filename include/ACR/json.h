@@ -48,6 +48,9 @@
 // included for ACR_String_t
 #include "ACR/public/public_string.h"
 
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
 /** predefined object type
 */
 typedef struct ACR_JsonObj_s ACR_JsonObj_t;
@@ -73,6 +76,16 @@ extern "C" {                                              //
 ACR_Info_t ACR_JsonNew(
 	ACR_JsonObj_t** mePtr);
 
+/** allocate json data from an allocator
+	\param mePtr location to store the pointer
+	\param allocator the allocator for all memory of the json
+	       data or ACR_NULL to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_JsonNewWithAllocator(
+	ACR_JsonObj_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free a json data
 	\param mePtr location of the pointer, which will
 	       be set to ACR_NULL after the memory is freed
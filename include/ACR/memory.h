@@ -0,0 +1,136 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file memory.h
+
+    public functions to copy, move, set, and compare memory
+    without the standard C library
+
+    ACR_MEMCPY(), ACR_MEMMOVE(), ACR_MEMSET(), and ACR_MEMCMP()
+    use these functions when ACR_CONFIG_NO_LIBC is defined.
+    the kernel that moves the bulk of the memory is selected
+    at compile time:
+
+        ACR_CONFIG_MEMORY_BYTES   one byte at a time
+        (default)                 one ACR_Block_t at a time once
+                                  the memory is aligned
+        ACR_CONFIG_MEMORY_SIMD    AVX2, SSE2, or NEON registers when
+                                  the compiler targets them and
+                                  ACR_Block_t otherwise
+
+    Note: src/ACR/memory.c must be added to any project
+          that defines ACR_CONFIG_NO_LIBC
+
+*/
+#ifndef _ACR_MEMORY_H_
+#define _ACR_MEMORY_H_
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** copy memory that does not overlap
+    \param dest the memory to copy to
+    \param src the memory to copy from
+    \param length the number of bytes to copy
+*/
+void ACR_MemoryCopy(
+    void* dest,
+    const void* src,
+    ACR_Length_t length);
+
+/** copy memory that may overlap
+    \param dest the memory to copy to
+    \param src the memory to copy from
+    \param length the number of bytes to copy
+*/
+void ACR_MemoryMove(
+    void* dest,
+    const void* src,
+    ACR_Length_t length);
+
+/** set every byte of memory to a value
+    \param dest the memory to set
+    \param value the value of each byte
+    \param length the number of bytes to set
+*/
+void ACR_MemorySet(
+    void* dest,
+    int value,
+    ACR_Length_t length);
+
+/** compare memory like memcmp
+    \param first the first memory
+    \param second the second memory
+    \param length the number of bytes to compare
+    \returns 0 if the memory is the same or the difference
+             of the first bytes that are not the same
+*/
+int ACR_MemoryCompare(
+    const void* first,
+    const void* second,
+    ACR_Length_t length);
+
+/** get the name of the kernel selected at compile time
+    \returns "bytes", "blocks", "sse2", "avx2", or "neon"
+*/
+const char* ACR_MemoryKernelName(void);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,158 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file pool.h
+
+    public functions for access to the ACR_PoolObj_t type
+
+    A pool hands out objects that are all the same size.
+    Objects are taken from slabs that hold many objects
+    next to each other in memory and freed objects are
+    kept in a list inside the objects themselves, so
+    allocating and freeing only moves a single pointer.
+
+    example:
+
+        ACR_PoolObj_t* pool;
+        if(ACR_PoolNew(&pool, sizeof(MyObject_t), 32) == ACR_INFO_OK)
+        {
+            ACR_NEW_BY_TYPE_FROM(obj, MyObject_t, ACR_Pool, pool);
+            // use obj
+            ACR_DELETE_FROM(obj, ACR_Pool, pool);
+            ACR_PoolDelete(&pool);
+        }
+
+*/
+#ifndef _ACR_POOL_H_
+#define _ACR_POOL_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Count_t
+#include "ACR/public/public_count.h"
+
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
+/** predefined object type
+*/
+typedef struct ACR_PoolObj_s ACR_PoolObj_t;
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare a pool allocated on the heap
+    \param mePtr location to store the pointer for the new pool
+    \param objectBytes the size of each object such as sizeof(MyObject_t)
+    \param objectsPerSlab the number of objects allocated at a
+           time when the pool runs out of free objects
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_PoolNew(
+    ACR_PoolObj_t** mePtr,
+    ACR_Length_t objectBytes,
+    ACR_Count_t objectsPerSlab);
+
+/** free a pool allocated on the heap along with
+    every object allocated from it
+    \param mePtr location of the pointer for the pool, which will
+           be set to ACR_NULL after the memory is freed
+*/
+void ACR_PoolDelete(
+    ACR_PoolObj_t** mePtr);
+
+/** get an object from the pool
+    \param me the pool
+    \param bytes must be no larger than the object size of the pool
+    \returns a pointer to the object or ACR_NULL on failure
+*/
+void* ACR_PoolAlloc(
+    ACR_PoolObj_t* me,
+    ACR_Length_t bytes);
+
+/** give an object back to the pool
+    \param me the pool
+    \param ptr pointer returned by ACR_PoolAlloc() from this pool
+*/
+void ACR_PoolFree(
+    ACR_PoolObj_t* me,
+    void* ptr);
+
+/** get the number of objects allocated from the pool that have not been freed
+    \param me the pool
+*/
+ACR_Count_t ACR_PoolCount(
+    ACR_PoolObj_t* me);
+
+/** set an allocator interface to allocate objects from the pool.
+    memory cannot be reallocated
+    \param me the pool
+    \param allocator the allocator interface
+    Note: ACR_AllocatorNew() needs a few more bytes than the object
+          it creates so create the pool with an object size of
+          ACR_ALLOCATOR_NEW_BYTES(sizeof(MyObject_t))
+*/
+void ACR_PoolInitAllocator(
+    ACR_PoolObj_t* me,
+    ACR_AllocatorInterface_t* allocator);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,103 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file private_arena.h
+
+    private functions for access to the ACR_ArenaObj_t type
+
+*/
+#ifndef _ACR_PRIVATE_ARENA_H_
+#define _ACR_PRIVATE_ARENA_H_
+
+#include "ACR/arena.h"
+
+// included for ACR_HEAP_ALIGNMENT
+#include "ACR/private/private_heap.h"
+
+/** private arena type
+
+    this uses the same memory layout as ACR_HeapObj_t
+    where m_NextFreePos is the position of the next allocation.
+    no headers or free lists are needed so every byte is usable
+*/
+struct ACR_ArenaObj_s
+{
+    ACR_Byte_t* m_Heap;
+    ACR_Length_t m_HeapLength;
+    ACR_Length_t m_NextFreePos;
+};
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare an arena to use the specified memory
+    \param me the arena
+    \param ptr pointer to the memory used for allocations
+    \param length the number of bytes at ptr
+*/
+void ACR_ArenaInit(
+    ACR_ArenaObj_t* me,
+    void* ptr,
+    ACR_Length_t length);
+
+/** stop using the arena memory
+*/
+void ACR_ArenaDeInit(
+    ACR_ArenaObj_t* me);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
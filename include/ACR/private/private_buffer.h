@@ -61,10 +61,15 @@
 #endif
 
 /** private buffer type
+
+    m_DataAllocator allocates the memory of the buffer and
+    is ACR_NULL to use ACR_MALLOC(). the buffer object itself
+    comes from the allocator given to ACR_BufferNewWithAllocator()
 */
 struct ACR_BufferObj_s
 {
     ACR_Buffer_t m_Base;
+    const ACR_AllocatorInterface_t* m_DataAllocator;
 };
 
 /** private type to store pointer to the buffer object
@@ -56,7 +56,229 @@
 // included for ACR_Count_t and ACR_ZERO_COUNT
 #include "ACR/public/public_count.h"
 
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+// included for ACR_BYTES_PER_BLOCK
+#include "ACR/public/public_blocks.h"
+
+// included for ACR_Decimal_t
+#include "ACR/public/public_decimal.h"
+
+// included for ACR_TYPEDEF_CALLBACK
+#include "ACR/public/public_functions.h"
+
+// included for ACR_AllocatorInterface_t
+#include "ACR/public/public_allocator.h"
+
+// included for ACR_Time_t
+#include "ACR/public/public_clock.h"
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_FileInterface_t
+#include "ACR/public/public_file.h"
+
+/** all heap allocations are a multiple of this number of
+    bytes and start at an address aligned to this number of bytes
+*/
+#define ACR_HEAP_ALIGNMENT ACR_BYTES_PER_BLOCK
+
+#ifndef ACR_CONFIG_HEAP_MAX_BLOCK_BITS
+/** the largest free block that can be found in constant time
+    is 2 to the power of this value. larger free blocks are still
+    reused but only for allocations up to this size.
+    this can be overridden in your project settings to
+    save memory for each heap on systems with very little memory
+*/
+#define ACR_CONFIG_HEAP_MAX_BLOCK_BITS 32
+#endif
+
+#ifndef ACR_CONFIG_HEAP_REGION_SIZE
+/** the smallest number of bytes requested for each region
+    added to a heap after its memory is used up
+*/
+#define ACR_CONFIG_HEAP_REGION_SIZE (1024*1024)
+#endif
+
+#ifndef ACR_CONFIG_HEAP_LARGE_SIZE
+/** allocations of at least this many bytes get a region
+    of their own when the heap can add regions so that they
+    do not fragment the memory used by smaller allocations
+*/
+#define ACR_CONFIG_HEAP_LARGE_SIZE (ACR_CONFIG_HEAP_REGION_SIZE / 4)
+#endif
+
+#ifndef ACR_CONFIG_HEAP_PAGE_SIZE
+/** regions for large allocations are a multiple of this many bytes
+*/
+#define ACR_CONFIG_HEAP_PAGE_SIZE 4096
+#endif
+
+#ifndef ACR_CONFIG_HEAP_MAX_REGIONS
+/** the most regions shared by small allocations that can be
+    added to a heap. each new region is twice the size of the
+    last so even a small number allows for a very large heap.
+    this can be overridden in your project settings with any
+    value less than ACR_HEAP_LARGE_REGION
+*/
+#define ACR_CONFIG_HEAP_MAX_REGIONS 32
+#endif
+
+/** ACR_HeapHeader_t m_RegionIndex value for the header of
+    a large allocation, which is at the start of the memory
+    of a region of its own
+*/
+#define ACR_HEAP_LARGE_REGION 0xFF
+
+/** the number of second level free lists for each first level
+    free list as a power of 2. each first level list holds blocks
+    from 2^n to 2^(n+1)-1 bytes, which are divided into this many
+    equally sized second level lists
+*/
+#define ACR_HEAP_SECOND_LEVEL_BITS 3
+
+/** the number of second level free lists for each first level free list
+*/
+#define ACR_HEAP_SECOND_LEVEL_COUNT (1 << ACR_HEAP_SECOND_LEVEL_BITS)
+
+/** blocks smaller than 2^ACR_HEAP_FIRST_LEVEL_SHIFT bytes are all
+    stored in the first first level list so that each second level
+    list holds blocks of exactly one size
+*/
+#define ACR_HEAP_FIRST_LEVEL_SHIFT (ACR_HEAP_SECOND_LEVEL_BITS + 3)
+
+/** the number of first level free lists
+*/
+#define ACR_HEAP_FIRST_LEVEL_COUNT (ACR_CONFIG_HEAP_MAX_BLOCK_BITS - ACR_HEAP_FIRST_LEVEL_SHIFT + 1)
+
+/** position value used by free list links when there is
+    no next or previous free block
+*/
+#define ACR_HEAP_NO_POS ACR_MAX_LENGTH
+
+/** get memory for a new heap region
+    \param length the number of bytes needed
+    \returns a pointer to the memory aligned to ACR_HEAP_ALIGNMENT
+             or ACR_NULL if there is no more memory
+*/
+ACR_TYPEDEF_CALLBACK(ACR_HeapCallbackAcquireRegion_t, void*)(
+    ACR_Length_t length);
+
+/** give back the memory of a heap region
+    \param ptr the memory returned by ACR_HeapCallbackAcquireRegion_t
+    \param length the number of bytes passed to ACR_HeapCallbackAcquireRegion_t
+*/
+ACR_TYPEDEF_CALLBACK(ACR_HeapCallbackReleaseRegion_t, void)(
+    void* ptr,
+    ACR_Length_t length);
+
+/** change the size of a heap region, moving it if needed
+    \param ptr the memory returned by ACR_HeapCallbackAcquireRegion_t
+    \param length the current number of bytes of the region
+    \param newLength the number of bytes needed
+    \returns a pointer to the region, which keeps the bytes it had,
+             or ACR_NULL if the region is unchanged
+*/
+ACR_TYPEDEF_CALLBACK(ACR_HeapCallbackResizeRegion_t, void*)(
+    void* ptr,
+    ACR_Length_t length,
+    ACR_Length_t newLength);
+
+/** the number of sizes counted by ACR_HeapStats_t m_SizeCount
+*/
+#define ACR_HEAP_STATS_SIZE_COUNT 32
+
+/** heap statistics
+
+    m_LiveBytes and m_PeakBytes count the bytes of each allocated
+    block, which includes any rounding up to the heap alignment
+    but not the header before each block.
+
+    m_SizeCount[n] is the number of allocations that requested
+    from 2^n to 2^(n+1)-1 bytes. the first also counts requests
+    for 0 bytes and the last also counts every larger request.
+
+    m_AllocMicro and m_FreeMicro are only measured when
+    ACR_CONFIG_HEAP_STATS_TIMING is defined in your project
+    settings, which requires a timer from public_timer.h
+
+    heaps do not keep statistics when ACR_CONFIG_NO_HEAP_STATS
+    is defined in your project settings.
+
+    m_LargestFree and m_Fragmentation are not kept up to date
+    by the heap and are only set when the statistics are read
+
+    Note: when ACR_CONFIG_HEAP_THREADS is defined the blocks kept
+          in the cache of each thread are counted as allocated
+*/
+typedef struct ACR_HeapStats_s
+{
+    ACR_Length_t m_LiveBytes;
+    ACR_Length_t m_PeakBytes;
+    ACR_Count_t m_AllocCount;
+    ACR_Count_t m_FreeCount;
+    ACR_Count_t m_ReallocCount;
+    ACR_Count_t m_FailCount;
+    ACR_Count_t m_SizeCount[ACR_HEAP_STATS_SIZE_COUNT];
+    ACR_Time_t m_AllocMicro;
+    ACR_Time_t m_FreeMicro;
+    ACR_Length_t m_LargestFree;
+    ACR_Decimal_t m_Fragmentation;
+} ACR_HeapStats_t;
+
 /** heap data structure
+
+    freed memory is kept in segregated free lists so that
+    ACR_HeapAlloc() and ACR_HeapFree() take the same amount
+    of time no matter how many headers exist. this is the
+    two level index described by the TLSF allocator:
+    m_FirstLevel has a bit set for each first level list
+    that has a second level list with free blocks and
+    m_SecondLevel has a bit set for each second level list
+    that is not empty.
+
+    m_FreeMax has the size of the largest block in each free
+    list so that the largest free block is read without
+    searching. it is kept when blocks are added and set to 0
+    when the largest block is removed, which only leaves that
+    list to be searched the next time the largest is read.
+
+    freed blocks are merged with the blocks next to them
+    in memory and large free blocks are split when only
+    part of the block is needed. a freed block at the end
+    of the used memory is given back to the unused memory
+    at m_NextFreePos.
+
+    when m_AcquireRegion is set the heap grows by adding
+    regions to the m_NextRegion list. each region is an
+    ACR_HeapObj_t stored at the start of its own memory.
+    a region is released as soon as it is empty. regions
+    for small allocations start at ACR_CONFIG_HEAP_REGION_SIZE
+    bytes and double in size for each one already in use so
+    that only a few regions are ever needed.
+
+    the first ACR_HeapObj_t keeps the regions shared by small
+    allocations in m_Regions. m_RegionIndex of a region is 1
+    more than its index in m_Regions (or 0 for the first
+    ACR_HeapObj_t) and is stored in each of its headers so
+    that the region of a pointer is found without searching.
+    m_AllocRegionIndex is the region that made the last
+    allocation, which is tried first by the next one.
+
+    allocations of at least ACR_CONFIG_HEAP_LARGE_SIZE bytes
+    are given a region of their own, which has m_IsLarge set
+    so that nothing else is allocated in it. these are not
+    in m_Regions and their m_RegionIndex is ACR_HEAP_LARGE_REGION.
+    when m_ResizeRegion is set reallocating them resizes the
+    region instead of copying.
+
+    m_Stats is only updated in the first ACR_HeapObj_t
+    and not in each region
+
+    Note: free lists store positions instead of pointers
+          so that the heap memory can be moved
 */
 typedef struct ACR_HeapObj_s
 {
@@ -65,17 +287,142 @@ typedef struct ACR_HeapObj_s
     ACR_Length_t m_NextFreePos;
     ACR_Count_t m_HeaderCount;
     ACR_Count_t m_FreeCount;
+    ACR_Length_t m_FreeBytes;
+    ACR_Length_t m_LastBytes;
+    struct ACR_HeapObj_s* m_NextRegion;
+    struct ACR_HeapObj_s* m_PrevRegion;
+    ACR_HeapCallbackAcquireRegion_t m_AcquireRegion;
+    ACR_HeapCallbackReleaseRegion_t m_ReleaseRegion;
+    ACR_HeapCallbackResizeRegion_t m_ResizeRegion;
+    ACR_Bool_t m_IsLarge;
+    ACR_Byte_t m_RegionIndex;
+    ACR_Byte_t m_AllocRegionIndex;
+    struct ACR_HeapObj_s* m_Regions[ACR_CONFIG_HEAP_MAX_REGIONS];
+    ACR_Length_t m_FirstLevel;
+    ACR_Flags_t m_SecondLevel[ACR_HEAP_FIRST_LEVEL_COUNT];
+    ACR_Length_t m_FreeList[ACR_HEAP_FIRST_LEVEL_COUNT][ACR_HEAP_SECOND_LEVEL_COUNT];
+    ACR_Length_t m_FreeMax[ACR_HEAP_FIRST_LEVEL_COUNT][ACR_HEAP_SECOND_LEVEL_COUNT];
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    ACR_HeapStats_t m_Stats;
+#endif
 } ACR_HeapObj_t;
 
 /** heap header data structure placed
     in heap memory before each allocation
+
+    m_PrevBytes is a boundary tag that stores m_Bytes of
+    the header just before this one in memory (or 0 for the
+    first header) so that neighbours can be found in both
+    directions without searching
+
+    m_RegionIndex is m_RegionIndex of the region that the
+    header is in. it uses bytes that would otherwise only
+    pad the header
 */
 typedef struct ACR_HeapHeader_s
 {
+    ACR_Length_t m_PrevBytes;
     ACR_Length_t m_Bytes;
     ACR_Flags_t m_Flags;
+    ACR_Byte_t m_RegionIndex;
 } ACR_HeapHeader_t;
 
+#ifdef ACR_CONFIG_HEAP_THREADS
+
+#ifndef ACR_CONFIG_HEAP_THREAD_CACHE_MAX
+/** the largest allocation in bytes that is served from
+    the cache of each thread. larger allocations lock the
+    global heap every time
+*/
+#define ACR_CONFIG_HEAP_THREAD_CACHE_MAX 256
+#endif
+
+#ifndef ACR_CONFIG_HEAP_THREAD_CACHE_BATCH
+/** the number of blocks moved between the cache of
+    a thread and the global heap each time it is locked
+*/
+#define ACR_CONFIG_HEAP_THREAD_CACHE_BATCH 32
+#endif
+
+/** the number of block sizes kept by each thread cache,
+    which are every multiple of ACR_HEAP_ALIGNMENT up to
+    ACR_CONFIG_HEAP_THREAD_CACHE_MAX
+*/
+#define ACR_HEAP_THREAD_CACHE_SIZES (ACR_CONFIG_HEAP_THREAD_CACHE_MAX / ACR_HEAP_ALIGNMENT)
+
+/** cache of small blocks owned by one thread
+
+    m_FreeList has a list of unused blocks for each size
+    that only the owning thread uses so it is not locked.
+    blocks freed by other threads are pushed onto m_RemoteList
+    without a lock and moved to m_FreeList by the owning
+    thread when it runs out of blocks.
+
+    caches are never freed. when a thread ends its unused
+    blocks are given back to the global heap and its cache
+    is added to a list of orphans so that the next new thread
+    owns it. m_Orphan is set while the cache has no thread so
+    that blocks it owns are given back to the global heap
+    when they are freed.
+*/
+typedef struct ACR_HeapThreadCache_s
+{
+    void* m_FreeList[ACR_HEAP_THREAD_CACHE_SIZES];
+    ACR_Count_t m_FreeCount[ACR_HEAP_THREAD_CACHE_SIZES];
+    void* volatile m_RemoteList;
+    volatile ACR_Bool_t m_Orphan;
+    struct ACR_HeapThreadCache_s* m_NextOrphan;
+} ACR_HeapThreadCache_t;
+
+/** data stored just before each pointer returned
+    by the global heap when ACR_CONFIG_HEAP_THREADS is defined
+
+    m_Owner is the cache that the block belongs to or ACR_NULL
+    for blocks that are allocated from the global heap directly.
+    m_Value is the index of the block size in the cache or
+    for blocks without an owner the number of bytes from the
+    start of the heap allocation to the pointer.
+
+    Note: while a block is in a free list m_Owner is used
+          to link to the next block
+*/
+typedef struct ACR_HeapThreadPrefix_s
+{
+    ACR_HeapThreadCache_t* m_Owner;
+    ACR_Length_t m_Value;
+} ACR_HeapThreadPrefix_t;
+
+/** the number of bytes used by each prefix, which is the
+    size of ACR_HeapThreadPrefix_t rounded up to ACR_HEAP_ALIGNMENT
+*/
+#define ACR_HEAP_THREAD_PREFIX_SIZE (((sizeof(ACR_HeapThreadPrefix_t) + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
+#endif // #ifdef ACR_CONFIG_HEAP_THREADS
+
+/** the number of bytes used by each header, which is
+    the size of ACR_HeapHeader_t rounded up to ACR_HEAP_ALIGNMENT
+*/
+#define ACR_HEAP_HEADER_SIZE (((sizeof(ACR_HeapHeader_t) + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
+/** the number of bytes used by the ACR_HeapObj_t at the start
+    of each region, which is the size of ACR_HeapObj_t rounded up
+    to ACR_HEAP_ALIGNMENT so that the memory after it is aligned
+*/
+#define ACR_HEAP_REGION_OBJECT_SIZE (((sizeof(ACR_HeapObj_t) + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
+/** free list links stored in the memory of each freed block
+*/
+typedef struct ACR_HeapFreeLinks_s
+{
+    ACR_Length_t m_NextPos;
+    ACR_Length_t m_PrevPos;
+} ACR_HeapFreeLinks_t;
+
+/** the fewest number of bytes that can follow a header
+    so that the block is able to store its free list links
+*/
+#define ACR_HEAP_MIN_BYTES (((sizeof(ACR_HeapFreeLinks_t) + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT)
+
 /** ACR_HeapHeader_t m_Flags sets this to indicate the header has been set
 */
 #define ACR_HEAP_FLAG_HEADER    ACR_FLAG_ONE
@@ -98,8 +445,31 @@ extern "C" {                                              //
 //
 ////////////////////////////////////////////////////////////
 
+#if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
+
+/** get the statistics of the global heap
+    \param stats stores a copy of the statistics
+    \returns ACR_BOOL_TRUE if stats was set or ACR_BOOL_FALSE
+             when ACR_CONFIG_NO_HEAP_STATS is defined
+*/
+ACR_Bool_t ACR_GlobalHeapGetStats(
+    ACR_HeapStats_t* stats);
+
+/** write the statistics of the global heap to a file as text
+    \param file the file interface, which must be ready to write
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_GlobalHeapWriteStats(
+    ACR_FileInterface_t* file);
+
+#endif // #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
+
 /** prepare a heap
     \param me the heap
+    \param ptr the memory to use for the heap.
+               Note: if ptr is not aligned to ACR_HEAP_ALIGNMENT
+                     the first few bytes will not be used
+    \param length the number of bytes of memory at ptr
 */
 void ACR_HeapInit(
 	ACR_HeapObj_t* me,
@@ -108,6 +478,7 @@ void ACR_HeapInit(
 
 /** deinit a heap
     \param me the heap
+    Note: any regions added to the heap are released
 */
 void ACR_HeapDeInit(
 	ACR_HeapObj_t* me);
@@ -122,6 +493,22 @@ void* ACR_HeapAlloc(
     ACR_HeapObj_t* me,
     ACR_Length_t bytes);
 
+/** allocate this many bytes on the heap with the
+    memory aligned to the specified number of bytes
+    \param me the heap
+    \param bytes the number of bytes to attempt to allocated
+    \param alignment a power of two such as 32 or 64
+    \returns a pointer to the newly allocated memory or ACR_NULL on failure
+
+    Note: the memory is freed by ACR_HeapFree() like any other
+          allocation but ACR_HeapRealloc() may move it to memory
+          that is only aligned to ACR_HEAP_ALIGNMENT
+*/
+void* ACR_HeapAllocAligned(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Length_t alignment);
+
 /** free the specified memory of the heap
     \param me the heap
     \param ptr existing allocated memory pointer
@@ -132,8 +519,13 @@ void ACR_HeapFree(
 
 /** reallocate the specified memory of the heap
     to make the amount allocated larger or smaller.
+    the memory is resized in place when possible by using
+    a free neighbour or the unused memory at the end of the
+    heap, otherwise it is moved. extra bytes left over after
+    making it smaller are freed.
     \param me the heap
-    \param ptr existing allocated memory pointer
+    \param ptr existing allocated memory pointer or ACR_NULL
+           to allocate new memory
     \param bytes new size desired
     \returns either a pointer to the newly allocated memory and ptr is no longer valid
              or on failure ACR_NULL and ptr remains valid but at its original allocation size.    
@@ -151,17 +543,38 @@ void ACR_HeapFreeAll(
     ACR_HeapObj_t* me);
 
 /** get the maximum heap space available to the next ACR_HeapAlloc() call
+    without adding a region
     \param me the heap
-    \returns the number of unused bytes of heap memory
+    \returns the number of unused bytes of heap memory in the region
+             with the most unused bytes
 */
 ACR_Length_t ACR_HeapAvailable(
     ACR_HeapObj_t* me);
 
+/** get the largest block that the next ACR_HeapAlloc() call could use
+    \param me the heap
+    \returns the number of bytes in the largest freed block or
+             the unused heap memory, whichever is larger
+*/
+ACR_Length_t ACR_HeapLargestFree(
+    ACR_HeapObj_t* me);
+
+/** get how fragmented the free memory in the heap is
+    \param me the heap
+    \returns a value from 0.0 when all free memory can be
+             used by a single allocation up to 1.0 when
+             the free memory is split into many small pieces.
+             this is calculated as 1 - (largest free / total free)
+*/
+ACR_Decimal_t ACR_HeapFragmentation(
+    ACR_HeapObj_t* me);
+
 /** get the pointer position within the heap
     \param me the heap
     \param ptr the pointer
     \param pos stores the position value of the pointer as the
-               number of bytes from the start of heap memory
+               number of bytes from the start of the memory of
+               the region that contains the pointer
     \returns ACR_BOOL_TRUE if the pointer is within the heap memory
 */
 ACR_Bool_t ACR_HeapPointerPos(
@@ -169,15 +582,94 @@ ACR_Bool_t ACR_HeapPointerPos(
     const void* ptr,
     ACR_Length_t* pos);
 
+/** get the region of the heap that contains the pointer
+    \param me the heap
+    \param ptr the pointer
+    \param pos optional location to store the position of
+               the pointer within the region
+    \returns the region, which is me for the original heap
+             memory, or ACR_NULL if the pointer is not in the heap
+
+    Note: once the heap has added regions any pointer that is
+          not in the original heap memory must have been
+          returned by the heap because the header before it
+          is read to find its region
+*/
+ACR_HeapObj_t* ACR_HeapPointerRegion(
+    ACR_HeapObj_t* me,
+    const void* ptr,
+    ACR_Length_t* pos);
+
+/** allow the heap to grow by adding regions when it is full
+    \param me the heap
+    \param acquire called to get memory for a new region or ACR_NULL
+           to stop the heap from growing
+    \param release called to give back the memory of an empty region
+           or ACR_NULL if the memory does not need to be given back
+*/
+void ACR_HeapSetRegionCallbacks(
+    ACR_HeapObj_t* me,
+    ACR_HeapCallbackAcquireRegion_t acquire,
+    ACR_HeapCallbackReleaseRegion_t release);
+
+/** allow regions with a single large allocation to be
+    resized when the allocation is reallocated
+    \param me the heap
+    \param resize called to resize a region or ACR_NULL
+           to copy large allocations to a new region instead
+*/
+void ACR_HeapSetResizeRegionCallback(
+    ACR_HeapObj_t* me,
+    ACR_HeapCallbackResizeRegion_t resize);
+
+/** set an allocator interface to allocate from the heap
+    \param me the heap
+    \param allocator the allocator interface
+*/
+void ACR_HeapInitAllocator(
+    ACR_HeapObj_t* me,
+    ACR_AllocatorInterface_t* allocator);
+
+/** get the statistics of the heap
+    \param me the heap
+    \param stats stores a copy of the statistics
+    \returns ACR_BOOL_TRUE if stats was set or ACR_BOOL_FALSE
+             when ACR_CONFIG_NO_HEAP_STATS is defined
+*/
+ACR_Bool_t ACR_HeapGetStats(
+    ACR_HeapObj_t* me,
+    ACR_HeapStats_t* stats);
+
+/** start counting the statistics of the heap from zero
+    \param me the heap
+    Note: m_LiveBytes is not changed and m_PeakBytes
+          is set to m_LiveBytes
+*/
+void ACR_HeapResetStats(
+    ACR_HeapObj_t* me);
+
+/** write the statistics of the heap to a file as text
+    with one "name=value" line per statistic
+    \param me the heap
+    \param file the file interface, which must be ready to write
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_HeapWriteStats(
+    ACR_HeapObj_t* me,
+    ACR_FileInterface_t* file);
+
 /** find the position of an existing header
     with the min number of bytes available
-    that has been freed
+    that has been freed in this region.
+    this searches the free lists so it takes the same amount of
+    time no matter how many headers exist
     \param me the heap
     \param minBytes the minimum number of free bytes to find
                     Note: set to zero to find the first
                           freed memory
     \param pos stores the position of the header as the
                number of bytes from the start of heap memory
+    \returns ACR_BOOL_TRUE if a free header was found
 */
 ACR_Bool_t ACR_HeapFindFree(
     ACR_HeapObj_t* me,
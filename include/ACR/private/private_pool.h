@@ -0,0 +1,117 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file private_pool.h
+
+    private functions for access to the ACR_PoolObj_t type
+
+*/
+#ifndef _ACR_PRIVATE_POOL_H_
+#define _ACR_PRIVATE_POOL_H_
+
+#include "ACR/pool.h"
+
+// included for ACR_HEAP_ALIGNMENT
+#include "ACR/private/private_heap.h"
+
+/** data structure stored at the start of each slab
+    Note: the union keeps the objects after it aligned
+*/
+typedef union ACR_PoolSlabHeader_u
+{
+    union ACR_PoolSlabHeader_u* m_NextSlab;
+    ACR_Block_t m_Align;
+} ACR_PoolSlabHeader_t;
+
+/** data structure stored in each free object
+*/
+typedef struct ACR_PoolFreeObject_s
+{
+    struct ACR_PoolFreeObject_s* m_Next;
+} ACR_PoolFreeObject_t;
+
+/** private pool type
+*/
+struct ACR_PoolObj_s
+{
+    ACR_Length_t m_ObjectBytes;
+    ACR_Count_t m_ObjectsPerSlab;
+    ACR_Count_t m_Count;
+    ACR_PoolFreeObject_t* m_FreeList;
+    ACR_PoolSlabHeader_t* m_Slabs;
+};
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare a pool
+    \param me the pool
+    \param objectBytes the size of each object
+    \param objectsPerSlab the number of objects in each slab
+*/
+void ACR_PoolInit(
+    ACR_PoolObj_t* me,
+    ACR_Length_t objectBytes,
+    ACR_Count_t objectsPerSlab);
+
+/** free every slab in the pool
+*/
+void ACR_PoolDeInit(
+    ACR_PoolObj_t* me);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
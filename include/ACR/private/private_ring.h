@@ -0,0 +1,100 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file private_ring.h
+
+    private functions for access to the ACR_RingObj_t type
+
+*/
+#ifndef _ACR_PRIVATE_RING_H_
+#define _ACR_PRIVATE_RING_H_
+
+#include "ACR/ring.h"
+
+/** private ring type
+
+    m_Buffer is the ring memory. readable bytes start at m_Head
+    and wrap to the start of the memory when they reach the end
+*/
+struct ACR_RingObj_s
+{
+    ACR_Buffer_t m_Buffer;
+    ACR_Length_t m_Head;
+    ACR_Length_t m_Used;
+    ACR_Bool_t m_IsMirrored;
+};
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare a ring to use the specified memory
+    \param me the ring
+    \param ptr pointer to the memory used for the bytes in the ring
+    \param length the number of bytes at ptr
+*/
+void ACR_RingInit(
+    ACR_RingObj_t* me,
+    void* ptr,
+    ACR_Length_t length);
+
+/** stop using the ring memory
+*/
+void ACR_RingDeInit(
+    ACR_RingObj_t* me);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
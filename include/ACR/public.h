@@ -319,6 +319,27 @@
 */
 #include "ACR/public/public_heap.h"
 
+////////////////////////////////////////////////////////////
+//
+// TYPES AND DEFINES - ALLOCATORS
+//
+////////////////////////////////////////////////////////////
+
+/**
+    Include the file "ACR/public/public_allocator.h" to define
+    ACR_AllocatorInterface_t, which is used to store callback
+    functions that allocate and free memory
+
+    ### New to C? ###
+
+    Q: Why use an allocator other than the heap?
+    A: Memory for many objects that are used together can
+       come from one arena or pool and be given back all at
+       once, which is faster than freeing each object and
+       does not compete with the rest of the program.
+*/
+#include "ACR/public/public_allocator.h"
+
 ////////////////////////////////////////////////////////////
 //
 // TYPES AND DEFINES - BYTES AND FLAGS
@@ -598,6 +619,50 @@
 */
 #include "ACR/public/public_varbuffer.h"
 
+////////////////////////////////////////////////////////////
+//
+// TYPES AND DEFINES - MEMORY CURSOR
+//
+////////////////////////////////////////////////////////////
+
+/**
+    Include the file "ACR/public/public_cursor.h" to define
+    ACR_Cursor_t, ACR_CURSOR_FROM_BUFFER(), ACR_CURSOR_HAS(),
+    ACR_CURSOR_READ_BYTE(), ACR_CURSOR_READ_32_BIG(), and more
+
+    ### New to C? ###
+
+    Q: Why not check the position every time a byte is read?
+    A: When many bytes are read in a loop, checking each one
+       can take longer than reading it. A cursor checks that
+       enough bytes remain once and then reads them directly.
+       See the include file ACR/public/public_cursor.h for more details.
+*/
+#include "ACR/public/public_cursor.h"
+
+////////////////////////////////////////////////////////////
+//
+// TYPES AND DEFINES - BUFFER CHAIN
+//
+////////////////////////////////////////////////////////////
+
+/**
+    Include the file "ACR/public/public_bufferchain.h" to define
+    ACR_BufferChain_t, ACR_BUFFER_CHAIN(), ACR_BUFFER_CHAIN_GET_LENGTH(),
+    and ACR_BUFFER_CHAIN_CLEAR()
+
+    ### New to C? ###
+
+    Q: Why not append every part of a message to one buffer?
+    A: Appending copies each part. A message with a header,
+       a large payload, and a trailer can instead be sent as
+       a chain of three references and the payload is never
+       copied. Only code that needs all of the bytes in one
+       place has to copy them, and only when it needs them.
+       See the include file ACR/public/public_bufferchain.h for more details.
+*/
+#include "ACR/public/public_bufferchain.h"
+
 ////////////////////////////////////////////////////////////
 //
 // TYPES AND DEFINES - ALIGNED MEMORY BUFFER
@@ -47,6 +47,7 @@
     This header gaurantees the following will be defined:
     ACR_AlignedBuffer_t      for memory aligned buffer data
     ACR_VAR_BUFFER_IS_VALID  as a macro to check for valid buffer data
+    ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO as a macro to allocate aligned memory
 
 */
 #ifndef _ACR_PUBLIC_ALIGNEDBUFFER_H_
@@ -82,6 +83,41 @@ typedef struct ACR_AlignedBuffer_s
 
 } ACR_AlignedBuffer_t;
 
+#ifndef ACR_CONFIG_CACHE_LINE_LENGTH
+/** the number of bytes in a cache line. memory that is written
+	by different threads should not share a cache line
+*/
+#define ACR_CONFIG_CACHE_LINE_LENGTH 64
+#endif
+
+#ifndef ACR_CONFIG_HUGE_PAGE_LENGTH
+/** the number of bytes in a huge page of the system
+*/
+#define ACR_CONFIG_HUGE_PAGE_LENGTH 2097152
+#endif
+
+/** alignment in bytes that keeps memory from sharing a cache line with other memory
+*/
+#define ACR_ALIGN_TO_CACHE_LINE ACR_CONFIG_CACHE_LINE_LENGTH
+
+/** alignment in bytes that lets memory start a huge page
+*/
+#define ACR_ALIGN_TO_HUGE_PAGE ACR_CONFIG_HUGE_PAGE_LENGTH
+
+/** options for ACR_AlignedBufferAllocatePages()
+*/
+enum ACR_AlignedBufferOptions_e
+{
+	ACR_ALIGNED_BUFFER_OPTIONS_NONE = ACR_FLAG_NONE,
+	/** ask the system to back the memory with transparent huge pages
+	*/
+	ACR_ALIGNED_BUFFER_HUGE_PAGES   = ACR_FLAG_ONE,
+	/** touch every page when it is allocated so that
+		the first access later does not fault
+	*/
+	ACR_ALIGNED_BUFFER_PREFAULT     = ACR_FLAG_TWO
+};
+
 /** define an empty aligned buffer on the stack with the specified name
 */
 #define ACR_ALIGNED_BUFFER(name) ACR_AlignedBuffer_t name = {{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE},{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE}}
@@ -121,6 +157,25 @@ typedef struct ACR_AlignedBuffer_s
 */
 #define ACR_ALIGNED_BUFFER_SET_MEMORY(name, memory, length) ACR_ALIGNED_BUFFER_SET_MEMORY_ALIGNED_TO(name, memory, length, ACR_BITS_PER_BLOCK)
 
+/** allocate memory for the buffer aligned on a boundary of the specified number of bytes
+	using ACR_MALLOC_ALIGNED so that no bytes are lost to alignment
+
+	Note: alignment must be a power of two.
+	      any memory already used by the buffer is freed first.
+	      a buffer with memory mapped by ACR_AlignedBufferAllocatePages()
+	      is left unchanged. see ACR_ALIGNED_BUFFER_FREE
+*/
+#define ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO(name, length, alignment) \
+        if(ACR_HAS_FLAG(name.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED) == ACR_BOOL_FALSE) \
+        { \
+			ACR_ALIGNED_BUFFER_FREE(name); \
+			name.m_AlignedBuffer.m_Pointer = ACR_MALLOC_ALIGNED((length), (alignment)); \
+			if(name.m_AlignedBuffer.m_Pointer != ACR_NULL) \
+			{ \
+				name.m_AlignedBuffer.m_Length = (length); \
+			} \
+        }
+
 /** get the number of bytes of memory available to the aligned buffer
 */
 #define ACR_ALIGNED_BUFFER_GET_LENGTH(name) name.m_AlignedBuffer.m_Length
@@ -130,11 +185,25 @@ typedef struct ACR_AlignedBuffer_s
 #define ACR_ALIGNED_BUFFER_GET_MEMORY(name) name.m_AlignedBuffer.m_Pointer
 
 /** free memory used by the buffer
+	Note: memory from ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO is owned by
+	      m_AlignedBuffer and all other memory by m_UnalignedBuffer
+	Note: memory mapped by ACR_AlignedBufferAllocatePages() has
+	      ACR_BUFFER_IS_MAPPED and can only be unmapped by the functions
+	      in "ACR/alignedbuffer.h" such as ACR_AlignedBufferDeInit().
+	      this macro leaves such a buffer unchanged instead of leaking it
 */
 #define ACR_ALIGNED_BUFFER_FREE(name) \
-        ACR_BUFFER_FREE(name.m_UnalignedBuffer); \
-		name.m_AlignedBuffer.m_Pointer = ACR_NULL; \
-		name.m_AlignedBuffer.m_Length = ACR_ZERO_LENGTH; \
-        ACR_REMOVE_FLAGS(name.m_AlignedBuffer.m_Flags, ACR_BUFFER_IS_REF)
+        if(ACR_HAS_FLAG(name.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED) == ACR_BOOL_FALSE) \
+        { \
+			if((name.m_AlignedBuffer.m_Pointer != ACR_NULL) && \
+			   (ACR_HAS_FLAG(name.m_AlignedBuffer.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE)) \
+			{ \
+				ACR_FREE_ALIGNED(name.m_AlignedBuffer.m_Pointer); \
+			} \
+			ACR_BUFFER_FREE(name.m_UnalignedBuffer); \
+			name.m_AlignedBuffer.m_Pointer = ACR_NULL; \
+			name.m_AlignedBuffer.m_Length = ACR_ZERO_LENGTH; \
+			ACR_REMOVE_FLAGS(name.m_AlignedBuffer.m_Flags, ACR_BUFFER_IS_REF); \
+        }
 
 #endif
@@ -0,0 +1,123 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+
+/** \file public_allocator.h
+ 
+    This header helps define a generic interface to allocators
+    so that objects can get their memory from a heap, arena,
+    pool, or any other allocator chosen when they are created.
+    It is included automatically with public.h
+
+    An ACR_AllocatorInterface_t pointer of ACR_NULL means
+    ACR_MALLOC(), ACR_FREE(), and ACR_REALLOC() are used.
+    
+*/
+#ifndef _ACR_PUBLIC_ALLOCATOR_H_
+#define _ACR_PUBLIC_ALLOCATOR_H_
+
+// included for ACR_TYPEDEF_CALLBACK()
+#include "ACR/public/public_functions.h"
+
+// included for ACR_Length_t and ACR_NULL
+#include "ACR/public/public_memory.h"
+
+// included for ACR_BYTES_PER_BLOCK
+#include "ACR/public/public_blocks.h"
+
+/** callback function type for allocating memory
+    \param bytes the number of bytes to allocate
+    \param userPtr optional user pointer
+    \returns a pointer to the memory or ACR_NULL on failure
+*/
+ACR_TYPEDEF_CALLBACK(ACR_AllocatorCallbackAlloc_t, void*)(
+    ACR_Length_t bytes,
+    void* userPtr);
+
+/** callback function type for freeing memory
+    \param ptr memory returned by the alloc or realloc callback
+    \param userPtr optional user pointer
+*/
+ACR_TYPEDEF_CALLBACK(ACR_AllocatorCallbackFree_t, void)(
+    void* ptr,
+    void* userPtr);
+
+/** callback function type for changing the size of memory
+    \param ptr memory returned by the alloc or realloc callback
+    \param bytes the new number of bytes
+    \param userPtr optional user pointer
+    \returns either a pointer to the memory and ptr is no longer valid
+             or on failure ACR_NULL and ptr remains valid
+*/
+ACR_TYPEDEF_CALLBACK(ACR_AllocatorCallbackRealloc_t, void*)(
+    void* ptr,
+    ACR_Length_t bytes,
+    void* userPtr);
+
+/** type for a complete interface to an allocator
+
+    m_Free may be ACR_NULL when the memory is given back all
+    at once by the allocator, such as when an arena is reset.
+    m_Realloc may be ACR_NULL when memory cannot change size.
+*/
+typedef struct ACR_InterfaceAllocator_s
+{
+    ACR_AllocatorCallbackAlloc_t m_Alloc;
+    ACR_AllocatorCallbackFree_t m_Free;
+    ACR_AllocatorCallbackRealloc_t m_Realloc;
+    void* m_User;
+} ACR_AllocatorInterface_t;
+
+/** define an allocator interface on the stack with the specified name
+*/
+#define ACR_ALLOCATOR_INTERFACE(name) ACR_AllocatorInterface_t name = {ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL}
+
+/** the number of bytes before memory from ACR_AllocatorNew()
+    used to store its allocator. this keeps the alignment
+    of the memory returned by the allocator
+*/
+#define ACR_ALLOCATOR_PREFIX_SIZE (2 * ACR_BYTES_PER_BLOCK)
+
+/** get the number of bytes ACR_AllocatorNew() takes from
+    the allocator for an object of this many bytes, such as
+    the object size of a pool used to create that object
+*/
+#define ACR_ALLOCATOR_NEW_BYTES(bytes) ((bytes) + ACR_ALLOCATOR_PREFIX_SIZE)
+
+#endif
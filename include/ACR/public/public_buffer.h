@@ -102,9 +102,18 @@ enum ACR_BufferFlags_e
 {
 	ACR_BUFFER_FLAGS_NONE = ACR_FLAG_NONE,
 	ACR_BUFFER_IS_REF     = ACR_FLAG_ONE,
-	ACR_BUFFER_READ_ONLY  = ACR_FLAG_TWO
+	ACR_BUFFER_READ_ONLY  = ACR_FLAG_TWO,
+	ACR_BUFFER_CAN_GROW   = ACR_FLAG_THREE,
+	ACR_BUFFER_IS_MAPPED  = ACR_FLAG_FOUR
 };
 
+#ifndef ACR_CONFIG_SMALL_BUFFER_LENGTH
+/** the number of bytes kept inside ACR_SmallVarBuffer_t and ACR_SmallString_t
+    before their data is moved to the heap
+*/
+#define ACR_CONFIG_SMALL_BUFFER_LENGTH 32
+#endif
+
 /** define a buffer on the stack with the specified name
 */
 #define ACR_BUFFER(name) ACR_Buffer_t name = {ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE}
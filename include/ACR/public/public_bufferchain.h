@@ -0,0 +1,108 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file public_bufferchain.h
+ 
+    This header provides a data type and macros to refer to
+    several separate memory buffers in order as if they were
+    one, without copying them together.
+    It is included automatically with public.h
+
+    This header gaurantees the following will be defined:
+    ACR_BufferChain_t        for an ordered list of buffer references
+    ACR_BUFFER_CHAIN         as a macro to define a chain on the stack
+    ACR_BUFFER_CHAIN_CLEAR   as a macro to remove all links
+
+*/
+#ifndef _ACR_PUBLIC_BUFFERCHAIN_H_
+#define _ACR_PUBLIC_BUFFERCHAIN_H_
+
+// included for ACR_Length_t and ACR_ZERO_LENGTH
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Count_t and ACR_ZERO_COUNT
+#include "ACR/public/public_count.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+/** type for an ordered list of references to memory buffers
+	- the links are stored in memory owned by the caller so
+	  a chain never allocates
+	- the memory each link refers to is never copied or freed
+	- include "ACR/bufferchain.h" for easy and safe functions
+*/
+typedef struct ACR_BufferChain_s
+{
+	/** the links in order, each one refers to a separate buffer
+	*/
+	ACR_Buffer_t* m_Links;
+
+	/** the number of links in use
+	*/
+	ACR_Count_t m_Count;
+
+	/** the number of links available in m_Links
+	*/
+	ACR_Count_t m_MaxCount;
+
+	/** the total number of bytes in all links
+	*/
+	ACR_Length_t m_Length;
+
+} ACR_BufferChain_t;
+
+/** define an empty buffer chain on the stack with the specified name
+	that stores up to count links in the array links
+*/
+#define ACR_BUFFER_CHAIN(name, links, count) ACR_BufferChain_t name = {links,ACR_ZERO_COUNT,count,ACR_ZERO_LENGTH}
+
+/** get the total number of bytes in all links of the chain
+*/
+#define ACR_BUFFER_CHAIN_GET_LENGTH(name) name.m_Length
+
+/** get the number of links in the chain
+*/
+#define ACR_BUFFER_CHAIN_GET_COUNT(name) name.m_Count
+
+/** remove all links from the chain without changing the memory they refer to
+*/
+#define ACR_BUFFER_CHAIN_CLEAR(name) name.m_Count = ACR_ZERO_COUNT; name.m_Length = ACR_ZERO_LENGTH
+
+#endif
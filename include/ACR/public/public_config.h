@@ -142,6 +142,67 @@
                                    size for ACR/heap.h when ACR_CONFIG_NO_LIBC
                                    is defined but ACR_CONFIG_NO_MALLOC is not
 
+        ACR_CONFIG_HEAP_MMAP       the global heap in ACR/heap.h gets memory from
+                                   the operating system one region at a time with
+                                   mmap() or VirtualAlloc() instead of using a static
+                                   array of ACR_CONFIG_HEAP_SIZE bytes. regions are
+                                   given back when everything in them is freed.
+                                   on Linux large allocations are resized with mremap().
+                                   Note: this includes <sys/mman.h> or <windows.h>
+                                         even when ACR_CONFIG_NO_LIBC is defined
+
+        ACR_CONFIG_HEAP_REGION_SIZE specified in bytes, this configures the
+                                   smallest region added to a heap that has run
+                                   out of memory. see ACR_HeapSetRegionCallbacks()
+
+        ACR_CONFIG_HEAP_LARGE_SIZE specified in bytes, allocations of at least
+                                   this size get a region of their own that is
+                                   given back as soon as they are freed. the default
+                                   is one quarter of ACR_CONFIG_HEAP_REGION_SIZE
+
+        ACR_CONFIG_HEAP_PAGE_SIZE  specified in bytes, regions of large allocations
+                                   are a multiple of this size. the default is 4096
+
+        ACR_CONFIG_HEAP_THREADS    the global heap in ACR/heap.h can be used by many
+                                   threads at once. each thread keeps a cache of small
+                                   blocks so that most allocations do not need a lock.
+                                   Note: this includes <pthread.h> or <windows.h>
+                                         even when ACR_CONFIG_NO_LIBC is defined
+
+        ACR_CONFIG_NO_HEAP_STATS   heaps from ACR/heap.h do not keep statistics
+                                   such as the number of live and peak bytes.
+                                   see ACR_HeapGetStats()
+
+        ACR_CONFIG_HEAP_STATS_TIMING heap statistics also measure the time spent
+                                   allocating and freeing memory
+
+        ACR_CONFIG_HEAP_TRACE      ACR_MALLOC, ACR_FREE, and ACR_REALLOC record each
+                                   call to a file while a trace is started.
+                                   see ACR_HeapTraceStart() in ACR/heaptrace.h
+
+        ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT the new max length of a growable
+                                   ACR_VarBuffer_t as a percent of the old one.
+                                   the default is 150. see ACR_VarBufferSetGrowable()
+
+        ACR_CONFIG_VAR_BUFFER_HEADROOM specified in bytes, the least headroom
+                                   ACR_VarBufferPrepend() leaves in front of the
+                                   data when it has to move the data. the default is 64
+
+        ACR_CONFIG_SMALL_BUFFER_LENGTH specified in bytes, the inline memory of
+                                   ACR_SmallVarBuffer_t and ACR_SmallString_t,
+                                   including a terminating zero. the default is 32
+
+        ACR_CONFIG_CACHE_LINE_LENGTH specified in bytes, the value of
+                                   ACR_ALIGN_TO_CACHE_LINE. the default is 64
+
+        ACR_CONFIG_HUGE_PAGE_LENGTH specified in bytes, the value of
+                                   ACR_ALIGN_TO_HUGE_PAGE. the default is 2MB
+
+        ACR_CONFIG_ALIGNED_BUFFER_MAP_LENGTH specified in bytes, the least length
+                                   that ACR_AlignedBufferAllocatePages() maps directly
+                                   from the system. page aligned memory is always
+                                   mapped. the default is ACR_CONFIG_HUGE_PAGE_LENGTH
+
 */
 
 /** MAC OS X
@@ -0,0 +1,235 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file public_cursor.h
+ 
+    This header provides a data type and macros to read
+    and write a buffer from start to end.
+    It is included automatically with public.h
+
+    The range of a cursor is checked once when the cursor
+    is set. After that, check ACR_CURSOR_HAS() once for a
+    group of accesses and use the unchecked macros for
+    the bytes and words in that group.
+
+    Example:
+
+        ACR_CURSOR(cursor);
+        ACR_CURSOR_FROM_BUFFER(cursor, buffer);
+        while(ACR_CURSOR_HAS(cursor, 3))
+        {
+            ACR_Byte_t type = ACR_CURSOR_READ_BYTE(cursor);
+            ACR_Unsigned_16bit_t value = ACR_CURSOR_READ_16_BIG(cursor);
+            ...
+        }
+
+*/
+#ifndef _ACR_PUBLIC_CURSOR_H_
+#define _ACR_PUBLIC_CURSOR_H_
+
+// included for ACR_Length_t, ACR_MEMCPY(), and ACR_NULL
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Byte_t
+#include "ACR/public/public_bytes_and_flags.h"
+
+// included for ACR_Unsigned_16bit_t and ACR_Unsigned_32bit_t
+#include "ACR/public/public_byte_order.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+/** type for a position within a range of memory
+*/
+typedef struct ACR_Cursor_s
+{
+    /** the next byte to read or write
+    */
+    ACR_Byte_t* m_Pointer;
+
+    /** one past the last byte in the range
+    */
+    ACR_Byte_t* m_End;
+
+} ACR_Cursor_t;
+
+/** define a cursor on the stack with the specified name and no range
+*/
+#define ACR_CURSOR(name) ACR_Cursor_t name = {ACR_NULL,ACR_NULL}
+
+/** set the range of the cursor to the memory of a buffer
+*/
+#define ACR_CURSOR_FROM_BUFFER(name, buffer) ACR_CURSOR_SET_DATA(name, (buffer).m_Pointer, (buffer).m_Length)
+
+/** set the range of the cursor to the specified memory
+*/
+#define ACR_CURSOR_SET_DATA(name, data, length)\
+        (name).m_Pointer = (ACR_Byte_t*)(data);\
+        if((name).m_Pointer != ACR_NULL)\
+        {\
+            (name).m_End = (name).m_Pointer + (length);\
+        }\
+        else\
+        {\
+            (name).m_End = ACR_NULL;\
+        }
+
+/** get the number of bytes between the cursor and the end of its range
+*/
+#define ACR_CURSOR_REMAINING(name) ((ACR_Length_t)((name).m_End - (name).m_Pointer))
+
+/** determine if the specified number of bytes are in range.
+    this is the only check needed before the unchecked macros below
+*/
+#define ACR_CURSOR_HAS(name, length) (ACR_CURSOR_REMAINING(name) >= (ACR_Length_t)(length))
+
+////////////////////////////////////////////////////////////
+//
+// UNCHECKED ACCESS
+//
+// Note: the caller must check ACR_CURSOR_HAS() for the
+//       total number of bytes before using these macros
+//
+////////////////////////////////////////////////////////////
+
+/** get the byte at offset from the cursor without moving the cursor
+*/
+#define ACR_CURSOR_PEEK_BYTE(name, offset) ((name).m_Pointer[(offset)])
+
+/** get the next byte and move the cursor past it
+*/
+#define ACR_CURSOR_READ_BYTE(name) (*((name).m_Pointer++))
+
+/** set the next byte and move the cursor past it
+*/
+#define ACR_CURSOR_WRITE_BYTE(name, value) (*((name).m_Pointer++) = (ACR_Byte_t)(value))
+
+/** move the cursor forward by the specified number of bytes
+*/
+#define ACR_CURSOR_SKIP(name, length) ((name).m_Pointer += (length))
+
+/** copy bytes from the cursor to dest and move the cursor past them
+*/
+#define ACR_CURSOR_READ_COPY(name, dest, length)\
+        ACR_MEMCPY((dest), (name).m_Pointer, (length));\
+        ACR_CURSOR_SKIP(name, length)
+
+/** copy bytes from src to the cursor and move the cursor past them
+*/
+#define ACR_CURSOR_WRITE_COPY(name, src, length)\
+        ACR_MEMCPY((name).m_Pointer, (src), (length));\
+        ACR_CURSOR_SKIP(name, length)
+
+/** get the 16 bit big endian value at offset from the cursor without moving the cursor
+*/
+#define ACR_CURSOR_PEEK_16_BIG(name, offset)\
+        ((ACR_Unsigned_16bit_t)((((ACR_Unsigned_16bit_t)(name).m_Pointer[(offset)]) << 8) |\
+                                 ((ACR_Unsigned_16bit_t)(name).m_Pointer[(offset) + 1])))
+
+/** get the 16 bit little endian value at offset from the cursor without moving the cursor
+*/
+#define ACR_CURSOR_PEEK_16_LITTLE(name, offset)\
+        ((ACR_Unsigned_16bit_t)(((ACR_Unsigned_16bit_t)(name).m_Pointer[(offset)]) |\
+                                (((ACR_Unsigned_16bit_t)(name).m_Pointer[(offset) + 1]) << 8)))
+
+/** get the 32 bit big endian value at offset from the cursor without moving the cursor
+*/
+#define ACR_CURSOR_PEEK_32_BIG(name, offset)\
+        ((((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset)]) << 24) |\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 1]) << 16) |\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 2]) << 8) |\
+          ((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 3]))
+
+/** get the 32 bit little endian value at offset from the cursor without moving the cursor
+*/
+#define ACR_CURSOR_PEEK_32_LITTLE(name, offset)\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset)]) |\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 1]) << 8) |\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 2]) << 16) |\
+         (((ACR_Unsigned_32bit_t)(name).m_Pointer[(offset) + 3]) << 24))
+
+/** get the next 16 bit big endian value and move the cursor past it
+*/
+#define ACR_CURSOR_READ_16_BIG(name) ((name).m_Pointer += 2, ACR_CURSOR_PEEK_16_BIG(name, -2))
+
+/** get the next 16 bit little endian value and move the cursor past it
+*/
+#define ACR_CURSOR_READ_16_LITTLE(name) ((name).m_Pointer += 2, ACR_CURSOR_PEEK_16_LITTLE(name, -2))
+
+/** get the next 32 bit big endian value and move the cursor past it
+*/
+#define ACR_CURSOR_READ_32_BIG(name) ((name).m_Pointer += 4, ACR_CURSOR_PEEK_32_BIG(name, -4))
+
+/** get the next 32 bit little endian value and move the cursor past it
+*/
+#define ACR_CURSOR_READ_32_LITTLE(name) ((name).m_Pointer += 4, ACR_CURSOR_PEEK_32_LITTLE(name, -4))
+
+/** set the next 16 bits in big endian order and move the cursor past them
+    Note: value is used more than once
+*/
+#define ACR_CURSOR_WRITE_16_BIG(name, value)\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_16bit_t)(value)) >> 8);\
+        ACR_CURSOR_WRITE_BYTE(name, (value))
+
+/** set the next 16 bits in little endian order and move the cursor past them
+    Note: value is used more than once
+*/
+#define ACR_CURSOR_WRITE_16_LITTLE(name, value)\
+        ACR_CURSOR_WRITE_BYTE(name, (value));\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_16bit_t)(value)) >> 8)
+
+/** set the next 32 bits in big endian order and move the cursor past them
+    Note: value is used more than once
+*/
+#define ACR_CURSOR_WRITE_32_BIG(name, value)\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 24);\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 16);\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 8);\
+        ACR_CURSOR_WRITE_BYTE(name, (value))
+
+/** set the next 32 bits in little endian order and move the cursor past them
+    Note: value is used more than once
+*/
+#define ACR_CURSOR_WRITE_32_LITTLE(name, value)\
+        ACR_CURSOR_WRITE_BYTE(name, (value));\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 8);\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 16);\
+        ACR_CURSOR_WRITE_BYTE(name, ((ACR_Unsigned_32bit_t)(value)) >> 24)
+
+#endif
@@ -55,6 +55,12 @@
 // included for ACR_VarBuffer_t
 #include "ACR/public/public_varbuffer.h"
 
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+// included for ACR_BufferChain_t
+#include "ACR/public/public_bufferchain.h"
+
 // included for ACR_Info_t
 #include "ACR/public/public_info.h"
 
@@ -104,6 +110,23 @@ ACR_TYPEDEF_CALLBACK(ACR_FileCallbackWrite_t, ACR_Info_t)(
     ACR_VarBuffer_t* src,
     void* userPtr);
 
+/** callback function type for writing several buffers to a file in order
+    with one call, like writev(), so that the buffers never need to be
+    copied together first
+    \param src the buffers to write. the callback must not change the chain
+    \param written set by the callback to the number of bytes actually
+                   written from all of the buffers together
+                   if the return value is ACR_INFO_OK
+    \param userPtr optional user pointer
+    \returns ACR_INFO_OK if 0 or more bytes are written
+             Note: check written for the exact number of bytes written.
+             ACR_INFO_ERROR if any error occurs.
+*/
+ACR_TYPEDEF_CALLBACK(ACR_FileCallbackWriteChain_t, ACR_Info_t)(
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written,
+    void* userPtr);
+
 /** callback function type for moving the read or write position within a file
     \param moveBy number of bytes to move the position
     \param fromPos starting position ACR_INFO_FIRST, ACR_INFO_CURRENT, or ACR_INFO_LAST
@@ -124,6 +147,25 @@ ACR_TYPEDEF_CALLBACK(ACR_FileCallbackSeek_t, ACR_Info_t)(
 ACR_TYPEDEF_CALLBACK(ACR_FileCallbackPosition_t, ACR_Length_t)(
     void* userPtr);
 
+/** callback function type for borrowing data from a file without copying it
+    \param view set by the callback to read only memory that holds
+                the next bytes of the file
+        view->m_Length is set by the callback to the number of bytes
+                       lent, which is never more than maxLength
+    \param maxLength the max number of bytes to borrow
+    \param userPtr optional user pointer
+    \returns ACR_INFO_OK if 0 or more bytes are lent and the position
+             has moved past them
+             ACR_INFO_ERROR if any error occurs.
+    Note: the memory still belongs to the file. it must not be changed
+          and is only valid until the file is written, closed, or its
+          storage is reallocated
+*/
+ACR_TYPEDEF_CALLBACK(ACR_FileCallbackBorrow_t, ACR_Info_t)(
+    ACR_Buffer_t* view,
+    ACR_Length_t maxLength,
+    void* userPtr);
+
 /** callback function type for opening a file
     \param path path to the file
     \param mode ACR_INFO_READ, ACR_INFO_WRITE, or ACR_INFO_READ_WRITE
@@ -152,11 +194,13 @@ typedef struct ACR_InterfaceFile_s
     ACR_FileCallbackWrite_t m_Write;
     ACR_FileCallbackSeek_t m_Seek;
     ACR_FileCallbackPosition_t m_Position;
+    ACR_FileCallbackBorrow_t m_Borrow; // optional, ACR_NULL when the file cannot lend memory
+    ACR_FileCallbackWriteChain_t m_WriteChain; // optional, ACR_NULL when each buffer is written with m_Write
     void* m_User;
 } ACR_FileInterface_t;
 
 /** define a file interface on the stack with the specified name
 */
-#define ACR_FILE_INTERFACE(name) ACR_FileInterface_t name = {ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL}
+#define ACR_FILE_INTERFACE(name) ACR_FileInterface_t name = {ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL,ACR_NULL}
 
 #endif
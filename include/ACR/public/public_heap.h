@@ -48,11 +48,21 @@
     ACR_MALLOC         as a macro to allocate memory or return ACR_NULL if memory cannot be allocated
     ACR_FREE           as a macro to free previously allocated memory
     ACR_DELETE         as a macro safer version of ACR_FREE
+    ACR_MALLOC_ALIGNED as a macro to allocate memory aligned to a power of two
+                       number of bytes or return ACR_NULL if memory cannot be allocated
+    ACR_FREE_ALIGNED   as a macro to free memory allocated by ACR_MALLOC_ALIGNED
+    ACR_NEW_BY_SIZE_FROM, ACR_NEW_BY_TYPE_FROM, ACR_NEW_BY_COUNT_FROM,
+    and ACR_DELETE_FROM as macros to allocate and free memory
+                       from a specific allocator object instead
+                       of ACR_MALLOC and ACR_FREE
     ACR_HEAP_IS_GLOBAL as either ACR_BOOL_TRUE or ACR_BOOL_FALSE.
                        the only case where this will be set to
                        ACR_BOOL_TRUE is when ACR_CONFIG_NO_LIBC is
                        set but ACR_CONFIG_NO_MALLOC is not set
 
+    When ACR_CONFIG_HEAP_TRACE is defined ACR_MALLOC, ACR_FREE,
+    and ACR_REALLOC are recorded by ACR/heaptrace.h
+
 */
 #ifndef _ACR_PUBLIC_HEAP_H_
 #define _ACR_PUBLIC_HEAP_H_
@@ -63,6 +73,9 @@
 // included for ACR_CLEAR_MEMORY and ACR_NULL
 #include "ACR/public/public_memory.h"
 
+// included for ACR_PLATFORM_WIN
+#include "ACR/public/public_config.h"
+
 #ifndef ACR_CONFIG_NO_MALLOC
     #ifndef ACR_CONFIG_NO_LIBC
         /** defined when malloc is available
@@ -76,6 +89,16 @@
         #define ACR_MALLOC(s) malloc((size_t)s)
         #define ACR_FREE(p) free(p)
         #define ACR_REALLOC(p,s) realloc(p, (size_t)s)
+        #ifdef ACR_PLATFORM_WIN
+            // included for _aligned_malloc and _aligned_free
+            #include <malloc.h>
+            #define ACR_MALLOC_ALIGNED(s,a) _aligned_malloc((size_t)s, (size_t)a)
+            #define ACR_FREE_ALIGNED(p) _aligned_free(p)
+        #else
+            // aligned_alloc requires the size to be a multiple of the alignment
+            #define ACR_MALLOC_ALIGNED(s,a) aligned_alloc((size_t)a, ((((size_t)s + (size_t)a - 1) / (size_t)a) * (size_t)a))
+            #define ACR_FREE_ALIGNED(p) free(p)
+        #endif
     #else
         // Note: src/ACR/heap.c must be added to any project
         //       that wishes to use ACR/heap.h
@@ -87,8 +110,14 @@
     #define ACR_MALLOC(s) ACR_NULL
     #define ACR_FREE(p)
     #define ACR_REALLOC(p,s) ACR_NULL
+    #define ACR_MALLOC_ALIGNED(s,a) ACR_NULL
+    #define ACR_FREE_ALIGNED(p)
 #endif // #ifndef ACR_CONFIG_NO_MALLOC
 
+// included to send ACR_MALLOC(), ACR_FREE(), and ACR_REALLOC()
+// through ACR/heaptrace.h when ACR_CONFIG_HEAP_TRACE is defined
+#include "ACR/public/public_heap_trace.h"
+
 /** similar to malloc but automatically defines the variable and clears the memory
  
     example:
@@ -145,4 +174,42 @@
     }\
 }
 
+/** same as ACR_NEW_BY_SIZE but the memory comes from an allocator object.
+    the allocator is the prefix of its functions so that
+    a##Alloc(o, s) and a##Free(o, p) are called.
+    this works with ACR_Heap (ACR_HeapObj_t), ACR_Arena (ACR_ArenaObj_t),
+    and ACR_Pool (ACR_PoolObj_t)
+
+    example:
+
+        void ParseRow(ACR_ArenaObj_t* arena)
+        {
+            ACR_NEW_BY_SIZE_FROM(text, char, 100, ACR_Arena, arena);
+            // etc
+        }
+*/
+#define ACR_NEW_BY_SIZE_FROM(n, t, s, a, o) t* n = (t*)a##Alloc(o, s);ACR_CLEAR_MEMORY(n,s)
+
+/** same as ACR_NEW_BY_TYPE but the memory comes from an allocator object
+    \see ACR_NEW_BY_SIZE_FROM
+*/
+#define ACR_NEW_BY_TYPE_FROM(n, t, a, o) ACR_NEW_BY_SIZE_FROM(n,t,(sizeof(t)),a,o)
+
+/** same as ACR_NEW_BY_COUNT but the memory comes from an allocator object
+    \see ACR_NEW_BY_SIZE_FROM
+*/
+#define ACR_NEW_BY_COUNT_FROM(n, t, c, a, o) ACR_NEW_BY_SIZE_FROM(n,t,(sizeof(t)*c),a,o)
+
+/** same as ACR_DELETE but the memory is given back to an allocator object
+    \see ACR_NEW_BY_SIZE_FROM
+*/
+#define ACR_DELETE_FROM(n, a, o) \
+{\
+    if(n)\
+    {\
+        a##Free(o, n);\
+        n = ACR_NULL;\
+    }\
+}
+
 #endif
@@ -0,0 +1,103 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file public_heap_trace.h
+
+    This header sends ACR_MALLOC(), ACR_FREE(), and ACR_REALLOC()
+    through the recorder in ACR/heaptrace.h when ACR_CONFIG_HEAP_TRACE
+    is defined. It is included automatically with public_heap.h
+
+    Note: src/ACR/heaptrace.c must be added to any project
+          that defines ACR_CONFIG_HEAP_TRACE
+
+*/
+
+// this header is not finished until the macros
+// it replaces have been defined by public_heap.h
+// or ACR/heap.h so it may be included more than once
+#ifndef _ACR_PUBLIC_HEAP_TRACE_H_
+#if defined(ACR_CONFIG_HEAP_TRACE) && !defined(ACR_HEAP_TRACE_RECORDER)
+#if defined(ACR_HAS_MALLOC) && (ACR_HAS_MALLOC == ACR_BOOL_TRUE)
+#define _ACR_PUBLIC_HEAP_TRACE_H_
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+#undef ACR_MALLOC
+#undef ACR_FREE
+#undef ACR_REALLOC
+#define ACR_MALLOC(s) ACR_HeapTraceAlloc((ACR_Length_t)s)
+#define ACR_FREE(p) ACR_HeapTraceFree(p)
+#define ACR_REALLOC(p,s) ACR_HeapTraceRealloc(p, (ACR_Length_t)s)
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+/** \see ACR_HeapTraceAlloc() in ACR/heaptrace.h
+*/
+void* ACR_HeapTraceAlloc(
+    ACR_Length_t bytes);
+
+/** \see ACR_HeapTraceFree() in ACR/heaptrace.h
+*/
+void ACR_HeapTraceFree(
+    void* ptr);
+
+/** \see ACR_HeapTraceRealloc() in ACR/heaptrace.h
+*/
+void* ACR_HeapTraceRealloc(
+    void* ptr,
+    ACR_Length_t bytes);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif // #if defined(ACR_HAS_MALLOC) && (ACR_HAS_MALLOC == ACR_BOOL_TRUE)
+#endif // #if defined(ACR_CONFIG_HEAP_TRACE) && !defined(ACR_HEAP_TRACE_RECORDER)
+#endif // #ifndef _ACR_PUBLIC_HEAP_TRACE_H_
@@ -145,6 +145,14 @@
     #define ACR_MAX_LENGTH 4294967295UL // hex value 0xFFFFFFFF
 #endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
 
+#ifdef ACR_CONFIG_NO_LIBC
+    // included for ACR_MemorySet(), ACR_MemoryCopy(),
+    // ACR_MemoryMove(), and ACR_MemoryCompare()
+    // Note: src/ACR/memory.c must be added to any project
+    //       that defines ACR_CONFIG_NO_LIBC
+    #include "ACR/memory.h"
+#endif
+
 /*
     ### New to C? ###
 
@@ -165,21 +173,10 @@
 
 #else
 
-    /** ACR_CONFIG_NO_LIBC is defined so this is a 
-        generic (slow) memset but gets the job done
+    /** ACR_CONFIG_NO_LIBC is defined so this uses
+        the kernel selected by ACR/memory.h
     */
-    #define ACR_MEMSET(p,v,s) \
-    {\
-        char* c=(char*)p;\
-        char d=(char)v;\
-        ACR_Length_t l=(ACR_Length_t)s;\
-        while(l>0)\
-        {\
-            (*c)=d;\
-            c++;\
-            l--;\
-        }\
-    }
+    #define ACR_MEMSET(p,v,s) ACR_MemorySet(p,v,(ACR_Length_t)(s))
 
 #endif // #ifndef ACR_CONFIG_NO_LIBC
 
@@ -210,22 +207,45 @@
 
 #else
 
-    /** ACR_CONFIG_NO_LIBC is defined so this is a 
-        generic (slow) memcpy but gets the job done
+    /** ACR_CONFIG_NO_LIBC is defined so this uses
+        the kernel selected by ACR/memory.h
+    */
+    #define ACR_MEMCPY(d,s,l) ACR_MemoryCopy(d,s,(ACR_Length_t)(l));
+
+#endif // #ifndef ACR_CONFIG_NO_LIBC
+
+#ifndef ACR_CONFIG_NO_LIBC
+
+    // included for memmove()
+    #include <string.h>
+    #define ACR_MEMMOVE(d,s,l) memmove(d,s,(size_t)l);
+
+#else
+
+    /** ACR_CONFIG_NO_LIBC is defined so this uses
+        the kernel selected by ACR/memory.h
+    */
+    #define ACR_MEMMOVE(d,s,l) ACR_MemoryMove(d,s,(ACR_Length_t)(l));
+
+#endif // #ifndef ACR_CONFIG_NO_LIBC
+
+/** compare memory
+    \returns 0 if the l bytes at a and b are the same, less than 0
+             if the first different byte of a is less than the byte
+             of b, or greater than 0 if it is greater
+*/
+#ifndef ACR_CONFIG_NO_LIBC
+
+    // included for memcmp()
+    #include <string.h>
+    #define ACR_MEMCMP(a,b,l) memcmp(a,b,(size_t)(l))
+
+#else
+
+    /** ACR_CONFIG_NO_LIBC is defined so this uses
+        the kernel selected by ACR/memory.h
     */
-    #define ACR_MEMCPY(d,s,l) \
-    {\
-        char* c=(char*)d;\
-        char* v=(char*)s;\
-        ACR_Length_t n=(ACR_Length_t)l;\
-        while(n>0)\
-        {\
-            (*c)=(*v);\
-            c++;\
-            v++;\
-            n--;\
-        }\
-    }
+    #define ACR_MEMCMP(a,b,l) ACR_MemoryCompare(a,b,(ACR_Length_t)(l))
 
 #endif // #ifndef ACR_CONFIG_NO_LIBC
 
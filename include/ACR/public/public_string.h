@@ -75,6 +75,24 @@ typedef struct ACR_String_s
 */
 #define ACR_STRING(name) ACR_String_t name = {{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE},ACR_ZERO_COUNT};
 
+/** type for a string that keeps up to ACR_CONFIG_SMALL_BUFFER_LENGTH - 1
+	bytes inside itself and only uses the heap for longer strings
+	- use the ACR_STRING macros on m_String
+	- include "ACR/string.h" for ACR_SmallStringSet()
+
+	IMPORTANT: m_String may point at m_Inline, so the
+	           object must not be copied or moved
+*/
+typedef struct ACR_SmallString_s
+{
+    ACR_String_t m_String;
+    ACR_Byte_t m_Inline[ACR_CONFIG_SMALL_BUFFER_LENGTH];
+} ACR_SmallString_t;
+
+/** define a small string on the stack with the specified name
+*/
+#define ACR_SMALL_STRING(name) ACR_SmallString_t name = {{{name.m_Inline,ACR_ZERO_LENGTH,ACR_BUFFER_IS_REF},ACR_ZERO_COUNT},{0}};
+
 /** assign memory to the string
 */
 #define ACR_STRING_SET_DATA(name, memory, length, count) ACR_BUFFER_SET_DATA(name.m_Buffer, memory, length); name.m_Count = count;
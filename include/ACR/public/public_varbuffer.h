@@ -77,11 +77,40 @@ typedef struct ACR_VarBuffer_s
 {
     ACR_Buffer_t m_Buffer;
     ACR_Length_t m_MaxLength;
+
+    /** number of unused bytes before m_Buffer.m_Pointer that
+        belong to the same memory so that data can be prepended
+        without moving the data that is already in the buffer
+    */
+    ACR_Length_t m_Headroom;
 } ACR_VarBuffer_t;
 
+/** type for a variable length buffer that keeps up to
+	ACR_CONFIG_SMALL_BUFFER_LENGTH - 1 bytes inside itself and
+	only moves its data to the heap when it grows past that
+	- use the ACR_VAR_BUFFER macros and ACR_VarBuffer functions on m_VarBuffer
+	- include "ACR/varbuffer.h" for ACR_SmallVarBufferInit()
+
+	IMPORTANT: m_VarBuffer may point at m_Inline, so the
+	           object must not be copied or moved
+*/
+typedef struct ACR_SmallVarBuffer_s
+{
+    ACR_VarBuffer_t m_VarBuffer;
+    ACR_Byte_t m_Inline[ACR_CONFIG_SMALL_BUFFER_LENGTH];
+} ACR_SmallVarBuffer_t;
+
+/** define a small variable sized buffer on the stack with the specified name
+*/
+#define ACR_SMALL_VAR_BUFFER(name) ACR_SmallVarBuffer_t name = {{{name.m_Inline,ACR_ZERO_LENGTH,(ACR_BUFFER_IS_REF|ACR_BUFFER_CAN_GROW)},(ACR_CONFIG_SMALL_BUFFER_LENGTH-1),ACR_ZERO_LENGTH},{0}}
+
 /** define a variable sized buffer on the stack with the specified name
 */
-#define ACR_VAR_BUFFER(name) ACR_VarBuffer_t name = {{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE},ACR_ZERO_LENGTH}
+#define ACR_VAR_BUFFER(name) ACR_VarBuffer_t name = {{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE},ACR_ZERO_LENGTH,ACR_ZERO_LENGTH}
+
+/** get the start of the memory including headroom
+*/
+#define ACR_VAR_BUFFER_GET_MEMORY(name) ((void*)(((ACR_Byte_t*)name.m_Buffer.m_Pointer) - name.m_Headroom))
 
 /** get the max length of the buffer
 */
@@ -130,10 +159,11 @@ typedef struct ACR_VarBuffer_s
         {\
             if(ACR_HAS_FLAG(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE)\
             {\
-                ACR_FREE(name.m_Buffer.m_Pointer);\
+                ACR_FREE(ACR_VAR_BUFFER_GET_MEMORY(name));\
             }\
         }\
         name.m_Buffer.m_Pointer = (void*)memory;\
+        name.m_Headroom = ACR_ZERO_LENGTH;\
         name.m_Buffer.m_Length = ACR_ZERO_LENGTH;\
         if(name.m_Buffer.m_Pointer != ACR_NULL)\
         {\
@@ -155,12 +185,13 @@ typedef struct ACR_VarBuffer_s
         {\
             if(ACR_HAS_FLAG(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE)\
             {\
-                ACR_FREE(name.m_Buffer.m_Pointer);\
+                ACR_FREE(ACR_VAR_BUFFER_GET_MEMORY(name));\
             }\
             name.m_Buffer.m_Pointer = ACR_NULL;\
         }\
         name.m_Buffer.m_Length = ACR_ZERO_LENGTH;\
         name.m_MaxLength = ACR_ZERO_LENGTH;\
+        name.m_Headroom = ACR_ZERO_LENGTH;\
         ACR_REMOVE_FLAGS(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF)
 
 /** allocate memory for the buffer and change the max length only if needed
@@ -176,10 +207,11 @@ typedef struct ACR_VarBuffer_s
 			{\
 				if(ACR_HAS_FLAG(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE)\
 				{\
-					ACR_FREE(name.m_Buffer.m_Pointer);\
+					ACR_FREE(ACR_VAR_BUFFER_GET_MEMORY(name));\
 				}\
 			}\
 			name.m_Buffer.m_Pointer = (void*)ACR_MALLOC(length+1);\
+			name.m_Headroom = ACR_ZERO_LENGTH;\
 			if(name.m_Buffer.m_Pointer != ACR_NULL)\
 			{\
                 ((ACR_Byte_t*)name.m_Buffer.m_Pointer)[length] = 0;\
@@ -195,7 +227,10 @@ typedef struct ACR_VarBuffer_s
 
 /** allocate memory for the buffer and change the max length
     while maintaining all data that is currently in the buffer
-    \todo make this work for memory references (right now it only works with buffers that allocated memory on the heap)
+
+    Note: memory references, including the memory inside an
+          ACR_SmallVarBuffer_t, cannot be reallocated so their
+          data is copied to new memory instead
 */
 #define ACR_VAR_BUFFER_CHANGE_MAX_LENGTH(name, length)\
         if(name.m_MaxLength != length)\
@@ -203,16 +238,29 @@ typedef struct ACR_VarBuffer_s
             if(length >= name.m_Buffer.m_Length)\
             {\
                 void* tempPtr = name.m_Buffer.m_Pointer;\
-                if(tempPtr != ACR_NULL)\
+                if((tempPtr != ACR_NULL) && ACR_HAS_FLAG(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF))\
+                {\
+                    tempPtr = (void*)ACR_MALLOC(length+1);\
+                    if(tempPtr != ACR_NULL)\
+                    {\
+                        if(name.m_Buffer.m_Length > 0)\
+                        {\
+                            ACR_MEMCPY(tempPtr, name.m_Buffer.m_Pointer, name.m_Buffer.m_Length);\
+                        }\
+                        name.m_Headroom = ACR_ZERO_LENGTH;\
+                    }\
+                }\
+                else\
                 {\
-                    if(ACR_HAS_FLAG(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF))\
+                    if(tempPtr != ACR_NULL)\
                     {\
-                        tempPtr = ACR_NULL;\
+                        tempPtr = ACR_VAR_BUFFER_GET_MEMORY(name);\
                     }\
+                    tempPtr = (void*)ACR_REALLOC(tempPtr, name.m_Headroom+length+1);\
                 }\
-                tempPtr = (void*)ACR_REALLOC(tempPtr, length+1);\
                 if(tempPtr != ACR_NULL)\
                 {\
+                    tempPtr = (void*)(((ACR_Byte_t*)tempPtr) + name.m_Headroom);\
                     ((ACR_Byte_t*)tempPtr)[length] = 0;\
                     name.m_MaxLength = length;\
                     name.m_Buffer.m_Pointer = tempPtr;\
@@ -225,11 +273,11 @@ typedef struct ACR_VarBuffer_s
 
 /** free is not available
 */
-#define ACR_VAR_BUFFER_FREE(name) name.m_Buffer.m_Pointer = ACR_NULL; name.m_Buffer.m_Length = ACR_ZERO_LENGTH; name.m_MaxLength = ACR_ZERO_LENGTH; ACR_REMOVE_FLAGS(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF)
+#define ACR_VAR_BUFFER_FREE(name) name.m_Buffer.m_Pointer = ACR_NULL; name.m_Buffer.m_Length = ACR_ZERO_LENGTH; name.m_MaxLength = ACR_ZERO_LENGTH; name.m_Headroom = ACR_ZERO_LENGTH; ACR_REMOVE_FLAGS(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF)
 
 /** malloc is not available
 */
-#define ACR_VAR_BUFFER_ALLOC(name, length) name.m_Buffer.m_Pointer = ACR_NULL; name.m_Buffer.m_Length = ACR_ZERO_LENGTH; name.m_MaxLength = ACR_ZERO_LENGTH; ACR_REMOVE_FLAGS(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF)
+#define ACR_VAR_BUFFER_ALLOC(name, length) name.m_Buffer.m_Pointer = ACR_NULL; name.m_Buffer.m_Length = ACR_ZERO_LENGTH; name.m_MaxLength = ACR_ZERO_LENGTH; name.m_Headroom = ACR_ZERO_LENGTH; ACR_REMOVE_FLAGS(name.m_Buffer.m_Flags, ACR_BUFFER_IS_REF)
 
 /** realloc is not available
 */
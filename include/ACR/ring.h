@@ -0,0 +1,254 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file ring.h
+
+    public functions for access to the ACR_RingObj_t type
+
+    A ring holds a stream of bytes in a fixed amount of memory.
+    Bytes are written at the tail and read from the head, and
+    both only move an offset so consuming the front of the
+    stream never moves the bytes that remain like
+    ACR_BufferShift() does.
+
+    Readable bytes and free space are each at most two
+    contiguous segments of the ring memory, which can be used
+    directly without copying. A ring from ACR_RingNewMirrored()
+    maps its memory twice, back to back, so that the first
+    segment is always the whole span.
+
+    example:
+
+        ACR_RingObj_t* ring;
+        if(ACR_RingNew(&ring, 4096) == ACR_INFO_OK)
+        {
+            ACR_BUFFER(first);
+            ACR_BUFFER(second);
+            ACR_RingWrite(ring, "hello", 5);
+            ACR_RingPeek(ring, &first, &second);
+            // parse first and then second
+            ACR_RingConsume(ring, first.m_Length + second.m_Length);
+            ACR_RingDelete(&ring);
+        }
+
+*/
+#ifndef _ACR_RING_H_
+#define _ACR_RING_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+// included for ACR_FileInterface_t
+#include "ACR/public/public_file.h"
+
+/** predefined object type
+*/
+typedef struct ACR_RingObj_s ACR_RingObj_t;
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** prepare a ring allocated on the heap
+    \param mePtr location to store the pointer for the new ring
+    \param length the number of bytes the ring can hold
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+
+    Note: the ring and its memory are a single allocation
+*/
+ACR_Info_t ACR_RingNew(
+    ACR_RingObj_t** mePtr,
+    ACR_Length_t length);
+
+/** prepare a ring with memory that is mapped twice, back to back,
+    so that readable bytes and free space are always contiguous
+    \param mePtr location to store the pointer for the new ring
+    \param length the number of bytes the ring can hold, which
+           is rounded up to a multiple of the page size
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if the platform cannot
+             map memory twice. use ACR_RingNew() instead
+*/
+ACR_Info_t ACR_RingNewMirrored(
+    ACR_RingObj_t** mePtr,
+    ACR_Length_t length);
+
+/** free a ring allocated by ACR_RingNew() or ACR_RingNewMirrored()
+    \param mePtr location of the pointer for the ring, which will
+           be set to ACR_NULL after the memory is freed
+*/
+void ACR_RingDelete(
+    ACR_RingObj_t** mePtr);
+
+/** get the number of bytes the ring can hold
+*/
+ACR_Length_t ACR_RingCapacity(
+    ACR_RingObj_t* me);
+
+/** get the number of bytes that can be read
+*/
+ACR_Length_t ACR_RingUsed(
+    ACR_RingObj_t* me);
+
+/** get the number of bytes that can be written
+*/
+ACR_Length_t ACR_RingAvailable(
+    ACR_RingObj_t* me);
+
+/** determine if the memory of the ring is mapped twice
+    \returns ACR_BOOL_TRUE if the first segment from ACR_RingPeek()
+             and ACR_RingReserve() is always the whole span
+*/
+ACR_Bool_t ACR_RingIsMirrored(
+    ACR_RingObj_t* me);
+
+/** forget every byte in the ring
+*/
+void ACR_RingClear(
+    ACR_RingObj_t* me);
+
+/** copy bytes into the ring
+    \param me the ring
+    \param ptr the bytes to copy
+    \param length the number of bytes to copy
+    \returns the number of bytes copied, which is less than
+             length when the ring is full
+*/
+ACR_Length_t ACR_RingWrite(
+    ACR_RingObj_t* me,
+    const void* ptr,
+    ACR_Length_t length);
+
+/** copy bytes out of the ring and consume them
+    \param me the ring
+    \param ptr the memory to copy to
+    \param length the maximum number of bytes to copy
+    \returns the number of bytes copied
+*/
+ACR_Length_t ACR_RingRead(
+    ACR_RingObj_t* me,
+    void* ptr,
+    ACR_Length_t length);
+
+/** reference the readable bytes without copying them
+    \param me the ring
+    \param first set to the bytes at the head of the ring
+    \param second set to the bytes that wrapped to the start of the
+           ring memory. this is always empty for a mirrored ring
+    \returns the number of readable bytes in both segments
+
+    Note: the buffers are set as references to the ring memory
+          and stay valid until the bytes are consumed
+*/
+ACR_Length_t ACR_RingPeek(
+    ACR_RingObj_t* me,
+    ACR_Buffer_t* first,
+    ACR_Buffer_t* second);
+
+/** drop bytes from the head of the ring without copying them
+    \param me the ring
+    \param length the number of bytes to drop
+    \returns the number of bytes dropped
+*/
+ACR_Length_t ACR_RingConsume(
+    ACR_RingObj_t* me,
+    ACR_Length_t length);
+
+/** reference the free space so that bytes can be written
+    directly into the ring
+    \param me the ring
+    \param first set to the free space at the tail of the ring
+    \param second set to the free space that wrapped to the start
+           of the ring memory. this is always empty for a mirrored ring
+    \returns the number of free bytes in both segments
+
+    Note: call ACR_RingProduce() after writing to add the bytes to the ring
+*/
+ACR_Length_t ACR_RingReserve(
+    ACR_RingObj_t* me,
+    ACR_Buffer_t* first,
+    ACR_Buffer_t* second);
+
+/** add bytes written into the space from ACR_RingReserve() to the ring
+    \param me the ring
+    \param length the number of bytes written
+    \returns the number of bytes added
+*/
+ACR_Length_t ACR_RingProduce(
+    ACR_RingObj_t* me,
+    ACR_Length_t length);
+
+/** set a file interface to read from and write to the ring.
+    reads consume bytes, writes add bytes, the position is
+    the number of readable bytes, and seeking from
+    ACR_INFO_CURRENT consumes bytes without reading them
+    \param me the ring
+    \param fileInterface the file interface
+*/
+void ACR_RingInitFileInterface(
+    ACR_RingObj_t* me,
+    ACR_FileInterface_t* fileInterface);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,230 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file sharedbuffer.h
+
+    public functions to share one block of memory between
+    several owners through an ACR_SharedBuffer_t
+
+    The memory is allocated once together with a count of the
+    shared buffers that refer to it. Sharing or slicing a shared
+    buffer only adds to the count, so the same payload can be
+    handed to several consumers or cut into pieces without a
+    copy, and each piece keeps the whole block alive. The block
+    is freed when the last shared buffer that refers to it is
+    released. The count is changed atomically so shared buffers
+    that refer to the same block can be released from different
+    threads.
+
+    Shared memory must not be changed. ACR_SharedBufferMakeWritable()
+    copies the bytes of a shared buffer only when another shared
+    buffer still refers to the same block.
+
+    example:
+
+        ACR_SHARED_BUFFER(payload);
+        ACR_SHARED_BUFFER(body);
+        ACR_SharedBufferCopyFrom(&payload, data, length);
+        ACR_SharedBufferSlice(&payload, headerLength, length - headerLength, &body);
+        ACR_SharedBufferRelease(&payload);
+        // body still refers to the same memory
+        ACR_SharedBufferMakeWritable(&body);
+        // body is the only owner so nothing was copied
+        ACR_SharedBufferRelease(&body);
+
+*/
+#ifndef _ACR_SHAREDBUFFER_H_
+#define _ACR_SHAREDBUFFER_H_
+
+// included for ACR_Info_t
+#include "ACR/public/public_info.h"
+
+// included for ACR_Length_t
+#include "ACR/public/public_memory.h"
+
+// included for ACR_Count_t
+#include "ACR/public/public_count.h"
+
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+// included for ACR_Buffer_t
+#include "ACR/public/public_buffer.h"
+
+/** the memory shared by one or more ACR_SharedBuffer_t
+    and the number of them that refer to it
+*/
+typedef struct ACR_SharedBlock_s ACR_SharedBlock_t;
+
+/** type for a range of bytes in memory that may be shared
+*/
+typedef struct ACR_SharedBuffer_s
+{
+    /** the bytes of this shared buffer. this is always a reference
+        into the memory of m_Block
+    */
+    ACR_Buffer_t m_Buffer;
+
+    /** the memory that m_Buffer refers to or ACR_NULL when empty
+    */
+    ACR_SharedBlock_t* m_Block;
+
+} ACR_SharedBuffer_t;
+
+/** define an empty shared buffer on the stack with the specified name
+*/
+#define ACR_SHARED_BUFFER(name) ACR_SharedBuffer_t name = {{ACR_NULL,ACR_ZERO_LENGTH,ACR_BUFFER_FLAGS_NONE},ACR_NULL}
+
+/** get the number of bytes in the shared buffer
+*/
+#define ACR_SHARED_BUFFER_GET_LENGTH(name) name.m_Buffer.m_Length
+
+/** get the memory pointer to the bytes in the shared buffer
+    Note: the memory must not be changed unless
+          ACR_SharedBufferMakeWritable() succeeded
+*/
+#define ACR_SHARED_BUFFER_GET_MEMORY(name) name.m_Buffer.m_Pointer
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+extern "C" {                                              //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** release any memory and allocate new memory that only
+    this shared buffer refers to
+    \param me the shared buffer
+    \param length the number of bytes to allocate
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if memory
+             could not be allocated
+
+    Note: the new memory is not cleared
+*/
+ACR_Info_t ACR_SharedBufferAllocate(
+    ACR_SharedBuffer_t* me,
+    ACR_Length_t length);
+
+/** release any memory and allocate new memory with a copy of data
+    \param me the shared buffer
+    \param data the bytes to copy
+    \param length the number of bytes to copy
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if memory
+             could not be allocated
+*/
+ACR_Info_t ACR_SharedBufferCopyFrom(
+    ACR_SharedBuffer_t* me,
+    const void* data,
+    ACR_Length_t length);
+
+/** let another shared buffer refer to the same bytes without a copy
+    \param me the shared buffer
+    \param dest released and then set to refer to the same bytes as me
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_SharedBufferShare(
+    ACR_SharedBuffer_t* me,
+    ACR_SharedBuffer_t* dest);
+
+/** let another shared buffer refer to a range of the bytes without a copy.
+    the range keeps all of the memory alive after me is released
+    \param me the shared buffer
+    \param pos the position of the first byte in the range
+    \param length the number of bytes in the range
+    \param dest released and then set to refer to the range
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if the range is not in me
+*/
+ACR_Info_t ACR_SharedBufferSlice(
+    ACR_SharedBuffer_t* me,
+    ACR_Length_t pos,
+    ACR_Length_t length,
+    ACR_SharedBuffer_t* dest);
+
+/** stop referring to the memory and free it if no other
+    shared buffer refers to it
+    \param me the shared buffer, which is empty afterwards
+*/
+void ACR_SharedBufferRelease(
+    ACR_SharedBuffer_t* me);
+
+/** get the number of shared buffers that refer to the same memory
+    \param me the shared buffer
+    \returns the number of shared buffers or 0 if me is empty
+
+    Note: other threads may change the count at any time
+*/
+ACR_Count_t ACR_SharedBufferGetShareCount(
+    ACR_SharedBuffer_t* me);
+
+/** determine if the bytes can be changed without copying them first
+    \param me the shared buffer
+    \returns ACR_BOOL_TRUE if no other shared buffer refers to the memory
+*/
+ACR_Bool_t ACR_SharedBufferIsUnique(
+    ACR_SharedBuffer_t* me);
+
+/** make sure the bytes can be changed by copying them to new memory
+    that only me refers to when any other shared buffer refers to
+    the same memory
+    \param me the shared buffer
+    \returns ACR_INFO_OK or ACR_INFO_ERROR if memory
+             could not be allocated for the copy
+
+    Note: the copy only holds the bytes of me, not the rest of
+          the memory, and m_Buffer.m_Pointer changes when copied
+*/
+ACR_Info_t ACR_SharedBufferMakeWritable(
+    ACR_SharedBuffer_t* me);
+
+////////////////////////////////////////////////////////////
+// ALLOW FUNCTIONS TO BE CALLED FROM C++                  //
+////////////////////////////////////////////////////////////
+#ifdef __cplusplus                                        //
+}                                                         //
+#endif                                                    //
+////////////////////////////////////////////////////////////
+
+#endif
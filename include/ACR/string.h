@@ -70,6 +70,18 @@ extern "C" {                                              //
 ACR_Info_t ACR_StringNew(
 	ACR_String_t** mePtr);
 
+/** prepare a string allocated from an allocator
+	\param mePtr location to store the pointer for the new string
+	\param allocator the allocator for the string object or ACR_NULL
+	       to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: the allocator must stay valid until ACR_StringDelete()
+*/
+ACR_Info_t ACR_StringNewWithAllocator(
+	ACR_String_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free a string allocated on the heap
     Note: this automatically calls ACR_StringDeInit() on
 	      the string before freeing its memory
@@ -89,6 +101,32 @@ void ACR_StringInit(
 void ACR_StringDeInit(
 	ACR_String_t* me);
 
+/** prepare a small string to use its inline memory
+	\param me the small string
+*/
+void ACR_SmallStringInit(
+	ACR_SmallString_t* me);
+
+/** free any heap memory used by a small string
+	and return to the empty inline memory
+	\param me the small string
+*/
+void ACR_SmallStringDeInit(
+	ACR_SmallString_t* me);
+
+/** copy UTF8 data into a small string. data shorter than
+	ACR_CONFIG_SMALL_BUFFER_LENGTH is kept in the inline memory
+	and longer data is copied to the heap
+	\param me the small string
+	\param data the UTF8 bytes to copy
+	\param length the number of bytes at data
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t ACR_SmallStringSet(
+	ACR_SmallString_t* me,
+	const void* data,
+	ACR_Length_t length);
+
 
 
 ////////////////////////////////////////////////////////////
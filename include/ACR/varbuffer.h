@@ -76,6 +76,18 @@ extern "C" {                                              //
 ACR_Info_t ACR_VarBufferNew(
 	ACR_VarBuffer_t** mePtr);
 
+/** prepare a buffer allocated from an allocator
+	\param mePtr location to store the pointer for the new buffer
+	\param allocator the allocator for the buffer object or ACR_NULL
+	       to use ACR_MALLOC()
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: the allocator must stay valid until ACR_VarBufferDelete()
+*/
+ACR_Info_t ACR_VarBufferNewWithAllocator(
+	ACR_VarBuffer_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator);
+
 /** free a variable length buffer allocated on the heap
 	\param mePtr location of the pointer for the buffer, which will
 	       be set to ACR_NULL after the memory is freed
@@ -148,12 +160,54 @@ ACR_Info_t ACR_VarBufferSetLength(
 	ACR_VarBuffer_t* me,
 	ACR_Length_t length);
 
+/** increase the max length if needed while keeping
+	all data that is currently in the buffer
+	\param me the buffer
+	\param length the smallest max length needed
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: memory with ACR_BUFFER_IS_REF is never reallocated or freed.
+	      its data is copied to newly allocated memory instead
+*/
+ACR_Info_t ACR_VarBufferReserve(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length);
+
+/** allow ACR_VarBufferAppend() and ACR_VarBufferPrepend() to
+	increase the max length when the data does not fit.
+	the max length grows by ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT
+	so that many small appends only reallocate a few times
+	\param me the buffer
+	\param canGrow ACR_BOOL_TRUE to grow or ACR_BOOL_FALSE to
+	       fail when the data does not fit, which is the default
+*/
+void ACR_VarBufferSetGrowable(
+	ACR_VarBuffer_t* me,
+	ACR_Bool_t canGrow);
+
+/** make sure at least length bytes can be prepended without
+	moving the data. call this before building a message that
+	will have headers prepended
+	\param me the buffer
+	\param length the number of bytes to keep in front of the data
+	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: the data is moved at most once and the memory may
+	      grow if ACR_VarBufferSetGrowable() was called
+*/
+ACR_Info_t ACR_VarBufferReserveHeadroom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length);
+
 /** copy data to the end of the buffer
 	\param me
 	\param srcPtr a pointer to the memory location to copy from or
 				  ACR_NULL to add to the buffer length without copying data
 	\param length the number of bytes to copy from srcPtr
 	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: see ACR_VarBufferSetGrowable() to grow instead of failing
+	      when length is more than the remaining max length
 */
 ACR_Info_t ACR_VarBufferAppend(
 	ACR_VarBuffer_t* me,
@@ -166,12 +220,28 @@ ACR_Info_t ACR_VarBufferAppend(
 				  ACR_NULL to add to the buffer length without copying data
 	\param length the number of bytes to copy from srcPtr
 	\returns ACR_INFO_OK or ACR_INFO_ERROR
+
+	Note: when there is enough headroom only the new bytes are copied.
+	      otherwise the data is moved once to leave at least
+	      ACR_CONFIG_VAR_BUFFER_HEADROOM bytes of headroom after the
+	      new bytes, or half the data length if that is larger
 */
 ACR_Info_t ACR_VarBufferPrepend(
 	ACR_VarBuffer_t* me,
 	void* srcPtr,
 	ACR_Length_t length);
 
+/** prepare a small variable length buffer to use its inline memory
+	and grow into the heap when data does not fit
+	\param me the small buffer
+
+	Note: ACR_VarBufferDeInit(&me->m_VarBuffer) frees any heap
+	      memory and this can then be called to use the inline
+	      memory again
+*/
+void ACR_SmallVarBufferInit(
+	ACR_SmallVarBuffer_t* me);
+
 /** clear the current length of this variable length buffer by filling
     with ACR_EMPTY_VALUE
 */
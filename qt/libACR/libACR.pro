@@ -20,34 +20,58 @@ DEFINES += ACR_PLATFORM_LINUX ACR_IDE_QTCREATOR ACR_COMPILER_GCC
 
 SOURCES += \
     ../../src/ACR/alignedbuffer.c \
+    ../../src/ACR/allocator.c \
+    ../../src/ACR/arena.c \
+    ../../src/ACR/binary.c \
     ../../src/ACR/buffer.c \
+    ../../src/ACR/bufferchain.c \
     ../../src/ACR/common.c \
     ../../src/ACR/file.c \
     ../../src/ACR/heap.c \
+    ../../src/ACR/heapfile.c \
+    ../../src/ACR/heaptrace.c \
+    ../../src/ACR/memory.c \
+    ../../src/ACR/pool.c \
+    ../../src/ACR/ring.c \
+    ../../src/ACR/sharedbuffer.c \
     ../../src/ACR/string.c \
     ../../src/ACR/varbuffer.c
 
 HEADERS += \
     ../../include/ACR/alignedbuffer.h \
+    ../../include/ACR/allocator.h \
+    ../../include/ACR/arena.h \
+    ../../include/ACR/binary.h \
     ../../include/ACR/buffer.h \
+    ../../include/ACR/bufferchain.h \
     ../../include/ACR/common.h \
     ../../include/ACR/csv.h \
     ../../include/ACR/file.h \
     ../../include/ACR/filesystem.h \
     ../../include/ACR/heap.h \
+    ../../include/ACR/heapfile.h \
+    ../../include/ACR/heaptrace.h \
     ../../include/ACR/json.h \
+    ../../include/ACR/memory.h \
+    ../../include/ACR/pool.h \
+    ../../include/ACR/private/private_arena.h \
     ../../include/ACR/private/private_buffer.h \
     ../../include/ACR/private/private_heap.h \
+    ../../include/ACR/private/private_pool.h \
+    ../../include/ACR/private/private_ring.h \
     ../../include/ACR/public.h \
     ../../include/ACR/public/public_alignedbuffer.h \
+    ../../include/ACR/public/public_allocator.h \
     ../../include/ACR/public/public_blocks.h \
     ../../include/ACR/public/public_bool.h \
     ../../include/ACR/public/public_buffer.h \
+    ../../include/ACR/public/public_bufferchain.h \
     ../../include/ACR/public/public_byte_order.h \
     ../../include/ACR/public/public_bytes_and_flags.h \
     ../../include/ACR/public/public_clock.h \
     ../../include/ACR/public/public_config.h \
     ../../include/ACR/public/public_count.h \
+    ../../include/ACR/public/public_cursor.h \
     ../../include/ACR/public/public_dates_and_times.h \
     ../../include/ACR/public/public_debug.h \
     ../../include/ACR/public/public_decimal.h \
@@ -55,6 +79,7 @@ HEADERS += \
     ../../include/ACR/public/public_filesystem.h \
     ../../include/ACR/public/public_functions.h \
     ../../include/ACR/public/public_heap.h \
+    ../../include/ACR/public/public_heap_trace.h \
     ../../include/ACR/public/public_info.h \
     ../../include/ACR/public/public_math.h \
     ../../include/ACR/public/public_memory.h \
@@ -63,6 +88,8 @@ HEADERS += \
     ../../include/ACR/public/public_unique_strings.h \
     ../../include/ACR/public/public_units.h \
     ../../include/ACR/public/public_varbuffer.h \
+    ../../include/ACR/ring.h \
+    ../../include/ACR/sharedbuffer.h \
     ../../include/ACR/string.h \
     ../../include/ACR/varbuffer.h
 
@@ -44,6 +44,99 @@
 */
 #include "ACR/alignedbuffer.h"
 
+// included for ACR_AllocatorNew() and ACR_AllocatorDelete()
+#include "ACR/allocator.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_PLATFORM_WIN
+#include "ACR/public/public_config.h"
+
+#ifndef ACR_CONFIG_NO_LIBC
+	#ifdef ACR_PLATFORM_WIN
+		// included for VirtualAlloc, VirtualFree, and GetSystemInfo
+		#include <windows.h>
+		#define ACR_ALIGNED_BUFFER_CAN_MAP
+	#elif defined(__linux__) || defined(__APPLE__)
+		// included for mmap, munmap, and madvise
+		#include <sys/mman.h>
+		// included for sysconf
+		#include <unistd.h>
+		#ifndef MAP_ANONYMOUS
+			#define MAP_ANONYMOUS MAP_ANON
+		#endif
+		#define ACR_ALIGNED_BUFFER_CAN_MAP
+	#endif
+#endif
+
+#ifndef ACR_CONFIG_PAGE_LENGTH
+/** the number of bytes in a page when the
+	system cannot be asked for its page length
+*/
+#define ACR_CONFIG_PAGE_LENGTH 4096
+#endif
+
+#ifndef ACR_CONFIG_ALIGNED_BUFFER_MAP_LENGTH
+/** the least number of bytes that ACR_AlignedBufferAllocatePages()
+	maps directly from the system instead of the heap
+*/
+#define ACR_CONFIG_ALIGNED_BUFFER_MAP_LENGTH ACR_CONFIG_HUGE_PAGE_LENGTH
+#endif
+
+#ifndef ACR_CONFIG_ALIGNED_BUFFER_MAP_TRIES
+/** the number of times to try mapping aligned memory when
+	another thread takes the address space between reserving
+	it and mapping it
+*/
+#define ACR_CONFIG_ALIGNED_BUFFER_MAP_TRIES 4
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** free the memory of the buffer whether it came from
+	the heap or was mapped from the system
+*/
+void _ACR_AlignedBufferFree(
+	ACR_AlignedBuffer_t* me);
+
+/** write to the first byte of every page so that the
+	system backs all of the memory now
+*/
+void _ACR_AlignedBufferPrefault(
+	void* ptr,
+	ACR_Length_t length,
+	ACR_Length_t pageLength);
+
+#ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+
+/** map whole pages from the system that start at alignment
+	\param length the number of bytes needed
+	\param alignment a power of two number of bytes
+	\param pageLength the number of bytes in a page
+	\param hugePages ACR_BOOL_TRUE to advise transparent huge pages
+	\param mapping set to the mapped memory, which is at least length bytes
+	\returns the aligned memory or ACR_NULL if it could not be mapped
+*/
+void* _ACR_AlignedBufferMap(
+	ACR_Length_t length,
+	ACR_Length_t alignment,
+	ACR_Length_t pageLength,
+	ACR_Bool_t hugePages,
+	ACR_Buffer_t* mapping);
+
+/** return memory from _ACR_AlignedBufferMap() to the system
+*/
+void _ACR_AlignedBufferUnmap(
+	void* ptr,
+	ACR_Length_t length);
+
+#endif // #ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+
 ////////////////////////////////////////////////////////////
 //
 // PUBLIC FUNCTIONS
@@ -53,19 +146,25 @@
 /**********************************************************/
 ACR_Info_t ACR_AlignedBufferNew(
 	ACR_AlignedBuffer_t** mePtr)
+{
+	return ACR_AlignedBufferNewWithAllocator(mePtr, ACR_NULL);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_AlignedBufferNewWithAllocator(
+	ACR_AlignedBuffer_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator)
 {
 	ACR_Info_t result = ACR_INFO_ERROR;
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
-		ACR_BUFFER_ALLOC(buffer, sizeof(ACR_AlignedBuffer_t));
-		if(ACR_BUFFER_IS_VALID(buffer))
+		ACR_AlignedBuffer_t* newObj = (ACR_AlignedBuffer_t*)ACR_AllocatorNew(allocator, sizeof(ACR_AlignedBuffer_t));
+		if(newObj != ACR_NULL)
 		{
-			ACR_AlignedBufferInit((ACR_AlignedBuffer_t*)buffer.m_Pointer);
+			ACR_AlignedBufferInit(newObj);
 			result = ACR_INFO_OK;
 		}
-		(*mePtr) = (ACR_AlignedBuffer_t*)buffer.m_Pointer;
+		(*mePtr) = newObj;
 	}
 	return result;
 }
@@ -76,11 +175,8 @@ void ACR_AlignedBufferDelete(
 {
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
 		ACR_AlignedBufferDeInit((*mePtr));
-		ACR_BUFFER_SET_DATA(buffer, (*mePtr), sizeof(ACR_AlignedBuffer_t));
-		ACR_BUFFER_FORCE_FREE(buffer);
+		ACR_AllocatorDelete((*mePtr));
 		(*mePtr) = ACR_NULL;
 	}
 }
@@ -111,7 +207,119 @@ void ACR_AlignedBufferDeInit(
 		return;
 	}
 
-	ACR_ALIGNED_BUFFER_FREE((*me));
+	_ACR_AlignedBufferFree(me);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_AlignedBufferAllocate(
+	ACR_AlignedBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t alignment)
+{
+	if(me == ACR_NULL)
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	if((length == ACR_ZERO_LENGTH) ||
+	   (alignment == ACR_ZERO_LENGTH) ||
+	   ((alignment & (alignment - 1)) != 0))
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	_ACR_AlignedBufferFree(me);
+	ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO((*me), length, alignment);
+	if(ACR_ALIGNED_BUFFER_IS_VALID((*me)))
+	{
+		return ACR_INFO_OK;
+	}
+
+	return ACR_INFO_ERROR;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_AlignedBufferAllocatePages(
+	ACR_AlignedBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t alignment,
+	ACR_Flags_t options)
+{
+	if(me == ACR_NULL)
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	if((length == ACR_ZERO_LENGTH) ||
+	   (alignment == ACR_ZERO_LENGTH) ||
+	   ((alignment & (alignment - 1)) != 0))
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	_ACR_AlignedBufferFree(me);
+	ACR_Length_t pageLength = ACR_AlignedBufferGetPageLength();
+
+#ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+	if((alignment >= pageLength) ||
+	   (length >= ACR_CONFIG_ALIGNED_BUFFER_MAP_LENGTH) ||
+	   (ACR_HAS_FLAG(options, ACR_ALIGNED_BUFFER_HUGE_PAGES)))
+	{
+		// whole pages from the system waste nothing
+		// to alignment and can be released to the
+		// system as soon as they are freed
+		void* ptr = _ACR_AlignedBufferMap(length, alignment, pageLength, ACR_HAS_FLAG(options, ACR_ALIGNED_BUFFER_HUGE_PAGES), &me->m_UnalignedBuffer);
+		if(ptr != ACR_NULL)
+		{
+			me->m_AlignedBuffer.m_Pointer = ptr;
+			me->m_AlignedBuffer.m_Length = length;
+			me->m_AlignedBuffer.m_Flags = ACR_BUFFER_IS_REF;
+		}
+		else
+		{
+			// try the heap instead
+		}
+	}
+	else
+	{
+		// small memory comes from the heap
+	}
+#endif
+
+	if(ACR_ALIGNED_BUFFER_IS_VALID((*me)) == ACR_BOOL_FALSE)
+	{
+		ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO((*me), length, alignment);
+		if(ACR_ALIGNED_BUFFER_IS_VALID((*me)) == ACR_BOOL_FALSE)
+		{
+			return ACR_INFO_ERROR;
+		}
+	}
+
+	if(ACR_HAS_FLAG(options, ACR_ALIGNED_BUFFER_PREFAULT))
+	{
+		_ACR_AlignedBufferPrefault(me->m_AlignedBuffer.m_Pointer, length, pageLength);
+	}
+
+	return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_AlignedBufferGetPageLength(void)
+{
+#ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+#ifdef ACR_PLATFORM_WIN
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (ACR_Length_t)info.dwPageSize;
+#else
+	long pageLength = sysconf(_SC_PAGESIZE);
+	if(pageLength > 0)
+	{
+		return (ACR_Length_t)pageLength;
+	}
+#endif
+#endif
+	return ACR_CONFIG_PAGE_LENGTH;
 }
 
 /**********************************************************/
@@ -125,6 +333,7 @@ ACR_Info_t ACR_AlignedBufferSetMemory(
 		return ACR_INFO_ERROR;
 	}
 
+	_ACR_AlignedBufferFree(me);
 	ACR_ALIGNED_BUFFER_SET_MEMORY((*me), ptr, length);
 	if(ACR_ALIGNED_BUFFER_IS_VALID((*me)))
 	{
@@ -157,3 +366,143 @@ ACR_Info_t ACR_AlignedBufferGetRef(
 
 	return ACR_INFO_ERROR;
 }
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void _ACR_AlignedBufferFree(
+	ACR_AlignedBuffer_t* me)
+{
+#ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+	if(ACR_HAS_FLAG(me->m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED))
+	{
+		_ACR_AlignedBufferUnmap(me->m_UnalignedBuffer.m_Pointer, me->m_UnalignedBuffer.m_Length);
+		ACR_AlignedBufferInit(me);
+		return;
+	}
+#endif
+
+	ACR_ALIGNED_BUFFER_FREE((*me));
+}
+
+/**********************************************************/
+void _ACR_AlignedBufferPrefault(
+	void* ptr,
+	ACR_Length_t length,
+	ACR_Length_t pageLength)
+{
+	// volatile so that the writes are not removed
+	volatile ACR_Byte_t* bytes = (volatile ACR_Byte_t*)ptr;
+	ACR_Length_t pos;
+	for(pos = 0; pos < length; pos += pageLength)
+	{
+		bytes[pos] = 0;
+	}
+}
+
+#ifdef ACR_ALIGNED_BUFFER_CAN_MAP
+
+/**********************************************************/
+void* _ACR_AlignedBufferMap(
+	ACR_Length_t length,
+	ACR_Length_t alignment,
+	ACR_Length_t pageLength,
+	ACR_Bool_t hugePages,
+	ACR_Buffer_t* mapping)
+{
+	ACR_Length_t mapLength = ((length + pageLength - 1) / pageLength) * pageLength;
+	if(alignment < pageLength)
+	{
+		// pages are always aligned to the page length
+		alignment = pageLength;
+	}
+	else
+	{
+		// reserve enough extra pages to find the alignment
+	}
+	ACR_Length_t reserveLength = mapLength + alignment - pageLength;
+	if((mapLength < length) ||
+	   (reserveLength < mapLength))
+	{
+		// too large
+		return ACR_NULL;
+	}
+
+	ACR_Byte_t* aligned = ACR_NULL;
+#ifdef ACR_PLATFORM_WIN
+	ACR_UNUSED(hugePages);
+	int tries;
+	for(tries = 0; (tries < ACR_CONFIG_ALIGNED_BUFFER_MAP_TRIES) && (aligned == ACR_NULL); tries++)
+	{
+		// find an address that can hold the aligned
+		// memory and then map exactly that range
+		ACR_Byte_t* base = (ACR_Byte_t*)VirtualAlloc(ACR_NULL, (SIZE_T)reserveLength, MEM_RESERVE, PAGE_NOACCESS);
+		if(base == ACR_NULL)
+		{
+			return ACR_NULL;
+		}
+		ACR_Byte_t* address = (ACR_Byte_t*)((((ACR_PointerValue_t)base) + (alignment - 1)) & (~((ACR_PointerValue_t)(alignment - 1))));
+		VirtualFree(base, 0, MEM_RELEASE);
+		aligned = (ACR_Byte_t*)VirtualAlloc(address, (SIZE_T)mapLength, (MEM_RESERVE | MEM_COMMIT), PAGE_READWRITE);
+	}
+	if(aligned == ACR_NULL)
+	{
+		return ACR_NULL;
+	}
+#else
+	ACR_Byte_t* base = (ACR_Byte_t*)mmap(ACR_NULL, (size_t)reserveLength, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+	if(base == (ACR_Byte_t*)MAP_FAILED)
+	{
+		return ACR_NULL;
+	}
+
+	// return the extra pages before and after
+	// the aligned memory to the system
+	aligned = (ACR_Byte_t*)((((ACR_PointerValue_t)base) + (alignment - 1)) & (~((ACR_PointerValue_t)(alignment - 1))));
+	ACR_Length_t headLength = (ACR_Length_t)(aligned - base);
+	ACR_Length_t tailLength = reserveLength - headLength - mapLength;
+	if(headLength > 0)
+	{
+		munmap(base, (size_t)headLength);
+	}
+	if(tailLength > 0)
+	{
+		munmap(&aligned[mapLength], (size_t)tailLength);
+	}
+
+#ifdef MADV_HUGEPAGE
+	if(hugePages)
+	{
+		// only advice so failure is not an error
+		madvise(aligned, (size_t)mapLength, MADV_HUGEPAGE);
+	}
+#else
+	ACR_UNUSED(hugePages);
+#endif
+#endif
+
+	mapping->m_Pointer = aligned;
+	mapping->m_Length = mapLength;
+	mapping->m_Flags = (ACR_BUFFER_IS_REF | ACR_BUFFER_IS_MAPPED);
+
+	return aligned;
+}
+
+/**********************************************************/
+void _ACR_AlignedBufferUnmap(
+	void* ptr,
+	ACR_Length_t length)
+{
+#ifdef ACR_PLATFORM_WIN
+	ACR_UNUSED(length);
+	VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+	munmap(ptr, (size_t)length);
+#endif
+}
+
+#endif // #ifdef ACR_ALIGNED_BUFFER_CAN_MAP
@@ -0,0 +1,169 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file allocator.c
+
+    public functions to allocate memory through an ACR_AllocatorInterface_t
+
+*/
+#include "ACR/allocator.h"
+
+// included for ACR_MALLOC, ACR_FREE, and ACR_REALLOC
+#include "ACR/public/public_heap.h"
+
+// included for ACR_Byte_t
+#include "ACR/public/public_bytes_and_flags.h"
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void* ACR_AllocatorAlloc(
+    const ACR_AllocatorInterface_t* me,
+    ACR_Length_t bytes)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_MALLOC(bytes);
+    }
+    else if(me->m_Alloc != ACR_NULL)
+    {
+        return me->m_Alloc(bytes, me->m_User);
+    }
+    else
+    {
+        // the allocator cannot allocate
+    }
+    return ACR_NULL;
+}
+
+/**********************************************************/
+void ACR_AllocatorFree(
+    const ACR_AllocatorInterface_t* me,
+    void* ptr)
+{
+    if(ptr == ACR_NULL)
+    {
+        // nothing to free
+    }
+    else if(me == ACR_NULL)
+    {
+        ACR_FREE(ptr);
+    }
+    else if(me->m_Free != ACR_NULL)
+    {
+        me->m_Free(ptr, me->m_User);
+    }
+    else
+    {
+        // the allocator gives back all of its memory at once
+    }
+}
+
+/**********************************************************/
+void* ACR_AllocatorRealloc(
+    const ACR_AllocatorInterface_t* me,
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    if(ptr == ACR_NULL)
+    {
+        return ACR_AllocatorAlloc(me, bytes);
+    }
+    else if(me == ACR_NULL)
+    {
+        return ACR_REALLOC(ptr, bytes);
+    }
+    else if(me->m_Realloc != ACR_NULL)
+    {
+        return me->m_Realloc(ptr, bytes, me->m_User);
+    }
+    else
+    {
+        // the allocator cannot change the size of memory
+    }
+    return ACR_NULL;
+}
+
+/**********************************************************/
+void* ACR_AllocatorNew(
+    const ACR_AllocatorInterface_t* me,
+    ACR_Length_t bytes)
+{
+    ACR_Byte_t* ptr;
+    if(bytes > (ACR_MAX_LENGTH - ACR_ALLOCATOR_PREFIX_SIZE))
+    {
+        // too many bytes requested
+        return ACR_NULL;
+    }
+
+    ptr = (ACR_Byte_t*)ACR_AllocatorAlloc(me, ACR_ALLOCATOR_NEW_BYTES(bytes));
+    if(ptr == ACR_NULL)
+    {
+        return ACR_NULL;
+    }
+    (*(const ACR_AllocatorInterface_t**)ptr) = me;
+    ptr += ACR_ALLOCATOR_PREFIX_SIZE;
+    ACR_CLEAR_MEMORY(ptr, bytes);
+    return ptr;
+}
+
+/**********************************************************/
+void ACR_AllocatorDelete(
+    void* ptr)
+{
+    if(ptr != ACR_NULL)
+    {
+        ACR_AllocatorFree(ACR_AllocatorOf(ptr), (((ACR_Byte_t*)ptr) - ACR_ALLOCATOR_PREFIX_SIZE));
+    }
+}
+
+/**********************************************************/
+const ACR_AllocatorInterface_t* ACR_AllocatorOf(
+    const void* ptr)
+{
+    if(ptr == ACR_NULL)
+    {
+        return ACR_NULL;
+    }
+    return (*(const ACR_AllocatorInterface_t* const*)(((const ACR_Byte_t*)ptr) - ACR_ALLOCATOR_PREFIX_SIZE));
+}
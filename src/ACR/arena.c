@@ -0,0 +1,275 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file arena.c
+
+    public and private functions for access to the ACR_ArenaObj_t type
+
+*/
+#include "ACR/private/private_arena.h"
+
+// included for ACR_MALLOC and ACR_FREE
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** \see ACR_AllocatorCallbackAlloc_t
+*/
+void* _ACR_ArenaAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr);
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_ArenaNew(
+    ACR_ArenaObj_t** mePtr,
+    ACR_Length_t length)
+{
+    ACR_Info_t result = ACR_INFO_ERROR;
+    if(mePtr != ACR_NULL)
+    {
+        ACR_ArenaObj_t* newArena = ACR_NULL;
+        if(length <= (ACR_MAX_LENGTH - sizeof(ACR_ArenaObj_t) - ACR_HEAP_ALIGNMENT))
+        {
+            // the arena memory is stored right after the
+            // arena object with room to align it
+            newArena = (ACR_ArenaObj_t*)ACR_MALLOC(sizeof(ACR_ArenaObj_t) + ACR_HEAP_ALIGNMENT + length);
+        }
+        if(newArena)
+        {
+            ACR_ArenaInit(newArena, &newArena[1], ACR_HEAP_ALIGNMENT + length);
+            result = ACR_INFO_OK;
+        }
+        (*mePtr) = newArena;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_ArenaDelete(
+    ACR_ArenaObj_t** mePtr)
+{
+    if(mePtr != ACR_NULL)
+    {
+        if((*mePtr) != ACR_NULL)
+        {
+            ACR_ArenaDeInit((*mePtr));
+            ACR_FREE((*mePtr));
+            (*mePtr) = ACR_NULL;
+        }
+    }
+}
+
+/**********************************************************/
+void* ACR_ArenaAlloc(
+    ACR_ArenaObj_t* me,
+    ACR_Length_t bytes)
+{
+    void* ptr = ACR_NULL;
+    if(me == ACR_NULL)
+    {
+        return ptr;
+    }
+
+    // keep every allocation aligned
+    if(bytes <= (ACR_MAX_LENGTH - ACR_HEAP_ALIGNMENT))
+    {
+        bytes = (((bytes + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT);
+        if(bytes <= ACR_ArenaAvailable(me))
+        {
+            ptr = &me->m_Heap[me->m_NextFreePos];
+            me->m_NextFreePos += bytes;
+        }
+        else
+        {
+            // arena is full
+        }
+    }
+    else
+    {
+        // too many bytes requested
+    }
+    return ptr;
+}
+
+/**********************************************************/
+void ACR_ArenaFree(
+    ACR_ArenaObj_t* me,
+    void* ptr)
+{
+    ACR_UNUSED(me);
+    ACR_UNUSED(ptr);
+}
+
+/**********************************************************/
+ACR_ArenaMark_t ACR_ArenaMark(
+    ACR_ArenaObj_t* me)
+{
+    ACR_ArenaMark_t result = ACR_ZERO_LENGTH;
+    if(me != ACR_NULL)
+    {
+        result = me->m_NextFreePos;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_ArenaRewind(
+    ACR_ArenaObj_t* me,
+    ACR_ArenaMark_t mark)
+{
+    if(me != ACR_NULL)
+    {
+        if(mark < me->m_NextFreePos)
+        {
+            me->m_NextFreePos = mark;
+        }
+        else
+        {
+            // nothing was allocated after the mark
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_ArenaReset(
+    ACR_ArenaObj_t* me)
+{
+    ACR_ArenaRewind(me, ACR_ZERO_LENGTH);
+}
+
+/**********************************************************/
+ACR_Length_t ACR_ArenaAvailable(
+    ACR_ArenaObj_t* me)
+{
+    ACR_Length_t result = ACR_ZERO_LENGTH;
+    if(me != ACR_NULL)
+    {
+        result = (me->m_HeapLength - me->m_NextFreePos);
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_ArenaInitAllocator(
+    ACR_ArenaObj_t* me,
+    ACR_AllocatorInterface_t* allocator)
+{
+    if(allocator != ACR_NULL)
+    {
+        allocator->m_Alloc = _ACR_ArenaAllocatorAlloc;
+        allocator->m_Free = ACR_NULL;
+        allocator->m_Realloc = ACR_NULL;
+        allocator->m_User = me;
+    }
+}
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_ArenaInit(
+    ACR_ArenaObj_t* me,
+    void* ptr,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    // skip any bytes needed to align the start of the arena
+    ACR_Length_t skip = (ACR_Length_t)((ACR_HEAP_ALIGNMENT - ((ACR_PointerValue_t)ptr % ACR_HEAP_ALIGNMENT)) % ACR_HEAP_ALIGNMENT);
+    if((ptr != ACR_NULL) &&
+       (length > skip))
+    {
+        me->m_Heap = &((ACR_Byte_t*)ptr)[skip];
+        me->m_HeapLength = (length - skip);
+    }
+    else
+    {
+        // no memory available
+        me->m_Heap = ACR_NULL;
+        me->m_HeapLength = ACR_ZERO_LENGTH;
+    }
+    me->m_NextFreePos = ACR_ZERO_LENGTH;
+}
+
+/**********************************************************/
+void ACR_ArenaDeInit(
+    ACR_ArenaObj_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    me->m_Heap = ACR_NULL;
+    me->m_HeapLength = ACR_ZERO_LENGTH;
+    me->m_NextFreePos = ACR_ZERO_LENGTH;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void* _ACR_ArenaAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr)
+{
+    return ACR_ArenaAlloc((ACR_ArenaObj_t*)userPtr, bytes);
+}
@@ -0,0 +1,784 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file binary.c
+
+    public and private functions for access to the ACR_Binary_t type
+
+*/
+#include "ACR/binary.h"
+
+////////////////////////////////////////////////////////////
+//
+// DEFINES
+//
+////////////////////////////////////////////////////////////
+
+/** determine if an array of type can be copied without changing
+    the byte order, which is only known at compile time when
+    ACR_ENDIAN_DYNAMIC is ACR_BOOL_FALSE
+*/
+#if ACR_ENDIAN_DYNAMIC == ACR_BOOL_FALSE
+    #define ACR_BINARY_CAN_COPY_ARRAY(me, type, bytes) ((sizeof(type) == (bytes)) && _ACR_BinaryIsSystemOrder(me))
+#else
+    #define ACR_BINARY_CAN_COPY_ARRAY(me, type, bytes) ACR_BOOL_FALSE
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** determine if length bytes fit and remember the failure if they do not
+*/
+ACR_Bool_t _ACR_BinaryFits(
+    ACR_Binary_t* me,
+    ACR_Length_t length);
+
+/** determine if count values of valueLength bytes fit and
+    remember the failure if they do not
+*/
+ACR_Bool_t _ACR_BinaryArrayFits(
+    ACR_Binary_t* me,
+    ACR_Length_t count,
+    ACR_Length_t valueLength);
+
+/** determine if the data has the same byte order as the system
+*/
+ACR_Bool_t _ACR_BinaryIsSystemOrder(
+    ACR_Binary_t* me);
+
+/** copy length bytes from the cursor to dest in system byte order
+*/
+void _ACR_BinaryReadOrdered(
+    ACR_Binary_t* me,
+    void* dest,
+    ACR_Length_t length);
+
+/** copy length bytes from src in system byte order to the cursor
+*/
+void _ACR_BinaryWriteOrdered(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length);
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_BinaryInit(
+    ACR_Binary_t* me,
+    ACR_Buffer_t buffer,
+    ACR_Bool_t isBigEndian)
+{
+    if(me)
+    {
+        ACR_CURSOR_FROM_BUFFER(me->m_Cursor, buffer);
+        me->m_IsBigEndian = isBigEndian;
+        me->m_Result = ACR_INFO_OK;
+    }
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BinaryResult(
+    ACR_Binary_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_INFO_ERROR;
+    }
+
+    return me->m_Result;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_BinaryRemaining(
+    ACR_Binary_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        return 0;
+    }
+
+    return ACR_CURSOR_REMAINING(me->m_Cursor);
+}
+
+/**********************************************************/
+void ACR_BinarySkip(
+    ACR_Binary_t* me,
+    ACR_Length_t length)
+{
+    if(_ACR_BinaryFits(me, length))
+    {
+        ACR_CURSOR_SKIP(me->m_Cursor, length);
+    }
+}
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS - READ
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Byte_t ACR_BinaryReadU8(
+    ACR_Binary_t* me)
+{
+    if(_ACR_BinaryFits(me, 1))
+    {
+        return ACR_CURSOR_READ_BYTE(me->m_Cursor);
+    }
+    return 0;
+}
+
+/**********************************************************/
+signed char ACR_BinaryReadI8(
+    ACR_Binary_t* me)
+{
+    ACR_Byte_t value = ACR_BinaryReadU8(me);
+    int result = (int)(value & 0x7F);
+    if(value & 0x80)
+    {
+        // restore the sign
+        result -= 0x80;
+    }
+    return (signed char)result;
+}
+
+/**********************************************************/
+ACR_Unsigned_16bit_t ACR_BinaryReadU16(
+    ACR_Binary_t* me)
+{
+    if(_ACR_BinaryFits(me, 2))
+    {
+        if(me->m_IsBigEndian)
+        {
+            return ACR_CURSOR_READ_16_BIG(me->m_Cursor);
+        }
+        else
+        {
+            return ACR_CURSOR_READ_16_LITTLE(me->m_Cursor);
+        }
+    }
+    return 0;
+}
+
+/**********************************************************/
+ACR_16bit_t ACR_BinaryReadI16(
+    ACR_Binary_t* me)
+{
+    ACR_Unsigned_16bit_t value = ACR_BinaryReadU16(me);
+    int result = (int)(value & 0x7FFF);
+    if(value & 0x8000)
+    {
+        // restore the sign
+        result -= 0x8000;
+    }
+    return (ACR_16bit_t)result;
+}
+
+/**********************************************************/
+ACR_Unsigned_32bit_t ACR_BinaryReadU32(
+    ACR_Binary_t* me)
+{
+    if(_ACR_BinaryFits(me, 4))
+    {
+        if(me->m_IsBigEndian)
+        {
+            return ACR_CURSOR_READ_32_BIG(me->m_Cursor);
+        }
+        else
+        {
+            return ACR_CURSOR_READ_32_LITTLE(me->m_Cursor);
+        }
+    }
+    return 0;
+}
+
+/**********************************************************/
+ACR_32bit_t ACR_BinaryReadI32(
+    ACR_Binary_t* me)
+{
+    ACR_Unsigned_32bit_t value = ACR_BinaryReadU32(me);
+    ACR_32bit_t result = (ACR_32bit_t)(value & 0x7FFFFFFFUL);
+    if(value & 0x80000000UL)
+    {
+        // restore the sign in two steps so that
+        // nothing overflows when long is 32 bits
+        result = (result - 0x7FFFFFFFL) - 1;
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Decimal_t ACR_BinaryReadF32(
+    ACR_Binary_t* me)
+{
+    ACR_Decimal_t value = 0;
+    if(_ACR_BinaryFits(me, 4))
+    {
+        _ACR_BinaryReadOrdered(me, &value, 4);
+    }
+    return value;
+}
+
+/**********************************************************/
+void ACR_BinaryReadBytes(
+    ACR_Binary_t* me,
+    void* dest,
+    ACR_Length_t length)
+{
+    if(_ACR_BinaryFits(me, length))
+    {
+        ACR_CURSOR_READ_COPY(me->m_Cursor, dest, length);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryReadBlob(
+    ACR_Binary_t* me,
+    ACR_Buffer_t* view)
+{
+    ACR_Length_t length = (ACR_Length_t)ACR_BinaryReadU32(me);
+    if(view == ACR_NULL)
+    {
+        // skip the blob
+        ACR_BinarySkip(me, length);
+        return;
+    }
+
+    view->m_Pointer = ACR_NULL;
+    view->m_Length = 0;
+    view->m_Flags = ACR_BUFFER_IS_REF;
+    if(_ACR_BinaryFits(me, length))
+    {
+        // reference the blob instead of copying it
+        view->m_Pointer = me->m_Cursor.m_Pointer;
+        view->m_Length = length;
+        ACR_CURSOR_SKIP(me->m_Cursor, length);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryReadU16Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_16bit_t* dest,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((dest == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 2) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_16bit_t, 2))
+    {
+        ACR_CURSOR_READ_COPY(me->m_Cursor, dest, count * 2);
+    }
+    else if(me->m_IsBigEndian)
+    {
+        // compilers turn this loop into byte swap instructions
+        for(i = 0; i < count; i++)
+        {
+            dest[i] = ACR_CURSOR_READ_16_BIG(me->m_Cursor);
+        }
+    }
+    else
+    {
+        for(i = 0; i < count; i++)
+        {
+            dest[i] = ACR_CURSOR_READ_16_LITTLE(me->m_Cursor);
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryReadU32Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_32bit_t* dest,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((dest == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 4) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_32bit_t, 4))
+    {
+        ACR_CURSOR_READ_COPY(me->m_Cursor, dest, count * 4);
+    }
+    else if(me->m_IsBigEndian)
+    {
+        // compilers turn this loop into byte swap instructions
+        for(i = 0; i < count; i++)
+        {
+            dest[i] = ACR_CURSOR_READ_32_BIG(me->m_Cursor);
+        }
+    }
+    else
+    {
+        for(i = 0; i < count; i++)
+        {
+            dest[i] = ACR_CURSOR_READ_32_LITTLE(me->m_Cursor);
+        }
+    }
+}
+
+#if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+/**********************************************************/
+ACR_Unsigned_64bit_t ACR_BinaryReadU64(
+    ACR_Binary_t* me)
+{
+    ACR_Unsigned_64bit_t value = 0;
+    if(_ACR_BinaryFits(me, 8))
+    {
+        if(me->m_IsBigEndian)
+        {
+            value = ((ACR_Unsigned_64bit_t)ACR_CURSOR_PEEK_32_BIG(me->m_Cursor, 0)) << 32;
+            value |= (ACR_Unsigned_64bit_t)ACR_CURSOR_PEEK_32_BIG(me->m_Cursor, 4);
+        }
+        else
+        {
+            value = (ACR_Unsigned_64bit_t)ACR_CURSOR_PEEK_32_LITTLE(me->m_Cursor, 0);
+            value |= ((ACR_Unsigned_64bit_t)ACR_CURSOR_PEEK_32_LITTLE(me->m_Cursor, 4)) << 32;
+        }
+        ACR_CURSOR_SKIP(me->m_Cursor, 8);
+    }
+    return value;
+}
+
+/**********************************************************/
+ACR_64bit_t ACR_BinaryReadI64(
+    ACR_Binary_t* me)
+{
+    ACR_Unsigned_64bit_t value = ACR_BinaryReadU64(me);
+    ACR_64bit_t result = (ACR_64bit_t)(value & 0x7FFFFFFFFFFFFFFFULL);
+    if(value & 0x8000000000000000ULL)
+    {
+        // restore the sign in two steps so that nothing overflows
+        result = (result - 0x7FFFFFFFFFFFFFFFLL) - 1;
+    }
+    return result;
+}
+
+/**********************************************************/
+double ACR_BinaryReadF64(
+    ACR_Binary_t* me)
+{
+    double value = 0;
+    if(_ACR_BinaryFits(me, 8))
+    {
+        _ACR_BinaryReadOrdered(me, &value, 8);
+    }
+    return value;
+}
+
+/**********************************************************/
+void ACR_BinaryReadU64Array(
+    ACR_Binary_t* me,
+    ACR_Unsigned_64bit_t* dest,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((dest == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 8) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_64bit_t, 8))
+    {
+        ACR_CURSOR_READ_COPY(me->m_Cursor, dest, count * 8);
+    }
+    else
+    {
+        // each read was already checked by _ACR_BinaryArrayFits()
+        for(i = 0; i < count; i++)
+        {
+            dest[i] = ACR_BinaryReadU64(me);
+        }
+    }
+}
+
+#endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS - WRITE
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_BinaryWriteU8(
+    ACR_Binary_t* me,
+    ACR_Byte_t value)
+{
+    if(_ACR_BinaryFits(me, 1))
+    {
+        ACR_CURSOR_WRITE_BYTE(me->m_Cursor, value);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteU16(
+    ACR_Binary_t* me,
+    ACR_Unsigned_16bit_t value)
+{
+    if(_ACR_BinaryFits(me, 2))
+    {
+        if(me->m_IsBigEndian)
+        {
+            ACR_CURSOR_WRITE_16_BIG(me->m_Cursor, value);
+        }
+        else
+        {
+            ACR_CURSOR_WRITE_16_LITTLE(me->m_Cursor, value);
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteU32(
+    ACR_Binary_t* me,
+    ACR_Unsigned_32bit_t value)
+{
+    if(_ACR_BinaryFits(me, 4))
+    {
+        if(me->m_IsBigEndian)
+        {
+            ACR_CURSOR_WRITE_32_BIG(me->m_Cursor, value);
+        }
+        else
+        {
+            ACR_CURSOR_WRITE_32_LITTLE(me->m_Cursor, value);
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteF32(
+    ACR_Binary_t* me,
+    ACR_Decimal_t value)
+{
+    if(_ACR_BinaryFits(me, 4))
+    {
+        _ACR_BinaryWriteOrdered(me, &value, 4);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteBytes(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length)
+{
+    if(_ACR_BinaryFits(me, length))
+    {
+        ACR_CURSOR_WRITE_COPY(me->m_Cursor, src, length);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteBlob(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length)
+{
+    if((me == ACR_NULL) ||
+       (length > 0xFFFFFFFFUL))
+    {
+        // the length does not fit in the prefix
+        if(me)
+        {
+            me->m_Result = ACR_INFO_ERROR;
+        }
+        return;
+    }
+
+    // check the whole blob first so that a length
+    // is never written without its bytes
+    if(_ACR_BinaryFits(me, length + 4))
+    {
+        ACR_BinaryWriteU32(me, (ACR_Unsigned_32bit_t)length);
+        ACR_BinaryWriteBytes(me, src, length);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteU16Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_16bit_t* src,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((src == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 2) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_16bit_t, 2))
+    {
+        ACR_CURSOR_WRITE_COPY(me->m_Cursor, src, count * 2);
+    }
+    else if(me->m_IsBigEndian)
+    {
+        for(i = 0; i < count; i++)
+        {
+            ACR_CURSOR_WRITE_16_BIG(me->m_Cursor, src[i]);
+        }
+    }
+    else
+    {
+        for(i = 0; i < count; i++)
+        {
+            ACR_CURSOR_WRITE_16_LITTLE(me->m_Cursor, src[i]);
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteU32Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_32bit_t* src,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((src == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 4) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_32bit_t, 4))
+    {
+        ACR_CURSOR_WRITE_COPY(me->m_Cursor, src, count * 4);
+    }
+    else if(me->m_IsBigEndian)
+    {
+        for(i = 0; i < count; i++)
+        {
+            ACR_CURSOR_WRITE_32_BIG(me->m_Cursor, src[i]);
+        }
+    }
+    else
+    {
+        for(i = 0; i < count; i++)
+        {
+            ACR_CURSOR_WRITE_32_LITTLE(me->m_Cursor, src[i]);
+        }
+    }
+}
+
+#if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+/**********************************************************/
+void ACR_BinaryWriteU64(
+    ACR_Binary_t* me,
+    ACR_Unsigned_64bit_t value)
+{
+    if(_ACR_BinaryFits(me, 8))
+    {
+        if(me->m_IsBigEndian)
+        {
+            ACR_CURSOR_WRITE_32_BIG(me->m_Cursor, (ACR_Unsigned_32bit_t)(value >> 32));
+            ACR_CURSOR_WRITE_32_BIG(me->m_Cursor, (ACR_Unsigned_32bit_t)(value & 0xFFFFFFFFULL));
+        }
+        else
+        {
+            ACR_CURSOR_WRITE_32_LITTLE(me->m_Cursor, (ACR_Unsigned_32bit_t)(value & 0xFFFFFFFFULL));
+            ACR_CURSOR_WRITE_32_LITTLE(me->m_Cursor, (ACR_Unsigned_32bit_t)(value >> 32));
+        }
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteF64(
+    ACR_Binary_t* me,
+    double value)
+{
+    if(_ACR_BinaryFits(me, 8))
+    {
+        _ACR_BinaryWriteOrdered(me, &value, 8);
+    }
+}
+
+/**********************************************************/
+void ACR_BinaryWriteU64Array(
+    ACR_Binary_t* me,
+    const ACR_Unsigned_64bit_t* src,
+    ACR_Length_t count)
+{
+    ACR_Length_t i;
+    if((src == ACR_NULL) ||
+       (_ACR_BinaryArrayFits(me, count, 8) == ACR_BOOL_FALSE))
+    {
+        // invalid pointer or not enough bytes
+        return;
+    }
+
+    if(ACR_BINARY_CAN_COPY_ARRAY(me, ACR_Unsigned_64bit_t, 8))
+    {
+        ACR_CURSOR_WRITE_COPY(me->m_Cursor, src, count * 8);
+    }
+    else
+    {
+        // each write was already checked by _ACR_BinaryArrayFits()
+        for(i = 0; i < count; i++)
+        {
+            ACR_BinaryWriteU64(me, src[i]);
+        }
+    }
+}
+
+#endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Bool_t _ACR_BinaryFits(
+    ACR_Binary_t* me,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_BOOL_FALSE;
+    }
+
+    if((me->m_Result == ACR_INFO_OK) &&
+       ACR_CURSOR_HAS(me->m_Cursor, length))
+    {
+        return ACR_BOOL_TRUE;
+    }
+
+    // remember the failure so that the
+    // caller only needs to check once
+    me->m_Result = ACR_INFO_ERROR;
+    return ACR_BOOL_FALSE;
+}
+
+/**********************************************************/
+ACR_Bool_t _ACR_BinaryArrayFits(
+    ACR_Binary_t* me,
+    ACR_Length_t count,
+    ACR_Length_t valueLength)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_BOOL_FALSE;
+    }
+
+    // divide instead of multiply so that a
+    // large count cannot wrap around
+    if(count > (ACR_CURSOR_REMAINING(me->m_Cursor) / valueLength))
+    {
+        me->m_Result = ACR_INFO_ERROR;
+        return ACR_BOOL_FALSE;
+    }
+
+    return _ACR_BinaryFits(me, count * valueLength);
+}
+
+/**********************************************************/
+ACR_Bool_t _ACR_BinaryIsSystemOrder(
+    ACR_Binary_t* me)
+{
+    return ((me->m_IsBigEndian != ACR_BOOL_FALSE) == (ACR_IS_BIG_ENDIAN != ACR_BOOL_FALSE));
+}
+
+/**********************************************************/
+void _ACR_BinaryReadOrdered(
+    ACR_Binary_t* me,
+    void* dest,
+    ACR_Length_t length)
+{
+    if(_ACR_BinaryIsSystemOrder(me))
+    {
+        ACR_CURSOR_READ_COPY(me->m_Cursor, dest, length);
+    }
+    else
+    {
+        // reverse the bytes
+        ACR_Byte_t* destPtr = (ACR_Byte_t*)dest;
+        while(length > 0)
+        {
+            length--;
+            destPtr[length] = ACR_CURSOR_READ_BYTE(me->m_Cursor);
+        }
+    }
+}
+
+/**********************************************************/
+void _ACR_BinaryWriteOrdered(
+    ACR_Binary_t* me,
+    const void* src,
+    ACR_Length_t length)
+{
+    if(_ACR_BinaryIsSystemOrder(me))
+    {
+        ACR_CURSOR_WRITE_COPY(me->m_Cursor, src, length);
+    }
+    else
+    {
+        // reverse the bytes
+        const ACR_Byte_t* srcPtr = (const ACR_Byte_t*)src;
+        while(length > 0)
+        {
+            length--;
+            ACR_CURSOR_WRITE_BYTE(me->m_Cursor, srcPtr[length]);
+        }
+    }
+}
@@ -50,6 +50,9 @@
 // included for ACR_VALUE_AT()
 #include "ACR/public/public_count.h"
 
+// included for ACR_AllocatorNew() and ACR_AllocatorDelete()
+#include "ACR/allocator.h"
+
 ////////////////////////////////////////////////////////////
 //
 // FILE INTERFACE FUNCTIONS
@@ -68,6 +71,13 @@ ACR_Info_t _ACR_BufferFileCallbackWrite(
     ACR_VarBuffer_t* src,
     void* userPtr);
 
+/** \see ACR_FileCallbackWriteChain_t
+*/
+ACR_Info_t _ACR_BufferFileCallbackWriteChain(
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written,
+    void* userPtr);
+
 /** \see ACR_FileCallbackSeek_t
 */
 ACR_Info_t _ACR_BufferFileCallbackSeek(
@@ -80,6 +90,13 @@ ACR_Info_t _ACR_BufferFileCallbackSeek(
 ACR_Length_t _ACR_BufferFileCallbackPosition(
     void* userPtr);
 
+/** \see ACR_FileCallbackBorrow_t
+*/
+ACR_Info_t _ACR_BufferFileCallbackBorrow(
+    ACR_Buffer_t* view,
+    ACR_Length_t maxLength,
+    void* userPtr);
+
 /** \see ACR_FileCallbackOpen_t
 */
 ACR_Info_t _ACR_BufferFileCallbackOpen(
@@ -130,6 +147,40 @@ void _ACR_BufferShiftRightWrap(
     ACR_Byte_t* swapPtr,
     ACR_Length_t swapLength);
 
+/** rotate the bytes to the left in place so that the byte at
+    position rotateBytes becomes the first byte. each byte is moved
+    a bounded number of times no matter how large rotateBytes is
+    \param rotateBytes must be less than length
+*/
+void _ACR_BufferRotateLeft(
+    ACR_Byte_t* ptr,
+    ACR_Length_t length,
+    ACR_Length_t rotateBytes,
+    ACR_Byte_t* swapPtr,
+    ACR_Length_t swapLength);
+
+/** exchange two blocks of memory that do not overlap
+    using swapPtr as temporary storage
+*/
+void _ACR_BufferSwapBlocks(
+    ACR_Byte_t* firstPtr,
+    ACR_Byte_t* secondPtr,
+    ACR_Length_t length,
+    ACR_Byte_t* swapPtr,
+    ACR_Length_t swapLength);
+
+/** free the memory of the buffer unless it is a reference
+    using the allocator of the buffer
+*/
+void _ACR_BufferFreeData(
+    ACR_BufferObj_t* me);
+
+/** allocate memory for the buffer from the allocator of the buffer
+*/
+void _ACR_BufferAllocData(
+    ACR_BufferObj_t* me,
+    ACR_Length_t length);
+
 ////////////////////////////////////////////////////////////
 //
 // PUBLIC FUNCTIONS
@@ -139,11 +190,19 @@ void _ACR_BufferShiftRightWrap(
 /**********************************************************/
 ACR_Info_t ACR_BufferNew(
     ACR_BufferObj_t** mePtr)
+{
+    return ACR_BufferNewWithAllocator(mePtr, ACR_NULL);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BufferNewWithAllocator(
+    ACR_BufferObj_t** mePtr,
+    const ACR_AllocatorInterface_t* allocator)
 {
     ACR_Info_t result = ACR_INFO_ERROR;
     if (mePtr != ACR_NULL)
     {
-        ACR_NEW_BY_TYPE(newBuffer, ACR_BufferObj_t);
+        ACR_BufferObj_t* newBuffer = (ACR_BufferObj_t*)ACR_AllocatorNew(allocator, sizeof(ACR_BufferObj_t));
         if (newBuffer)
         {
             ACR_BufferInit(newBuffer);
@@ -161,7 +220,7 @@ void ACR_BufferDelete(
     if (mePtr != ACR_NULL)
     {
         ACR_BufferDeInit((*mePtr));
-        ACR_FREE((*mePtr));
+        ACR_AllocatorDelete((*mePtr));
         (*mePtr) = ACR_NULL;
     }
 }
@@ -178,11 +237,11 @@ ACR_Info_t ACR_BufferAllocate(
 
     if (length == 0)
     {
-        ACR_BUFFER_FREE(me->m_Base);
+        _ACR_BufferFreeData(me);
         return ACR_INFO_ERROR;
     }
 
-    ACR_BUFFER_ALLOC(me->m_Base, length);
+    _ACR_BufferAllocData(me, length);
     if (ACR_BUFFER_IS_VALID(me->m_Base))
     {
         return ACR_INFO_OK;
@@ -191,6 +250,21 @@ ACR_Info_t ACR_BufferAllocate(
     return ACR_INFO_ERROR;
 }
 
+/**********************************************************/
+void ACR_BufferSetDataAllocator(
+    ACR_BufferObj_t* me,
+    const ACR_AllocatorInterface_t* allocator)
+{
+    if (me == ACR_NULL)
+    {
+        return;
+    }
+
+    // memory is always freed by the allocator it came from
+    _ACR_BufferFreeData(me);
+    me->m_DataAllocator = allocator;
+}
+
 /**********************************************************/
 ACR_Info_t ACR_BufferSetData(
     ACR_BufferObj_t* me,
@@ -204,10 +278,11 @@ ACR_Info_t ACR_BufferSetData(
 
     if (length == 0)
     {
-        ACR_BUFFER_FREE(me->m_Base);
+        _ACR_BufferFreeData(me);
         return ACR_INFO_ERROR;
     }
 
+    _ACR_BufferFreeData(me);
     ACR_BUFFER_SET_DATA(me->m_Base, ptr, length);
     if (ACR_BUFFER_IS_VALID(me->m_Base))
     {
@@ -367,6 +442,36 @@ ACR_Info_t ACR_BufferGetByteAt(
     return ACR_INFO_OK;
 }
 
+/**********************************************************/
+ACR_Info_t ACR_BufferGetCursor(
+	ACR_BufferObj_t* me,
+	ACR_Length_t pos,
+	ACR_Length_t length,
+	ACR_Cursor_t* cursor)
+{
+    if ((me == ACR_NULL) || (cursor == ACR_NULL))
+    {
+        return ACR_INFO_ERROR;
+    }
+
+    if (me->m_Base.m_Pointer == ACR_NULL)
+    {
+        return ACR_INFO_INVALID;
+    }
+
+    // check pos and length separately so that
+    // their sum cannot wrap around
+    if ((pos > me->m_Base.m_Length) ||
+        (length > (me->m_Base.m_Length - pos)))
+    {
+        return ACR_INFO_GREATER;
+    }
+
+    ACR_CURSOR_SET_DATA((*cursor), ((ACR_Byte_t*)me->m_Base.m_Pointer) + pos, length);
+
+    return ACR_INFO_OK;
+}
+
 /**********************************************************/
 void ACR_BufferShift(
     ACR_BufferObj_t* me,
@@ -466,6 +571,8 @@ ACR_Info_t ACR_BufferNewFileInterface(
             newFileInterface->m_Write = _ACR_BufferFileCallbackWrite;
             newFileInterface->m_Seek = _ACR_BufferFileCallbackSeek;
             newFileInterface->m_Position = _ACR_BufferFileCallbackPosition;
+            newFileInterface->m_Borrow = _ACR_BufferFileCallbackBorrow;
+            newFileInterface->m_WriteChain = _ACR_BufferFileCallbackWriteChain;
         }
         else
         {
@@ -674,6 +781,48 @@ ACR_Info_t _ACR_BufferFileCallbackWrite(
     return ACR_INFO_OK;
 }
 
+/**********************************************************/
+ACR_Info_t _ACR_BufferFileCallbackWriteChain(
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written,
+    void* userPtr)
+{
+    if (src == ACR_NULL || written == ACR_NULL || userPtr == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    // each link is copied straight to its place in the
+    // buffer with the same checks as a single write
+    ACR_Info_t result = ACR_INFO_OK;
+    ACR_Count_t index;
+    (*written) = 0;
+    for(index = 0; index < src->m_Count; index++)
+    {
+        ACR_VAR_BUFFER(link);
+        ACR_VAR_BUFFER_SET_MEMORY(link, src->m_Links[index].m_Pointer, src->m_Links[index].m_Length);
+        result = _ACR_BufferFileCallbackWrite(&link, userPtr);
+        if(result != ACR_INFO_OK)
+        {
+            // write failed
+            break;
+        }
+        (*written) += link.m_Buffer.m_Length;
+        if(link.m_Buffer.m_Length < src->m_Links[index].m_Length)
+        {
+            // no space available for the rest
+            break;
+        }
+        else
+        {
+            // continue with the next link
+        }
+    }
+
+    return result;
+}
+
 /**********************************************************/
 ACR_Info_t _ACR_BufferFileCallbackSeek(
     ACR_Length_t moveBy,
@@ -782,6 +931,69 @@ ACR_Length_t _ACR_BufferFileCallbackPosition(
     return bufferObjForFileInterface->m_Position;
 }
 
+/**********************************************************/
+ACR_Info_t _ACR_BufferFileCallbackBorrow(
+    ACR_Buffer_t* view,
+    ACR_Length_t maxLength,
+    void* userPtr)
+{
+    if (view == ACR_NULL || userPtr == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    struct ACR_BufferObjForFileInterface_s* bufferObjForFileInterface = (struct ACR_BufferObjForFileInterface_s*)userPtr;
+    if(bufferObjForFileInterface->m_BufferObj == ACR_NULL)
+    {
+        // invalid buffer in file interface
+        return ACR_INFO_ERROR;
+    }
+
+    if((bufferObjForFileInterface->m_Mode != ACR_INFO_READ) &&
+        (bufferObjForFileInterface->m_Mode != ACR_INFO_READ_WRITE))
+    {
+        // cannot read from this buffer
+        return ACR_INFO_ERROR;
+    }
+
+    if (bufferObjForFileInterface->m_BufferObj->m_Base.m_Pointer == ACR_NULL)
+    {
+        // invalid memory
+        return ACR_INFO_ERROR;
+    }
+
+    if(bufferObjForFileInterface->m_Position < bufferObjForFileInterface->m_BufferObj->m_Base.m_Length)
+    {
+        // limit the number of bytes to lend to just
+        // those that are requested
+        view->m_Length = bufferObjForFileInterface->m_BufferObj->m_Base.m_Length - bufferObjForFileInterface->m_Position;
+        if(view->m_Length > maxLength)
+        {
+            view->m_Length = maxLength;
+        }
+
+        // point into the buffer at the current position
+        // instead of copying the bytes out of it
+        view->m_Pointer = ((ACR_Byte_t*)bufferObjForFileInterface->m_BufferObj->m_Base.m_Pointer) + bufferObjForFileInterface->m_Position;
+        view->m_Flags = ACR_BUFFER_IS_REF;
+
+        // update the position within the buffer so
+        // that the next read will continue from
+        // where this borrow finished
+        bufferObjForFileInterface->m_Position += view->m_Length;
+    }
+    else
+    {
+        // no bytes available
+        view->m_Pointer = ACR_NULL;
+        view->m_Length = 0;
+        view->m_Flags = ACR_BUFFER_IS_REF;
+    }
+
+    return ACR_INFO_OK;
+}
+
 /**********************************************************/
 ACR_Info_t _ACR_BufferFileCallbackOpen(
     ACR_String_t path,
@@ -1112,29 +1324,11 @@ void _ACR_BufferShiftLeftWrap(
                              V                                    |
         swapPtr      (0) |abcdef| (swapLength)                 |abcdef|
  
+       when the wrapped data does not fit in the swap
+       memory the buffer is rotated by _ACR_BufferRotateLeft()
     */
 
-    while(shiftBytes > 0)
-    {
-        // determine the max number of bytes
-        // that can be shifted during this loop
-        ACR_Length_t currentShift = swapLength;
-        if(currentShift > shiftBytes)
-        {
-            // reduce the number of bytes to just
-            // those that remain to be shifted
-            currentShift = shiftBytes;
-        }
-
-        // make a copy of the data at the start
-        // of the buffer for this shift
-        // Note: a previous check ensured currentShift is less than length
-        ACR_MEMCPY(swapPtr, ptr, currentShift);
-        _ACR_BufferShiftLeftNoWrap(ptr, length, currentShift);
-        ACR_MEMCPY(&ptr[length - currentShift], swapPtr, currentShift);
-        shiftBytes -= currentShift;
-    }
-    
+    _ACR_BufferRotateLeft(ptr, length, shiftBytes, swapPtr, swapLength);
 }
 
 /**********************************************************/
@@ -1178,27 +1372,143 @@ void _ACR_BufferShiftRightWrap(
                              |                                    V
         swapPtr      (0) |abcdef|        (length - shiftBytes) |abcdef| (length + swapLength)
  
+       shifting right is the same as shifting
+       left by the rest of the buffer
     */
 
-    while(shiftBytes > 0)
+    if (shiftBytes > 0)
+    {
+        _ACR_BufferRotateLeft(ptr, length, (length - shiftBytes), swapPtr, swapLength);
+    }
+}
+
+/**********************************************************/
+void _ACR_BufferRotateLeft(
+    ACR_Byte_t* ptr,
+    ACR_Length_t length,
+    ACR_Length_t rotateBytes,
+    ACR_Byte_t* swapPtr,
+    ACR_Length_t swapLength)
+{
+    // the bytes before the rotation point are the left block
+    // and the bytes after it are the right block
+    ACR_Length_t leftLength = rotateBytes;
+    ACR_Length_t rightLength = (length - rotateBytes);
+
+    if (leftLength == 0)
     {
-        // determine the max number of bytes
-        // that can be shifted during this loop
-        ACR_Length_t currentShift = swapLength;
-        if(currentShift > shiftBytes)
+        // nothing to rotate
+        return;
+    }
+
+    /* block swap: exchange the smaller block with the
+       same number of bytes at the far end of the larger block,
+       which puts those bytes in their final position. what is
+       left is a smaller rotation of the rest of the larger block
+
+        left larger      |xxxxYYYYYYYY|rrrr|  -->  |rrrr|YYYYYYYYxxxx|
+                                                    done  rotate the rest
+
+        right larger     |llll|XXXXXXXXyyyy|  -->  |yyyyXXXXXXXX|llll|
+                                                   rotate the rest done
+
+       once the smaller block fits in the swap memory the
+       rotation is finished with a single move of the larger block
+    */
+    while ((leftLength > swapLength) &&
+           (rightLength > swapLength))
+    {
+        if (leftLength > rightLength)
+        {
+            _ACR_BufferSwapBlocks(ptr, &ptr[leftLength], rightLength, swapPtr, swapLength);
+            ptr += rightLength;
+            leftLength -= rightLength;
+        }
+        else
+        {
+            _ACR_BufferSwapBlocks(ptr, &ptr[rightLength], leftLength, swapPtr, swapLength);
+            rightLength -= leftLength;
+            if (rightLength == 0)
+            {
+                // the blocks were the same size
+                return;
+            }
+        }
+    }
+
+    if (leftLength <= rightLength)
+    {
+        ACR_MEMCPY(swapPtr, ptr, leftLength);
+        ACR_MEMMOVE(ptr, &ptr[leftLength], rightLength);
+        ACR_MEMCPY(&ptr[rightLength], swapPtr, leftLength);
+    }
+    else
+    {
+        ACR_MEMCPY(swapPtr, &ptr[leftLength], rightLength);
+        ACR_MEMMOVE(&ptr[rightLength], ptr, leftLength);
+        ACR_MEMCPY(ptr, swapPtr, rightLength);
+    }
+}
+
+/**********************************************************/
+void _ACR_BufferSwapBlocks(
+    ACR_Byte_t* firstPtr,
+    ACR_Byte_t* secondPtr,
+    ACR_Length_t length,
+    ACR_Byte_t* swapPtr,
+    ACR_Length_t swapLength)
+{
+    while (length > 0)
+    {
+        ACR_Length_t currentLength = swapLength;
+        if (currentLength > length)
+        {
+            currentLength = length;
+        }
+        ACR_MEMCPY(swapPtr, firstPtr, currentLength);
+        ACR_MEMCPY(firstPtr, secondPtr, currentLength);
+        ACR_MEMCPY(secondPtr, swapPtr, currentLength);
+        firstPtr += currentLength;
+        secondPtr += currentLength;
+        length -= currentLength;
+    }
+}
+
+/**********************************************************/
+void _ACR_BufferFreeData(
+    ACR_BufferObj_t* me)
+{
+    if (me->m_Base.m_Pointer != ACR_NULL)
+    {
+        if (ACR_HAS_FLAG(me->m_Base.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE)
         {
-            // reduce the number of bytes to just
-            // those that remain to be shifted
-            currentShift = shiftBytes;
+            ACR_AllocatorFree(me->m_DataAllocator, me->m_Base.m_Pointer);
         }
+        me->m_Base.m_Pointer = ACR_NULL;
+    }
+    me->m_Base.m_Length = ACR_ZERO_LENGTH;
+    ACR_REMOVE_FLAGS(me->m_Base.m_Flags, ACR_BUFFER_IS_REF);
+}
 
-        // make a copy of the data at the start
-        // of the buffer for this shift
-        // Note: a previous check ensured currentShift is less than length
-        ACR_MEMCPY(swapPtr, &ptr[length - currentShift], currentShift);
-        _ACR_BufferShiftRightNoWrap(ptr, length, currentShift);
-        ACR_MEMCPY(ptr, swapPtr, currentShift);
-        shiftBytes -= currentShift;
+/**********************************************************/
+void _ACR_BufferAllocData(
+    ACR_BufferObj_t* me,
+    ACR_Length_t length)
+{
+    _ACR_BufferFreeData(me);
+    if (length < ACR_MAX_LENGTH)
+    {
+        // one extra byte is allocated to terminate the data
+        me->m_Base.m_Pointer = ACR_AllocatorAlloc(me->m_DataAllocator, (length + 1));
+    }
+    else
+    {
+        // no room for the extra byte
+    }
+    if (me->m_Base.m_Pointer != ACR_NULL)
+    {
+        ((ACR_Byte_t*)me->m_Base.m_Pointer)[length] = 0;
+        me->m_Base.m_Length = length;
     }
 }
 
@@ -1220,6 +1530,7 @@ void ACR_BufferInit(
     me->m_Base.m_Length = ACR_ZERO_LENGTH;
     me->m_Base.m_Pointer = ACR_NULL;
     me->m_Base.m_Flags = ACR_BUFFER_FLAGS_NONE;
+    me->m_DataAllocator = ACR_NULL;
 }
 
 /**********************************************************/
@@ -1231,5 +1542,5 @@ void ACR_BufferDeInit(
         return;
     }
 
-    ACR_BUFFER_FREE(me->m_Base);
+    _ACR_BufferFreeData(me);
 }
@@ -0,0 +1,373 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bufferchain.c
+
+    public and private functions for access to the ACR_BufferChain_t type
+
+*/
+#include "ACR/bufferchain.h"
+
+// included for ACR_VarBufferReserve()
+#include "ACR/varbuffer.h"
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** find the link that holds the byte at pos
+    \param me the chain
+    \param pos the position of the byte in the chain
+    \param index set to the link that holds the byte
+    \param offset set to the position of the byte in the link
+    \returns ACR_BOOL_TRUE if pos is in the chain
+*/
+ACR_Bool_t _ACR_BufferChainFind(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    ACR_Count_t* index,
+    ACR_Length_t* offset);
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_BufferChainInit(
+    ACR_BufferChain_t* me,
+    ACR_Buffer_t* links,
+    ACR_Count_t maxCount)
+{
+    if(me)
+    {
+        me->m_Links = links;
+        me->m_MaxCount = (links != ACR_NULL) ? maxCount : ACR_ZERO_COUNT;
+        me->m_Count = ACR_ZERO_COUNT;
+        me->m_Length = ACR_ZERO_LENGTH;
+    }
+}
+
+/**********************************************************/
+void ACR_BufferChainClear(
+    ACR_BufferChain_t* me)
+{
+    if(me)
+    {
+        ACR_BUFFER_CHAIN_CLEAR((*me));
+    }
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BufferChainAppend(
+    ACR_BufferChain_t* me,
+    void* data,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if(length == ACR_ZERO_LENGTH)
+    {
+        // nothing to refer to
+        return ACR_INFO_OK;
+    }
+
+    if((data == ACR_NULL) ||
+       (me->m_Count >= me->m_MaxCount))
+    {
+        // invalid memory or no links left
+        return ACR_INFO_ERROR;
+    }
+
+    ACR_Buffer_t* link = &me->m_Links[me->m_Count];
+    link->m_Pointer = data;
+    link->m_Length = length;
+    link->m_Flags = ACR_BUFFER_IS_REF;
+    me->m_Count++;
+    me->m_Length += length;
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_BufferChainGetLength(
+    ACR_BufferChain_t* me)
+{
+    if(me)
+    {
+        return me->m_Length;
+    }
+    return ACR_ZERO_LENGTH;
+}
+
+/**********************************************************/
+ACR_Count_t ACR_BufferChainGetCount(
+    ACR_BufferChain_t* me)
+{
+    if(me)
+    {
+        return me->m_Count;
+    }
+    return ACR_ZERO_COUNT;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BufferChainGetLink(
+    ACR_BufferChain_t* me,
+    ACR_Count_t index,
+    ACR_Buffer_t* link)
+{
+    if((me == ACR_NULL) ||
+       (link == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if(index >= me->m_Count)
+    {
+        // not a link
+        return ACR_INFO_ERROR;
+    }
+
+    link->m_Pointer = me->m_Links[index].m_Pointer;
+    link->m_Length = me->m_Links[index].m_Length;
+    link->m_Flags = ACR_BUFFER_IS_REF;
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BufferChainSlice(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    ACR_Length_t length,
+    ACR_BufferChain_t* slice)
+{
+    if((me == ACR_NULL) ||
+       (slice == ACR_NULL) ||
+       (slice == me))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if((pos > me->m_Length) ||
+       (length > (me->m_Length - pos)))
+    {
+        // the range is not in the chain
+        return ACR_INFO_ERROR;
+    }
+
+    ACR_BUFFER_CHAIN_CLEAR((*slice));
+    if(length == ACR_ZERO_LENGTH)
+    {
+        // an empty range has no links
+        return ACR_INFO_OK;
+    }
+
+    ACR_Count_t index;
+    ACR_Length_t offset;
+    if(_ACR_BufferChainFind(me, pos, &index, &offset) == ACR_BOOL_FALSE)
+    {
+        // the range was already checked
+        // so this should not happen
+        return ACR_INFO_ERROR;
+    }
+
+    while(length > 0)
+    {
+        // refer to as much of this link
+        // as the range needs
+        ACR_Length_t linkLength = me->m_Links[index].m_Length - offset;
+        if(linkLength > length)
+        {
+            linkLength = length;
+        }
+        else
+        {
+            // the range continues into the next link
+        }
+
+        if(ACR_BufferChainAppend(slice, ((ACR_Byte_t*)me->m_Links[index].m_Pointer) + offset, linkLength) != ACR_INFO_OK)
+        {
+            // not enough links in the slice
+            ACR_BUFFER_CHAIN_CLEAR((*slice));
+            return ACR_INFO_ERROR;
+        }
+        length -= linkLength;
+        offset = 0;
+        index++;
+    }
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_BufferChainCopyTo(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    void* dest,
+    ACR_Length_t length)
+{
+    if((me == ACR_NULL) ||
+       (dest == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_ZERO_LENGTH;
+    }
+
+    ACR_Count_t index;
+    ACR_Length_t offset;
+    if(_ACR_BufferChainFind(me, pos, &index, &offset) == ACR_BOOL_FALSE)
+    {
+        // nothing to copy
+        return ACR_ZERO_LENGTH;
+    }
+
+    ACR_Byte_t* destPtr = (ACR_Byte_t*)dest;
+    ACR_Length_t copied = ACR_ZERO_LENGTH;
+    while((copied < length) &&
+          (index < me->m_Count))
+    {
+        ACR_Length_t linkLength = me->m_Links[index].m_Length - offset;
+        if(linkLength > (length - copied))
+        {
+            linkLength = length - copied;
+        }
+        else
+        {
+            // copy the rest of this link
+        }
+
+        ACR_MEMCPY(&destPtr[copied], ((ACR_Byte_t*)me->m_Links[index].m_Pointer) + offset, linkLength);
+        copied += linkLength;
+        offset = 0;
+        index++;
+    }
+
+    return copied;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_BufferChainLinearize(
+    ACR_BufferChain_t* me,
+    ACR_VarBuffer_t* scratch,
+    ACR_Buffer_t* view)
+{
+    if((me == ACR_NULL) ||
+       (scratch == ACR_NULL) ||
+       (view == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if(me->m_Count <= 1)
+    {
+        // the bytes are already contiguous
+        // so there is nothing to copy
+        if(me->m_Count == 1)
+        {
+            return ACR_BufferChainGetLink(me, 0, view);
+        }
+        else
+        {
+            // no bytes
+            view->m_Pointer = ACR_NULL;
+            view->m_Length = ACR_ZERO_LENGTH;
+            view->m_Flags = ACR_BUFFER_IS_REF;
+            return ACR_INFO_OK;
+        }
+    }
+
+    // replace the data in scratch with a copy
+    // of every link in order
+    scratch->m_Buffer.m_Length = ACR_ZERO_LENGTH;
+    if(ACR_VarBufferReserve(scratch, me->m_Length) != ACR_INFO_OK)
+    {
+        // scratch is too small
+        return ACR_INFO_ERROR;
+    }
+    scratch->m_Buffer.m_Length = ACR_BufferChainCopyTo(me, 0, scratch->m_Buffer.m_Pointer, me->m_Length);
+
+    view->m_Pointer = scratch->m_Buffer.m_Pointer;
+    view->m_Length = scratch->m_Buffer.m_Length;
+    view->m_Flags = ACR_BUFFER_IS_REF;
+
+    return ACR_INFO_OK;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Bool_t _ACR_BufferChainFind(
+    ACR_BufferChain_t* me,
+    ACR_Length_t pos,
+    ACR_Count_t* index,
+    ACR_Length_t* offset)
+{
+    ACR_Count_t linkIndex;
+    for(linkIndex = 0; linkIndex < me->m_Count; linkIndex++)
+    {
+        if(pos < me->m_Links[linkIndex].m_Length)
+        {
+            (*index) = linkIndex;
+            (*offset) = pos;
+            return ACR_BOOL_TRUE;
+        }
+        else
+        {
+            // the byte is in a later link
+            pos -= me->m_Links[linkIndex].m_Length;
+        }
+    }
+    return ACR_BOOL_FALSE;
+}
@@ -149,3 +149,106 @@ ACR_Info_t ACR_FileReadAll(
 
     return result;
 }
+
+/**********************************************************/
+ACR_Info_t ACR_FileReadView(
+	ACR_FileInterface_t* me,
+    ACR_VarBuffer_t* scratch,
+    ACR_Buffer_t* view)
+{
+    ACR_Info_t result = ACR_INFO_OK;
+    if(me && scratch && view)
+    {
+        if(me->m_Borrow)
+        {
+            // the file is already in memory
+            // so there is nothing to copy
+            result = me->m_Borrow(view, scratch->m_MaxLength, me->m_User);
+        }
+        else if(me->m_Read)
+        {
+            // copy into scratch and let
+            // view refer to the copy
+            result = me->m_Read(scratch, me->m_User);
+            if(result == ACR_INFO_OK)
+            {
+                view->m_Pointer = scratch->m_Buffer.m_Pointer;
+                view->m_Length = scratch->m_Buffer.m_Length;
+                view->m_Flags = ACR_BUFFER_IS_REF;
+            }
+            else
+            {
+                // read failed
+            }
+        }
+        else
+        {
+            // no read function
+            result = ACR_INFO_ERROR;
+        }
+    }
+    else
+    {
+        // invalid pointer
+        result = ACR_INFO_ERROR;
+    }
+
+    return result;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_FileWriteChain(
+	ACR_FileInterface_t* me,
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written)
+{
+    ACR_Info_t result = ACR_INFO_OK;
+    if(me && src && written)
+    {
+        (*written) = 0;
+        if(me->m_WriteChain)
+        {
+            // the file takes every buffer in one call
+            result = me->m_WriteChain(src, written, me->m_User);
+        }
+        else if(me->m_Write)
+        {
+            // write each buffer where it is and stop
+            // early when the file cannot take it all
+            ACR_Count_t index;
+            for(index = 0; index < src->m_Count; index++)
+            {
+                ACR_VAR_BUFFER(link);
+                ACR_VAR_BUFFER_SET_MEMORY(link, src->m_Links[index].m_Pointer, src->m_Links[index].m_Length);
+                result = me->m_Write(&link, me->m_User);
+                if(result != ACR_INFO_OK)
+                {
+                    // write failed
+                    break;
+                }
+                (*written) += link.m_Buffer.m_Length;
+                if(link.m_Buffer.m_Length < src->m_Links[index].m_Length)
+                {
+                    // the file is full
+                    break;
+                }
+                else
+                {
+                    // continue with the next buffer
+                }
+            }
+        }
+        else
+        {
+            // no write function
+            result = ACR_INFO_ERROR;
+        }
+    }
+    else
+    {
+        // invalid pointer
+        result = ACR_INFO_ERROR;
+    }
+
+    return result;
+}
@@ -42,17 +42,281 @@
     public and private functions for access to a rudimentary heap
 
 */
+#if defined(ACR_CONFIG_HEAP_MMAP) && defined(__linux__) && !defined(_GNU_SOURCE)
+    // needed for mremap, which must be
+    // defined before any system header
+    #define _GNU_SOURCE
+#endif
+
 #include "ACR/private/private_heap.h"
 
 #ifndef ACR_CONFIG_HEAP_SIZE
     // the project settings did not define a heap size.
     // configure the heap size for 2MB
-    #define ACR_CONFIG_HEAP_SIZE (2*1024)
+    #define ACR_CONFIG_HEAP_SIZE (2*1024*1024)
 #endif
 
 // included for ACR_Bool_t
 #include "ACR/public/public_bool.h"
 
+// included for ACR_COMPILER_GCC, ACR_COMPILER_CLANG, and ACR_PLATFORM_WIN
+#include "ACR/public/public_config.h"
+
+#ifdef ACR_CONFIG_NO_HEAP_STATS
+    // timing is part of the statistics
+    #undef ACR_CONFIG_HEAP_STATS_TIMING
+    #define ACR_HEAP_STATS_INIT
+#else
+    // zero the statistics of the global heap
+    #define ACR_HEAP_STATS_INIT , {0}
+#endif
+
+#ifdef ACR_CONFIG_HEAP_STATS_TIMING
+    // included for ACR_Timer_t and ACR_TIMER_DIFF_MICRO
+    #include "ACR/public/public_timer.h"
+
+    /** start timing a heap function
+    */
+    #define ACR_HEAP_STATS_TIMER_START(timer) ACR_Timer_t timer; ACR_TIMER_START(timer)
+
+    /** add the time since ACR_HEAP_STATS_TIMER_START() to the total
+    */
+    #define ACR_HEAP_STATS_TIMER_ADD(timer, total)\
+            {\
+                ACR_Timer_t timerEnd;\
+                ACR_Time_t timerDiff;\
+                ACR_Info_t timerComp;\
+                ACR_TIMER_START(timerEnd);\
+                ACR_TIMER_DIFF_MICRO(timerEnd, timer, timerDiff, timerComp);\
+                ACR_UNUSED(timerComp);\
+                total += timerDiff;\
+            }
+#else
+    #define ACR_HEAP_STATS_TIMER_START(timer)
+    #define ACR_HEAP_STATS_TIMER_ADD(timer, total)
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** get the index of the most significant bit that is set
+    \param value any value other than 0
+*/
+ACR_Count_t _ACR_HeapFindLastSet(
+    ACR_Length_t value);
+
+/** \see ACR_AllocatorCallbackAlloc_t
+*/
+void* _ACR_HeapAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr);
+
+/** \see ACR_AllocatorCallbackFree_t
+*/
+void _ACR_HeapAllocatorFree(
+    void* ptr,
+    void* userPtr);
+
+/** \see ACR_AllocatorCallbackRealloc_t
+*/
+void* _ACR_HeapAllocatorRealloc(
+    void* ptr,
+    ACR_Length_t bytes,
+    void* userPtr);
+
+/** get the index of the least significant bit that is set
+    \param value any value other than 0
+*/
+ACR_Count_t _ACR_HeapFindFirstSet(
+    ACR_Length_t value);
+
+/** round the number of bytes up to a valid block size
+    \param bytes the number of bytes requested
+    \param blockBytes stores the block size
+    \returns ACR_BOOL_TRUE if the block size is valid
+*/
+ACR_Bool_t _ACR_HeapBlockBytes(
+    ACR_Length_t bytes,
+    ACR_Length_t* blockBytes);
+
+/** get the free list that a block of this size is stored in
+*/
+void _ACR_HeapMappingInsert(
+    ACR_Length_t bytes,
+    ACR_Count_t* firstLevel,
+    ACR_Count_t* secondLevel);
+
+/** get the first free list where every block is at least this size
+    \returns ACR_BOOL_FALSE if the size is too large to be in any free list
+*/
+ACR_Bool_t _ACR_HeapMappingSearch(
+    ACR_Length_t bytes,
+    ACR_Count_t* firstLevel,
+    ACR_Count_t* secondLevel);
+
+/** add a freed header to its free list
+*/
+void _ACR_HeapInsertFree(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos);
+
+/** remove a freed header from its free list
+*/
+void _ACR_HeapRemoveFree(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos);
+
+/** get the unused bytes at the end of one region
+*/
+ACR_Length_t _ACR_HeapRegionAvailable(
+    ACR_HeapObj_t* me);
+
+/** get the largest block that one region could allocate
+*/
+ACR_Length_t _ACR_HeapRegionLargestFree(
+    ACR_HeapObj_t* me);
+
+/** get the pointer position within one region
+    \returns ACR_BOOL_TRUE if the pointer is within the region memory
+*/
+ACR_Bool_t _ACR_HeapRegionPointerPos(
+    ACR_HeapObj_t* me,
+    const void* ptr,
+    ACR_Length_t* pos);
+
+/** allocate from one region
+*/
+void* _ACR_HeapRegionAlloc(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes);
+
+/** allocate aligned memory from one region
+*/
+void* _ACR_HeapRegionAllocAligned(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Length_t alignment);
+
+/** free memory that is in this region
+    \returns the number of bytes that were allocated
+             or 0 if nothing was freed
+*/
+ACR_Length_t _ACR_HeapRegionFree(
+    ACR_HeapObj_t* me,
+    void* ptr);
+
+/** change the size of an allocation using the free memory around it
+    \param ptrPos position of the allocated memory in the region, which
+           is changed when the allocation moves into the free header before it
+    \param bytes valid block size from _ACR_HeapBlockBytes()
+    \returns ACR_BOOL_TRUE if the allocation now has at least this many bytes
+*/
+ACR_Bool_t _ACR_HeapRegionResize(
+    ACR_HeapObj_t* me,
+    ACR_Length_t* ptrPos,
+    ACR_Length_t bytes);
+
+/** get the number of bytes needed for a region with room for at least this many bytes
+    \param isLarge ACR_BOOL_TRUE for a region of a single large allocation
+           that is rounded up to ACR_CONFIG_HEAP_PAGE_SIZE
+    \param length stores the number of bytes
+    \returns ACR_BOOL_FALSE if too many bytes are requested
+*/
+ACR_Bool_t _ACR_HeapRegionLength(
+    ACR_Length_t bytes,
+    ACR_Bool_t isLarge,
+    ACR_Length_t* length);
+
+/** get a region from its m_RegionIndex
+    \returns the region or ACR_NULL if there is no region at this index
+*/
+ACR_HeapObj_t* _ACR_HeapRegionAt(
+    ACR_HeapObj_t* me,
+    ACR_Count_t index);
+
+/** allocate from the regions shared by small allocations
+    starting with the region that made the last allocation
+    and add a region if they are all full
+    \param alignment a power of two or ACR_HEAP_ALIGNMENT
+           when the allocation does not need more alignment
+*/
+void* _ACR_HeapSharedAlloc(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Length_t alignment);
+
+/** add a region with room for at least this many bytes
+    \param isLarge ACR_BOOL_TRUE for a region of a single large allocation
+    \returns the new region or ACR_NULL if the heap cannot grow
+*/
+ACR_HeapObj_t* _ACR_HeapAddRegion(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Bool_t isLarge);
+
+/** change the size of a large allocation by resizing its region
+    \param region the region, which has m_IsLarge set
+    \param ptrPos position of the allocated memory in the region, which
+           is changed if the allocation moves within the region
+    \param bytes valid block size from _ACR_HeapBlockBytes()
+    \returns the region, which may have moved, or ACR_NULL
+              if the allocation could not be resized
+*/
+ACR_HeapObj_t* _ACR_HeapResizeLargeRegion(
+    ACR_HeapObj_t* me,
+    ACR_HeapObj_t* region,
+    ACR_Length_t* ptrPos,
+    ACR_Length_t bytes);
+
+/** remove a region from the heap and give back its memory
+*/
+void _ACR_HeapRemoveRegion(
+    ACR_HeapObj_t* me,
+    ACR_HeapObj_t* region);
+
+/** merge a header that is no longer allocated with any free
+    neighbours and then either add it to its free list or
+    give it back to the unused memory at the end of the heap
+    \param headerPos position of a header that is counted
+           in m_HeaderCount but is not in any free list
+*/
+void _ACR_HeapReleaseBlock(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos);
+
+/** split the unneeded bytes at the end of an allocated
+    header into a new free header when there are enough
+    \param bytes the number of bytes the header must keep
+*/
+void _ACR_HeapSplitBlock(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos,
+    ACR_Length_t bytes);
+
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+
+/** count an allocation in the statistics of the heap
+    \param bytes the number of bytes requested
+    \param ptr the allocated memory or ACR_NULL if it failed
+*/
+void _ACR_HeapStatsAlloc(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    void* ptr);
+
+/** write one statistic to a file as a "name=value" line
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t _ACR_HeapWriteStat(
+    ACR_FileInterface_t* file,
+    const char* name,
+    ACR_Length_t value);
+
+#endif // #ifndef ACR_CONFIG_NO_HEAP_STATS
+
 ////////////////////////////////////////////////////////////
 //
 // PUBLIC FUNCTIONS
@@ -83,105 +347,1685 @@ void* ACR_GlobalHeapRealloc(
     return ACR_REALLOC(ptr, bytes);
 }
 
+/**********************************************************/
+void* ACR_GlobalHeapAllocAligned(
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
+{
+    return ACR_MALLOC_ALIGNED(bytes, alignment);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFreeAligned(
+    void* ptr)
+{
+    ACR_FREE_ALIGNED(ptr);
+}
+
 #endif // #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_FALSE
 
 #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
 
+#ifdef ACR_CONFIG_HEAP_MMAP
+
+#ifdef ACR_PLATFORM_WIN
+    // included for VirtualAlloc and VirtualFree
+    #include <windows.h>
+#else
+    // included for mmap and munmap
+    #include <sys/mman.h>
+    #ifndef MAP_ANONYMOUS
+        #define MAP_ANONYMOUS MAP_ANON
+    #endif
+    #ifndef MAP_NORESERVE
+        #define MAP_NORESERVE 0
+    #endif
+#endif
+
+/** \see ACR_HeapCallbackAcquireRegion_t
+    Note: pages are not backed by physical memory
+          until they are used
+*/
+void* _ACR_HeapMapRegion(
+    ACR_Length_t length)
+{
+#ifdef ACR_PLATFORM_WIN
+    return VirtualAlloc(ACR_NULL, (SIZE_T)length, (MEM_RESERVE | MEM_COMMIT), PAGE_READWRITE);
+#else
+    void* ptr = mmap(ACR_NULL, (size_t)length, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE), -1, 0);
+    return ((ptr != MAP_FAILED) ? ptr : ACR_NULL);
+#endif
+}
+
+/** \see ACR_HeapCallbackReleaseRegion_t
+*/
+void _ACR_HeapUnmapRegion(
+    void* ptr,
+    ACR_Length_t length)
+{
+#ifdef ACR_PLATFORM_WIN
+    ACR_UNUSED(length);
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, (size_t)length);
+#endif
+}
+
+#ifdef __linux__
+
+/** \see ACR_HeapCallbackResizeRegion_t
+    Note: pages are moved instead of copied
+*/
+void* _ACR_HeapRemapRegion(
+    void* ptr,
+    ACR_Length_t length,
+    ACR_Length_t newLength)
+{
+    void* newPtr = mremap(ptr, (size_t)length, (size_t)newLength, MREMAP_MAYMOVE);
+    return ((newPtr != MAP_FAILED) ? newPtr : ACR_NULL);
+}
+
+/** regions are resized by moving pages
+*/
+#define ACR_HEAP_RESIZE_REGION _ACR_HeapRemapRegion
+
+#else
+
+/** regions are copied to resize them
+*/
+#define ACR_HEAP_RESIZE_REGION ACR_NULL
+
+#endif
+
+/** global heap
+    Note: there is no memory until the first
+          allocation adds a region
+*/
+ACR_HeapObj_t g_ACR_Heap = {ACR_NULL, ACR_ZERO_LENGTH, 0, ACR_ZERO_COUNT, ACR_ZERO_COUNT, 0, 0, ACR_NULL, ACR_NULL, _ACR_HeapMapRegion, _ACR_HeapUnmapRegion, ACR_HEAP_RESIZE_REGION, ACR_BOOL_FALSE, 0, 0, {ACR_NULL}, 0, {ACR_FLAG_NONE}, {{0}}, {{0}} ACR_HEAP_STATS_INIT};
+
+#else
+
 /** global heap memory
+    Note: ACR_Block_t is used so that the memory
+          is aligned to ACR_HEAP_ALIGNMENT
 */
-ACR_Byte_t g_ACR_HeapMemory[ACR_CONFIG_HEAP_SIZE];
+ACR_Block_t g_ACR_HeapMemory[ACR_MIN_BLOCKS_NEEDED(ACR_CONFIG_HEAP_SIZE)];
 
 /** global heap
 */
-ACR_HeapObj_t g_ACR_Heap = {(ACR_Byte_t*)&g_ACR_HeapMemory, ACR_CONFIG_HEAP_SIZE, 0, ACR_ZERO_COUNT, ACR_ZERO_COUNT};
+ACR_HeapObj_t g_ACR_Heap = {(ACR_Byte_t*)g_ACR_HeapMemory, sizeof(g_ACR_HeapMemory), 0, ACR_ZERO_COUNT, ACR_ZERO_COUNT, 0, 0, ACR_NULL, ACR_NULL, ACR_NULL, ACR_NULL, ACR_NULL, ACR_BOOL_FALSE, 0, 0, {ACR_NULL}, 0, {ACR_FLAG_NONE}, {{0}}, {{0}} ACR_HEAP_STATS_INIT};
 
-/**********************************************************/
-void* ACR_GlobalHeapAlloc(
-    ACR_Length_t bytes)
+#endif // #ifdef ACR_CONFIG_HEAP_MMAP
+
+#ifdef ACR_CONFIG_HEAP_THREADS
+
+#ifdef ACR_PLATFORM_WIN
+    // included for SRWLOCK, FlsAlloc, and InterlockedExchangePointer
+    #include <windows.h>
+
+    /** lock for the global heap
+    */
+    SRWLOCK g_ACR_HeapLock = SRWLOCK_INIT;
+
+    #define ACR_HEAP_LOCK() AcquireSRWLockExclusive(&g_ACR_HeapLock)
+    #define ACR_HEAP_UNLOCK() ReleaseSRWLockExclusive(&g_ACR_HeapLock)
+#else
+    // included for pthread_mutex_t and pthread_key_t
+    #include <pthread.h>
+
+    /** lock for the global heap
+    */
+    pthread_mutex_t g_ACR_HeapLock = PTHREAD_MUTEX_INITIALIZER;
+
+    #define ACR_HEAP_LOCK() pthread_mutex_lock(&g_ACR_HeapLock)
+    #define ACR_HEAP_UNLOCK() pthread_mutex_unlock(&g_ACR_HeapLock)
+#endif
+
+#ifdef ACR_COMPILER_MSVC
+    /** replace the pointer at p with desired if it is still expected.
+        otherwise expected is set to the current pointer at p so that
+        the caller can try again, like __atomic_compare_exchange_n()
+        \returns ACR_BOOL_TRUE if the pointer was replaced
+    */
+    ACR_Bool_t _ACR_HeapAtomicCompareExchange(
+        PVOID volatile* p,
+        void** expected,
+        void* desired)
+    {
+        void* current = InterlockedCompareExchangePointer(p, desired, (*expected));
+        if(current == (*expected))
+        {
+            return ACR_BOOL_TRUE;
+        }
+        (*expected) = current;
+        return ACR_BOOL_FALSE;
+    }
+
+    #define ACR_HEAP_THREAD_LOCAL __declspec(thread)
+    #define ACR_HEAP_ATOMIC_LOAD(p) (*(p))
+    #define ACR_HEAP_ATOMIC_STORE(p, value) (*(p) = (value))
+    #define ACR_HEAP_ATOMIC_CAS(p, expected, desired) _ACR_HeapAtomicCompareExchange((PVOID volatile*)(p), (void**)&(expected), (desired))
+    #define ACR_HEAP_ATOMIC_TAKE(p) InterlockedExchangePointer((PVOID volatile*)(p), ACR_NULL)
+#else
+    #define ACR_HEAP_THREAD_LOCAL __thread
+    #define ACR_HEAP_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define ACR_HEAP_ATOMIC_STORE(p, value) __atomic_store_n((p), (value), __ATOMIC_RELAXED)
+    #define ACR_HEAP_ATOMIC_CAS(p, expected, desired) __atomic_compare_exchange_n((p), &(expected), (desired), 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+    #define ACR_HEAP_ATOMIC_TAKE(p) __atomic_exchange_n((p), ACR_NULL, __ATOMIC_ACQUIRE)
+#endif
+
+/** caches of threads that have ended
+    Note: only used while the global heap is locked
+*/
+ACR_HeapThreadCache_t* g_ACR_HeapOrphans = ACR_NULL;
+
+/** changed by ACR_GlobalHeapFreeAll() so that each
+    thread knows its cache is no longer valid
+*/
+ACR_Count_t g_ACR_HeapGeneration = ACR_ZERO_COUNT;
+
+/** the cache of this thread
+*/
+ACR_HEAP_THREAD_LOCAL ACR_HeapThreadCache_t* g_ACR_HeapThreadCache = ACR_NULL;
+
+/** the value of g_ACR_HeapGeneration when
+    g_ACR_HeapThreadCache was set
+*/
+ACR_HEAP_THREAD_LOCAL ACR_Count_t g_ACR_HeapThreadGeneration = ACR_ZERO_COUNT;
+
+/** give back the unused blocks of a cache to the global heap
+    \param me the cache
+    \param size the index of the block size
+    \param count the number of blocks to keep
+    Note: the global heap must be locked
+*/
+void _ACR_HeapThreadTrim(
+    ACR_HeapThreadCache_t* me,
+    ACR_Count_t size,
+    ACR_Count_t count)
 {
-    return ACR_HeapAlloc(&g_ACR_Heap, bytes);
+    while(me->m_FreeCount[size] > count)
+    {
+        ACR_HeapThreadPrefix_t* prefix = (ACR_HeapThreadPrefix_t*)me->m_FreeList[size];
+        me->m_FreeList[size] = (void*)prefix->m_Owner;
+        me->m_FreeCount[size]--;
+        ACR_HeapFree(&g_ACR_Heap, prefix);
+    }
 }
 
-/**********************************************************/
-void ACR_GlobalHeapFree(
-    void* ptr)
+/** move the blocks freed by other threads into the free lists of a cache
+    \param me the cache, which must be owned by this thread
+*/
+void _ACR_HeapThreadTakeRemote(
+    ACR_HeapThreadCache_t* me)
 {
-    ACR_HeapFree(&g_ACR_Heap, ptr);
+    ACR_HeapThreadPrefix_t* prefix = (ACR_HeapThreadPrefix_t*)ACR_HEAP_ATOMIC_TAKE(&me->m_RemoteList);
+    while(prefix)
+    {
+        ACR_HeapThreadPrefix_t* next = (ACR_HeapThreadPrefix_t*)prefix->m_Owner;
+        prefix->m_Owner = (ACR_HeapThreadCache_t*)me->m_FreeList[prefix->m_Value];
+        me->m_FreeList[prefix->m_Value] = prefix;
+        me->m_FreeCount[prefix->m_Value]++;
+        prefix = next;
+    }
 }
 
-/**********************************************************/
-void* ACR_GlobalHeapRealloc(
-    void* ptr,
-    ACR_Length_t bytes)
+/** give a block back to the cache that owns it from another thread
+    without locking
+*/
+void _ACR_HeapThreadGiveRemote(
+    ACR_HeapThreadCache_t* me,
+    ACR_HeapThreadPrefix_t* prefix)
 {
-    return ACR_HeapRealloc(&g_ACR_Heap, ptr, bytes);
+    void* head = ACR_HEAP_ATOMIC_LOAD(&me->m_RemoteList);
+    do
+    {
+        prefix->m_Owner = (ACR_HeapThreadCache_t*)head;
+    } while(ACR_HEAP_ATOMIC_CAS(&me->m_RemoteList, head, (void*)prefix) == 0);
 }
 
-/**********************************************************/
-void ACR_GlobalHeapFreeAll(void)
+/** called when a thread ends so that its cache can be used by another thread
+*/
+#ifdef ACR_PLATFORM_WIN
+VOID WINAPI _ACR_HeapThreadEnd(
+    PVOID ptr)
+#else
+void _ACR_HeapThreadEnd(
+    void* ptr)
+#endif
 {
-    ACR_HeapFreeAll(&g_ACR_Heap);
+    ACR_HeapThreadCache_t* me = (ACR_HeapThreadCache_t*)ptr;
+    ACR_Count_t size;
+    if(me == ACR_NULL)
+    {
+        // this thread never allocated anything
+        return;
+    }
+
+    ACR_HEAP_LOCK();
+    if(g_ACR_HeapThreadGeneration == ACR_HEAP_ATOMIC_LOAD(&g_ACR_HeapGeneration))
+    {
+        // the cache is only touched once it is known
+        // to still be memory of the global heap
+        _ACR_HeapThreadTakeRemote(me);
+        for(size = 0; size < ACR_HEAP_THREAD_CACHE_SIZES; size++)
+        {
+            _ACR_HeapThreadTrim(me, size, ACR_ZERO_COUNT);
+        }
+        ACR_HEAP_ATOMIC_STORE(&me->m_Orphan, ACR_BOOL_TRUE);
+        me->m_NextOrphan = g_ACR_HeapOrphans;
+        g_ACR_HeapOrphans = me;
+    }
+    else
+    {
+        // the cache was freed by ACR_GlobalHeapFreeAll()
+        // and its memory may now belong to another allocation
+    }
+    ACR_HEAP_UNLOCK();
+    g_ACR_HeapThreadCache = ACR_NULL;
 }
 
-#endif // #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
+#ifdef ACR_PLATFORM_WIN
+/** fiber local storage index used to call _ACR_HeapThreadEnd()
+    or FLS_OUT_OF_INDEXES before it is needed
+*/
+DWORD g_ACR_HeapThreadEndIndex = FLS_OUT_OF_INDEXES;
+#else
+/** key used to call _ACR_HeapThreadEnd()
+*/
+pthread_key_t g_ACR_HeapThreadEndKey;
 
-////////////////////////////////////////////////////////////
-//
-// PRIVATE FUNCTIONS
-//
-////////////////////////////////////////////////////////////
+/** ACR_BOOL_TRUE after g_ACR_HeapThreadEndKey is created
+*/
+ACR_Bool_t g_ACR_HeapThreadEndKeyCreated = ACR_BOOL_FALSE;
+#endif
 
-/**********************************************************/
-void ACR_HeapInit(
-	ACR_HeapObj_t* me,
-    void* ptr,
-    ACR_Length_t length)
+/** get the cache of this thread
+    \returns the cache or ACR_NULL if there is no memory for one
+*/
+ACR_HeapThreadCache_t* _ACR_HeapThreadCache(void)
 {
-    me->m_Heap = ptr;
-    me->m_HeapLength = length;
-    me->m_NextFreePos = 0;
-    me->m_HeaderCount = ACR_ZERO_COUNT;
-    me->m_FreeCount = ACR_ZERO_COUNT;
+    if((g_ACR_HeapThreadCache != ACR_NULL) &&
+       (g_ACR_HeapThreadGeneration == ACR_HEAP_ATOMIC_LOAD(&g_ACR_HeapGeneration)))
+    {
+        return g_ACR_HeapThreadCache;
+    }
+
+    ACR_HEAP_LOCK();
+    ACR_HeapThreadCache_t* cache = g_ACR_HeapOrphans;
+    if(cache)
+    {
+        // adopt the cache of a thread that has ended
+        g_ACR_HeapOrphans = cache->m_NextOrphan;
+        cache->m_NextOrphan = ACR_NULL;
+        ACR_HEAP_ATOMIC_STORE(&cache->m_Orphan, ACR_BOOL_FALSE);
+    }
+    else
+    {
+        cache = (ACR_HeapThreadCache_t*)ACR_HeapAlloc(&g_ACR_Heap, sizeof(ACR_HeapThreadCache_t));
+        if(cache)
+        {
+            ACR_MEMSET(cache, 0, sizeof(ACR_HeapThreadCache_t));
+        }
+    }
+#ifdef ACR_PLATFORM_WIN
+    if(g_ACR_HeapThreadEndIndex == FLS_OUT_OF_INDEXES)
+    {
+        g_ACR_HeapThreadEndIndex = FlsAlloc(_ACR_HeapThreadEnd);
+    }
+    if(g_ACR_HeapThreadEndIndex != FLS_OUT_OF_INDEXES)
+    {
+        FlsSetValue(g_ACR_HeapThreadEndIndex, cache);
+    }
+#else
+    if(g_ACR_HeapThreadEndKeyCreated == ACR_BOOL_FALSE)
+    {
+        g_ACR_HeapThreadEndKeyCreated = (pthread_key_create(&g_ACR_HeapThreadEndKey, _ACR_HeapThreadEnd) == 0);
+    }
+    if(g_ACR_HeapThreadEndKeyCreated)
+    {
+        pthread_setspecific(g_ACR_HeapThreadEndKey, cache);
+    }
+#endif
+    g_ACR_HeapThreadCache = cache;
+    g_ACR_HeapThreadGeneration = ACR_HEAP_ATOMIC_LOAD(&g_ACR_HeapGeneration);
+    ACR_HEAP_UNLOCK();
+    return cache;
 }
 
 /**********************************************************/
-void ACR_HeapDeInit(
-	ACR_HeapObj_t* me)
+void* ACR_GlobalHeapAlloc(
+    ACR_Length_t bytes)
 {
-    me->m_Heap = ACR_NULL;
-    me->m_HeapLength = ACR_ZERO_LENGTH;
-    me->m_NextFreePos = 0;
-    me->m_HeaderCount = ACR_ZERO_COUNT;
-    me->m_FreeCount = ACR_ZERO_COUNT;
+    ACR_HeapThreadPrefix_t* prefix = ACR_NULL;
+    ACR_HeapThreadCache_t* cache = ACR_NULL;
+    ACR_Count_t size = 0;
+    if(bytes <= ACR_CONFIG_HEAP_THREAD_CACHE_MAX)
+    {
+        cache = _ACR_HeapThreadCache();
+    }
+
+    if(cache)
+    {
+        if(bytes > ACR_HEAP_ALIGNMENT)
+        {
+            size = (ACR_Count_t)(((bytes + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) - 1);
+        }
+        if(cache->m_FreeList[size] == ACR_NULL)
+        {
+            // use blocks freed by other threads before
+            // locking to get more from the global heap
+            _ACR_HeapThreadTakeRemote(cache);
+        }
+        if(cache->m_FreeList[size] == ACR_NULL)
+        {
+            ACR_Length_t blockBytes = ((size + 1) * ACR_HEAP_ALIGNMENT) + ACR_HEAP_THREAD_PREFIX_SIZE;
+            ACR_Count_t i;
+            ACR_HEAP_LOCK();
+            for(i = 0; i < ACR_CONFIG_HEAP_THREAD_CACHE_BATCH; i++)
+            {
+                prefix = (ACR_HeapThreadPrefix_t*)ACR_HeapAlloc(&g_ACR_Heap, blockBytes);
+                if(prefix == ACR_NULL)
+                {
+                    break;
+                }
+                prefix->m_Owner = (ACR_HeapThreadCache_t*)cache->m_FreeList[size];
+                prefix->m_Value = size;
+                cache->m_FreeList[size] = prefix;
+                cache->m_FreeCount[size]++;
+            }
+            ACR_HEAP_UNLOCK();
+        }
+        prefix = (ACR_HeapThreadPrefix_t*)cache->m_FreeList[size];
+        if(prefix)
+        {
+            cache->m_FreeList[size] = (void*)prefix->m_Owner;
+            cache->m_FreeCount[size]--;
+            prefix->m_Owner = cache;
+        }
+        else
+        {
+            // the global heap is full
+        }
+    }
+    else if(bytes <= (ACR_MAX_LENGTH - ACR_HEAP_THREAD_PREFIX_SIZE))
+    {
+        // too large for the cache
+        ACR_HEAP_LOCK();
+        prefix = (ACR_HeapThreadPrefix_t*)ACR_HeapAlloc(&g_ACR_Heap, bytes + ACR_HEAP_THREAD_PREFIX_SIZE);
+        ACR_HEAP_UNLOCK();
+        if(prefix)
+        {
+            prefix->m_Owner = ACR_NULL;
+            prefix->m_Value = ACR_HEAP_THREAD_PREFIX_SIZE;
+        }
+    }
+    else
+    {
+        // too many bytes requested
+    }
+    return ((prefix != ACR_NULL) ? &((ACR_Byte_t*)prefix)[ACR_HEAP_THREAD_PREFIX_SIZE] : ACR_NULL);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFree(
+    void* ptr)
+{
+    ACR_HeapThreadPrefix_t* prefix;
+    if(ptr == ACR_NULL)
+    {
+        return;
+    }
+
+    prefix = (ACR_HeapThreadPrefix_t*)(((ACR_Byte_t*)ptr) - ACR_HEAP_THREAD_PREFIX_SIZE);
+    if(prefix->m_Owner == ACR_NULL)
+    {
+        // not from a cache
+        ACR_HEAP_LOCK();
+        ACR_HeapFree(&g_ACR_Heap, (((ACR_Byte_t*)ptr) - prefix->m_Value));
+        ACR_HEAP_UNLOCK();
+    }
+    else if(prefix->m_Owner == _ACR_HeapThreadCache())
+    {
+        ACR_HeapThreadCache_t* cache = prefix->m_Owner;
+        ACR_Count_t size = (ACR_Count_t)prefix->m_Value;
+        prefix->m_Owner = (ACR_HeapThreadCache_t*)cache->m_FreeList[size];
+        cache->m_FreeList[size] = prefix;
+        cache->m_FreeCount[size]++;
+        if(cache->m_FreeCount[size] > (2 * ACR_CONFIG_HEAP_THREAD_CACHE_BATCH))
+        {
+            // keep the cache from holding on
+            // to too much of the global heap
+            ACR_HEAP_LOCK();
+            _ACR_HeapThreadTrim(cache, size, ACR_CONFIG_HEAP_THREAD_CACHE_BATCH);
+            ACR_HEAP_UNLOCK();
+        }
+    }
+    else
+    {
+        // owned by the cache of another thread
+        ACR_HeapThreadCache_t* cache = prefix->m_Owner;
+        if(ACR_HEAP_ATOMIC_LOAD(&cache->m_Orphan))
+        {
+            // the thread has ended so the block
+            // is not needed by the cache
+            ACR_HEAP_LOCK();
+            if(cache->m_Orphan)
+            {
+                ACR_HeapFree(&g_ACR_Heap, prefix);
+                prefix = ACR_NULL;
+            }
+            ACR_HEAP_UNLOCK();
+        }
+        if(prefix)
+        {
+            _ACR_HeapThreadGiveRemote(cache, prefix);
+        }
+    }
+}
+
+/**********************************************************/
+void* ACR_GlobalHeapRealloc(
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    ACR_HeapThreadPrefix_t* prefix;
+    ACR_Length_t oldBytes;
+    void* newPtr;
+    if(ptr == ACR_NULL)
+    {
+        // same as a new allocation
+        return ACR_GlobalHeapAlloc(bytes);
+    }
+
+    prefix = (ACR_HeapThreadPrefix_t*)(((ACR_Byte_t*)ptr) - ACR_HEAP_THREAD_PREFIX_SIZE);
+    if(prefix->m_Owner != ACR_NULL)
+    {
+        oldBytes = ((prefix->m_Value + 1) * ACR_HEAP_ALIGNMENT);
+    }
+    else if((prefix->m_Value == ACR_HEAP_THREAD_PREFIX_SIZE) &&
+            (bytes > ACR_CONFIG_HEAP_THREAD_CACHE_MAX) &&
+            (bytes <= (ACR_MAX_LENGTH - ACR_HEAP_THREAD_PREFIX_SIZE)))
+    {
+        // stays too large for the cache
+        // so the heap can resize it directly
+        ACR_HEAP_LOCK();
+        newPtr = ACR_HeapRealloc(&g_ACR_Heap, prefix, bytes + ACR_HEAP_THREAD_PREFIX_SIZE);
+        ACR_HEAP_UNLOCK();
+        return ((newPtr != ACR_NULL) ? &((ACR_Byte_t*)newPtr)[ACR_HEAP_THREAD_PREFIX_SIZE] : ACR_NULL);
+    }
+    else
+    {
+        // the header before the heap allocation has its size
+        ACR_Byte_t* heapPtr = (((ACR_Byte_t*)ptr) - prefix->m_Value);
+        ACR_HEAP_LOCK();
+        oldBytes = (((ACR_HeapHeader_t*)(heapPtr - ACR_HEAP_HEADER_SIZE))->m_Bytes - prefix->m_Value);
+        ACR_HEAP_UNLOCK();
+    }
+
+    newPtr = ACR_GlobalHeapAlloc(bytes);
+    if(newPtr)
+    {
+        ACR_MEMCPY(newPtr, ptr, ((bytes < oldBytes) ? bytes : oldBytes));
+        ACR_GlobalHeapFree(ptr);
+    }
+    else
+    {
+        // failed to realloc
+    }
+    return newPtr;
+}
+
+/**********************************************************/
+void* ACR_GlobalHeapAllocAligned(
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
+{
+    ACR_Byte_t* heapPtr;
+    ACR_Length_t offset = alignment;
+    if(alignment <= ACR_HEAP_ALIGNMENT)
+    {
+        // every allocation is already aligned
+        return ACR_GlobalHeapAlloc(bytes);
+    }
+
+    // leave room for the prefix before the
+    // pointer without losing the alignment
+    while(offset < ACR_HEAP_THREAD_PREFIX_SIZE)
+    {
+        offset += alignment;
+    }
+    if(bytes > (ACR_MAX_LENGTH - offset))
+    {
+        // too many bytes requested
+        return ACR_NULL;
+    }
+    ACR_HEAP_LOCK();
+    heapPtr = (ACR_Byte_t*)ACR_HeapAllocAligned(&g_ACR_Heap, bytes + offset, alignment);
+    ACR_HEAP_UNLOCK();
+    if(heapPtr)
+    {
+        ACR_HeapThreadPrefix_t* prefix = (ACR_HeapThreadPrefix_t*)&heapPtr[offset - ACR_HEAP_THREAD_PREFIX_SIZE];
+        prefix->m_Owner = ACR_NULL;
+        prefix->m_Value = offset;
+        return &heapPtr[offset];
+    }
+    return ACR_NULL;
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFreeAligned(
+    void* ptr)
+{
+    ACR_GlobalHeapFree(ptr);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFreeAll(void)
+{
+    ACR_HEAP_LOCK();
+    ACR_HeapFreeAll(&g_ACR_Heap);
+
+    // every cache was in the heap memory
+    g_ACR_HeapOrphans = ACR_NULL;
+    // only changed while locked but read without the lock
+    ACR_HEAP_ATOMIC_STORE(&g_ACR_HeapGeneration, ACR_HEAP_ATOMIC_LOAD(&g_ACR_HeapGeneration) + 1);
+    ACR_HEAP_UNLOCK();
+}
+
+#else
+
+// only one thread uses the global heap
+#define ACR_HEAP_LOCK()
+#define ACR_HEAP_UNLOCK()
+
+/**********************************************************/
+void* ACR_GlobalHeapAlloc(
+    ACR_Length_t bytes)
+{
+    return ACR_HeapAlloc(&g_ACR_Heap, bytes);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFree(
+    void* ptr)
+{
+    ACR_HeapFree(&g_ACR_Heap, ptr);
+}
+
+/**********************************************************/
+void* ACR_GlobalHeapRealloc(
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    return ACR_HeapRealloc(&g_ACR_Heap, ptr, bytes);
+}
+
+/**********************************************************/
+void* ACR_GlobalHeapAllocAligned(
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
+{
+    return ACR_HeapAllocAligned(&g_ACR_Heap, bytes, alignment);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFreeAligned(
+    void* ptr)
+{
+    ACR_HeapFree(&g_ACR_Heap, ptr);
+}
+
+/**********************************************************/
+void ACR_GlobalHeapFreeAll(void)
+{
+    ACR_HeapFreeAll(&g_ACR_Heap);
+}
+
+#endif // #ifdef ACR_CONFIG_HEAP_THREADS
+
+/**********************************************************/
+ACR_Decimal_t ACR_GlobalHeapFragmentation(void)
+{
+    ACR_Decimal_t result;
+    ACR_HEAP_LOCK();
+    result = ACR_HeapFragmentation(&g_ACR_Heap);
+    ACR_HEAP_UNLOCK();
+    return result;
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_GlobalHeapGetStats(
+    ACR_HeapStats_t* stats)
+{
+    ACR_Bool_t result;
+    ACR_HEAP_LOCK();
+    result = ACR_HeapGetStats(&g_ACR_Heap, stats);
+    ACR_HEAP_UNLOCK();
+    return result;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_GlobalHeapWriteStats(
+    ACR_FileInterface_t* file)
+{
+    ACR_Info_t result;
+    ACR_HEAP_LOCK();
+    result = ACR_HeapWriteStats(&g_ACR_Heap, file);
+    ACR_HEAP_UNLOCK();
+    return result;
+}
+
+#endif // #if ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+
+/**********************************************************/
+void ACR_HeapInit(
+	ACR_HeapObj_t* me,
+    void* ptr,
+    ACR_Length_t length)
+{
+    // skip any bytes needed to align the start of the heap
+    ACR_Length_t skip = (ACR_Length_t)((ACR_HEAP_ALIGNMENT - ((ACR_PointerValue_t)ptr % ACR_HEAP_ALIGNMENT)) % ACR_HEAP_ALIGNMENT);
+    if((ptr != ACR_NULL) &&
+       (length > skip))
+    {
+        me->m_Heap = &((ACR_Byte_t*)ptr)[skip];
+        me->m_HeapLength = (length - skip);
+    }
+    else
+    {
+        // no memory available
+        me->m_Heap = ACR_NULL;
+        me->m_HeapLength = ACR_ZERO_LENGTH;
+    }
+    me->m_NextRegion = ACR_NULL;
+    me->m_PrevRegion = ACR_NULL;
+    me->m_AcquireRegion = ACR_NULL;
+    me->m_ReleaseRegion = ACR_NULL;
+    me->m_ResizeRegion = ACR_NULL;
+    me->m_IsLarge = ACR_BOOL_FALSE;
+    me->m_RegionIndex = 0;
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    ACR_MEMSET(&me->m_Stats, 0, sizeof(me->m_Stats));
+#endif
+    ACR_HeapFreeAll(me);
+}
+
+/**********************************************************/
+void ACR_HeapDeInit(
+	ACR_HeapObj_t* me)
+{
+    me->m_Heap = ACR_NULL;
+    me->m_HeapLength = ACR_ZERO_LENGTH;
+    ACR_HeapFreeAll(me);
+    me->m_AcquireRegion = ACR_NULL;
+    me->m_ReleaseRegion = ACR_NULL;
+    me->m_ResizeRegion = ACR_NULL;
+}
+
+/**********************************************************/
+void* ACR_HeapAlloc(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes)
+{
+    void* ptr = ACR_NULL;
+    ACR_HEAP_STATS_TIMER_START(timer);
+    if((bytes >= ACR_CONFIG_HEAP_LARGE_SIZE) &&
+       (me->m_AcquireRegion != ACR_NULL))
+    {
+        // large allocations get a region of their own
+        // instead of using memory shared with small ones
+        ACR_HeapObj_t* large = _ACR_HeapAddRegion(me, bytes, ACR_BOOL_TRUE);
+        if(large)
+        {
+            ptr = _ACR_HeapRegionAlloc(large, bytes);
+            large->m_IsLarge = ACR_BOOL_TRUE;
+            if(ptr == ACR_NULL)
+            {
+                _ACR_HeapRemoveRegion(me, large);
+            }
+        }
+    }
+
+    if(ptr == ACR_NULL)
+    {
+        ptr = _ACR_HeapSharedAlloc(me, bytes, ACR_HEAP_ALIGNMENT);
+    }
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    _ACR_HeapStatsAlloc(me, bytes, ptr);
+    ACR_HEAP_STATS_TIMER_ADD(timer, me->m_Stats.m_AllocMicro);
+#endif
+    return ptr;
+}
+
+/**********************************************************/
+void* ACR_HeapAllocAligned(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
+{
+    void* ptr;
+    ACR_HEAP_STATS_TIMER_START(timer);
+    ptr = _ACR_HeapSharedAlloc(me, bytes, alignment);
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    _ACR_HeapStatsAlloc(me, bytes, ptr);
+    ACR_HEAP_STATS_TIMER_ADD(timer, me->m_Stats.m_AllocMicro);
+#endif
+    return ptr;
+}
+
+/**********************************************************/
+void ACR_HeapFree(
+    ACR_HeapObj_t* me,
+    void* ptr)
+{
+    ACR_HEAP_STATS_TIMER_START(timer);
+    ACR_HeapObj_t* region = ACR_HeapPointerRegion(me, ptr, ACR_NULL);
+    if(region)
+    {
+        ACR_Length_t freedBytes = _ACR_HeapRegionFree(region, ptr);
+        if((region != me) &&
+           (region->m_HeaderCount == ACR_ZERO_COUNT))
+        {
+            // give the empty region back
+            _ACR_HeapRemoveRegion(me, region);
+        }
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+        if(freedBytes > 0)
+        {
+            me->m_Stats.m_LiveBytes -= freedBytes;
+            me->m_Stats.m_FreeCount++;
+            ACR_HEAP_STATS_TIMER_ADD(timer, me->m_Stats.m_FreeMicro);
+        }
+        else
+        {
+            // nothing was freed
+        }
+#else
+        ACR_UNUSED(freedBytes);
+#endif
+    }
+    else
+    {
+        // pointer is not in this heap
+    }
+}
+
+/**********************************************************/
+void* ACR_HeapRealloc(
+    ACR_HeapObj_t* me,
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    void* newPtr = ACR_NULL;
+    ACR_Length_t ptrPos;
+    ACR_HeapObj_t* region;
+    if(ptr == ACR_NULL)
+    {
+        // same as a new allocation
+        return ACR_HeapAlloc(me, bytes);
+    }
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    me->m_Stats.m_ReallocCount++;
+#endif
+
+    region = ACR_HeapPointerRegion(me, ptr, &ptrPos);
+    if((region != ACR_NULL) &&
+       (ptrPos <= region->m_NextFreePos))
+    {
+        ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&region->m_Heap[ptrPos - ACR_HEAP_HEADER_SIZE];
+        ACR_Length_t blockBytes;
+        if((ACR_HAS_FLAG(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED) == ACR_BOOL_FALSE) ||
+           (_ACR_HeapBlockBytes(bytes, &blockBytes) == ACR_BOOL_FALSE))
+        {
+            // not allocated or too many bytes requested
+        }
+        else
+        {
+            ACR_Length_t oldBytes = headerPtr->m_Bytes;
+            ACR_HeapObj_t* resized = ACR_NULL;
+            if(region->m_IsLarge == ACR_BOOL_FALSE)
+            {
+                if(_ACR_HeapRegionResize(region, &ptrPos, blockBytes))
+                {
+                    resized = region;
+                }
+                else
+                {
+                    // not enough room
+                }
+            }
+            else if(blockBytes >= ACR_CONFIG_HEAP_LARGE_SIZE)
+            {
+                // large allocations resize their region
+                resized = _ACR_HeapResizeLargeRegion(me, region, &ptrPos, blockBytes);
+            }
+            else
+            {
+                // no longer large enough for a region
+                // of its own so it is moved
+            }
+
+            if(resized)
+            {
+                // the region or the allocation may have moved
+                newPtr = &resized->m_Heap[ptrPos];
+                headerPtr = (ACR_HeapHeader_t*)&resized->m_Heap[ptrPos - ACR_HEAP_HEADER_SIZE];
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+                me->m_Stats.m_LiveBytes += headerPtr->m_Bytes;
+                me->m_Stats.m_LiveBytes -= oldBytes;
+                if(me->m_Stats.m_LiveBytes > me->m_Stats.m_PeakBytes)
+                {
+                    me->m_Stats.m_PeakBytes = me->m_Stats.m_LiveBytes;
+                }
+#endif
+            }
+            else
+            {
+                // could not resize in place so
+                // allocate like normal and copy
+                // the existing data to the new location
+                newPtr = ACR_HeapAlloc(me, blockBytes);
+                if(newPtr)
+                {
+                    ACR_MEMCPY(newPtr, ptr, ((oldBytes < blockBytes) ? oldBytes : blockBytes));
+                    ACR_HeapFree(me, ptr);
+                }
+                else
+                {
+                    // failed to realloc
+                }
+            }
+        }
+    }
+    else
+    {
+        // invalid pointer cannot
+        // be reallocated
+    }
+
+    return newPtr;
+}
+
+/**********************************************************/
+void ACR_HeapFreeAll(
+    ACR_HeapObj_t* me)
+{
+    // give back every region except the first
+    while(me->m_NextRegion)
+    {
+        _ACR_HeapRemoveRegion(me, me->m_NextRegion);
+    }
+    ACR_MEMSET(me->m_Regions, 0, sizeof(me->m_Regions));
+    me->m_AllocRegionIndex = 0;
+
+    me->m_NextFreePos = 0;
+    me->m_HeaderCount = ACR_ZERO_COUNT;
+    me->m_FreeCount = ACR_ZERO_COUNT;
+    me->m_FreeBytes = 0;
+    me->m_LastBytes = 0;
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    me->m_Stats.m_LiveBytes = 0;
+#endif
+
+    // empty all of the free lists
+    me->m_FirstLevel = 0;
+    ACR_MEMSET(me->m_SecondLevel, ACR_FLAG_NONE, sizeof(me->m_SecondLevel));
+}
+
+
+/**********************************************************/
+ACR_Length_t ACR_HeapAvailable(
+    ACR_HeapObj_t* me)
+{
+    ACR_Length_t result = 0;
+    ACR_HeapObj_t* region;
+    for(region = me; region != ACR_NULL; region = region->m_NextRegion)
+    {
+        ACR_Length_t available = (region->m_IsLarge ? 0 : _ACR_HeapRegionAvailable(region));
+        if(available > result)
+        {
+            result = available;
+        }
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_HeapLargestFree(
+    ACR_HeapObj_t* me)
+{
+    ACR_Length_t result = 0;
+    ACR_HeapObj_t* region;
+    for(region = me; region != ACR_NULL; region = region->m_NextRegion)
+    {
+        ACR_Length_t largest = (region->m_IsLarge ? 0 : _ACR_HeapRegionLargestFree(region));
+        if(largest > result)
+        {
+            result = largest;
+        }
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Decimal_t ACR_HeapFragmentation(
+    ACR_HeapObj_t* me)
+{
+    ACR_Decimal_t result = 0;
+    ACR_Length_t totalFree = 0;
+    ACR_HeapObj_t* region;
+    for(region = me; region != ACR_NULL; region = region->m_NextRegion)
+    {
+        if(region->m_IsLarge == ACR_BOOL_FALSE)
+        {
+            totalFree += (region->m_FreeBytes + _ACR_HeapRegionAvailable(region));
+        }
+        else
+        {
+            // the memory of large regions cannot be used by others
+        }
+    }
+    if(totalFree > 0)
+    {
+        result = (1 - ((ACR_Decimal_t)ACR_HeapLargestFree(me) / (ACR_Decimal_t)totalFree));
+    }
+    else
+    {
+        // no free memory at all is not fragmented
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_HeapPointerPos(
+    ACR_HeapObj_t* me,
+    const void* ptr,
+    ACR_Length_t* pos)
+{
+    return (ACR_HeapPointerRegion(me, ptr, pos) != ACR_NULL);
+}
+
+/**********************************************************/
+ACR_HeapObj_t* ACR_HeapPointerRegion(
+    ACR_HeapObj_t* me,
+    const void* ptr,
+    ACR_Length_t* pos)
+{
+    ACR_HeapObj_t* region = ACR_NULL;
+    if(_ACR_HeapRegionPointerPos(me, ptr, pos))
+    {
+        // in the original heap memory
+        region = me;
+    }
+    else if((me->m_NextRegion != ACR_NULL) &&
+            (ptr != ACR_NULL))
+    {
+        // the header before the pointer has the index of its region
+        ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)(((const ACR_Byte_t*)ptr) - ACR_HEAP_HEADER_SIZE);
+        if(headerPtr->m_RegionIndex == ACR_HEAP_LARGE_REGION)
+        {
+            // the region object is just before the
+            // only header in the memory of the region
+            region = (ACR_HeapObj_t*)(((ACR_Byte_t*)headerPtr) - ACR_HEAP_REGION_OBJECT_SIZE);
+            if(region->m_Heap != (ACR_Byte_t*)headerPtr)
+            {
+                region = ACR_NULL;
+            }
+        }
+        else if(headerPtr->m_RegionIndex > 0)
+        {
+            region = _ACR_HeapRegionAt(me, headerPtr->m_RegionIndex);
+        }
+        else
+        {
+            // the header is not in a region
+        }
+
+        if((region != ACR_NULL) &&
+           (_ACR_HeapRegionPointerPos(region, ptr, pos) == ACR_BOOL_FALSE))
+        {
+            // not a valid heap memory pointer
+            region = ACR_NULL;
+        }
+    }
+    else
+    {
+        // the heap has no other regions
+    }
+    return region;
+}
+
+/**********************************************************/
+void ACR_HeapSetRegionCallbacks(
+    ACR_HeapObj_t* me,
+    ACR_HeapCallbackAcquireRegion_t acquire,
+    ACR_HeapCallbackReleaseRegion_t release)
+{
+    me->m_AcquireRegion = acquire;
+    me->m_ReleaseRegion = release;
+}
+
+/**********************************************************/
+void ACR_HeapSetResizeRegionCallback(
+    ACR_HeapObj_t* me,
+    ACR_HeapCallbackResizeRegion_t resize)
+{
+    me->m_ResizeRegion = resize;
+}
+
+/**********************************************************/
+void ACR_HeapInitAllocator(
+    ACR_HeapObj_t* me,
+    ACR_AllocatorInterface_t* allocator)
+{
+    if(allocator != ACR_NULL)
+    {
+        allocator->m_Alloc = _ACR_HeapAllocatorAlloc;
+        allocator->m_Free = _ACR_HeapAllocatorFree;
+        allocator->m_Realloc = _ACR_HeapAllocatorRealloc;
+        allocator->m_User = me;
+    }
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_HeapGetStats(
+    ACR_HeapObj_t* me,
+    ACR_HeapStats_t* stats)
+{
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    (*stats) = me->m_Stats;
+    stats->m_LargestFree = ACR_HeapLargestFree(me);
+    stats->m_Fragmentation = ACR_HeapFragmentation(me);
+    return ACR_BOOL_TRUE;
+#else
+    ACR_UNUSED(me);
+    ACR_MEMSET(stats, 0, sizeof(ACR_HeapStats_t));
+    return ACR_BOOL_FALSE;
+#endif
+}
+
+/**********************************************************/
+void ACR_HeapResetStats(
+    ACR_HeapObj_t* me)
+{
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    ACR_Length_t liveBytes = me->m_Stats.m_LiveBytes;
+    ACR_MEMSET(&me->m_Stats, 0, sizeof(me->m_Stats));
+    me->m_Stats.m_LiveBytes = liveBytes;
+    me->m_Stats.m_PeakBytes = liveBytes;
+#else
+    ACR_UNUSED(me);
+#endif
+}
+
+/**********************************************************/
+ACR_Info_t ACR_HeapWriteStats(
+    ACR_HeapObj_t* me,
+    ACR_FileInterface_t* file)
+{
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+    ACR_Info_t result = ACR_INFO_OK;
+    ACR_HeapStats_t stats;
+    ACR_Count_t i;
+    if((file == ACR_NULL) ||
+       (file->m_Write == ACR_NULL))
+    {
+        // nowhere to write
+        return ACR_INFO_ERROR;
+    }
+
+    ACR_HeapGetStats(me, &stats);
+    const char* names[] = {"live_bytes", "peak_bytes", "alloc_count", "free_count",
+                           "realloc_count", "fail_count", "alloc_micro", "free_micro",
+                           "largest_free", "fragmentation_percent"};
+    ACR_Length_t values[] = {stats.m_LiveBytes, stats.m_PeakBytes, stats.m_AllocCount, stats.m_FreeCount,
+                             stats.m_ReallocCount, stats.m_FailCount, (ACR_Length_t)stats.m_AllocMicro, (ACR_Length_t)stats.m_FreeMicro,
+                             stats.m_LargestFree, (ACR_Length_t)(stats.m_Fragmentation * 100)};
+    for(i = 0; (i < (sizeof(values) / sizeof(values[0]))) && (result == ACR_INFO_OK); i++)
+    {
+        result = _ACR_HeapWriteStat(file, names[i], values[i]);
+    }
+    for(i = 0; (i < ACR_HEAP_STATS_SIZE_COUNT) && (result == ACR_INFO_OK); i++)
+    {
+        if(stats.m_SizeCount[i] > 0)
+        {
+            // name each size by the smallest
+            // number of bytes that it counts
+            char name[] = "size_2^00";
+            name[7] = (char)('0' + (i / 10));
+            name[8] = (char)('0' + (i % 10));
+            result = _ACR_HeapWriteStat(file, name, stats.m_SizeCount[i]);
+        }
+        else
+        {
+            // skip sizes that were never requested
+        }
+    }
+    return result;
+#else
+    ACR_UNUSED(me);
+    ACR_UNUSED(file);
+    return ACR_INFO_ERROR;
+#endif
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_HeapFindFree(
+    ACR_HeapObj_t* me,
+    ACR_Length_t minBytes,
+    ACR_Length_t* pos)
+{
+    ACR_Count_t firstLevel;
+    ACR_Count_t secondLevel;
+    if(_ACR_HeapMappingSearch(minBytes, &firstLevel, &secondLevel) == ACR_BOOL_FALSE)
+    {
+        // no free list has blocks this large
+        return ACR_BOOL_FALSE;
+    }
+
+    // check for a second level list in this first level
+    // list with blocks that are large enough
+    ACR_Length_t secondLevelMap = (me->m_SecondLevel[firstLevel] & (ACR_MAX_LENGTH << secondLevel));
+    if(secondLevelMap == 0)
+    {
+        // check for any larger first level list
+        ACR_Length_t firstLevelMap = (me->m_FirstLevel & (ACR_MAX_LENGTH << (firstLevel + 1)));
+        if(firstLevelMap == 0)
+        {
+            // no free memory with enough space
+            return ACR_BOOL_FALSE;
+        }
+        firstLevel = _ACR_HeapFindFirstSet(firstLevelMap);
+        secondLevelMap = me->m_SecondLevel[firstLevel];
+    }
+    secondLevel = _ACR_HeapFindFirstSet(secondLevelMap);
+
+    // every block in this list has enough space
+    // so the first one can be used
+    if(pos)
+    {
+        (*pos) = me->m_FreeList[firstLevel][secondLevel];
+    }
+    return ACR_BOOL_TRUE;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void* _ACR_HeapAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr)
+{
+    return ACR_HeapAlloc((ACR_HeapObj_t*)userPtr, bytes);
+}
+
+/**********************************************************/
+void _ACR_HeapAllocatorFree(
+    void* ptr,
+    void* userPtr)
+{
+    ACR_HeapFree((ACR_HeapObj_t*)userPtr, ptr);
+}
+
+/**********************************************************/
+void* _ACR_HeapAllocatorRealloc(
+    void* ptr,
+    ACR_Length_t bytes,
+    void* userPtr)
+{
+    return ACR_HeapRealloc((ACR_HeapObj_t*)userPtr, ptr, bytes);
+}
+
+/**********************************************************/
+ACR_Count_t _ACR_HeapFindLastSet(
+    ACR_Length_t value)
+{
+#if defined(ACR_COMPILER_GCC) || defined(ACR_COMPILER_CLANG)
+    #if ACR_USE_64BIT == ACR_BOOL_TRUE
+    return (ACR_Count_t)(63 - __builtin_clzll(value));
+    #else
+    return (ACR_Count_t)(31 - __builtin_clzl(value));
+    #endif
+#else
+    // binary search for the highest bit
+    ACR_Count_t result = 0;
+    ACR_Count_t shift = (sizeof(ACR_Length_t) * ACR_BITS_PER_BYTE) / 2;
+    while(shift > 0)
+    {
+        if((value >> shift) != 0)
+        {
+            value >>= shift;
+            result += shift;
+        }
+        shift /= 2;
+    }
+    return result;
+#endif
+}
+
+/**********************************************************/
+ACR_Count_t _ACR_HeapFindFirstSet(
+    ACR_Length_t value)
+{
+    // isolate the lowest bit so it is also the highest bit
+    return _ACR_HeapFindLastSet(value & (~value + 1));
+}
+
+/**********************************************************/
+ACR_Bool_t _ACR_HeapBlockBytes(
+    ACR_Length_t bytes,
+    ACR_Length_t* blockBytes)
+{
+    if(bytes > (ACR_MAX_LENGTH - ACR_HEAP_ALIGNMENT))
+    {
+        return ACR_BOOL_FALSE;
+    }
+
+    if(bytes < ACR_HEAP_MIN_BYTES)
+    {
+        // freed blocks must have room for the free list links
+        bytes = ACR_HEAP_MIN_BYTES;
+    }
+    (*blockBytes) = (((bytes + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT);
+    return ACR_BOOL_TRUE;
+}
+
+/**********************************************************/
+void _ACR_HeapMappingInsert(
+    ACR_Length_t bytes,
+    ACR_Count_t* firstLevel,
+    ACR_Count_t* secondLevel)
+{
+    if(bytes < ((ACR_Length_t)1 << ACR_HEAP_FIRST_LEVEL_SHIFT))
+    {
+        // small blocks are evenly divided into the first list
+        (*firstLevel) = 0;
+        (*secondLevel) = (ACR_Count_t)(bytes / (((ACR_Length_t)1 << ACR_HEAP_FIRST_LEVEL_SHIFT) / ACR_HEAP_SECOND_LEVEL_COUNT));
+    }
+    else
+    {
+        ACR_Count_t bit = _ACR_HeapFindLastSet(bytes);
+        if(bit >= ACR_CONFIG_HEAP_MAX_BLOCK_BITS)
+        {
+            // store blocks that are too large in the last list
+            (*firstLevel) = (ACR_HEAP_FIRST_LEVEL_COUNT - 1);
+            (*secondLevel) = (ACR_HEAP_SECOND_LEVEL_COUNT - 1);
+        }
+        else
+        {
+            // the bits just below the highest bit select the second level
+            (*secondLevel) = (ACR_Count_t)((bytes >> (bit - ACR_HEAP_SECOND_LEVEL_BITS)) ^ ACR_HEAP_SECOND_LEVEL_COUNT);
+            (*firstLevel) = (bit - (ACR_HEAP_FIRST_LEVEL_SHIFT - 1));
+        }
+    }
+}
+
+/**********************************************************/
+ACR_Bool_t _ACR_HeapMappingSearch(
+    ACR_Length_t bytes,
+    ACR_Count_t* firstLevel,
+    ACR_Count_t* secondLevel)
+{
+    if(bytes >= ((ACR_Length_t)1 << ACR_HEAP_FIRST_LEVEL_SHIFT))
+    {
+        // round up to the start of the next list so that
+        // any block in the list will be large enough
+        ACR_Length_t round = (((ACR_Length_t)1 << (_ACR_HeapFindLastSet(bytes) - ACR_HEAP_SECOND_LEVEL_BITS)) - 1);
+        if(bytes > (ACR_MAX_LENGTH - round))
+        {
+            return ACR_BOOL_FALSE;
+        }
+        bytes += round;
+        if(_ACR_HeapFindLastSet(bytes) >= ACR_CONFIG_HEAP_MAX_BLOCK_BITS)
+        {
+            return ACR_BOOL_FALSE;
+        }
+    }
+    _ACR_HeapMappingInsert(bytes, firstLevel, secondLevel);
+    return ACR_BOOL_TRUE;
+}
+
+/**********************************************************/
+void _ACR_HeapInsertFree(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos)
+{
+    ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+    ACR_HeapFreeLinks_t* linksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[headerPos + ACR_HEAP_HEADER_SIZE];
+    ACR_Count_t firstLevel;
+    ACR_Count_t secondLevel;
+    _ACR_HeapMappingInsert(headerPtr->m_Bytes, &firstLevel, &secondLevel);
+
+    // add to the front of the list
+    linksPtr->m_PrevPos = ACR_HEAP_NO_POS;
+    if(ACR_HAS_FLAG(me->m_SecondLevel[firstLevel], ACR_FLAG(secondLevel + 1)))
+    {
+        ACR_Length_t nextPos = me->m_FreeList[firstLevel][secondLevel];
+        ACR_HeapFreeLinks_t* nextLinksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[nextPos + ACR_HEAP_HEADER_SIZE];
+        nextLinksPtr->m_PrevPos = headerPos;
+        linksPtr->m_NextPos = nextPos;
+        if((me->m_FreeMax[firstLevel][secondLevel] != 0) &&
+           (headerPtr->m_Bytes > me->m_FreeMax[firstLevel][secondLevel]))
+        {
+            me->m_FreeMax[firstLevel][secondLevel] = headerPtr->m_Bytes;
+        }
+        else
+        {
+            // the largest block is unchanged or must be found again
+        }
+    }
+    else
+    {
+        // this list was empty
+        linksPtr->m_NextPos = ACR_HEAP_NO_POS;
+        me->m_FreeMax[firstLevel][secondLevel] = headerPtr->m_Bytes;
+        ACR_ADD_FLAGS(me->m_SecondLevel[firstLevel], ACR_FLAG(secondLevel + 1));
+        ACR_ADD_FLAGS(me->m_FirstLevel, ((ACR_Length_t)1 << firstLevel));
+    }
+    me->m_FreeList[firstLevel][secondLevel] = headerPos;
+}
+
+/**********************************************************/
+void _ACR_HeapRemoveFree(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos)
+{
+    ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+    ACR_HeapFreeLinks_t* linksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[headerPos + ACR_HEAP_HEADER_SIZE];
+    ACR_Count_t firstLevel;
+    ACR_Count_t secondLevel;
+    _ACR_HeapMappingInsert(headerPtr->m_Bytes, &firstLevel, &secondLevel);
+
+    if(headerPtr->m_Bytes == me->m_FreeMax[firstLevel][secondLevel])
+    {
+        // another block of the same size may be left
+        // so the largest is found again when it is read
+        me->m_FreeMax[firstLevel][secondLevel] = 0;
+    }
+
+    if(linksPtr->m_NextPos != ACR_HEAP_NO_POS)
+    {
+        ACR_HeapFreeLinks_t* nextLinksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[linksPtr->m_NextPos + ACR_HEAP_HEADER_SIZE];
+        nextLinksPtr->m_PrevPos = linksPtr->m_PrevPos;
+    }
+
+    if(linksPtr->m_PrevPos != ACR_HEAP_NO_POS)
+    {
+        ACR_HeapFreeLinks_t* prevLinksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[linksPtr->m_PrevPos + ACR_HEAP_HEADER_SIZE];
+        prevLinksPtr->m_NextPos = linksPtr->m_NextPos;
+    }
+    else
+    {
+        // this was the first in the list
+        me->m_FreeList[firstLevel][secondLevel] = linksPtr->m_NextPos;
+        if(linksPtr->m_NextPos == ACR_HEAP_NO_POS)
+        {
+            // the list is now empty
+            ACR_REMOVE_FLAGS(me->m_SecondLevel[firstLevel], ACR_FLAG(secondLevel + 1));
+            if(me->m_SecondLevel[firstLevel] == ACR_FLAG_NONE)
+            {
+                ACR_REMOVE_FLAGS(me->m_FirstLevel, ((ACR_Length_t)1 << firstLevel));
+            }
+        }
+    }
+}
+
+/**********************************************************/
+void _ACR_HeapReleaseBlock(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos)
+{
+    ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+    ACR_Length_t nextPos = (headerPos + ACR_HEAP_HEADER_SIZE + headerPtr->m_Bytes);
+
+    // merge with the next header when it is free
+    if(nextPos < me->m_NextFreePos)
+    {
+        ACR_HeapHeader_t* nextPtr = (ACR_HeapHeader_t*)&me->m_Heap[nextPos];
+        if(ACR_HAS_FLAG(nextPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED) == ACR_BOOL_FALSE)
+        {
+            _ACR_HeapRemoveFree(me, nextPos);
+            me->m_FreeCount--;
+            me->m_FreeBytes -= nextPtr->m_Bytes;
+            me->m_HeaderCount--;
+            headerPtr->m_Bytes += (ACR_HEAP_HEADER_SIZE + nextPtr->m_Bytes);
+            nextPos = (headerPos + ACR_HEAP_HEADER_SIZE + headerPtr->m_Bytes);
+        }
+        else
+        {
+            // next header is in use
+        }
+    }
+    else
+    {
+        // this is the last header
+    }
+
+    // merge with the previous header when it is free
+    if(headerPos > 0)
+    {
+        ACR_Length_t prevPos = (headerPos - ACR_HEAP_HEADER_SIZE - headerPtr->m_PrevBytes);
+        ACR_HeapHeader_t* prevPtr = (ACR_HeapHeader_t*)&me->m_Heap[prevPos];
+        if(ACR_HAS_FLAG(prevPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED) == ACR_BOOL_FALSE)
+        {
+            _ACR_HeapRemoveFree(me, prevPos);
+            me->m_FreeCount--;
+            me->m_FreeBytes -= prevPtr->m_Bytes;
+            me->m_HeaderCount--;
+            prevPtr->m_Bytes += (ACR_HEAP_HEADER_SIZE + headerPtr->m_Bytes);
+            headerPos = prevPos;
+            headerPtr = prevPtr;
+        }
+        else
+        {
+            // previous header is in use
+        }
+    }
+    else
+    {
+        // this is the first header
+    }
+
+    if(nextPos >= me->m_NextFreePos)
+    {
+        // give the memory back to the end of the heap
+        me->m_NextFreePos = headerPos;
+        me->m_HeaderCount--;
+        me->m_LastBytes = ((headerPos > 0) ? headerPtr->m_PrevBytes : 0);
+    }
+    else
+    {
+        // the next header must know the new size of this one
+        ACR_HeapHeader_t* nextPtr = (ACR_HeapHeader_t*)&me->m_Heap[nextPos];
+        nextPtr->m_PrevBytes = headerPtr->m_Bytes;
+        _ACR_HeapInsertFree(me, headerPos);
+        me->m_FreeCount++;
+        me->m_FreeBytes += headerPtr->m_Bytes;
+    }
+}
+
+/**********************************************************/
+void _ACR_HeapSplitBlock(
+    ACR_HeapObj_t* me,
+    ACR_Length_t headerPos,
+    ACR_Length_t bytes)
+{
+    ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+    if(headerPtr->m_Bytes >= (bytes + ACR_HEAP_HEADER_SIZE + ACR_HEAP_MIN_BYTES))
+    {
+        ACR_Length_t splitPos = (headerPos + ACR_HEAP_HEADER_SIZE + bytes);
+        ACR_HeapHeader_t* splitPtr = (ACR_HeapHeader_t*)&me->m_Heap[splitPos];
+        splitPtr->m_PrevBytes = bytes;
+        splitPtr->m_Bytes = (headerPtr->m_Bytes - bytes - ACR_HEAP_HEADER_SIZE);
+        splitPtr->m_Flags = ACR_HEAP_FLAG_HEADER;
+        splitPtr->m_RegionIndex = me->m_RegionIndex;
+        headerPtr->m_Bytes = bytes;
+        me->m_HeaderCount++;
+        if((splitPos + ACR_HEAP_HEADER_SIZE + splitPtr->m_Bytes) >= me->m_NextFreePos)
+        {
+            // the split header is now the last header
+            me->m_LastBytes = splitPtr->m_Bytes;
+        }
+        _ACR_HeapReleaseBlock(me, splitPos);
+    }
+    else
+    {
+        // not enough extra bytes to be worth a header
+    }
+}
+
+/**********************************************************/
+ACR_Length_t _ACR_HeapRegionAvailable(
+    ACR_HeapObj_t* me)
+{
+    ACR_Length_t result = 0;
+    if(me->m_HeapLength > ACR_HEAP_HEADER_SIZE)
+    {
+        ACR_Length_t maxHeapAvailable = (me->m_HeapLength - ACR_HEAP_HEADER_SIZE);
+        if(maxHeapAvailable > me->m_NextFreePos)
+        {
+            result = (maxHeapAvailable - me->m_NextFreePos);
+        }
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Length_t _ACR_HeapRegionLargestFree(
+    ACR_HeapObj_t* me)
+{
+    ACR_Length_t result = _ACR_HeapRegionAvailable(me);
+    if(me->m_FirstLevel != 0)
+    {
+        // the largest free block is in the highest list
+        ACR_Count_t firstLevel = _ACR_HeapFindLastSet(me->m_FirstLevel);
+        ACR_Count_t secondLevel = _ACR_HeapFindLastSet(me->m_SecondLevel[firstLevel]);
+        ACR_Length_t* maxPtr = &me->m_FreeMax[firstLevel][secondLevel];
+        if((*maxPtr) == 0)
+        {
+            // the largest block was removed so check
+            // each of the blocks that are left once
+            ACR_Length_t headerPos = me->m_FreeList[firstLevel][secondLevel];
+            while(headerPos != ACR_HEAP_NO_POS)
+            {
+                ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+                ACR_HeapFreeLinks_t* linksPtr = (ACR_HeapFreeLinks_t*)&me->m_Heap[headerPos + ACR_HEAP_HEADER_SIZE];
+                if(headerPtr->m_Bytes > (*maxPtr))
+                {
+                    (*maxPtr) = headerPtr->m_Bytes;
+                }
+                headerPos = linksPtr->m_NextPos;
+            }
+        }
+        if((*maxPtr) > result)
+        {
+            result = (*maxPtr);
+        }
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Bool_t _ACR_HeapRegionPointerPos(
+    ACR_HeapObj_t* me,
+    const void* ptr,
+    ACR_Length_t* pos)
+{
+    ACR_Bool_t result = ACR_BOOL_FALSE;
+    if(me->m_HeapLength > ACR_HEAP_HEADER_SIZE)
+    {
+        if(ptr)
+        {
+            ACR_PointerValue_t ptrAddr = (ACR_PointerValue_t)ptr;
+            ACR_PointerValue_t heapAddr = (ACR_PointerValue_t)me->m_Heap;
+            ACR_PointerValue_t minHeapAddr = (heapAddr + ACR_HEAP_HEADER_SIZE);
+            if(ptrAddr >= minHeapAddr)
+            {
+                ACR_PointerValue_t heapEndAddr = (heapAddr + me->m_HeapLength);
+                if(ptrAddr < heapEndAddr)
+                {
+                    if(pos)
+                    {
+                        (*pos) = (ACR_Length_t)(ptrAddr - heapAddr);
+                    }
+                    result = ACR_BOOL_TRUE;
+                }
+                else
+                {
+                    // pointer address is too high
+                }
+            }
+            else
+            {
+                // pointer address is too low
+            }
+        }
+        else
+        {
+            // null pointer
+        }
+    }
+    else
+    {
+        // no heap available
+    }
+    return result;
 }
 
 /**********************************************************/
-void* ACR_HeapAlloc(
+void* _ACR_HeapRegionAlloc(
     ACR_HeapObj_t* me,
     ACR_Length_t bytes)
 {
     void* ptr = ACR_NULL;
     ACR_Length_t headerPos;
+    if((me->m_IsLarge) ||
+       (_ACR_HeapBlockBytes(bytes, &bytes) == ACR_BOOL_FALSE))
+    {
+        // the region belongs to one large allocation
+        // or too many bytes requested
+        return ptr;
+    }
+
     if(ACR_HeapFindFree(me, bytes, &headerPos))
     {
         // found existing memory that can be reused
         ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+        _ACR_HeapRemoveFree(me, headerPos);
         ACR_ADD_FLAGS(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED);
         me->m_FreeCount--;
+        me->m_FreeBytes -= headerPtr->m_Bytes;
+        // give back any extra bytes
+        _ACR_HeapSplitBlock(me, headerPos, bytes);
         // get the new address
-        ptr = &me->m_Heap[headerPos + sizeof(ACR_HeapHeader_t)];
+        ptr = &me->m_Heap[headerPos + ACR_HEAP_HEADER_SIZE];
     }
     else
     {
         // must allocate more memory
-        ACR_Length_t available = ACR_HeapAvailable(me);
+        ACR_Length_t available = _ACR_HeapRegionAvailable(me);
         if(bytes <= available)
         {
             // store heap header data before the allocated memory
             ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[me->m_NextFreePos];
+            headerPtr->m_PrevBytes = me->m_LastBytes;
             headerPtr->m_Bytes = bytes;
-            ACR_ADD_FLAGS(headerPtr->m_Flags, ACR_HEAP_FLAG_HEADER | ACR_HEAP_FLAG_ALLOCATED);
-            me->m_NextFreePos += sizeof(ACR_HeapHeader_t);
+            headerPtr->m_Flags = (ACR_HEAP_FLAG_HEADER | ACR_HEAP_FLAG_ALLOCATED);
+            headerPtr->m_RegionIndex = me->m_RegionIndex;
+            me->m_LastBytes = bytes;
+            me->m_NextFreePos += ACR_HEAP_HEADER_SIZE;
             // get the new address and select the next free position
             ptr = &me->m_Heap[me->m_NextFreePos];
             me->m_NextFreePos += bytes;
@@ -192,21 +2036,111 @@ void* ACR_HeapAlloc(
 }
 
 /**********************************************************/
-void ACR_HeapFree(
+void* _ACR_HeapRegionAllocAligned(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
+{
+    void* ptr = ACR_NULL;
+    ACR_Length_t extraBytes = (alignment + ACR_HEAP_HEADER_SIZE + ACR_HEAP_MIN_BYTES);
+    if((me->m_IsLarge) ||
+       (alignment == 0) ||
+       ((alignment & (alignment - 1)) != 0))
+    {
+        // the region belongs to one large allocation
+        // or not a power of two
+        return ptr;
+    }
+
+    if(alignment <= ACR_HEAP_ALIGNMENT)
+    {
+        // every allocation is already aligned this much
+        return _ACR_HeapRegionAlloc(me, bytes);
+    }
+
+    if((_ACR_HeapBlockBytes(bytes, &bytes) == ACR_BOOL_FALSE) ||
+       (bytes > (ACR_MAX_LENGTH - extraBytes)))
+    {
+        // too many bytes requested
+        return ptr;
+    }
+
+    // allocate enough extra bytes to move the start of
+    // the allocation forward and free the skipped bytes
+    ptr = _ACR_HeapRegionAlloc(me, (bytes + extraBytes));
+    if(ptr)
+    {
+        ACR_Length_t headerPos = ((ACR_Length_t)((ACR_PointerValue_t)ptr - (ACR_PointerValue_t)me->m_Heap) - ACR_HEAP_HEADER_SIZE);
+        ACR_Length_t skip = (ACR_Length_t)((alignment - ((ACR_PointerValue_t)ptr % alignment)) % alignment);
+        if(skip != 0)
+        {
+            ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+            ACR_HeapHeader_t* alignedPtr;
+            ACR_Length_t alignedPos;
+            ACR_Length_t nextPos;
+            while(skip < (ACR_HEAP_HEADER_SIZE + ACR_HEAP_MIN_BYTES))
+            {
+                // the skipped bytes must be large enough to free
+                skip += alignment;
+            }
+
+            // move the header forward
+            alignedPos = (headerPos + skip);
+            alignedPtr = (ACR_HeapHeader_t*)&me->m_Heap[alignedPos];
+            alignedPtr->m_PrevBytes = (skip - ACR_HEAP_HEADER_SIZE);
+            alignedPtr->m_Bytes = (headerPtr->m_Bytes - skip);
+            alignedPtr->m_Flags = (ACR_HEAP_FLAG_HEADER | ACR_HEAP_FLAG_ALLOCATED);
+            alignedPtr->m_RegionIndex = me->m_RegionIndex;
+            me->m_HeaderCount++;
+            nextPos = (alignedPos + ACR_HEAP_HEADER_SIZE + alignedPtr->m_Bytes);
+            if(nextPos < me->m_NextFreePos)
+            {
+                ACR_HeapHeader_t* nextPtr = (ACR_HeapHeader_t*)&me->m_Heap[nextPos];
+                nextPtr->m_PrevBytes = alignedPtr->m_Bytes;
+            }
+            else
+            {
+                // the moved header is now the last header
+                me->m_LastBytes = alignedPtr->m_Bytes;
+            }
+
+            // free the skipped bytes
+            headerPtr->m_Bytes = (skip - ACR_HEAP_HEADER_SIZE);
+            ACR_REMOVE_FLAGS(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED);
+            _ACR_HeapReleaseBlock(me, headerPos);
+            headerPos = alignedPos;
+        }
+        else
+        {
+            // already aligned
+        }
+
+        // give back any extra bytes at the end
+        _ACR_HeapSplitBlock(me, headerPos, bytes);
+        ptr = &me->m_Heap[headerPos + ACR_HEAP_HEADER_SIZE];
+    }
+    return ptr;
+}
+
+/**********************************************************/
+ACR_Length_t _ACR_HeapRegionFree(
     ACR_HeapObj_t* me,
     void* ptr)
 {
+    ACR_Length_t freedBytes = 0;
     ACR_Length_t ptrPos;
-    if(ACR_HeapPointerPos(me, ptr, &ptrPos))
+    if(_ACR_HeapRegionPointerPos(me, ptr, &ptrPos) &&
+       (ptrPos <= me->m_NextFreePos))
     {
-        ACR_Length_t headerPos = (ptrPos - sizeof(ACR_HeapHeader_t));
+        ACR_Length_t headerPos = (ptrPos - ACR_HEAP_HEADER_SIZE);
         ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
         if(ACR_HAS_FLAG(headerPtr->m_Flags, ACR_HEAP_FLAG_HEADER))
         {
             if(ACR_HAS_FLAG(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED))
             {
+                freedBytes = headerPtr->m_Bytes;
                 ACR_REMOVE_FLAGS(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED);
-                me->m_FreeCount++;
+                _ACR_HeapReleaseBlock(me, headerPos);
             }
             else
             {
@@ -220,177 +2154,476 @@ void ACR_HeapFree(
     }
     else
     {
-        // pointer is not in this heap
+        // pointer is not in this region
     }
+    return freedBytes;
 }
 
 /**********************************************************/
-void* ACR_HeapRealloc(
+ACR_Bool_t _ACR_HeapRegionResize(
     ACR_HeapObj_t* me,
-    void* ptr,
+    ACR_Length_t* ptrPos,
     ACR_Length_t bytes)
 {
-    void* newPtr = ACR_NULL;
-    ACR_Length_t ptrPos;
-    if(ACR_HeapPointerPos(me, ptr, &ptrPos))
+    ACR_Length_t headerPos = ((*ptrPos) - ACR_HEAP_HEADER_SIZE);
+    ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
+    ACR_Length_t dataBytes = headerPtr->m_Bytes;
+    ACR_Length_t nextPos = ((*ptrPos) + headerPtr->m_Bytes);
+    ACR_Length_t endPos = nextPos;
+    ACR_Length_t room = headerPtr->m_Bytes;
+    ACR_HeapHeader_t* nextPtr = ACR_NULL;
+    ACR_Length_t prevPos = 0;
+    ACR_HeapHeader_t* prevPtr = ACR_NULL;
+    ACR_Bool_t isLast;
+    if(bytes <= headerPtr->m_Bytes)
     {
-        ACR_Length_t headerPos = (ptrPos - sizeof(ACR_HeapHeader_t));
-        ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[headerPos];
-        if(bytes <= headerPtr->m_Bytes)
+        // plenty of space already allocated
+        // so give back any extra bytes
+        _ACR_HeapSplitBlock(me, headerPos, bytes);
+        return ACR_BOOL_TRUE;
+    }
+
+    // find all of the free memory around the
+    // allocation before changing anything
+    if(nextPos < me->m_NextFreePos)
+    {
+        ACR_HeapHeader_t* followingPtr = (ACR_HeapHeader_t*)&me->m_Heap[nextPos];
+        if(ACR_HAS_FLAG(followingPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED) == ACR_BOOL_FALSE)
         {
-            // plenty of space already allocated
-            newPtr = ptr;
+            // grow into the next header
+            nextPtr = followingPtr;
+            room += (ACR_HEAP_HEADER_SIZE + nextPtr->m_Bytes);
+            endPos += (ACR_HEAP_HEADER_SIZE + nextPtr->m_Bytes);
         }
         else
         {
-            // this is a very rudimentary heap so there is no way
-            // to realloc anything larger than currently allocated.
-            // in theory, a search could be performed to see if
-            // the next N headers were free and could be merged
-            // into the requested reallocation. But, instead,
-            // just try to allocate like normal and copy
-            // the existing data to the new location
-            newPtr = ACR_HeapAlloc(me, bytes);
-            if(newPtr)
-            {
-                ACR_MEMCPY(newPtr, ptr, headerPtr->m_Bytes);
-                ACR_HeapFree(me, ptr);
-            }
-            else
-            {
-                // failed to realloc
-            }
+            // next header is in use
         }
     }
     else
     {
-        // invalid pointer cannot
-        // be reallocated
+        // this is the last header
+    }
+    isLast = (endPos >= me->m_NextFreePos);
+    if(isLast)
+    {
+        // the unused memory at the end of the region can also be used
+        room += _ACR_HeapRegionAvailable(me);
+    }
+    if((room < bytes) &&
+       (headerPos > 0))
+    {
+        ACR_HeapHeader_t* beforePtr;
+        prevPos = (headerPos - ACR_HEAP_HEADER_SIZE - headerPtr->m_PrevBytes);
+        beforePtr = (ACR_HeapHeader_t*)&me->m_Heap[prevPos];
+        if(ACR_HAS_FLAG(beforePtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED) == ACR_BOOL_FALSE)
+        {
+            // the allocation must move to the
+            // previous header to use its memory
+            prevPtr = beforePtr;
+            room += (ACR_HEAP_HEADER_SIZE + prevPtr->m_Bytes);
+        }
+        else
+        {
+            // previous header is in use
+        }
+    }
+    if(room < bytes)
+    {
+        // not enough free memory around the allocation
+        return ACR_BOOL_FALSE;
     }
 
-    return newPtr;
+    if(nextPtr)
+    {
+        _ACR_HeapRemoveFree(me, nextPos);
+        me->m_FreeCount--;
+        me->m_FreeBytes -= nextPtr->m_Bytes;
+        me->m_HeaderCount--;
+        headerPtr->m_Bytes += (ACR_HEAP_HEADER_SIZE + nextPtr->m_Bytes);
+    }
+    if(prevPtr)
+    {
+        // merge into the previous header and move
+        // the data to its new position only once
+        _ACR_HeapRemoveFree(me, prevPos);
+        me->m_FreeCount--;
+        me->m_FreeBytes -= prevPtr->m_Bytes;
+        me->m_HeaderCount--;
+        prevPtr->m_Bytes += (ACR_HEAP_HEADER_SIZE + headerPtr->m_Bytes);
+        ACR_ADD_FLAGS(prevPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED);
+        ACR_MEMMOVE(&me->m_Heap[prevPos + ACR_HEAP_HEADER_SIZE], &me->m_Heap[*ptrPos], dataBytes);
+        headerPos = prevPos;
+        headerPtr = prevPtr;
+        (*ptrPos) = (prevPos + ACR_HEAP_HEADER_SIZE);
+    }
+
+    if(isLast)
+    {
+        if(headerPtr->m_Bytes < bytes)
+        {
+            // grow into the unused memory
+            headerPtr->m_Bytes = bytes;
+        }
+        me->m_NextFreePos = ((*ptrPos) + headerPtr->m_Bytes);
+        me->m_LastBytes = headerPtr->m_Bytes;
+    }
+    else
+    {
+        // the next header must know the new size of this one
+        ACR_HeapHeader_t* followingPtr = (ACR_HeapHeader_t*)&me->m_Heap[(*ptrPos) + headerPtr->m_Bytes];
+        followingPtr->m_PrevBytes = headerPtr->m_Bytes;
+    }
+    _ACR_HeapSplitBlock(me, headerPos, bytes);
+    return ACR_BOOL_TRUE;
 }
 
 /**********************************************************/
-void ACR_HeapFreeAll(
-    ACR_HeapObj_t* me)
+ACR_Bool_t _ACR_HeapRegionLength(
+    ACR_Length_t bytes,
+    ACR_Bool_t isLarge,
+    ACR_Length_t* length)
 {
-    me->m_NextFreePos = 0;
-    me->m_HeaderCount = ACR_ZERO_COUNT;
-    me->m_FreeCount = ACR_ZERO_COUNT;
+    ACR_Length_t overhead = (sizeof(ACR_HeapObj_t) + ACR_HEAP_ALIGNMENT + (2 * ACR_HEAP_HEADER_SIZE) + ACR_HEAP_MIN_BYTES);
+    if(bytes > (ACR_MAX_LENGTH - overhead - ACR_CONFIG_HEAP_PAGE_SIZE))
+    {
+        // too many bytes requested
+        return ACR_BOOL_FALSE;
+    }
+
+    (*length) = (bytes + overhead);
+    if(isLarge)
+    {
+        // whole pages so that all of the memory is used
+        (*length) = ((((*length) + ACR_CONFIG_HEAP_PAGE_SIZE - 1) / ACR_CONFIG_HEAP_PAGE_SIZE) * ACR_CONFIG_HEAP_PAGE_SIZE);
+    }
+    else if((*length) < ACR_CONFIG_HEAP_REGION_SIZE)
+    {
+        // small allocations share a region
+        (*length) = ACR_CONFIG_HEAP_REGION_SIZE;
+    }
+    else
+    {
+        // allocations larger than a region get a region of their own
+    }
+    return ACR_BOOL_TRUE;
 }
 
 /**********************************************************/
-ACR_Length_t ACR_HeapAvailable(
-    ACR_HeapObj_t* me)
+ACR_HeapObj_t* _ACR_HeapRegionAt(
+    ACR_HeapObj_t* me,
+    ACR_Count_t index)
 {
-    ACR_Length_t result = 0;
-    ACR_Length_t maxHeapAvailable = (me->m_HeapLength - sizeof(ACR_HeapHeader_t));
-    if(maxHeapAvailable > me->m_NextFreePos)
+    if(index == 0)
     {
-        result = (maxHeapAvailable - me->m_NextFreePos);
+        // the first ACR_HeapObj_t
+        return me;
     }
-    return result;
+    if(index <= ACR_CONFIG_HEAP_MAX_REGIONS)
+    {
+        return me->m_Regions[index - 1];
+    }
+    return ACR_NULL;
 }
 
 /**********************************************************/
-ACR_Bool_t ACR_HeapPointerPos(
+void* _ACR_HeapSharedAlloc(
     ACR_HeapObj_t* me,
-    const void* ptr,
-    ACR_Length_t* pos)
+    ACR_Length_t bytes,
+    ACR_Length_t alignment)
 {
-    ACR_Bool_t result = ACR_BOOL_FALSE;
-    if(me->m_HeapLength > sizeof(ACR_HeapHeader_t))
+    void* ptr = ACR_NULL;
+    ACR_HeapObj_t* region = _ACR_HeapRegionAt(me, me->m_AllocRegionIndex);
+    ACR_Count_t index;
+    if(region)
     {
-        if(ptr)
+        ptr = _ACR_HeapRegionAllocAligned(region, bytes, alignment);
+    }
+
+    for(index = 0; (ptr == ACR_NULL) && (index <= ACR_CONFIG_HEAP_MAX_REGIONS); index++)
+    {
+        region = _ACR_HeapRegionAt(me, index);
+        if((region != ACR_NULL) &&
+           (index != me->m_AllocRegionIndex))
         {
-            ACR_PointerValue_t ptrAddr = (ACR_PointerValue_t)ptr;
-            ACR_PointerValue_t heapAddr = (ACR_PointerValue_t)me->m_Heap;
-            ACR_PointerValue_t minHeapAddr = (heapAddr + sizeof(ACR_HeapHeader_t));
-            if(ptrAddr >= minHeapAddr)
+            ptr = _ACR_HeapRegionAllocAligned(region, bytes, alignment);
+        }
+    }
+
+    if((ptr == ACR_NULL) &&
+       (bytes <= (ACR_MAX_LENGTH - alignment)))
+    {
+        // every region is full so try to add
+        // one with enough room to align
+        region = _ACR_HeapAddRegion(me, (bytes + alignment), ACR_BOOL_FALSE);
+        if(region)
+        {
+            ptr = _ACR_HeapRegionAllocAligned(region, bytes, alignment);
+            if(ptr == ACR_NULL)
             {
-                ACR_PointerValue_t heapEndAddr = (heapAddr + me->m_HeapLength);
-                if(ptrAddr < heapEndAddr)
-                {
-                    if(pos)
-                    {
-                        (*pos) = (ACR_Length_t)(ptrAddr - heapAddr);
-                    }
-                    result = ACR_BOOL_TRUE;
-                }
-                else
-                {
-                    // pointer address is too high
-                }
+                _ACR_HeapRemoveRegion(me, region);
+            }
+        }
+    }
+
+    if(ptr)
+    {
+        // the next allocation tries this region first
+        me->m_AllocRegionIndex = region->m_RegionIndex;
+    }
+    return ptr;
+}
+
+/**********************************************************/
+ACR_HeapObj_t* _ACR_HeapAddRegion(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    ACR_Bool_t isLarge)
+{
+    ACR_HeapObj_t* region = ACR_NULL;
+    ACR_Length_t length;
+    ACR_Length_t grownLength = ACR_CONFIG_HEAP_REGION_SIZE;
+    ACR_Count_t index = 0;
+    ACR_Count_t i;
+    if((me->m_AcquireRegion == ACR_NULL) ||
+       (_ACR_HeapRegionLength(bytes, isLarge, &length) == ACR_BOOL_FALSE))
+    {
+        // this heap cannot grow or too many bytes requested
+        return region;
+    }
+
+    if(isLarge == ACR_BOOL_FALSE)
+    {
+        // find the lowest unused index and double
+        // the region size for each index in use
+        for(i = ACR_CONFIG_HEAP_MAX_REGIONS; i > 0; i--)
+        {
+            if(me->m_Regions[i - 1] == ACR_NULL)
+            {
+                index = i;
+            }
+            else if(grownLength <= (ACR_MAX_LENGTH / 2))
+            {
+                grownLength *= 2;
             }
             else
             {
-                // pointer address is too low
+                // the region size cannot grow any more
+            }
+        }
+        if(index == 0)
+        {
+            // every index is in use
+            return region;
+        }
+        if(grownLength > length)
+        {
+            region = (ACR_HeapObj_t*)me->m_AcquireRegion(grownLength);
+            if(region)
+            {
+                length = grownLength;
             }
         }
+    }
+
+    if(region == ACR_NULL)
+    {
+        // only get the memory that is needed
+        region = (ACR_HeapObj_t*)me->m_AcquireRegion(length);
+    }
+    if(region)
+    {
+        // the region object is stored at the start
+        // of the region and followed by its memory
+        ACR_HeapInit(region, &((ACR_Byte_t*)region)[ACR_HEAP_REGION_OBJECT_SIZE], (length - ACR_HEAP_REGION_OBJECT_SIZE));
+        region->m_PrevRegion = me;
+        region->m_NextRegion = me->m_NextRegion;
+        if(me->m_NextRegion)
+        {
+            me->m_NextRegion->m_PrevRegion = region;
+        }
+        me->m_NextRegion = region;
+        if(isLarge)
+        {
+            region->m_RegionIndex = ACR_HEAP_LARGE_REGION;
+        }
         else
         {
-            // null pointer
+            region->m_RegionIndex = (ACR_Byte_t)index;
+            me->m_Regions[index - 1] = region;
         }
     }
+    return region;
+}
+
+/**********************************************************/
+ACR_HeapObj_t* _ACR_HeapResizeLargeRegion(
+    ACR_HeapObj_t* me,
+    ACR_HeapObj_t* region,
+    ACR_Length_t* ptrPos,
+    ACR_Length_t bytes)
+{
+    ACR_HeapObj_t* resized;
+    ACR_Length_t skip = (ACR_Length_t)((ACR_PointerValue_t)region->m_Heap - (ACR_PointerValue_t)region);
+    ACR_Length_t length = (skip + region->m_HeapLength);
+    ACR_Length_t newLength;
+    if((me->m_ResizeRegion == ACR_NULL) ||
+       (_ACR_HeapRegionLength(bytes, ACR_BOOL_TRUE, &newLength) == ACR_BOOL_FALSE) ||
+       (newLength == length))
+    {
+        // the region cannot change size so
+        // only the memory it already has is used
+        return (_ACR_HeapRegionResize(region, ptrPos, bytes) ? region : ACR_NULL);
+    }
+
+    if(newLength < length)
+    {
+        // make the allocation smaller first so
+        // that it fits in the smaller region
+        _ACR_HeapRegionResize(region, ptrPos, bytes);
+    }
     else
     {
-        // no heap available
+        // the region grows before the allocation
     }
-    return result;
+
+    resized = (ACR_HeapObj_t*)me->m_ResizeRegion(region, length, newLength);
+    if(resized == ACR_NULL)
+    {
+        // the region keeps its size
+        return (_ACR_HeapRegionResize(region, ptrPos, bytes) ? region : ACR_NULL);
+    }
+
+    // the region may have moved so its
+    // neighbours must link to its new location
+    resized->m_PrevRegion->m_NextRegion = resized;
+    if(resized->m_NextRegion)
+    {
+        resized->m_NextRegion->m_PrevRegion = resized;
+    }
+    resized->m_Heap = &((ACR_Byte_t*)resized)[skip];
+    resized->m_HeapLength = (newLength - skip);
+    _ACR_HeapRegionResize(resized, ptrPos, bytes);
+    return resized;
 }
 
 /**********************************************************/
-ACR_Bool_t ACR_HeapFindFree(
+void _ACR_HeapRemoveRegion(
     ACR_HeapObj_t* me,
-    ACR_Length_t minBytes,
-    ACR_Length_t* pos)
+    ACR_HeapObj_t* region)
 {
-    ACR_Bool_t result = ACR_BOOL_FALSE;
-    ACR_Length_t heapPos = 0;
-    ACR_Count_t currentHeader = 0;
-    ACR_Count_t freeFound = 0;
-    while((currentHeader < me->m_HeaderCount) &&
-          (freeFound < me->m_FreeCount))
+    ACR_HeapObj_t* prev = region->m_PrevRegion;
+    if((region != me) &&
+       (prev != ACR_NULL))
     {
-        ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)&me->m_Heap[heapPos];
-        if(ACR_HAS_FLAG(headerPtr->m_Flags, ACR_HEAP_FLAG_HEADER))
+        // the region memory ends where its heap memory ends
+        ACR_Length_t length = (ACR_Length_t)(((ACR_PointerValue_t)region->m_Heap + region->m_HeapLength) - (ACR_PointerValue_t)region);
+        prev->m_NextRegion = region->m_NextRegion;
+        if(region->m_NextRegion)
         {
-            if(ACR_HAS_FLAG(headerPtr->m_Flags, ACR_HEAP_FLAG_ALLOCATED))
-            {
-                // this memory is in use.
-                heapPos += headerPtr->m_Bytes;
-            }
-            else
-            {
-                freeFound++;
-                if(headerPtr->m_Bytes >= minBytes)
-                {
-                    // found free memory with enough space
-                    // break out of this loop
-                    result = ACR_BOOL_TRUE;
-                    if(pos)
-                    {
-                        (*pos) = heapPos;
-                    }
-                    break;
-                }
-                else
-                {
-                    // this memory is too small
-                    heapPos += headerPtr->m_Bytes;
-                }
-            }
+            region->m_NextRegion->m_PrevRegion = prev;
+        }
+        if(region->m_RegionIndex != ACR_HEAP_LARGE_REGION)
+        {
+            me->m_Regions[region->m_RegionIndex - 1] = ACR_NULL;
+        }
+        if(me->m_AllocRegionIndex == region->m_RegionIndex)
+        {
+            // the next allocation starts with the first region
+            me->m_AllocRegionIndex = 0;
+        }
+        if(me->m_ReleaseRegion)
+        {
+            me->m_ReleaseRegion(region, length);
         }
         else
         {
-            // sanity check failed.
-            // the heap is corrupt
-            /// \todo what is the best way to handle this?
-            break;
+            // the memory cannot be given back
+        }
+    }
+    else
+    {
+        // not a region of this heap
+    }
+}
+
+
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+
+/**********************************************************/
+void _ACR_HeapStatsAlloc(
+    ACR_HeapObj_t* me,
+    ACR_Length_t bytes,
+    void* ptr)
+{
+    ACR_Count_t size = 0;
+    if(bytes > 1)
+    {
+        size = _ACR_HeapFindLastSet(bytes);
+        if(size >= ACR_HEAP_STATS_SIZE_COUNT)
+        {
+            size = (ACR_HEAP_STATS_SIZE_COUNT - 1);
         }
-        currentHeader++;
     }
+    me->m_Stats.m_SizeCount[size]++;
 
-    return result;
+    if(ptr)
+    {
+        // the header before the memory has the
+        // number of bytes that were actually used
+        ACR_HeapHeader_t* headerPtr = (ACR_HeapHeader_t*)(((ACR_Byte_t*)ptr) - ACR_HEAP_HEADER_SIZE);
+        me->m_Stats.m_AllocCount++;
+        me->m_Stats.m_LiveBytes += headerPtr->m_Bytes;
+        if(me->m_Stats.m_LiveBytes > me->m_Stats.m_PeakBytes)
+        {
+            me->m_Stats.m_PeakBytes = me->m_Stats.m_LiveBytes;
+        }
+    }
+    else
+    {
+        // out of memory or too fragmented
+        me->m_Stats.m_FailCount++;
+    }
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_HeapWriteStat(
+    ACR_FileInterface_t* file,
+    const char* name,
+    ACR_Length_t value)
+{
+    // room for the name, the largest value,
+    // the equals sign, and the new line
+    char line[64];
+    char digits[24];
+    ACR_Length_t length = 0;
+    ACR_Count_t digitCount = 0;
+    while((name[length] != '\0') &&
+          (length < (sizeof(line) - sizeof(digits))))
+    {
+        line[length] = name[length];
+        length++;
+    }
+    line[length++] = '=';
+    do
+    {
+        digits[digitCount++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while(value > 0);
+    while(digitCount > 0)
+    {
+        line[length++] = digits[--digitCount];
+    }
+    line[length++] = '\n';
+
+    ACR_VAR_BUFFER(src);
+    ACR_VAR_BUFFER_SET_MEMORY(src, line, length);
+    if((file->m_Write(&src, file->m_User) != ACR_INFO_OK) ||
+       (src.m_Buffer.m_Length != length))
+    {
+        return ACR_INFO_ERROR;
+    }
+    return ACR_INFO_OK;
 }
+
+#endif // #ifndef ACR_CONFIG_NO_HEAP_STATS
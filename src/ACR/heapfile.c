@@ -0,0 +1,444 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file heapfile.c
+
+    public functions to keep a heap in a memory mapped file
+
+*/
+#include "ACR/heapfile.h"
+
+// included for ACR_MEMCPY and ACR_MEMSET
+#include "ACR/public/public_memory.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+#ifndef ACR_CONFIG_NO_LIBC
+    #ifdef ACR_PLATFORM_WIN
+        // included for CreateFileA, CreateFileMappingA, and MapViewOfFile
+        #include <windows.h>
+    #else
+        // included for open
+        #include <fcntl.h>
+        // included for fstat
+        #include <sys/stat.h>
+        // included for mmap, msync, and munmap
+        #include <sys/mman.h>
+        // included for ftruncate and close
+        #include <unistd.h>
+    #endif
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+#ifndef ACR_CONFIG_NO_LIBC
+
+/** map a file into memory
+    \param me the heap file. m_Length is the number of
+           bytes of a new file and is set to the length
+           of an existing file
+    \param path the file name
+    \param isNew stores ACR_BOOL_TRUE if the file was created
+    \returns the memory or ACR_NULL on failure
+*/
+void* _ACR_HeapFileMap(
+    ACR_HeapFile_t* me,
+    const char* path,
+    ACR_Bool_t* isNew);
+
+/** unmap the memory of a file and close it
+*/
+void _ACR_HeapFileUnmap(
+    ACR_HeapFile_t* me,
+    void* memory);
+
+#endif // #ifndef ACR_CONFIG_NO_LIBC
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_HeapFileOpen(
+    ACR_HeapFile_t* me,
+    const char* path,
+    ACR_Length_t length)
+{
+#ifndef ACR_CONFIG_NO_LIBC
+    void* memory;
+    ACR_Bool_t isNew = ACR_BOOL_FALSE;
+    if((me == ACR_NULL) ||
+       (path == ACR_NULL) ||
+       (me->m_Header != ACR_NULL))
+    {
+        // no file or already open
+        return ACR_INFO_ERROR;
+    }
+
+    me->m_Length = length;
+    memory = _ACR_HeapFileMap(me, path, &isNew);
+    if(memory == ACR_NULL)
+    {
+        return ACR_INFO_ERROR;
+    }
+
+    if(isNew)
+    {
+        me->m_Header = ACR_HeapFileInitMemory(memory, me->m_Length);
+    }
+    else
+    {
+        me->m_Header = ACR_HeapFileAttachMemory(memory, me->m_Length);
+    }
+
+    if(me->m_Header == ACR_NULL)
+    {
+        _ACR_HeapFileUnmap(me, memory);
+        return (isNew ? ACR_INFO_ERROR : ACR_INFO_INVALID);
+    }
+    return (isNew ? ACR_INFO_NEW : ACR_INFO_OLD);
+#else
+    ACR_UNUSED(me);
+    ACR_UNUSED(path);
+    ACR_UNUSED(length);
+    return ACR_INFO_ERROR;
+#endif
+}
+
+/**********************************************************/
+ACR_Info_t ACR_HeapFileSync(
+    ACR_HeapFile_t* me)
+{
+#ifndef ACR_CONFIG_NO_LIBC
+    if((me == ACR_NULL) ||
+       (me->m_Header == ACR_NULL))
+    {
+        // not open
+        return ACR_INFO_ERROR;
+    }
+#ifdef ACR_PLATFORM_WIN
+    if((FlushViewOfFile(me->m_Header, 0) == FALSE) ||
+       (FlushFileBuffers((HANDLE)me->m_File) == FALSE))
+    {
+        return ACR_INFO_ERROR;
+    }
+#else
+    if(msync(me->m_Header, (size_t)me->m_Length, MS_SYNC) != 0)
+    {
+        return ACR_INFO_ERROR;
+    }
+#endif
+    return ACR_INFO_OK;
+#else
+    ACR_UNUSED(me);
+    return ACR_INFO_ERROR;
+#endif
+}
+
+/**********************************************************/
+void ACR_HeapFileClose(
+    ACR_HeapFile_t* me)
+{
+#ifndef ACR_CONFIG_NO_LIBC
+    if((me != ACR_NULL) &&
+       (me->m_Header != ACR_NULL))
+    {
+        _ACR_HeapFileUnmap(me, me->m_Header);
+        me->m_Header = ACR_NULL;
+        me->m_Length = ACR_ZERO_LENGTH;
+    }
+#else
+    ACR_UNUSED(me);
+#endif
+}
+
+/**********************************************************/
+ACR_HeapFileHeader_t* ACR_HeapFileInitMemory(
+    void* memory,
+    ACR_Length_t length)
+{
+    ACR_HeapFileHeader_t* me = (ACR_HeapFileHeader_t*)memory;
+    if((memory == ACR_NULL) ||
+       (((ACR_PointerValue_t)memory % ACR_HEAP_ALIGNMENT) != 0) ||
+       (length <= ACR_HEAP_FILE_HEADER_SIZE))
+    {
+        return ACR_NULL;
+    }
+
+    ACR_MEMSET(me, 0, ACR_HEAP_FILE_HEADER_SIZE);
+    ACR_MEMCPY(me->m_Magic, ACR_HEAP_FILE_MAGIC, ACR_HEAP_FILE_MAGIC_LENGTH);
+    me->m_Layout = ACR_HEAP_FILE_LAYOUT;
+    me->m_Length = length;
+    me->m_RootPos = 0;
+    ACR_HeapInit(&me->m_Heap, &((ACR_Byte_t*)memory)[ACR_HEAP_FILE_HEADER_SIZE], (length - ACR_HEAP_FILE_HEADER_SIZE));
+    return me;
+}
+
+/**********************************************************/
+ACR_HeapFileHeader_t* ACR_HeapFileAttachMemory(
+    void* memory,
+    ACR_Length_t length)
+{
+    ACR_HeapFileHeader_t* me = (ACR_HeapFileHeader_t*)memory;
+    ACR_HeapObj_t* heap;
+    ACR_Length_t i;
+    if((memory == ACR_NULL) ||
+       (((ACR_PointerValue_t)memory % ACR_HEAP_ALIGNMENT) != 0) ||
+       (length <= ACR_HEAP_FILE_HEADER_SIZE))
+    {
+        return ACR_NULL;
+    }
+
+    for(i = 0; i < ACR_HEAP_FILE_MAGIC_LENGTH; i++)
+    {
+        if(me->m_Magic[i] != (ACR_Byte_t)ACR_HEAP_FILE_MAGIC[i])
+        {
+            // not a heap file
+            return ACR_NULL;
+        }
+    }
+
+    // only the header is checked so that attaching
+    // takes the same time no matter how much is allocated
+    heap = &me->m_Heap;
+    if((me->m_Layout != ACR_HEAP_FILE_LAYOUT) ||
+       (me->m_Length != length) ||
+       (me->m_RootPos >= length) ||
+       (heap->m_HeapLength != (length - ACR_HEAP_FILE_HEADER_SIZE)) ||
+       (heap->m_NextFreePos > heap->m_HeapLength) ||
+       (heap->m_LastBytes > heap->m_NextFreePos) ||
+       (heap->m_FreeBytes > heap->m_NextFreePos))
+    {
+        return ACR_NULL;
+    }
+
+    // the pointers are from the program that used the
+    // memory last so they are set for this program
+    heap->m_Heap = &((ACR_Byte_t*)memory)[ACR_HEAP_FILE_HEADER_SIZE];
+    heap->m_NextRegion = ACR_NULL;
+    heap->m_PrevRegion = ACR_NULL;
+    heap->m_AcquireRegion = ACR_NULL;
+    heap->m_ReleaseRegion = ACR_NULL;
+    heap->m_ResizeRegion = ACR_NULL;
+    heap->m_IsLarge = ACR_BOOL_FALSE;
+    heap->m_RegionIndex = 0;
+    heap->m_AllocRegionIndex = 0;
+    ACR_MEMSET(heap->m_Regions, 0, sizeof(heap->m_Regions));
+    return me;
+}
+
+/**********************************************************/
+ACR_HeapObj_t* ACR_HeapFileHeap(
+    ACR_HeapFileHeader_t* me)
+{
+    return ((me != ACR_NULL) ? &me->m_Heap : ACR_NULL);
+}
+
+/**********************************************************/
+void ACR_HeapFileSetRoot(
+    ACR_HeapFileHeader_t* me,
+    const void* root)
+{
+    if(me != ACR_NULL)
+    {
+        me->m_RootPos = ACR_HeapFilePos(me, root);
+    }
+}
+
+/**********************************************************/
+void* ACR_HeapFileGetRoot(
+    ACR_HeapFileHeader_t* me)
+{
+    return ((me != ACR_NULL) ? ACR_HeapFilePointer(me, me->m_RootPos) : ACR_NULL);
+}
+
+/**********************************************************/
+ACR_Length_t ACR_HeapFilePos(
+    ACR_HeapFileHeader_t* me,
+    const void* ptr)
+{
+    const ACR_Byte_t* start = (const ACR_Byte_t*)me->m_Heap.m_Heap;
+    if((ptr == ACR_NULL) ||
+       ((const ACR_Byte_t*)ptr < start) ||
+       ((const ACR_Byte_t*)ptr >= &start[me->m_Heap.m_HeapLength]))
+    {
+        // not in the heap
+        return 0;
+    }
+    return (ACR_Length_t)((const ACR_Byte_t*)ptr - (const ACR_Byte_t*)me);
+}
+
+/**********************************************************/
+void* ACR_HeapFilePointer(
+    ACR_HeapFileHeader_t* me,
+    ACR_Length_t pos)
+{
+    if((pos < ACR_HEAP_FILE_HEADER_SIZE) ||
+       (pos >= me->m_Length))
+    {
+        // not in the heap
+        return ACR_NULL;
+    }
+    return &((ACR_Byte_t*)me)[pos];
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+#ifndef ACR_CONFIG_NO_LIBC
+
+/**********************************************************/
+void* _ACR_HeapFileMap(
+    ACR_HeapFile_t* me,
+    const char* path,
+    ACR_Bool_t* isNew)
+{
+#ifdef ACR_PLATFORM_WIN
+    HANDLE file;
+    HANDLE mapping;
+    LARGE_INTEGER size;
+    void* memory;
+    file = CreateFileA(path, (GENERIC_READ | GENERIC_WRITE), 0, ACR_NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, ACR_NULL);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return ACR_NULL;
+    }
+    if(GetFileSizeEx(file, &size) == FALSE)
+    {
+        CloseHandle(file);
+        return ACR_NULL;
+    }
+    if(size.QuadPart != 0)
+    {
+        // an existing file keeps its length
+        me->m_Length = (ACR_Length_t)size.QuadPart;
+        (*isNew) = ACR_BOOL_FALSE;
+    }
+    else
+    {
+        // the mapping makes the file this long
+        size.QuadPart = (LONGLONG)me->m_Length;
+        (*isNew) = ACR_BOOL_TRUE;
+    }
+    mapping = CreateFileMappingA(file, ACR_NULL, PAGE_READWRITE, (DWORD)size.HighPart, (DWORD)size.LowPart, ACR_NULL);
+    if(mapping == ACR_NULL)
+    {
+        CloseHandle(file);
+        return ACR_NULL;
+    }
+    memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)me->m_Length);
+    if(memory == ACR_NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return ACR_NULL;
+    }
+    me->m_File = (ACR_PointerValue_t)file;
+    me->m_Mapping = (ACR_PointerValue_t)mapping;
+    return memory;
+#else
+    int file;
+    struct stat info;
+    void* memory;
+    file = open(path, (O_RDWR | O_CREAT), 0600);
+    if(file < 0)
+    {
+        return ACR_NULL;
+    }
+    if(fstat(file, &info) != 0)
+    {
+        close(file);
+        return ACR_NULL;
+    }
+    if(info.st_size != 0)
+    {
+        // an existing file keeps its length
+        me->m_Length = (ACR_Length_t)info.st_size;
+        (*isNew) = ACR_BOOL_FALSE;
+    }
+    else if(ftruncate(file, (off_t)me->m_Length) == 0)
+    {
+        // the file is filled with zeros
+        (*isNew) = ACR_BOOL_TRUE;
+    }
+    else
+    {
+        close(file);
+        return ACR_NULL;
+    }
+    memory = mmap(ACR_NULL, (size_t)me->m_Length, (PROT_READ | PROT_WRITE), MAP_SHARED, file, 0);
+    if(memory == MAP_FAILED)
+    {
+        close(file);
+        return ACR_NULL;
+    }
+    me->m_File = (ACR_PointerValue_t)file;
+    me->m_Mapping = 0;
+    return memory;
+#endif
+}
+
+/**********************************************************/
+void _ACR_HeapFileUnmap(
+    ACR_HeapFile_t* me,
+    void* memory)
+{
+#ifdef ACR_PLATFORM_WIN
+    UnmapViewOfFile(memory);
+    CloseHandle((HANDLE)me->m_Mapping);
+    CloseHandle((HANDLE)me->m_File);
+#else
+    munmap(memory, (size_t)me->m_Length);
+    close((int)me->m_File);
+#endif
+    me->m_File = 0;
+    me->m_Mapping = 0;
+}
+
+#endif // #ifndef ACR_CONFIG_NO_LIBC
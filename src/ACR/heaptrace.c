@@ -0,0 +1,451 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file heaptrace.c
+
+    public functions to record every ACR_MALLOC(), ACR_FREE(),
+    and ACR_REALLOC() call as a compact binary trace
+
+*/
+
+// the recorder calls the allocator that it records
+// so ACR_MALLOC(), ACR_FREE(), and ACR_REALLOC()
+// must not be sent back to the recorder
+#define ACR_HEAP_TRACE_RECORDER
+
+#include "ACR/heaptrace.h"
+
+// included for ACR_MALLOC, ACR_FREE, and ACR_REALLOC
+#include "ACR/public/public_heap.h"
+
+// included for ACR_BYTES_PER_BLOCK
+#include "ACR/public/public_blocks.h"
+
+// included for ACR_Timer_t
+#include "ACR/public/public_timer.h"
+
+#ifndef ACR_CONFIG_HEAP_TRACE_BUFFER_SIZE
+/** the number of bytes of records that are kept
+    in memory before they are written to the file
+*/
+#define ACR_CONFIG_HEAP_TRACE_BUFFER_SIZE 4096
+#endif
+
+/** the number of bytes before each allocation used to store its id.
+    this keeps the alignment of the memory returned by ACR_MALLOC()
+*/
+#define ACR_HEAP_TRACE_PREFIX_SIZE (2 * ACR_BYTES_PER_BLOCK)
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+#ifdef ACR_CONFIG_HEAP_TRACE
+
+/** add a record to the trace if recording
+*/
+void _ACR_HeapTraceRecord(
+    ACR_Byte_t op,
+    ACR_Length_t size,
+    ACR_Length_t id);
+
+/** write the records kept in memory to the file
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t _ACR_HeapTraceFlush(void);
+
+/** write bytes to the file
+    \returns ACR_INFO_OK or ACR_INFO_ERROR
+*/
+ACR_Info_t _ACR_HeapTraceWrite(
+    const void* data,
+    ACR_Length_t length);
+
+/** add a value to the records kept in memory as unsigned LEB128
+*/
+void _ACR_HeapTraceEncode(
+    ACR_Length_t value);
+
+#endif // #ifdef ACR_CONFIG_HEAP_TRACE
+
+/** read an unsigned LEB128 value
+    \returns ACR_BOOL_TRUE if the value was complete
+*/
+ACR_Bool_t _ACR_HeapTraceDecode(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos,
+    ACR_Length_t* value);
+
+#ifdef ACR_CONFIG_HEAP_TRACE
+
+/** the file to write to or ACR_NULL when not recording
+*/
+ACR_FileInterface_t* g_ACR_HeapTraceFile = ACR_NULL;
+
+/** records that have not been written to the file
+*/
+ACR_Byte_t g_ACR_HeapTraceBuffer[ACR_CONFIG_HEAP_TRACE_BUFFER_SIZE];
+
+/** the number of bytes in g_ACR_HeapTraceBuffer
+*/
+ACR_Length_t g_ACR_HeapTraceLength = 0;
+
+/** ACR_INFO_ERROR after any write to the file fails
+*/
+ACR_Info_t g_ACR_HeapTraceResult = ACR_INFO_OK;
+
+/** the id given to the next allocation
+*/
+ACR_Length_t g_ACR_HeapTraceNextId = 1;
+
+/** the time of the previous record
+*/
+ACR_Time_t g_ACR_HeapTracePrevMicro = 0;
+
+/** ACR_BOOL_TRUE while writing to the file so that
+    any memory allocated by the file is not recorded
+*/
+ACR_Bool_t g_ACR_HeapTraceBusy = ACR_BOOL_FALSE;
+
+#endif // #ifdef ACR_CONFIG_HEAP_TRACE
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_HeapTraceStart(
+    ACR_FileInterface_t* file)
+{
+#ifdef ACR_CONFIG_HEAP_TRACE
+    ACR_Timer_t timer;
+    if((file == ACR_NULL) ||
+       (file->m_Write == ACR_NULL) ||
+       (g_ACR_HeapTraceFile != ACR_NULL))
+    {
+        // no file or already recording
+        return ACR_INFO_ERROR;
+    }
+
+    g_ACR_HeapTraceFile = file;
+    g_ACR_HeapTraceLength = 0;
+    g_ACR_HeapTraceResult = _ACR_HeapTraceWrite(ACR_HEAP_TRACE_MAGIC, ACR_HEAP_TRACE_MAGIC_LENGTH);
+    if(g_ACR_HeapTraceResult != ACR_INFO_OK)
+    {
+        g_ACR_HeapTraceFile = ACR_NULL;
+        return ACR_INFO_ERROR;
+    }
+    ACR_TIMER_START(timer);
+    ACR_TIMER_AS_MICROSECONDS(timer, g_ACR_HeapTracePrevMicro);
+    return ACR_INFO_OK;
+#else
+    ACR_UNUSED(file);
+    return ACR_INFO_ERROR;
+#endif
+}
+
+/**********************************************************/
+ACR_Info_t ACR_HeapTraceStop(void)
+{
+#ifdef ACR_CONFIG_HEAP_TRACE
+    ACR_Info_t result;
+    if(g_ACR_HeapTraceFile == ACR_NULL)
+    {
+        // not recording
+        return ACR_INFO_ERROR;
+    }
+
+    _ACR_HeapTraceFlush();
+    result = g_ACR_HeapTraceResult;
+    g_ACR_HeapTraceFile = ACR_NULL;
+    return result;
+#else
+    return ACR_INFO_ERROR;
+#endif
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_HeapTraceReadStart(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos)
+{
+    ACR_Length_t i;
+    if((data == ACR_NULL) ||
+       (length < ACR_HEAP_TRACE_MAGIC_LENGTH))
+    {
+        // too short to be a trace
+        return ACR_BOOL_FALSE;
+    }
+    for(i = 0; i < ACR_HEAP_TRACE_MAGIC_LENGTH; i++)
+    {
+        if(data[i] != (ACR_Byte_t)ACR_HEAP_TRACE_MAGIC[i])
+        {
+            // not a trace
+            return ACR_BOOL_FALSE;
+        }
+    }
+    (*pos) = ACR_HEAP_TRACE_MAGIC_LENGTH;
+    return ACR_BOOL_TRUE;
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_HeapTraceRead(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos,
+    ACR_HeapTraceRecord_t* record)
+{
+    ACR_Length_t readPos = (*pos);
+    ACR_Length_t micro;
+    if(readPos >= length)
+    {
+        // end of the trace
+        return ACR_BOOL_FALSE;
+    }
+
+    record->m_Op = data[readPos++];
+    if((_ACR_HeapTraceDecode(data, length, &readPos, &record->m_Size) == ACR_BOOL_FALSE) ||
+       (_ACR_HeapTraceDecode(data, length, &readPos, &record->m_Id) == ACR_BOOL_FALSE) ||
+       (_ACR_HeapTraceDecode(data, length, &readPos, &micro) == ACR_BOOL_FALSE))
+    {
+        // the record is not complete
+        return ACR_BOOL_FALSE;
+    }
+    record->m_Micro += (ACR_Time_t)micro;
+    (*pos) = readPos;
+    return ACR_BOOL_TRUE;
+}
+
+#ifdef ACR_CONFIG_HEAP_TRACE
+
+/**********************************************************/
+void* ACR_HeapTraceAlloc(
+    ACR_Length_t bytes)
+{
+    ACR_Byte_t* ptr = ACR_NULL;
+    if(bytes <= (ACR_MAX_LENGTH - ACR_HEAP_TRACE_PREFIX_SIZE))
+    {
+        ptr = (ACR_Byte_t*)ACR_MALLOC(bytes + ACR_HEAP_TRACE_PREFIX_SIZE);
+    }
+    if(ptr)
+    {
+        ACR_Length_t id = g_ACR_HeapTraceNextId++;
+        ACR_MEMCPY(ptr, &id, sizeof(id));
+        _ACR_HeapTraceRecord(ACR_HEAP_TRACE_ALLOC, bytes, id);
+        return &ptr[ACR_HEAP_TRACE_PREFIX_SIZE];
+    }
+    return ACR_NULL;
+}
+
+/**********************************************************/
+void ACR_HeapTraceFree(
+    void* ptr)
+{
+    if(ptr)
+    {
+        ACR_Byte_t* heapPtr = (((ACR_Byte_t*)ptr) - ACR_HEAP_TRACE_PREFIX_SIZE);
+        ACR_Length_t id;
+        ACR_MEMCPY(&id, heapPtr, sizeof(id));
+        _ACR_HeapTraceRecord(ACR_HEAP_TRACE_FREE, 0, id);
+        ACR_FREE(heapPtr);
+    }
+    else
+    {
+        // nothing to free
+    }
+}
+
+/**********************************************************/
+void* ACR_HeapTraceRealloc(
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    ACR_Byte_t* heapPtr;
+    ACR_Length_t id;
+    if(ptr == ACR_NULL)
+    {
+        // same as a new allocation
+        return ACR_HeapTraceAlloc(bytes);
+    }
+    if(bytes > (ACR_MAX_LENGTH - ACR_HEAP_TRACE_PREFIX_SIZE))
+    {
+        // too many bytes requested
+        return ACR_NULL;
+    }
+
+    heapPtr = (ACR_Byte_t*)ACR_REALLOC((((ACR_Byte_t*)ptr) - ACR_HEAP_TRACE_PREFIX_SIZE), bytes + ACR_HEAP_TRACE_PREFIX_SIZE);
+    if(heapPtr)
+    {
+        ACR_MEMCPY(&id, heapPtr, sizeof(id));
+        _ACR_HeapTraceRecord(ACR_HEAP_TRACE_REALLOC, bytes, id);
+        return &heapPtr[ACR_HEAP_TRACE_PREFIX_SIZE];
+    }
+    return ACR_NULL;
+}
+
+#endif // #ifdef ACR_CONFIG_HEAP_TRACE
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+#ifdef ACR_CONFIG_HEAP_TRACE
+
+/**********************************************************/
+void _ACR_HeapTraceRecord(
+    ACR_Byte_t op,
+    ACR_Length_t size,
+    ACR_Length_t id)
+{
+    ACR_Timer_t timer;
+    ACR_Time_t micro;
+    if((g_ACR_HeapTraceFile == ACR_NULL) ||
+       (g_ACR_HeapTraceBusy))
+    {
+        // not recording
+        return;
+    }
+
+    if((ACR_CONFIG_HEAP_TRACE_BUFFER_SIZE - g_ACR_HeapTraceLength) < ACR_HEAP_TRACE_MAX_RECORD_LENGTH)
+    {
+        _ACR_HeapTraceFlush();
+    }
+
+    ACR_TIMER_START(timer);
+    ACR_TIMER_AS_MICROSECONDS(timer, micro);
+    g_ACR_HeapTraceBuffer[g_ACR_HeapTraceLength++] = op;
+    _ACR_HeapTraceEncode(size);
+    _ACR_HeapTraceEncode(id);
+    _ACR_HeapTraceEncode((micro > g_ACR_HeapTracePrevMicro) ? (ACR_Length_t)(micro - g_ACR_HeapTracePrevMicro) : 0);
+    g_ACR_HeapTracePrevMicro = micro;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_HeapTraceFlush(void)
+{
+    ACR_Info_t result = ACR_INFO_OK;
+    if(g_ACR_HeapTraceLength > 0)
+    {
+        result = _ACR_HeapTraceWrite(g_ACR_HeapTraceBuffer, g_ACR_HeapTraceLength);
+        g_ACR_HeapTraceLength = 0;
+    }
+    if(result != ACR_INFO_OK)
+    {
+        // keep the error until recording stops
+        g_ACR_HeapTraceResult = result;
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_HeapTraceWrite(
+    const void* data,
+    ACR_Length_t length)
+{
+    ACR_Info_t result = ACR_INFO_OK;
+    const ACR_Byte_t* next = (const ACR_Byte_t*)data;
+    g_ACR_HeapTraceBusy = ACR_BOOL_TRUE;
+    while((length > 0) &&
+          (result == ACR_INFO_OK))
+    {
+        ACR_VAR_BUFFER(src);
+        ACR_VAR_BUFFER_SET_MEMORY(src, next, length);
+        if((g_ACR_HeapTraceFile->m_Write(&src, g_ACR_HeapTraceFile->m_User) != ACR_INFO_OK) ||
+           (src.m_Buffer.m_Length == 0) ||
+           (src.m_Buffer.m_Length > length))
+        {
+            result = ACR_INFO_ERROR;
+        }
+        else
+        {
+            // the file may not write everything at once
+            next += src.m_Buffer.m_Length;
+            length -= src.m_Buffer.m_Length;
+        }
+    }
+    g_ACR_HeapTraceBusy = ACR_BOOL_FALSE;
+    return result;
+}
+
+/**********************************************************/
+void _ACR_HeapTraceEncode(
+    ACR_Length_t value)
+{
+    while(value >= 0x80)
+    {
+        g_ACR_HeapTraceBuffer[g_ACR_HeapTraceLength++] = (ACR_Byte_t)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    g_ACR_HeapTraceBuffer[g_ACR_HeapTraceLength++] = (ACR_Byte_t)value;
+}
+
+#endif // #ifdef ACR_CONFIG_HEAP_TRACE
+
+/**********************************************************/
+ACR_Bool_t _ACR_HeapTraceDecode(
+    const ACR_Byte_t* data,
+    ACR_Length_t length,
+    ACR_Length_t* pos,
+    ACR_Length_t* value)
+{
+    ACR_Length_t readPos = (*pos);
+    ACR_Count_t shift = 0;
+    (*value) = 0;
+    while((readPos < length) &&
+          (shift < (sizeof(ACR_Length_t) * 8)))
+    {
+        ACR_Byte_t byte = data[readPos++];
+        (*value) |= (((ACR_Length_t)(byte & 0x7F)) << shift);
+        if((byte & 0x80) == 0)
+        {
+            (*pos) = readPos;
+            return ACR_BOOL_TRUE;
+        }
+        shift += 7;
+    }
+    return ACR_BOOL_FALSE;
+}
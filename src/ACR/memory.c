@@ -0,0 +1,589 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file memory.c
+
+    public functions to copy, move, set, and compare memory
+    without the standard C library
+
+    each function handles the bytes before the destination is
+    aligned to a chunk (the head), then whole chunks, and then
+    the bytes that are left (the tail). chunks of ACR_Block_t
+    are only loaded from aligned addresses because some processors
+    cannot load them from any address, so when the pointers have
+    different alignments two aligned blocks are shifted together
+    to make each block of the destination
+
+*/
+#include "ACR/memory.h"
+
+// included for ACR_Byte_t
+#include "ACR/public/public_bytes_and_flags.h"
+
+// included for ACR_Block_t and ACR_MAX_BLOCK
+#include "ACR/public/public_blocks.h"
+
+// included for ACR_Bool_t
+#include "ACR/public/public_bool.h"
+
+#if defined(ACR_CONFIG_MEMORY_SIMD) && defined(__AVX2__)
+
+    // included for the AVX2 intrinsics
+    #include <immintrin.h>
+
+    #define ACR_MEMORY_KERNEL_NAME "avx2"
+    #define ACR_MEMORY_CHUNK_BYTES 32
+    #define ACR_MEMORY_CHUNK_UNALIGNED
+    typedef __m256i ACR_MemoryChunk_t;
+    #define ACR_MEMORY_CHUNK_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+    #define ACR_MEMORY_CHUNK_STORE(p,c) _mm256_storeu_si256((__m256i*)(p), c)
+    #define ACR_MEMORY_CHUNK_SPLAT(v) _mm256_set1_epi8((char)(v))
+    #define ACR_MEMORY_CHUNK_EQUAL(a,b) (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == -1)
+
+#elif defined(ACR_CONFIG_MEMORY_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+
+    // included for the SSE2 intrinsics
+    #include <emmintrin.h>
+
+    #define ACR_MEMORY_KERNEL_NAME "sse2"
+    #define ACR_MEMORY_CHUNK_BYTES 16
+    #define ACR_MEMORY_CHUNK_UNALIGNED
+    typedef __m128i ACR_MemoryChunk_t;
+    #define ACR_MEMORY_CHUNK_LOAD(p) _mm_loadu_si128((const __m128i*)(p))
+    #define ACR_MEMORY_CHUNK_STORE(p,c) _mm_storeu_si128((__m128i*)(p), c)
+    #define ACR_MEMORY_CHUNK_SPLAT(v) _mm_set1_epi8((char)(v))
+    #define ACR_MEMORY_CHUNK_EQUAL(a,b) (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF)
+
+#elif defined(ACR_CONFIG_MEMORY_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+    // included for the NEON intrinsics
+    #include <arm_neon.h>
+
+    #define ACR_MEMORY_KERNEL_NAME "neon"
+    #define ACR_MEMORY_KERNEL_NEON
+    #define ACR_MEMORY_CHUNK_BYTES 16
+    #define ACR_MEMORY_CHUNK_UNALIGNED
+    typedef uint8x16_t ACR_MemoryChunk_t;
+    #define ACR_MEMORY_CHUNK_LOAD(p) vld1q_u8((const uint8_t*)(p))
+    #define ACR_MEMORY_CHUNK_STORE(p,c) vst1q_u8((uint8_t*)(p), c)
+    #define ACR_MEMORY_CHUNK_SPLAT(v) vdupq_n_u8((uint8_t)(v))
+    #define ACR_MEMORY_CHUNK_EQUAL(a,b) _ACR_MemoryNeonEqual(a, b)
+
+    /** determine if every byte of two NEON registers is the same
+    */
+    ACR_Bool_t _ACR_MemoryNeonEqual(
+        uint8x16_t first,
+        uint8x16_t second);
+
+#elif !defined(ACR_CONFIG_MEMORY_BYTES)
+
+    #define ACR_MEMORY_KERNEL_NAME "blocks"
+    #define ACR_MEMORY_CHUNK_BYTES ACR_BYTES_PER_BLOCK
+    #if defined(__GNUC__)
+        // the chunks are read from memory of any type
+        typedef ACR_Block_t __attribute__((__may_alias__)) ACR_MemoryChunk_t;
+    #else
+        typedef ACR_Block_t ACR_MemoryChunk_t;
+    #endif
+    #define ACR_MEMORY_CHUNK_LOAD(p) (*(const ACR_MemoryChunk_t*)(const void*)(p))
+    #define ACR_MEMORY_CHUNK_STORE(p,c) (*(ACR_MemoryChunk_t*)(void*)(p)) = (c)
+    #define ACR_MEMORY_CHUNK_SPLAT(v) ((ACR_MemoryChunk_t)((ACR_MAX_BLOCK / 0xFF) * (ACR_Byte_t)(v)))
+    #define ACR_MEMORY_CHUNK_EQUAL(a,b) ((a) == (b))
+
+#else
+
+    #define ACR_MEMORY_KERNEL_NAME "bytes"
+
+#endif
+
+#if defined(ACR_MEMORY_CHUNK_BYTES) && !defined(ACR_MEMORY_CHUNK_UNALIGNED)
+
+/** get the block that starts part way into the lower of two
+    blocks that are next to each other in memory
+    \param lower the block at the lower address
+    \param higher the block right after it
+    \param offset the number of bytes into lower where the block starts, 1 to ACR_BYTES_PER_BLOCK-1
+*/
+ACR_MemoryChunk_t _ACR_MemoryJoinBlocks(
+    ACR_MemoryChunk_t lower,
+    ACR_MemoryChunk_t higher,
+    ACR_Length_t offset);
+
+/** copy whole blocks when the source has a different alignment
+    than the destination by loading aligned blocks from the source
+    and shifting them together
+    \param destPtr the destination, which must be aligned, is moved past the blocks
+    \param srcPtr the source is moved past the blocks
+    \param length the number of bytes, which is reduced by the blocks copied
+*/
+void _ACR_MemoryCopyShifted(
+    ACR_Byte_t** destPtr,
+    const ACR_Byte_t** srcPtr,
+    ACR_Length_t* length);
+
+/** copy whole blocks backward like _ACR_MemoryCopyShifted()
+    so that a source before an overlapping destination is
+    read before it is overwritten
+    \param destPtr the end of the destination, which must be aligned, is moved back past the blocks
+    \param srcPtr the end of the source is moved back past the blocks
+    \param length the number of bytes, which is reduced by the blocks copied
+*/
+void _ACR_MemoryMoveShifted(
+    ACR_Byte_t** destPtr,
+    const ACR_Byte_t** srcPtr,
+    ACR_Length_t* length);
+
+/** skip whole blocks that are the same when the second memory has a
+    different alignment than the first by shifting its aligned blocks together
+    \param firstPtr the first memory, which must be aligned, is moved past the blocks that are the same
+    \param secondPtr the second memory is moved past the blocks that are the same
+    \param length the number of bytes, which is reduced by the blocks that are the same
+*/
+void _ACR_MemoryCompareShifted(
+    const ACR_Byte_t** firstPtr,
+    const ACR_Byte_t** secondPtr,
+    ACR_Length_t* length);
+
+#endif
+
+#ifdef ACR_MEMORY_CHUNK_BYTES
+
+/** the number of bytes from p to the next chunk aligned address
+*/
+#define ACR_MEMORY_HEAD_BYTES(p) ((ACR_MEMORY_CHUNK_BYTES - ((ACR_PointerValue_t)(p) % ACR_MEMORY_CHUNK_BYTES)) % ACR_MEMORY_CHUNK_BYTES)
+
+#ifdef ACR_MEMORY_CHUNK_UNALIGNED
+    /** chunks can be loaded from any address
+    */
+    #define ACR_MEMORY_CAN_USE_CHUNKS(a,b) ACR_BOOL_TRUE
+#else
+    /** chunks can only be used when both addresses
+        reach an aligned address at the same time
+    */
+    #define ACR_MEMORY_CAN_USE_CHUNKS(a,b) (((ACR_PointerValue_t)(a) % ACR_MEMORY_CHUNK_BYTES) == ((ACR_PointerValue_t)(b) % ACR_MEMORY_CHUNK_BYTES))
+#endif
+
+#endif // #ifdef ACR_MEMORY_CHUNK_BYTES
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_MemoryCopy(
+    void* dest,
+    const void* src,
+    ACR_Length_t length)
+{
+    ACR_Byte_t* destPtr = (ACR_Byte_t*)dest;
+    const ACR_Byte_t* srcPtr = (const ACR_Byte_t*)src;
+
+#ifdef ACR_MEMORY_CHUNK_BYTES
+    // head
+    while((length > 0) &&
+          (ACR_MEMORY_HEAD_BYTES(destPtr) != 0))
+    {
+        (*destPtr++) = (*srcPtr++);
+        length--;
+    }
+
+    if(ACR_MEMORY_CAN_USE_CHUNKS(destPtr, srcPtr))
+    {
+        // chunks
+        while(length >= ACR_MEMORY_CHUNK_BYTES)
+        {
+            ACR_MEMORY_CHUNK_STORE(destPtr, ACR_MEMORY_CHUNK_LOAD(srcPtr));
+            destPtr += ACR_MEMORY_CHUNK_BYTES;
+            srcPtr += ACR_MEMORY_CHUNK_BYTES;
+            length -= ACR_MEMORY_CHUNK_BYTES;
+        }
+    }
+    else
+    {
+#ifndef ACR_MEMORY_CHUNK_UNALIGNED
+        _ACR_MemoryCopyShifted(&destPtr, &srcPtr, &length);
+#endif
+    }
+#endif
+
+    // tail
+    while(length > 0)
+    {
+        (*destPtr++) = (*srcPtr++);
+        length--;
+    }
+}
+
+/**********************************************************/
+void ACR_MemoryMove(
+    void* dest,
+    const void* src,
+    ACR_Length_t length)
+{
+    ACR_Byte_t* destPtr = (ACR_Byte_t*)dest;
+    const ACR_Byte_t* srcPtr = (const ACR_Byte_t*)src;
+
+    if((destPtr <= srcPtr) ||
+       (destPtr >= &srcPtr[length]))
+    {
+        // copying forward never overwrites a
+        // source byte before it is copied
+        ACR_MemoryCopy(dest, src, length);
+        return;
+    }
+
+    // copy backward from the end
+    destPtr += length;
+    srcPtr += length;
+
+#ifdef ACR_MEMORY_CHUNK_BYTES
+    // head
+    while((length > 0) &&
+          (((ACR_PointerValue_t)destPtr % ACR_MEMORY_CHUNK_BYTES) != 0))
+    {
+        (*--destPtr) = (*--srcPtr);
+        length--;
+    }
+
+    if(ACR_MEMORY_CAN_USE_CHUNKS(destPtr, srcPtr))
+    {
+        // chunks
+        // Note: each chunk is loaded before it is
+        //       stored so the overlap does not matter
+        while(length >= ACR_MEMORY_CHUNK_BYTES)
+        {
+            destPtr -= ACR_MEMORY_CHUNK_BYTES;
+            srcPtr -= ACR_MEMORY_CHUNK_BYTES;
+            ACR_MEMORY_CHUNK_STORE(destPtr, ACR_MEMORY_CHUNK_LOAD(srcPtr));
+            length -= ACR_MEMORY_CHUNK_BYTES;
+        }
+    }
+    else
+    {
+#ifndef ACR_MEMORY_CHUNK_UNALIGNED
+        _ACR_MemoryMoveShifted(&destPtr, &srcPtr, &length);
+#endif
+    }
+#endif
+
+    // tail
+    while(length > 0)
+    {
+        (*--destPtr) = (*--srcPtr);
+        length--;
+    }
+}
+
+/**********************************************************/
+void ACR_MemorySet(
+    void* dest,
+    int value,
+    ACR_Length_t length)
+{
+    ACR_Byte_t* destPtr = (ACR_Byte_t*)dest;
+    ACR_Byte_t byteValue = (ACR_Byte_t)value;
+
+#ifdef ACR_MEMORY_CHUNK_BYTES
+    {
+        ACR_MemoryChunk_t chunk = ACR_MEMORY_CHUNK_SPLAT(byteValue);
+
+        // head
+        while((length > 0) &&
+              (ACR_MEMORY_HEAD_BYTES(destPtr) != 0))
+        {
+            (*destPtr++) = byteValue;
+            length--;
+        }
+
+        // chunks
+        while(length >= ACR_MEMORY_CHUNK_BYTES)
+        {
+            ACR_MEMORY_CHUNK_STORE(destPtr, chunk);
+            destPtr += ACR_MEMORY_CHUNK_BYTES;
+            length -= ACR_MEMORY_CHUNK_BYTES;
+        }
+    }
+#endif
+
+    // tail
+    while(length > 0)
+    {
+        (*destPtr++) = byteValue;
+        length--;
+    }
+}
+
+/**********************************************************/
+int ACR_MemoryCompare(
+    const void* first,
+    const void* second,
+    ACR_Length_t length)
+{
+    const ACR_Byte_t* firstPtr = (const ACR_Byte_t*)first;
+    const ACR_Byte_t* secondPtr = (const ACR_Byte_t*)second;
+
+#ifdef ACR_MEMORY_CHUNK_BYTES
+    // head
+    while((length > 0) &&
+          (ACR_MEMORY_HEAD_BYTES(firstPtr) != 0))
+    {
+        if((*firstPtr) != (*secondPtr))
+        {
+            return ((int)(*firstPtr) - (int)(*secondPtr));
+        }
+        firstPtr++;
+        secondPtr++;
+        length--;
+    }
+
+    if(ACR_MEMORY_CAN_USE_CHUNKS(firstPtr, secondPtr))
+    {
+        // skip chunks that are the same and let the
+        // tail loop find the byte that is different
+        while(length >= ACR_MEMORY_CHUNK_BYTES)
+        {
+            if(!ACR_MEMORY_CHUNK_EQUAL(ACR_MEMORY_CHUNK_LOAD(firstPtr), ACR_MEMORY_CHUNK_LOAD(secondPtr)))
+            {
+                break;
+            }
+            firstPtr += ACR_MEMORY_CHUNK_BYTES;
+            secondPtr += ACR_MEMORY_CHUNK_BYTES;
+            length -= ACR_MEMORY_CHUNK_BYTES;
+        }
+    }
+    else
+    {
+#ifndef ACR_MEMORY_CHUNK_UNALIGNED
+        _ACR_MemoryCompareShifted(&firstPtr, &secondPtr, &length);
+#endif
+    }
+#endif
+
+    // tail
+    while(length > 0)
+    {
+        if((*firstPtr) != (*secondPtr))
+        {
+            return ((int)(*firstPtr) - (int)(*secondPtr));
+        }
+        firstPtr++;
+        secondPtr++;
+        length--;
+    }
+    return 0;
+}
+
+/**********************************************************/
+const char* ACR_MemoryKernelName(void)
+{
+    return ACR_MEMORY_KERNEL_NAME;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+#if defined(ACR_MEMORY_CHUNK_BYTES) && !defined(ACR_MEMORY_CHUNK_UNALIGNED)
+
+/**********************************************************/
+ACR_MemoryChunk_t _ACR_MemoryJoinBlocks(
+    ACR_MemoryChunk_t lower,
+    ACR_MemoryChunk_t higher,
+    ACR_Length_t offset)
+{
+    unsigned int lowShift = (unsigned int)(offset * 8);
+    unsigned int highShift = (unsigned int)((ACR_BYTES_PER_BLOCK - offset) * 8);
+    const ACR_Block_t one = 1;
+    if((*(const ACR_Byte_t*)&one) == 1)
+    {
+        // little endian
+        return ((lower >> lowShift) | (higher << highShift));
+    }
+    else
+    {
+        // big endian
+        return ((lower << lowShift) | (higher >> highShift));
+    }
+}
+
+/**********************************************************/
+void _ACR_MemoryCopyShifted(
+    ACR_Byte_t** destPtr,
+    const ACR_Byte_t** srcPtr,
+    ACR_Length_t* length)
+{
+    ACR_Length_t srcOffset = (ACR_Length_t)((ACR_PointerValue_t)(*srcPtr) % ACR_BYTES_PER_BLOCK);
+    const ACR_MemoryChunk_t* src = (const ACR_MemoryChunk_t*)(const void*)((*srcPtr) - srcOffset);
+    ACR_MemoryChunk_t* dest = (ACR_MemoryChunk_t*)(void*)(*destPtr);
+    ACR_MemoryChunk_t current = 0;
+    ACR_Length_t count = 0;
+    ACR_Length_t i;
+
+    if((*length) < (2 * ACR_BYTES_PER_BLOCK))
+    {
+        // too short to read the first block without reading
+        // past the end of the source. the caller copies it
+        return;
+    }
+
+    // only the bytes that belong to the source are read
+    // from the first block. the rest are shifted out
+    for(i = srcOffset; i < ACR_BYTES_PER_BLOCK; i++)
+    {
+        ((ACR_Byte_t*)&current)[i] = (*srcPtr)[i - srcOffset];
+    }
+
+    // stop early enough that every block loaded is inside the source
+    while((*length) >= (2 * ACR_BYTES_PER_BLOCK))
+    {
+        ACR_MemoryChunk_t next = src[count + 1];
+        dest[count] = _ACR_MemoryJoinBlocks(current, next, srcOffset);
+        current = next;
+        count++;
+        (*length) -= ACR_BYTES_PER_BLOCK;
+    }
+    (*destPtr) += (count * ACR_BYTES_PER_BLOCK);
+    (*srcPtr) += (count * ACR_BYTES_PER_BLOCK);
+}
+
+/**********************************************************/
+void _ACR_MemoryMoveShifted(
+    ACR_Byte_t** destPtr,
+    const ACR_Byte_t** srcPtr,
+    ACR_Length_t* length)
+{
+    ACR_Length_t srcOffset = (ACR_Length_t)((ACR_PointerValue_t)(*srcPtr) % ACR_BYTES_PER_BLOCK);
+    const ACR_MemoryChunk_t* src = (const ACR_MemoryChunk_t*)(const void*)((*srcPtr) - srcOffset);
+    ACR_MemoryChunk_t* dest = (ACR_MemoryChunk_t*)(void*)(*destPtr);
+    ACR_MemoryChunk_t current = 0;
+    ACR_Length_t count = 0;
+    ACR_Length_t i;
+
+    if((*length) < (2 * ACR_BYTES_PER_BLOCK))
+    {
+        // too short to read the last block without reading
+        // before the start of the source. the caller copies it
+        return;
+    }
+
+    // only the bytes that belong to the source are read
+    // from the last block. the rest are shifted out
+    for(i = 0; i < srcOffset; i++)
+    {
+        ((ACR_Byte_t*)&current)[i] = ((const ACR_Byte_t*)src)[i];
+    }
+
+    // each block is loaded before the destination block it
+    // overlaps is stored because the destination is after the
+    // source. stop early enough that every block loaded is inside
+    // the source
+    while((*length) >= (2 * ACR_BYTES_PER_BLOCK))
+    {
+        ACR_MemoryChunk_t previous = (*(src - (count + 1)));
+        (*(dest - (count + 1))) = _ACR_MemoryJoinBlocks(previous, current, srcOffset);
+        current = previous;
+        count++;
+        (*length) -= ACR_BYTES_PER_BLOCK;
+    }
+    (*destPtr) -= (count * ACR_BYTES_PER_BLOCK);
+    (*srcPtr) -= (count * ACR_BYTES_PER_BLOCK);
+}
+
+/**********************************************************/
+void _ACR_MemoryCompareShifted(
+    const ACR_Byte_t** firstPtr,
+    const ACR_Byte_t** secondPtr,
+    ACR_Length_t* length)
+{
+    ACR_Length_t secondOffset = (ACR_Length_t)((ACR_PointerValue_t)(*secondPtr) % ACR_BYTES_PER_BLOCK);
+    const ACR_MemoryChunk_t* second = (const ACR_MemoryChunk_t*)(const void*)((*secondPtr) - secondOffset);
+    const ACR_MemoryChunk_t* first = (const ACR_MemoryChunk_t*)(const void*)(*firstPtr);
+    ACR_MemoryChunk_t current = 0;
+    ACR_Length_t count = 0;
+    ACR_Length_t i;
+
+    if((*length) < (2 * ACR_BYTES_PER_BLOCK))
+    {
+        // too short to read the first block without reading
+        // past the end of the memory. the caller compares it
+        return;
+    }
+
+    // only the bytes that belong to the memory are read
+    // from the first block. the rest are shifted out
+    for(i = secondOffset; i < ACR_BYTES_PER_BLOCK; i++)
+    {
+        ((ACR_Byte_t*)&current)[i] = (*secondPtr)[i - secondOffset];
+    }
+
+    // stop at the first block that is different so that
+    // the caller can find the byte that is different
+    while((*length) >= (2 * ACR_BYTES_PER_BLOCK))
+    {
+        ACR_MemoryChunk_t next = second[count + 1];
+        if(first[count] != _ACR_MemoryJoinBlocks(current, next, secondOffset))
+        {
+            break;
+        }
+        current = next;
+        count++;
+        (*length) -= ACR_BYTES_PER_BLOCK;
+    }
+    (*firstPtr) += (count * ACR_BYTES_PER_BLOCK);
+    (*secondPtr) += (count * ACR_BYTES_PER_BLOCK);
+}
+
+#endif // #if defined(ACR_MEMORY_CHUNK_BYTES) && !defined(ACR_MEMORY_CHUNK_UNALIGNED)
+
+#ifdef ACR_MEMORY_KERNEL_NEON
+
+/**********************************************************/
+ACR_Bool_t _ACR_MemoryNeonEqual(
+    uint8x16_t first,
+    uint8x16_t second)
+{
+    uint64x2_t equal = vreinterpretq_u64_u8(vceqq_u8(first, second));
+    return ((vgetq_lane_u64(equal, 0) & vgetq_lane_u64(equal, 1)) == 0xFFFFFFFFFFFFFFFFULL);
+}
+
+#endif // #ifdef ACR_MEMORY_KERNEL_NEON
@@ -0,0 +1,297 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file pool.c
+
+    public and private functions for access to the ACR_PoolObj_t type
+
+*/
+#include "ACR/private/private_pool.h"
+
+// included for ACR_MALLOC and ACR_FREE
+#include "ACR/public/public_heap.h"
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** allocate a new slab and add its objects to the free list
+    \returns ACR_BOOL_TRUE if the slab was allocated
+*/
+ACR_Bool_t _ACR_PoolAddSlab(
+    ACR_PoolObj_t* me);
+
+/** \see ACR_AllocatorCallbackAlloc_t
+*/
+void* _ACR_PoolAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr);
+
+/** \see ACR_AllocatorCallbackFree_t
+*/
+void _ACR_PoolAllocatorFree(
+    void* ptr,
+    void* userPtr);
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_PoolNew(
+    ACR_PoolObj_t** mePtr,
+    ACR_Length_t objectBytes,
+    ACR_Count_t objectsPerSlab)
+{
+    ACR_Info_t result = ACR_INFO_ERROR;
+    if(mePtr != ACR_NULL)
+    {
+        ACR_NEW_BY_TYPE(newPool, ACR_PoolObj_t);
+        if(newPool)
+        {
+            ACR_PoolInit(newPool, objectBytes, objectsPerSlab);
+            result = ACR_INFO_OK;
+        }
+        (*mePtr) = newPool;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_PoolDelete(
+    ACR_PoolObj_t** mePtr)
+{
+    if(mePtr != ACR_NULL)
+    {
+        ACR_PoolDeInit((*mePtr));
+        ACR_FREE((*mePtr));
+        (*mePtr) = ACR_NULL;
+    }
+}
+
+/**********************************************************/
+void* ACR_PoolAlloc(
+    ACR_PoolObj_t* me,
+    ACR_Length_t bytes)
+{
+    ACR_PoolFreeObject_t* objectPtr = ACR_NULL;
+    if((me == ACR_NULL) ||
+       (bytes > me->m_ObjectBytes))
+    {
+        // invalid pool or object is too large
+        return objectPtr;
+    }
+
+    if(me->m_FreeList == ACR_NULL)
+    {
+        // no objects left so get more
+        _ACR_PoolAddSlab(me);
+    }
+
+    objectPtr = me->m_FreeList;
+    if(objectPtr)
+    {
+        me->m_FreeList = objectPtr->m_Next;
+        me->m_Count++;
+    }
+    else
+    {
+        // failed to allocate a slab
+    }
+    return objectPtr;
+}
+
+/**********************************************************/
+void ACR_PoolFree(
+    ACR_PoolObj_t* me,
+    void* ptr)
+{
+    if((me != ACR_NULL) &&
+       (ptr != ACR_NULL))
+    {
+        ACR_PoolFreeObject_t* objectPtr = (ACR_PoolFreeObject_t*)ptr;
+        objectPtr->m_Next = me->m_FreeList;
+        me->m_FreeList = objectPtr;
+        me->m_Count--;
+    }
+}
+
+/**********************************************************/
+ACR_Count_t ACR_PoolCount(
+    ACR_PoolObj_t* me)
+{
+    ACR_Count_t result = ACR_ZERO_COUNT;
+    if(me != ACR_NULL)
+    {
+        result = me->m_Count;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_PoolInitAllocator(
+    ACR_PoolObj_t* me,
+    ACR_AllocatorInterface_t* allocator)
+{
+    if(allocator != ACR_NULL)
+    {
+        allocator->m_Alloc = _ACR_PoolAllocatorAlloc;
+        allocator->m_Free = _ACR_PoolAllocatorFree;
+        allocator->m_Realloc = ACR_NULL;
+        allocator->m_User = me;
+    }
+}
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_PoolInit(
+    ACR_PoolObj_t* me,
+    ACR_Length_t objectBytes,
+    ACR_Count_t objectsPerSlab)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    // each object must have room for the free list
+    // pointer and keep the objects after it aligned
+    if(objectBytes < sizeof(ACR_PoolFreeObject_t))
+    {
+        objectBytes = sizeof(ACR_PoolFreeObject_t);
+    }
+    if(objectBytes <= (ACR_MAX_LENGTH - ACR_HEAP_ALIGNMENT))
+    {
+        objectBytes = (((objectBytes + ACR_HEAP_ALIGNMENT - 1) / ACR_HEAP_ALIGNMENT) * ACR_HEAP_ALIGNMENT);
+    }
+    else
+    {
+        // objects this large can never be allocated
+        objectBytes = ACR_ZERO_LENGTH;
+    }
+    me->m_ObjectBytes = objectBytes;
+    me->m_ObjectsPerSlab = ((objectsPerSlab > 0) ? objectsPerSlab : 1);
+    me->m_Count = ACR_ZERO_COUNT;
+    me->m_FreeList = ACR_NULL;
+    me->m_Slabs = ACR_NULL;
+}
+
+/**********************************************************/
+void ACR_PoolDeInit(
+    ACR_PoolObj_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    while(me->m_Slabs)
+    {
+        ACR_PoolSlabHeader_t* nextSlab = me->m_Slabs->m_NextSlab;
+        ACR_FREE(me->m_Slabs);
+        me->m_Slabs = nextSlab;
+    }
+    me->m_Count = ACR_ZERO_COUNT;
+    me->m_FreeList = ACR_NULL;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Bool_t _ACR_PoolAddSlab(
+    ACR_PoolObj_t* me)
+{
+    ACR_PoolSlabHeader_t* slabPtr;
+    ACR_Byte_t* objectsPtr;
+    ACR_Count_t count;
+    if((me->m_ObjectBytes == ACR_ZERO_LENGTH) ||
+       (me->m_ObjectsPerSlab > ((ACR_MAX_LENGTH - sizeof(ACR_PoolSlabHeader_t)) / me->m_ObjectBytes)))
+    {
+        // slab would be too large
+        return ACR_BOOL_FALSE;
+    }
+
+    slabPtr = (ACR_PoolSlabHeader_t*)ACR_MALLOC(sizeof(ACR_PoolSlabHeader_t) + (me->m_ObjectBytes * me->m_ObjectsPerSlab));
+    if(slabPtr == ACR_NULL)
+    {
+        return ACR_BOOL_FALSE;
+    }
+    slabPtr->m_NextSlab = me->m_Slabs;
+    me->m_Slabs = slabPtr;
+
+    // link the objects from last to first so that
+    // they are handed out in order of their address
+    objectsPtr = (ACR_Byte_t*)&slabPtr[1];
+    for(count = me->m_ObjectsPerSlab; count > 0; count--)
+    {
+        ACR_PoolFreeObject_t* objectPtr = (ACR_PoolFreeObject_t*)&objectsPtr[(count - 1) * me->m_ObjectBytes];
+        objectPtr->m_Next = me->m_FreeList;
+        me->m_FreeList = objectPtr;
+    }
+    return ACR_BOOL_TRUE;
+}
+
+/**********************************************************/
+void* _ACR_PoolAllocatorAlloc(
+    ACR_Length_t bytes,
+    void* userPtr)
+{
+    return ACR_PoolAlloc((ACR_PoolObj_t*)userPtr, bytes);
+}
+
+/**********************************************************/
+void _ACR_PoolAllocatorFree(
+    void* ptr,
+    void* userPtr)
+{
+    ACR_PoolFree((ACR_PoolObj_t*)userPtr, ptr);
+}
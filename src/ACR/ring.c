@@ -0,0 +1,855 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file ring.c
+
+    public and private functions for access to the ACR_RingObj_t type
+
+*/
+#if defined(__linux__) && !defined(ACR_CONFIG_NO_LIBC) && !defined(_GNU_SOURCE)
+    // needed for memfd_create, which must be
+    // defined before any system header
+    #define _GNU_SOURCE
+#endif
+
+#include "ACR/private/private_ring.h"
+
+// included for ACR_MALLOC and ACR_FREE
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_PLATFORM_WIN
+#include "ACR/public/public_config.h"
+
+#ifndef ACR_CONFIG_NO_LIBC
+    #ifdef ACR_PLATFORM_WIN
+        // included for CreateFileMapping and MapViewOfFileEx
+        #include <windows.h>
+        #define ACR_RING_CAN_MIRROR
+    #elif defined(__linux__)
+        // included for memfd_create, mmap, and munmap
+        #include <sys/mman.h>
+        // included for ftruncate, sysconf, and close
+        #include <unistd.h>
+        #define ACR_RING_CAN_MIRROR
+    #endif
+#endif
+
+#ifndef ACR_CONFIG_RING_MIRROR_TRIES
+/** the number of times to try mapping the memory of a
+    mirrored ring when another thread takes the address
+    space between reserving it and mapping it
+*/
+#define ACR_CONFIG_RING_MIRROR_TRIES 4
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// FILE INTERFACE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** \see ACR_FileCallbackRead_t
+*/
+ACR_Info_t _ACR_RingFileCallbackRead(
+    ACR_VarBuffer_t* dest,
+    void* userPtr);
+
+/** \see ACR_FileCallbackWrite_t
+*/
+ACR_Info_t _ACR_RingFileCallbackWrite(
+    ACR_VarBuffer_t* src,
+    void* userPtr);
+
+/** \see ACR_FileCallbackWriteChain_t
+*/
+ACR_Info_t _ACR_RingFileCallbackWriteChain(
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written,
+    void* userPtr);
+
+/** \see ACR_FileCallbackSeek_t
+*/
+ACR_Info_t _ACR_RingFileCallbackSeek(
+    ACR_Length_t moveBy,
+    ACR_Info_t fromPos,
+    void* userPtr);
+
+/** \see ACR_FileCallbackPosition_t
+*/
+ACR_Length_t _ACR_RingFileCallbackPosition(
+    void* userPtr);
+
+/** \see ACR_FileCallbackOpen_t
+*/
+ACR_Info_t _ACR_RingFileCallbackOpen(
+    ACR_String_t path,
+    ACR_Info_t mode,
+    void* userPtr);
+
+/** \see ACR_FileCallbackClose_t
+*/
+ACR_Info_t _ACR_RingFileCallbackClose(
+    void* userPtr);
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** set a buffer to reference ring memory
+*/
+void _ACR_RingSetView(
+    ACR_Buffer_t* view,
+    ACR_Byte_t* ptr,
+    ACR_Length_t length);
+
+#ifdef ACR_RING_CAN_MIRROR
+
+/** get the size that the length of mirrored memory must be a multiple of
+*/
+ACR_Length_t _ACR_RingPageSize(void);
+
+/** map the same memory twice, back to back
+    \param length a multiple of _ACR_RingPageSize()
+    \returns a pointer to (length * 2) bytes or ACR_NULL on failure
+*/
+void* _ACR_RingMapMirror(
+    ACR_Length_t length);
+
+/** unmap memory from _ACR_RingMapMirror()
+*/
+void _ACR_RingUnmapMirror(
+    void* ptr,
+    ACR_Length_t length);
+
+#endif // #ifdef ACR_RING_CAN_MIRROR
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_RingNew(
+    ACR_RingObj_t** mePtr,
+    ACR_Length_t length)
+{
+    ACR_Info_t result = ACR_INFO_ERROR;
+    if(mePtr != ACR_NULL)
+    {
+        ACR_RingObj_t* newRing = ACR_NULL;
+        if((length > ACR_ZERO_LENGTH) &&
+           (length <= (ACR_MAX_LENGTH - sizeof(ACR_RingObj_t))))
+        {
+            // the ring memory is stored right after the ring object
+            newRing = (ACR_RingObj_t*)ACR_MALLOC(sizeof(ACR_RingObj_t) + length);
+        }
+        if(newRing)
+        {
+            ACR_RingInit(newRing, &newRing[1], length);
+            result = ACR_INFO_OK;
+        }
+        (*mePtr) = newRing;
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_RingNewMirrored(
+    ACR_RingObj_t** mePtr,
+    ACR_Length_t length)
+{
+    ACR_Info_t result = ACR_INFO_ERROR;
+    if(mePtr != ACR_NULL)
+    {
+        ACR_RingObj_t* newRing = ACR_NULL;
+#ifdef ACR_RING_CAN_MIRROR
+        ACR_Length_t pageSize = _ACR_RingPageSize();
+        if((length > ACR_ZERO_LENGTH) &&
+           (length <= ((ACR_MAX_LENGTH / 2) - pageSize)))
+        {
+            length = (((length + pageSize - 1) / pageSize) * pageSize);
+            newRing = (ACR_RingObj_t*)ACR_MALLOC(sizeof(ACR_RingObj_t));
+        }
+        if(newRing)
+        {
+            void* ptr = _ACR_RingMapMirror(length);
+            if(ptr != ACR_NULL)
+            {
+                ACR_RingInit(newRing, ptr, length);
+                newRing->m_IsMirrored = ACR_BOOL_TRUE;
+                result = ACR_INFO_OK;
+            }
+            else
+            {
+                // the memory could not be mapped twice
+                ACR_FREE(newRing);
+                newRing = ACR_NULL;
+            }
+        }
+#else
+        ACR_UNUSED(length);
+#endif
+        (*mePtr) = newRing;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_RingDelete(
+    ACR_RingObj_t** mePtr)
+{
+    if(mePtr != ACR_NULL)
+    {
+        if((*mePtr) != ACR_NULL)
+        {
+#ifdef ACR_RING_CAN_MIRROR
+            if((*mePtr)->m_IsMirrored)
+            {
+                _ACR_RingUnmapMirror((*mePtr)->m_Buffer.m_Pointer, (*mePtr)->m_Buffer.m_Length);
+            }
+            else
+            {
+                // the memory is part of the ring object
+            }
+#endif
+            ACR_RingDeInit((*mePtr));
+            ACR_FREE((*mePtr));
+            (*mePtr) = ACR_NULL;
+        }
+    }
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingCapacity(
+    ACR_RingObj_t* me)
+{
+    ACR_Length_t result = ACR_ZERO_LENGTH;
+    if(me != ACR_NULL)
+    {
+        result = me->m_Buffer.m_Length;
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingUsed(
+    ACR_RingObj_t* me)
+{
+    ACR_Length_t result = ACR_ZERO_LENGTH;
+    if(me != ACR_NULL)
+    {
+        result = me->m_Used;
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingAvailable(
+    ACR_RingObj_t* me)
+{
+    ACR_Length_t result = ACR_ZERO_LENGTH;
+    if(me != ACR_NULL)
+    {
+        result = (me->m_Buffer.m_Length - me->m_Used);
+    }
+    return result;
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_RingIsMirrored(
+    ACR_RingObj_t* me)
+{
+    ACR_Bool_t result = ACR_BOOL_FALSE;
+    if(me != ACR_NULL)
+    {
+        result = me->m_IsMirrored;
+    }
+    return result;
+}
+
+/**********************************************************/
+void ACR_RingClear(
+    ACR_RingObj_t* me)
+{
+    if(me != ACR_NULL)
+    {
+        me->m_Head = ACR_ZERO_LENGTH;
+        me->m_Used = ACR_ZERO_LENGTH;
+    }
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingWrite(
+    ACR_RingObj_t* me,
+    const void* ptr,
+    ACR_Length_t length)
+{
+    ACR_BUFFER(first);
+    ACR_BUFFER(second);
+    if(ptr == ACR_NULL)
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    if(length > ACR_RingReserve(me, &first, &second))
+    {
+        // only write what fits
+        length = (first.m_Length + second.m_Length);
+    }
+    if(length == 0)
+    {
+        // nothing to copy
+        return ACR_ZERO_LENGTH;
+    }
+    if(length <= first.m_Length)
+    {
+        ACR_MEMCPY(first.m_Pointer, ptr, length);
+    }
+    else
+    {
+        ACR_MEMCPY(first.m_Pointer, ptr, first.m_Length);
+        ACR_MEMCPY(second.m_Pointer, &((const ACR_Byte_t*)ptr)[first.m_Length], (length - first.m_Length));
+    }
+    return ACR_RingProduce(me, length);
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingRead(
+    ACR_RingObj_t* me,
+    void* ptr,
+    ACR_Length_t length)
+{
+    ACR_BUFFER(first);
+    ACR_BUFFER(second);
+    if(ptr == ACR_NULL)
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    if(length > ACR_RingPeek(me, &first, &second))
+    {
+        // only read what is available
+        length = (first.m_Length + second.m_Length);
+    }
+    if(length == 0)
+    {
+        // nothing to copy
+        return ACR_ZERO_LENGTH;
+    }
+    if(length <= first.m_Length)
+    {
+        ACR_MEMCPY(ptr, first.m_Pointer, length);
+    }
+    else
+    {
+        ACR_MEMCPY(ptr, first.m_Pointer, first.m_Length);
+        ACR_MEMCPY(&((ACR_Byte_t*)ptr)[first.m_Length], second.m_Pointer, (length - first.m_Length));
+    }
+    return ACR_RingConsume(me, length);
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingPeek(
+    ACR_RingObj_t* me,
+    ACR_Buffer_t* first,
+    ACR_Buffer_t* second)
+{
+    ACR_Length_t firstLength;
+    if((me == ACR_NULL) ||
+       (first == ACR_NULL) ||
+       (second == ACR_NULL))
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    firstLength = me->m_Used;
+    if((me->m_IsMirrored == ACR_BOOL_FALSE) &&
+       (firstLength > (me->m_Buffer.m_Length - me->m_Head)))
+    {
+        // the bytes wrap to the start of the memory
+        firstLength = (me->m_Buffer.m_Length - me->m_Head);
+    }
+    _ACR_RingSetView(first, &((ACR_Byte_t*)me->m_Buffer.m_Pointer)[me->m_Head], firstLength);
+    _ACR_RingSetView(second, (ACR_Byte_t*)me->m_Buffer.m_Pointer, (me->m_Used - firstLength));
+    return me->m_Used;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingConsume(
+    ACR_RingObj_t* me,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    if(length > me->m_Used)
+    {
+        length = me->m_Used;
+    }
+    me->m_Used -= length;
+    if(me->m_Used == ACR_ZERO_LENGTH)
+    {
+        // start over at the beginning of the memory so
+        // that the next bytes are in a single segment
+        me->m_Head = ACR_ZERO_LENGTH;
+    }
+    else if(length >= (me->m_Buffer.m_Length - me->m_Head))
+    {
+        // the head wrapped to the start of the memory
+        me->m_Head = (length - (me->m_Buffer.m_Length - me->m_Head));
+    }
+    else
+    {
+        me->m_Head += length;
+    }
+    return length;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingReserve(
+    ACR_RingObj_t* me,
+    ACR_Buffer_t* first,
+    ACR_Buffer_t* second)
+{
+    ACR_Length_t tail;
+    ACR_Length_t available;
+    ACR_Length_t firstLength;
+    if((me == ACR_NULL) ||
+       (first == ACR_NULL) ||
+       (second == ACR_NULL))
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    available = (me->m_Buffer.m_Length - me->m_Used);
+    if(me->m_Used < (me->m_Buffer.m_Length - me->m_Head))
+    {
+        tail = (me->m_Head + me->m_Used);
+    }
+    else
+    {
+        // the tail wrapped to the start of the memory
+        tail = (me->m_Used - (me->m_Buffer.m_Length - me->m_Head));
+    }
+    firstLength = available;
+    if((me->m_IsMirrored == ACR_BOOL_FALSE) &&
+       (firstLength > (me->m_Buffer.m_Length - tail)))
+    {
+        // the free space wraps to the start of the memory
+        firstLength = (me->m_Buffer.m_Length - tail);
+    }
+    _ACR_RingSetView(first, &((ACR_Byte_t*)me->m_Buffer.m_Pointer)[tail], firstLength);
+    _ACR_RingSetView(second, (ACR_Byte_t*)me->m_Buffer.m_Pointer, (available - firstLength));
+    return available;
+}
+
+/**********************************************************/
+ACR_Length_t ACR_RingProduce(
+    ACR_RingObj_t* me,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        return ACR_ZERO_LENGTH;
+    }
+
+    if(length > (me->m_Buffer.m_Length - me->m_Used))
+    {
+        length = (me->m_Buffer.m_Length - me->m_Used);
+    }
+    me->m_Used += length;
+    return length;
+}
+
+/**********************************************************/
+void ACR_RingInitFileInterface(
+    ACR_RingObj_t* me,
+    ACR_FileInterface_t* fileInterface)
+{
+    if(fileInterface != ACR_NULL)
+    {
+        fileInterface->m_Open = _ACR_RingFileCallbackOpen;
+        fileInterface->m_Close = _ACR_RingFileCallbackClose;
+        fileInterface->m_Read = _ACR_RingFileCallbackRead;
+        fileInterface->m_Write = _ACR_RingFileCallbackWrite;
+        fileInterface->m_Seek = _ACR_RingFileCallbackSeek;
+        fileInterface->m_Position = _ACR_RingFileCallbackPosition;
+        fileInterface->m_Borrow = ACR_NULL;
+        fileInterface->m_WriteChain = _ACR_RingFileCallbackWriteChain;
+        fileInterface->m_User = me;
+    }
+}
+
+////////////////////////////////////////////////////////////
+//
+// FILE INTERFACE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackRead(
+    ACR_VarBuffer_t* dest,
+    void* userPtr)
+{
+    if((dest == ACR_NULL) ||
+       (userPtr == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    dest->m_Buffer.m_Length = ACR_RingRead((ACR_RingObj_t*)userPtr, dest->m_Buffer.m_Pointer, dest->m_MaxLength);
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackWrite(
+    ACR_VarBuffer_t* src,
+    void* userPtr)
+{
+    if((src == ACR_NULL) ||
+       (userPtr == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    src->m_Buffer.m_Length = ACR_RingWrite((ACR_RingObj_t*)userPtr, src->m_Buffer.m_Pointer, src->m_MaxLength);
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackWriteChain(
+    ACR_BufferChain_t* src,
+    ACR_Length_t* written,
+    void* userPtr)
+{
+    if((src == ACR_NULL) ||
+       (written == ACR_NULL) ||
+       (userPtr == ACR_NULL))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    // copy each link into the ring until it is full
+    ACR_Count_t index;
+    (*written) = 0;
+    for(index = 0; index < src->m_Count; index++)
+    {
+        ACR_Length_t length = ACR_RingWrite((ACR_RingObj_t*)userPtr, src->m_Links[index].m_Pointer, src->m_Links[index].m_Length);
+        (*written) += length;
+        if(length < src->m_Links[index].m_Length)
+        {
+            // the ring is full
+            break;
+        }
+        else
+        {
+            // continue with the next link
+        }
+    }
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackSeek(
+    ACR_Length_t moveBy,
+    ACR_Info_t fromPos,
+    void* userPtr)
+{
+    ACR_RingObj_t* ring = (ACR_RingObj_t*)userPtr;
+    if(ring == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if((fromPos == ACR_INFO_CURRENT) &&
+       (moveBy <= ring->m_Used))
+    {
+        // skip the bytes
+        ACR_RingConsume(ring, moveBy);
+        return ACR_INFO_OK;
+    }
+
+    // bytes that were consumed cannot be read again
+    return ACR_INFO_ERROR;
+}
+
+/**********************************************************/
+ACR_Length_t _ACR_RingFileCallbackPosition(
+    void* userPtr)
+{
+    return ACR_RingUsed((ACR_RingObj_t*)userPtr);
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackOpen(
+    ACR_String_t path,
+    ACR_Info_t mode,
+    void* userPtr)
+{
+    ACR_UNUSED(path);
+
+    if(userPtr == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if((mode != ACR_INFO_READ) &&
+       (mode != ACR_INFO_WRITE) &&
+       (mode != ACR_INFO_READ_WRITE))
+    {
+        // invalid mode
+        return ACR_INFO_ERROR;
+    }
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_RingFileCallbackClose(
+    void* userPtr)
+{
+    if(userPtr == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    return ACR_INFO_OK;
+}
+
+////////////////////////////////////////////////////////////
+//
+// PRIVATE FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void ACR_RingInit(
+    ACR_RingObj_t* me,
+    void* ptr,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    if(ptr != ACR_NULL)
+    {
+        me->m_Buffer.m_Pointer = ptr;
+        me->m_Buffer.m_Length = length;
+    }
+    else
+    {
+        // no memory available
+        me->m_Buffer.m_Pointer = ACR_NULL;
+        me->m_Buffer.m_Length = ACR_ZERO_LENGTH;
+    }
+    me->m_Buffer.m_Flags = ACR_BUFFER_IS_REF;
+    me->m_Head = ACR_ZERO_LENGTH;
+    me->m_Used = ACR_ZERO_LENGTH;
+    me->m_IsMirrored = ACR_BOOL_FALSE;
+}
+
+/**********************************************************/
+void ACR_RingDeInit(
+    ACR_RingObj_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        return;
+    }
+
+    ACR_BUFFER_FREE(me->m_Buffer);
+    me->m_Head = ACR_ZERO_LENGTH;
+    me->m_Used = ACR_ZERO_LENGTH;
+    me->m_IsMirrored = ACR_BOOL_FALSE;
+}
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+void _ACR_RingSetView(
+    ACR_Buffer_t* view,
+    ACR_Byte_t* ptr,
+    ACR_Length_t length)
+{
+    if(length > ACR_ZERO_LENGTH)
+    {
+        view->m_Pointer = ptr;
+        view->m_Length = length;
+    }
+    else
+    {
+        // nothing to reference
+        view->m_Pointer = ACR_NULL;
+        view->m_Length = ACR_ZERO_LENGTH;
+    }
+    view->m_Flags = ACR_BUFFER_IS_REF;
+}
+
+#ifdef ACR_RING_CAN_MIRROR
+
+/**********************************************************/
+ACR_Length_t _ACR_RingPageSize(void)
+{
+#ifdef ACR_PLATFORM_WIN
+    // views must start at the allocation granularity
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (ACR_Length_t)info.dwAllocationGranularity;
+#else
+    return (ACR_Length_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/**********************************************************/
+void* _ACR_RingMapMirror(
+    ACR_Length_t length)
+{
+#ifdef ACR_PLATFORM_WIN
+    void* result = ACR_NULL;
+    int tries;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, ACR_NULL, PAGE_READWRITE, (DWORD)(((unsigned long long)length) >> 32), (DWORD)(length & 0xFFFFFFFF), ACR_NULL);
+    if(mapping == ACR_NULL)
+    {
+        return ACR_NULL;
+    }
+
+    for(tries = 0; tries < ACR_CONFIG_RING_MIRROR_TRIES; tries++)
+    {
+        // find enough address space for both views
+        // and then map the views into it
+        ACR_Byte_t* base = (ACR_Byte_t*)VirtualAlloc(ACR_NULL, (SIZE_T)(length * 2), MEM_RESERVE, PAGE_NOACCESS);
+        void* firstView;
+        void* secondView;
+        if(base == ACR_NULL)
+        {
+            break;
+        }
+        VirtualFree(base, 0, MEM_RELEASE);
+        firstView = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)length, base);
+        secondView = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)length, &base[length]);
+        if((firstView == base) &&
+           (secondView == &base[length]))
+        {
+            result = base;
+            break;
+        }
+
+        // another thread took part of the address space
+        if(firstView != ACR_NULL)
+        {
+            UnmapViewOfFile(firstView);
+        }
+        if(secondView != ACR_NULL)
+        {
+            UnmapViewOfFile(secondView);
+        }
+    }
+
+    // the views keep the mapping open
+    CloseHandle(mapping);
+    return result;
+#else
+    ACR_Byte_t* base;
+    int fd = memfd_create("ACR_Ring", 0);
+    if(fd < 0)
+    {
+        return ACR_NULL;
+    }
+
+    if(ftruncate(fd, (off_t)length) != 0)
+    {
+        close(fd);
+        return ACR_NULL;
+    }
+
+    // reserve the address space for both views
+    // and then replace it with the views
+    base = (ACR_Byte_t*)mmap(ACR_NULL, (size_t)(length * 2), PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+    if(base == (ACR_Byte_t*)MAP_FAILED)
+    {
+        close(fd);
+        return ACR_NULL;
+    }
+    if((mmap(base, (size_t)length, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0) == MAP_FAILED) ||
+       (mmap(&base[length], (size_t)length, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0) == MAP_FAILED))
+    {
+        munmap(base, (size_t)(length * 2));
+        base = ACR_NULL;
+    }
+
+    // the views keep the memory open
+    close(fd);
+    return base;
+#endif
+}
+
+/**********************************************************/
+void _ACR_RingUnmapMirror(
+    void* ptr,
+    ACR_Length_t length)
+{
+#ifdef ACR_PLATFORM_WIN
+    UnmapViewOfFile(ptr);
+    UnmapViewOfFile(&((ACR_Byte_t*)ptr)[length]);
+#else
+    munmap(ptr, (size_t)(length * 2));
+#endif
+}
+
+#endif // #ifdef ACR_RING_CAN_MIRROR
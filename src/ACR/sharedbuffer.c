@@ -0,0 +1,298 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file sharedbuffer.c
+
+    public and private functions for access to the ACR_SharedBuffer_t type
+
+*/
+#include "ACR/sharedbuffer.h"
+
+// included for ACR_MALLOC and ACR_FREE
+#include "ACR/public/public_heap.h"
+
+// included for ACR_MIN_BLOCKS_NEEDED and ACR_BYTES_PER_BLOCK
+#include "ACR/public/public_blocks.h"
+
+// included for ACR_COMPILER_MSVC
+#include "ACR/public/public_config.h"
+
+////////////////////////////////////////////////////////////
+//
+// DEFINES
+//
+////////////////////////////////////////////////////////////
+
+#ifdef ACR_COMPILER_MSVC
+    // included for InterlockedIncrement and InterlockedDecrement
+    #include <windows.h>
+
+    #define ACR_SHARED_BUFFER_ATOMIC_LOAD(p) ((ACR_Count_t)InterlockedCompareExchange((LONG volatile*)(p), 0, 0))
+    #define ACR_SHARED_BUFFER_ATOMIC_INCREMENT(p) ((ACR_Count_t)InterlockedIncrement((LONG volatile*)(p)))
+    #define ACR_SHARED_BUFFER_ATOMIC_DECREMENT(p) ((ACR_Count_t)InterlockedDecrement((LONG volatile*)(p)))
+#else
+    #define ACR_SHARED_BUFFER_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ACR_SHARED_BUFFER_ATOMIC_INCREMENT(p) __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+    #define ACR_SHARED_BUFFER_ATOMIC_DECREMENT(p) __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#endif
+
+/** the memory shared by one or more ACR_SharedBuffer_t
+    Note: the shared bytes follow this header at
+          ACR_SHARED_BLOCK_HEADER_LENGTH so that they
+          are aligned the same as memory from ACR_MALLOC
+*/
+struct ACR_SharedBlock_s
+{
+    /** the number of shared buffers that refer to this block.
+        only changed with ACR_SHARED_BUFFER_ATOMIC_INCREMENT
+        and ACR_SHARED_BUFFER_ATOMIC_DECREMENT
+    */
+    ACR_Count_t m_ShareCount;
+};
+
+/** the number of bytes from the start of a block to its shared bytes
+*/
+#define ACR_SHARED_BLOCK_HEADER_LENGTH (ACR_MIN_BLOCKS_NEEDED(sizeof(ACR_SharedBlock_t)) * ACR_BYTES_PER_BLOCK)
+
+/** get the shared bytes of a block
+*/
+#define ACR_SHARED_BLOCK_GET_MEMORY(block) (((ACR_Byte_t*)(block)) + ACR_SHARED_BLOCK_HEADER_LENGTH)
+
+////////////////////////////////////////////////////////////
+//
+// PUBLIC FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t ACR_SharedBufferAllocate(
+    ACR_SharedBuffer_t* me,
+    ACR_Length_t length)
+{
+    if(me == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    ACR_SharedBufferRelease(me);
+    if(length == ACR_ZERO_LENGTH)
+    {
+        // nothing to allocate
+        return ACR_INFO_OK;
+    }
+
+    ACR_SharedBlock_t* block = (ACR_SharedBlock_t*)ACR_MALLOC(ACR_SHARED_BLOCK_HEADER_LENGTH + length);
+    if(block == ACR_NULL)
+    {
+        // could not allocate memory
+        return ACR_INFO_ERROR;
+    }
+
+    block->m_ShareCount = 1;
+    me->m_Block = block;
+    me->m_Buffer.m_Pointer = ACR_SHARED_BLOCK_GET_MEMORY(block);
+    me->m_Buffer.m_Length = length;
+    me->m_Buffer.m_Flags = ACR_BUFFER_IS_REF;
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_SharedBufferCopyFrom(
+    ACR_SharedBuffer_t* me,
+    const void* data,
+    ACR_Length_t length)
+{
+    if((data == ACR_NULL) &&
+       (length > 0))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    ACR_Info_t result = ACR_SharedBufferAllocate(me, length);
+    if((result == ACR_INFO_OK) &&
+       (length > 0))
+    {
+        ACR_MEMCPY(me->m_Buffer.m_Pointer, data, length);
+    }
+    else
+    {
+        // nothing to copy or could not allocate
+    }
+
+    return result;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_SharedBufferShare(
+    ACR_SharedBuffer_t* me,
+    ACR_SharedBuffer_t* dest)
+{
+    if(me == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    return ACR_SharedBufferSlice(me, 0, me->m_Buffer.m_Length, dest);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_SharedBufferSlice(
+    ACR_SharedBuffer_t* me,
+    ACR_Length_t pos,
+    ACR_Length_t length,
+    ACR_SharedBuffer_t* dest)
+{
+    if((me == ACR_NULL) ||
+       (dest == ACR_NULL) ||
+       (dest == me))
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if((pos > me->m_Buffer.m_Length) ||
+       (length > (me->m_Buffer.m_Length - pos)))
+    {
+        // the range is not in me
+        return ACR_INFO_ERROR;
+    }
+
+    // count the new reference before releasing the old one
+    // in case dest already refers to the same block
+    if(me->m_Block != ACR_NULL)
+    {
+        ACR_SHARED_BUFFER_ATOMIC_INCREMENT(&me->m_Block->m_ShareCount);
+    }
+    else
+    {
+        // me is empty so dest will be empty too
+    }
+    ACR_SharedBufferRelease(dest);
+
+    dest->m_Block = me->m_Block;
+    dest->m_Buffer.m_Pointer = (me->m_Block != ACR_NULL) ? (((ACR_Byte_t*)me->m_Buffer.m_Pointer) + pos) : ACR_NULL;
+    dest->m_Buffer.m_Length = length;
+    dest->m_Buffer.m_Flags = ACR_BUFFER_IS_REF;
+
+    return ACR_INFO_OK;
+}
+
+/**********************************************************/
+void ACR_SharedBufferRelease(
+    ACR_SharedBuffer_t* me)
+{
+    if(me)
+    {
+        if(me->m_Block != ACR_NULL)
+        {
+            if(ACR_SHARED_BUFFER_ATOMIC_DECREMENT(&me->m_Block->m_ShareCount) == 0)
+            {
+                // no other shared buffer refers to the memory
+                ACR_FREE(me->m_Block);
+            }
+            else
+            {
+                // another shared buffer will free the memory
+            }
+        }
+        else
+        {
+            // nothing to release
+        }
+        me->m_Block = ACR_NULL;
+        me->m_Buffer.m_Pointer = ACR_NULL;
+        me->m_Buffer.m_Length = ACR_ZERO_LENGTH;
+        me->m_Buffer.m_Flags = ACR_BUFFER_FLAGS_NONE;
+    }
+}
+
+/**********************************************************/
+ACR_Count_t ACR_SharedBufferGetShareCount(
+    ACR_SharedBuffer_t* me)
+{
+    if((me != ACR_NULL) &&
+       (me->m_Block != ACR_NULL))
+    {
+        return ACR_SHARED_BUFFER_ATOMIC_LOAD(&me->m_Block->m_ShareCount);
+    }
+    return ACR_ZERO_COUNT;
+}
+
+/**********************************************************/
+ACR_Bool_t ACR_SharedBufferIsUnique(
+    ACR_SharedBuffer_t* me)
+{
+    // the count can only be 1 when me holds the only
+    // reference so no other thread can increase it
+    return (ACR_SharedBufferGetShareCount(me) <= 1) ? ACR_BOOL_TRUE : ACR_BOOL_FALSE;
+}
+
+/**********************************************************/
+ACR_Info_t ACR_SharedBufferMakeWritable(
+    ACR_SharedBuffer_t* me)
+{
+    if(me == ACR_NULL)
+    {
+        // invalid pointer
+        return ACR_INFO_ERROR;
+    }
+
+    if(ACR_SharedBufferIsUnique(me))
+    {
+        // no other shared buffer can see a change
+        return ACR_INFO_OK;
+    }
+
+    // copy only the bytes of me and then
+    // stop referring to the shared block
+    ACR_SHARED_BUFFER(copy);
+    if(ACR_SharedBufferCopyFrom(&copy, me->m_Buffer.m_Pointer, me->m_Buffer.m_Length) != ACR_INFO_OK)
+    {
+        // could not allocate the copy
+        return ACR_INFO_ERROR;
+    }
+    ACR_SharedBufferRelease(me);
+    (*me) = copy;
+
+    return ACR_INFO_OK;
+}
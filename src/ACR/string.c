@@ -44,6 +44,9 @@
 */
 #include "ACR/string.h"
 
+// included for ACR_AllocatorNew() and ACR_AllocatorDelete()
+#include "ACR/allocator.h"
+
 ////////////////////////////////////////////////////////////
 //
 // PUBLIC FUNCTIONS
@@ -53,19 +56,25 @@
 /**********************************************************/
 ACR_Info_t ACR_StringNew(
 	ACR_String_t** mePtr)
+{
+	return ACR_StringNewWithAllocator(mePtr, ACR_NULL);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_StringNewWithAllocator(
+	ACR_String_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator)
 {
 	ACR_Info_t result = ACR_INFO_ERROR;
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
-		ACR_BUFFER_ALLOC(buffer, sizeof(ACR_String_t));
-		if(ACR_BUFFER_IS_VALID(buffer))
+		ACR_String_t* newObj = (ACR_String_t*)ACR_AllocatorNew(allocator, sizeof(ACR_String_t));
+		if(newObj != ACR_NULL)
 		{
-			ACR_StringInit((ACR_String_t*)buffer.m_Pointer);
+			ACR_StringInit(newObj);
 			result = ACR_INFO_OK;
 		}
-		(*mePtr) = (ACR_String_t*)buffer.m_Pointer;
+		(*mePtr) = newObj;
 	}
 	return result;
 }
@@ -76,11 +85,8 @@ void ACR_StringDelete(
 {
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
 		ACR_StringDeInit((*mePtr));
-		ACR_BUFFER_SET_DATA(buffer, (*mePtr), sizeof(ACR_String_t));
-		ACR_BUFFER_FORCE_FREE(buffer);
+		ACR_AllocatorDelete((*mePtr));
 		(*mePtr) = ACR_NULL;
 	}
 }
@@ -97,6 +103,7 @@ void ACR_StringInit(
 	me->m_Count = ACR_EMPTY_VALUE;
 	me->m_Buffer.m_Pointer = ACR_NULL;
 	me->m_Buffer.m_Length = ACR_ZERO_LENGTH;
+	me->m_Buffer.m_Flags = ACR_BUFFER_FLAGS_NONE;
 }
 
 /**********************************************************/
@@ -110,3 +117,84 @@ void ACR_StringDeInit(
 
 	ACR_BUFFER_FREE(me->m_Buffer);
 }
+
+/**********************************************************/
+void ACR_SmallStringInit(
+	ACR_SmallString_t* me)
+{
+	if(me == ACR_NULL)
+	{
+		return;
+	}
+
+	ACR_StringInit(&me->m_String);
+	me->m_Inline[0] = 0;
+	ACR_STRING_SET_DATA(me->m_String, me->m_Inline, ACR_ZERO_LENGTH, ACR_ZERO_COUNT);
+}
+
+/**********************************************************/
+void ACR_SmallStringDeInit(
+	ACR_SmallString_t* me)
+{
+	if(me == ACR_NULL)
+	{
+		return;
+	}
+
+	// the inline memory is a reference so only heap memory is freed
+	ACR_BUFFER_FREE(me->m_String.m_Buffer);
+	ACR_SmallStringInit(me);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_SmallStringSet(
+	ACR_SmallString_t* me,
+	const void* data,
+	ACR_Length_t length)
+{
+	const ACR_Byte_t* bytes = (const ACR_Byte_t*)data;
+	ACR_Count_t count = ACR_ZERO_COUNT;
+	ACR_Length_t i;
+
+	if((me == ACR_NULL) ||
+	   ((data == ACR_NULL) && (length > 0)))
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	// release heap memory from a longer string
+	ACR_BUFFER_FREE(me->m_String.m_Buffer);
+	if(length < ACR_CONFIG_SMALL_BUFFER_LENGTH)
+	{
+		// short enough for the inline memory
+		ACR_BUFFER_SET_DATA(me->m_String.m_Buffer, me->m_Inline, length);
+	}
+	else
+	{
+		ACR_BUFFER_ALLOC(me->m_String.m_Buffer, length);
+		if(me->m_String.m_Buffer.m_Pointer == ACR_NULL)
+		{
+			// return to an empty string
+			ACR_SmallStringInit(me);
+			return ACR_INFO_ERROR;
+		}
+	}
+
+	if(length > 0)
+	{
+		ACR_MEMCPY(me->m_String.m_Buffer.m_Pointer, data, length);
+	}
+	((ACR_Byte_t*)me->m_String.m_Buffer.m_Pointer)[length] = 0;
+
+	// count every byte that does not continue a character
+	for(i = 0; i < length; i++)
+	{
+		if((bytes[i] & 0xC0) != 0x80)
+		{
+			count++;
+		}
+	}
+	me->m_String.m_Count = count;
+
+	return ACR_INFO_OK;
+}
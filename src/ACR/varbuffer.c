@@ -44,6 +44,50 @@
 */
 #include "ACR/varbuffer.h"
 
+// included for ACR_AllocatorNew() and ACR_AllocatorDelete()
+#include "ACR/allocator.h"
+
+#ifndef ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT
+/** the new max length of a growable buffer as a percent
+    of the old max length. growing by a factor instead of
+    by the amount needed keeps appends O(1) on average
+*/
+#define ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT 150
+#endif
+
+#ifndef ACR_CONFIG_VAR_BUFFER_HEADROOM
+/** the least headroom that ACR_VarBufferPrepend() leaves
+    when it has to move the data to make room
+*/
+#define ACR_CONFIG_VAR_BUFFER_HEADROOM 64
+#endif
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/** make room for length more bytes if the buffer can grow
+    \returns ACR_INFO_OK if length more bytes fit
+*/
+ACR_Info_t _ACR_VarBufferMakeRoom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length);
+
+/** make sure there are at least length bytes of headroom by
+    moving the data once, growing the memory first if needed
+    \param me the buffer
+    \param length the headroom needed
+    \param extraLength the headroom to add beyond length when
+           the data has to be moved anyway
+    \returns ACR_INFO_OK if there are at least length bytes of headroom
+*/
+ACR_Info_t _ACR_VarBufferMakeHeadroom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t extraLength);
+
 ////////////////////////////////////////////////////////////
 //
 // PUBLIC FUNCTIONS
@@ -53,19 +97,25 @@
 /**********************************************************/
 ACR_Info_t ACR_VarBufferNew(
 	ACR_VarBuffer_t** mePtr)
+{
+	return ACR_VarBufferNewWithAllocator(mePtr, ACR_NULL);
+}
+
+/**********************************************************/
+ACR_Info_t ACR_VarBufferNewWithAllocator(
+	ACR_VarBuffer_t** mePtr,
+	const ACR_AllocatorInterface_t* allocator)
 {
 	ACR_Info_t result = ACR_INFO_ERROR;
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
-		ACR_BUFFER_ALLOC(buffer, sizeof(ACR_VarBuffer_t));
-		if(ACR_BUFFER_IS_VALID(buffer))
+		ACR_VarBuffer_t* newObj = (ACR_VarBuffer_t*)ACR_AllocatorNew(allocator, sizeof(ACR_VarBuffer_t));
+		if(newObj != ACR_NULL)
 		{
-			ACR_VarBufferInit((ACR_VarBuffer_t*)buffer.m_Pointer);
+			ACR_VarBufferInit(newObj);
 			result = ACR_INFO_OK;
 		}
-		(*mePtr) = (ACR_VarBuffer_t*)buffer.m_Pointer;
+		(*mePtr) = newObj;
 	}
 	return result;
 }
@@ -76,11 +126,8 @@ void ACR_VarBufferDelete(
 {
 	if(mePtr != ACR_NULL)
 	{
-		ACR_BUFFER(buffer);
-
 		ACR_VarBufferDeInit((*mePtr));
-		ACR_BUFFER_SET_DATA(buffer, (*mePtr), sizeof(ACR_VarBuffer_t));
-		ACR_BUFFER_FORCE_FREE(buffer);
+		ACR_AllocatorDelete((*mePtr));
 		(*mePtr) = ACR_NULL;
 	}
 }
@@ -97,6 +144,8 @@ void ACR_VarBufferInit(
 	me->m_MaxLength = ACR_ZERO_LENGTH;
 	me->m_Buffer.m_Length = ACR_ZERO_LENGTH;
 	me->m_Buffer.m_Pointer = ACR_NULL;
+	me->m_Buffer.m_Flags = ACR_BUFFER_FLAGS_NONE;
+	me->m_Headroom = ACR_ZERO_LENGTH;
 }
 
 /**********************************************************/
@@ -194,6 +243,102 @@ ACR_Info_t ACR_VarBufferSetLength(
 	return ACR_INFO_OK;
 }
 
+/**********************************************************/
+ACR_Info_t ACR_VarBufferReserve(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length)
+{
+	if(me == ACR_NULL)
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	if(length <= me->m_MaxLength)
+	{
+		// already enough memory
+		return ACR_INFO_OK;
+	}
+
+#if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+	{
+		void* newPtr;
+		ACR_Length_t totalLength = me->m_Headroom + length + 1;
+		if(totalLength <= length)
+		{
+			// no room for the headroom and terminating zero
+			return ACR_INFO_ERROR;
+		}
+
+		if((me->m_Buffer.m_Pointer != ACR_NULL) &&
+		   (ACR_HAS_FLAG(me->m_Buffer.m_Flags, ACR_BUFFER_IS_REF) == ACR_BOOL_FALSE))
+		{
+			// the memory belongs to this buffer
+			newPtr = (void*)ACR_REALLOC(ACR_VAR_BUFFER_GET_MEMORY((*me)), totalLength);
+		}
+		else
+		{
+			// referenced memory cannot be reallocated
+			// so copy its data to new memory instead
+			newPtr = (void*)ACR_MALLOC(totalLength);
+			if((newPtr != ACR_NULL) &&
+			   (me->m_Buffer.m_Length > 0))
+			{
+				ACR_MEMCPY(((ACR_Byte_t*)newPtr) + me->m_Headroom, me->m_Buffer.m_Pointer, me->m_Buffer.m_Length);
+			}
+		}
+
+		if(newPtr == ACR_NULL)
+		{
+			// the existing memory is unchanged
+			return ACR_INFO_ERROR;
+		}
+
+		newPtr = (void*)(((ACR_Byte_t*)newPtr) + me->m_Headroom);
+		((ACR_Byte_t*)newPtr)[length] = 0;
+		me->m_Buffer.m_Pointer = newPtr;
+		me->m_MaxLength = length;
+		ACR_REMOVE_FLAGS(me->m_Buffer.m_Flags, ACR_BUFFER_IS_REF);
+		return ACR_INFO_OK;
+	}
+#else
+	// cannot allocate more memory
+	return ACR_INFO_ERROR;
+#endif // #if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+}
+
+/**********************************************************/
+void ACR_VarBufferSetGrowable(
+	ACR_VarBuffer_t* me,
+	ACR_Bool_t canGrow)
+{
+	if(me == ACR_NULL)
+	{
+		return;
+	}
+
+	if(canGrow)
+	{
+		ACR_ADD_FLAGS(me->m_Buffer.m_Flags, ACR_BUFFER_CAN_GROW);
+	}
+	else
+	{
+		ACR_REMOVE_FLAGS(me->m_Buffer.m_Flags, ACR_BUFFER_CAN_GROW);
+	}
+}
+
+/**********************************************************/
+ACR_Info_t ACR_VarBufferReserveHeadroom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length)
+{
+	if(me == ACR_NULL)
+	{
+		return ACR_INFO_ERROR;
+	}
+
+	return _ACR_VarBufferMakeHeadroom(me, length, 0);
+}
+
 /**********************************************************/
 ACR_Info_t ACR_VarBufferAppend(
 	ACR_VarBuffer_t* me,
@@ -203,7 +348,7 @@ ACR_Info_t ACR_VarBufferAppend(
 	if(me != ACR_NULL)
 	{
 		// do what ACR_VAR_BUFFER_APPEND does but with error checking
-		if(length <= (me->m_MaxLength - me->m_Buffer.m_Length))
+		if(_ACR_VarBufferMakeRoom(me, length) == ACR_INFO_OK)
 		{
 			if(srcPtr != ACR_NULL)
 			{
@@ -228,17 +373,14 @@ ACR_Info_t ACR_VarBufferPrepend(
 {
 	if(me != ACR_NULL)
 	{
-		if(length <= (me->m_MaxLength - me->m_Buffer.m_Length))
+		if(_ACR_VarBufferMakeHeadroom(me, length, ACR_CONFIG_VAR_BUFFER_HEADROOM) == ACR_INFO_OK)
 		{
-			if(me->m_Buffer.m_Length > 0)
-			{
-				me->m_Buffer.m_Length += length;
-				/// \todo shift
-			}
-			else
-			{
-				me->m_Buffer.m_Length += length;
-			}
+			// the data that is already in the
+			// buffer stays where it is
+			me->m_Buffer.m_Pointer = (void*)(((ACR_Byte_t*)me->m_Buffer.m_Pointer) - length);
+			me->m_Headroom -= length;
+			me->m_MaxLength += length;
+			me->m_Buffer.m_Length += length;
 			if(srcPtr != ACR_NULL)
 			{
 				ACR_MEMCPY(me->m_Buffer.m_Pointer, srcPtr, length);
@@ -250,6 +392,23 @@ ACR_Info_t ACR_VarBufferPrepend(
 	return ACR_INFO_ERROR;
 }
 
+/**********************************************************/
+void ACR_SmallVarBufferInit(
+	ACR_SmallVarBuffer_t* me)
+{
+	if(me == ACR_NULL)
+	{
+		return;
+	}
+
+	// the inline memory is a reference so that it is never
+	// freed and is copied to the heap when the buffer grows
+	ACR_VarBufferInit(&me->m_VarBuffer);
+	me->m_Inline[ACR_CONFIG_SMALL_BUFFER_LENGTH - 1] = 0;
+	ACR_VAR_BUFFER_SET_MEMORY(me->m_VarBuffer, me->m_Inline, (ACR_CONFIG_SMALL_BUFFER_LENGTH - 1));
+	ACR_ADD_FLAGS(me->m_VarBuffer.m_Buffer.m_Flags, ACR_BUFFER_CAN_GROW);
+}
+
 /**********************************************************/
 void ACR_VarBufferClear(
 	ACR_VarBuffer_t* me)
@@ -261,3 +420,136 @@ void ACR_VarBufferClear(
 
 	ACR_BUFFER_CLEAR(me->m_Buffer);
 }
+
+////////////////////////////////////////////////////////////
+//
+// HELPER FUNCTIONS
+//
+////////////////////////////////////////////////////////////
+
+/**********************************************************/
+ACR_Info_t _ACR_VarBufferMakeRoom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length)
+{
+	ACR_Length_t needed;
+	ACR_Length_t grown;
+
+	if(length <= (me->m_MaxLength - me->m_Buffer.m_Length))
+	{
+		// already fits
+		return ACR_INFO_OK;
+	}
+
+	if(ACR_HAS_FLAG(me->m_Buffer.m_Flags, ACR_BUFFER_CAN_GROW) == ACR_BOOL_FALSE)
+	{
+		// the max length is fixed
+		return ACR_INFO_ERROR;
+	}
+
+	needed = me->m_Buffer.m_Length + length;
+	if(needed < length)
+	{
+		// the length wrapped around
+		return ACR_INFO_ERROR;
+	}
+
+	// grow by a factor so that the number of reallocations
+	// is logarithmic in the final length
+	grown = me->m_MaxLength +
+		((me->m_MaxLength / 100) * (ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT - 100)) +
+		(((me->m_MaxLength % 100) * (ACR_CONFIG_VAR_BUFFER_GROWTH_PERCENT - 100)) / 100);
+	if((grown < me->m_MaxLength) ||
+	   (grown < needed))
+	{
+		// the factor would wrap around or is not enough
+		grown = needed;
+	}
+
+	if(ACR_VarBufferReserve(me, grown) != ACR_INFO_OK)
+	{
+		// try again with just the memory needed
+		return ACR_VarBufferReserve(me, needed);
+	}
+	return ACR_INFO_OK;
+}
+
+/**********************************************************/
+ACR_Info_t _ACR_VarBufferMakeHeadroom(
+	ACR_VarBuffer_t* me,
+	ACR_Length_t length,
+	ACR_Length_t extraLength)
+{
+	ACR_Length_t spare;
+	ACR_Length_t headroom;
+	ACR_Byte_t* memory;
+
+	if(length <= me->m_Headroom)
+	{
+		// already enough headroom
+		return ACR_INFO_OK;
+	}
+
+	if(me->m_Buffer.m_Pointer == ACR_NULL)
+	{
+		// nothing to move into
+		if(_ACR_VarBufferMakeRoom(me, length) != ACR_INFO_OK)
+		{
+			return ACR_INFO_ERROR;
+		}
+	}
+
+	// leave more headroom the more data there is, so that the
+	// data is only moved a few times while many headers are prepended
+	if(extraLength > 0)
+	{
+		if(extraLength < (me->m_Buffer.m_Length / 2))
+		{
+			extraLength = (me->m_Buffer.m_Length / 2);
+		}
+	}
+	headroom = length + extraLength;
+	if(headroom < length)
+	{
+		// the length wrapped around
+		headroom = length;
+	}
+
+	// all of the bytes that are not data can be headroom
+	spare = me->m_Headroom + (me->m_MaxLength - me->m_Buffer.m_Length);
+	if((spare < headroom) &&
+	   ACR_HAS_FLAG(me->m_Buffer.m_Flags, ACR_BUFFER_CAN_GROW))
+	{
+		// grow at the end and move the data
+		// forward into the new memory below
+		if(_ACR_VarBufferMakeRoom(me, (me->m_MaxLength - me->m_Buffer.m_Length) + (headroom - spare)) == ACR_INFO_OK)
+		{
+			spare = me->m_Headroom + (me->m_MaxLength - me->m_Buffer.m_Length);
+		}
+	}
+
+	if(spare < length)
+	{
+		// the max length is fixed or the memory could not grow
+		return ACR_INFO_ERROR;
+	}
+
+	if(spare < headroom)
+	{
+		// split what is left between
+		// the front and the back
+		headroom = length + ((spare - length) / 2);
+	}
+
+	// move the data once so that the
+	// front has the requested headroom
+	memory = (ACR_Byte_t*)ACR_VAR_BUFFER_GET_MEMORY((*me));
+	if(me->m_Buffer.m_Length > 0)
+	{
+		ACR_MEMMOVE(memory + headroom, me->m_Buffer.m_Pointer, me->m_Buffer.m_Length);
+	}
+	me->m_MaxLength = (me->m_Headroom + me->m_MaxLength) - headroom;
+	me->m_Buffer.m_Pointer = (void*)(memory + headroom);
+	me->m_Headroom = headroom;
+	return ACR_INFO_OK;
+}
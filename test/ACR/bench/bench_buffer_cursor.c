@@ -0,0 +1,201 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bench_buffer_cursor.c
+
+    application to time reading every byte of a buffer with
+    ACR_BufferGetByteAt() compared to reading it with a cursor
+    from ACR_BufferGetCursor() and report the bytes read per second
+
+    usage: bench_buffer_cursor [buffer size in bytes]
+
+    Note: requires the standard C library
+
+*/
+#include "ACR/buffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for printf
+#include <stdio.h>
+
+// included for malloc, free, and strtoul
+#include <stdlib.h>
+
+#ifdef ACR_PLATFORM_WIN
+    // included for QueryPerformanceCounter
+    #include <windows.h>
+#else
+    // included for clock_gettime
+    #include <time.h>
+#endif
+
+//
+// PROTOTYPES
+//
+
+/** get a time in nanoseconds for measuring how long something takes
+*/
+unsigned long long BenchNanoseconds(void);
+
+/** print the time and bytes per second for one way of reading
+*/
+void BenchPrint(
+    const char* name,
+    ACR_Length_t length,
+    unsigned long long elapsed,
+    unsigned long sum);
+
+//
+// MAIN
+//
+
+/** the default buffer size
+*/
+#define BENCH_DEFAULT_LENGTH (1024UL * 1024UL)
+
+/** the number of times to read the buffer
+*/
+#define BENCH_REPEAT 16
+
+int main(int argc, char** argv)
+{
+    ACR_Length_t length = BENCH_DEFAULT_LENGTH;
+    ACR_BufferObj_t* buffer;
+    ACR_Byte_t* data;
+    ACR_Length_t i;
+    unsigned long long start;
+    unsigned long sum;
+    int repeat;
+
+    if(argc > 1)
+    {
+        length = (ACR_Length_t)strtoul(argv[1], ACR_NULL, 10);
+    }
+
+    data = (ACR_Byte_t*)malloc((size_t)length);
+    if((data == ACR_NULL) ||
+       (ACR_BufferNew(&buffer) != ACR_INFO_OK))
+    {
+        printf("could not allocate %lu bytes\n", (unsigned long)length);
+        free(data);
+        return ACR_FAILURE;
+    }
+    for(i = 0; i < length; i++)
+    {
+        data[i] = (ACR_Byte_t)(i % 251);
+    }
+    ACR_BufferSetData(buffer, data, length);
+
+    printf("%-10s %-12s %14s %12s\n", "method", "length", "ns", "MB/sec");
+
+    // every byte is checked
+    sum = 0;
+    start = BenchNanoseconds();
+    for(repeat = 0; repeat < BENCH_REPEAT; repeat++)
+    {
+        for(i = 0; i < length; i++)
+        {
+            ACR_Byte_t value;
+            ACR_BufferGetByteAt(buffer, i, &value);
+            sum += value;
+        }
+    }
+    BenchPrint("byteat", length, BenchNanoseconds() - start, sum);
+
+    // the range is checked once per pass
+    sum = 0;
+    start = BenchNanoseconds();
+    for(repeat = 0; repeat < BENCH_REPEAT; repeat++)
+    {
+        ACR_CURSOR(cursor);
+        ACR_BufferGetCursor(buffer, 0, length, &cursor);
+        while(ACR_CURSOR_HAS(cursor, 1))
+        {
+            sum += ACR_CURSOR_READ_BYTE(cursor);
+        }
+    }
+    BenchPrint("cursor", length, BenchNanoseconds() - start, sum);
+
+    ACR_BufferDelete(&buffer);
+    free(data);
+
+    return ACR_SUCCESS;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/**********************************************************/
+unsigned long long BenchNanoseconds(void)
+{
+#ifdef ACR_PLATFORM_WIN
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)((counter.QuadPart * 1000000000.0) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+/**********************************************************/
+void BenchPrint(
+    const char* name,
+    ACR_Length_t length,
+    unsigned long long elapsed,
+    unsigned long sum)
+{
+    // the sum is printed so that the reads cannot be optimized away
+    if(elapsed == 0)
+    {
+        elapsed = 1;
+    }
+    printf("%-10s %-12lu %14llu %12.1f (sum %lu)\n",
+        name,
+        (unsigned long)length,
+        elapsed,
+        ((double)length * BENCH_REPEAT / (1024.0 * 1024.0)) / ((double)elapsed / 1000000000.0),
+        sum);
+}
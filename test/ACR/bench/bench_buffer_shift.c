@@ -0,0 +1,201 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bench_buffer_shift.c
+
+    application to time ACR_BufferShift() with wrap across
+    buffer sizes and shift distances and report the time of
+    each shift and the bytes rotated per second
+
+    usage: bench_buffer_shift [largest buffer size in bytes]
+
+    Note: requires the standard C library
+
+*/
+#include "ACR/buffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for printf
+#include <stdio.h>
+
+// included for malloc, free, and strtoul
+#include <stdlib.h>
+
+#ifdef ACR_PLATFORM_WIN
+    // included for QueryPerformanceCounter
+    #include <windows.h>
+#else
+    // included for clock_gettime
+    #include <time.h>
+#endif
+
+//
+// PROTOTYPES
+//
+
+/** get a time in nanoseconds for measuring how long something takes
+*/
+unsigned long long BenchNanoseconds(void);
+
+/** time shifts of a buffer in both directions and print the results
+    \returns ACR_SUCCESS if the data was in the correct position after each shift
+*/
+int BenchShift(
+    ACR_BufferObj_t* buffer,
+    ACR_Length_t shiftBytes);
+
+//
+// MAIN
+//
+
+/** the default largest buffer size
+*/
+#define BENCH_DEFAULT_MAX_LENGTH (100UL * 1024UL * 1024UL)
+
+int main(int argc, char** argv)
+{
+    int result = ACR_SUCCESS;
+    ACR_Length_t maxLength = BENCH_DEFAULT_MAX_LENGTH;
+    ACR_Length_t length;
+
+    if(argc > 1)
+    {
+        maxLength = (ACR_Length_t)strtoul(argv[1], ACR_NULL, 10);
+    }
+
+    printf("%-12s %-12s %-6s %14s %12s\n", "length", "shift", "dir", "ns", "MB/sec");
+    for(length = 1024; length <= maxLength; length *= 16)
+    {
+        ACR_BufferObj_t* buffer;
+        ACR_Byte_t* data = (ACR_Byte_t*)malloc((size_t)length);
+        ACR_Length_t i;
+        if((data == ACR_NULL) ||
+           (ACR_BufferNew(&buffer) != ACR_INFO_OK))
+        {
+            printf("could not allocate %lu bytes\n", (unsigned long)length);
+            free(data);
+            return ACR_FAILURE;
+        }
+        for(i = 0; i < length; i++)
+        {
+            data[i] = (ACR_Byte_t)(i % 251);
+        }
+        ACR_BufferSetData(buffer, data, length);
+
+        // short, word sized, odd, and large distances
+        result |= BenchShift(buffer, 1);
+        result |= BenchShift(buffer, 63);
+        result |= BenchShift(buffer, 4096 % length);
+        result |= BenchShift(buffer, length / 3);
+        result |= BenchShift(buffer, length / 2);
+
+        ACR_BufferDelete(&buffer);
+        free(data);
+
+        if(length > (maxLength / 16))
+        {
+            // the next size would be too large
+            break;
+        }
+    }
+
+    return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/**********************************************************/
+unsigned long long BenchNanoseconds(void)
+{
+#ifdef ACR_PLATFORM_WIN
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)((counter.QuadPart * 1000000000.0) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+/**********************************************************/
+int BenchShift(
+    ACR_BufferObj_t* buffer,
+    ACR_Length_t shiftBytes)
+{
+    int result = ACR_SUCCESS;
+    ACR_Length_t length = ACR_BufferGetLength(buffer);
+    ACR_Info_t directions[2] = {ACR_INFO_LEFT, ACR_INFO_RIGHT};
+    int i;
+
+    for(i = 0; i < 2; i++)
+    {
+        unsigned long long start = BenchNanoseconds();
+        unsigned long long elapsed;
+        ACR_Byte_t first;
+        ACR_BufferShift(buffer, shiftBytes, directions[i], ACR_BOOL_TRUE);
+        elapsed = BenchNanoseconds() - start;
+        if(elapsed == 0)
+        {
+            elapsed = 1;
+        }
+        printf("%-12lu %-12lu %-6s %14llu %12.1f\n",
+            (unsigned long)length,
+            (unsigned long)shiftBytes,
+            (directions[i] == ACR_INFO_LEFT) ? "left" : "right",
+            elapsed,
+            ((double)length / (1024.0 * 1024.0)) / ((double)elapsed / 1000000000.0));
+
+        // after a left shift the first byte came from shiftBytes
+        // and after the right shift the data is back in place
+        ACR_BufferGetByteAt(buffer, 0, &first);
+        if(first != (ACR_Byte_t)(((i == 0) ? shiftBytes : 0) % 251))
+        {
+            printf("FAIL data is not in the correct position\n");
+            result = ACR_FAILURE;
+        }
+    }
+    return result;
+}
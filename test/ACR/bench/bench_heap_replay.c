@@ -0,0 +1,560 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bench_heap_replay.c
+
+    application to replay an allocation trace recorded by
+    ACR/heaptrace.h against each allocator and report the
+    operations per second, the 50th and 99th percentile time
+    of each operation, and the peak memory footprint
+
+    usage: bench_heap_replay [trace file]
+
+    without a trace file a generated workload is replayed.
+    add another entry to g_BenchAllocators to compare a
+    new allocator against the existing ones.
+
+    build it with the "Build Benchmark" task in .vscode/tasks.json
+
+    Note: requires the standard C library
+
+*/
+#include "ACR/heaptrace.h"
+
+// included for ACR_HeapObj_t
+#include "ACR/private/private_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for printf, fopen, fread, and fclose
+#include <stdio.h>
+
+// included for malloc, free, realloc, and qsort
+#include <stdlib.h>
+
+#ifdef ACR_PLATFORM_WIN
+    // included for QueryPerformanceCounter
+    #include <windows.h>
+#else
+    // included for clock_gettime
+    #include <time.h>
+#endif
+
+#ifdef __GLIBC__
+    // included for mallinfo2
+    #include <malloc.h>
+#endif
+
+//
+// TYPES
+//
+
+/** an allocator that can be benchmarked
+*/
+typedef struct BenchAllocator_s
+{
+    const char* m_Name;
+    void (*m_Start)(void);
+    void* (*m_Alloc)(ACR_Length_t bytes);
+    void (*m_Free)(void* ptr);
+    void* (*m_Realloc)(void* ptr, ACR_Length_t bytes);
+    ACR_Length_t (*m_Footprint)(void);
+    void (*m_Stop)(void);
+} BenchAllocator_t;
+
+//
+// PROTOTYPES
+//
+
+/** get a time in nanoseconds for measuring how long something takes
+*/
+unsigned long long BenchNanoseconds(void);
+
+/** read all of the records of a trace
+    \returns the number of records or 0 if the trace could not be read
+*/
+ACR_Length_t BenchReadTrace(
+    const char* path,
+    ACR_HeapTraceRecord_t** records);
+
+/** generate a workload of many small and a few large
+    allocations that live for different amounts of time
+    \returns the number of records
+*/
+ACR_Length_t BenchGenerateTrace(
+    ACR_HeapTraceRecord_t** records);
+
+/** replay the records against an allocator and print the results
+*/
+void BenchReplay(
+    const BenchAllocator_t* allocator,
+    const ACR_HeapTraceRecord_t* records,
+    ACR_Length_t count);
+
+/** the ACR_HeapObj_t allocator
+*/
+void BenchHeapStart(void);
+void* BenchHeapAlloc(ACR_Length_t bytes);
+void BenchHeapFree(void* ptr);
+void* BenchHeapRealloc(void* ptr, ACR_Length_t bytes);
+ACR_Length_t BenchHeapFootprint(void);
+void BenchHeapStop(void);
+
+/** the system malloc allocator
+*/
+void BenchMallocStart(void);
+void* BenchMallocAlloc(ACR_Length_t bytes);
+void BenchMallocFree(void* ptr);
+void* BenchMallocRealloc(void* ptr, ACR_Length_t bytes);
+ACR_Length_t BenchMallocFootprint(void);
+void BenchMallocStop(void);
+
+//
+// DATA
+//
+
+/** every allocator that is benchmarked
+*/
+const BenchAllocator_t g_BenchAllocators[] =
+{
+    {"ACR_HeapObj_t", BenchHeapStart, BenchHeapAlloc, BenchHeapFree, BenchHeapRealloc, BenchHeapFootprint, BenchHeapStop},
+    {"system malloc", BenchMallocStart, BenchMallocAlloc, BenchMallocFree, BenchMallocRealloc, BenchMallocFootprint, BenchMallocStop}
+};
+
+/** the heap used by the ACR_HeapObj_t allocator
+*/
+ACR_HeapObj_t g_BenchHeap;
+
+/** the number of bytes of memory the system had when the benchmark started
+*/
+ACR_Length_t g_BenchMallocStartBytes;
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+    ACR_HeapTraceRecord_t* records = ACR_NULL;
+    ACR_Length_t count;
+    ACR_Length_t i;
+
+    if(argc > 1)
+    {
+        count = BenchReadTrace(argv[1], &records);
+        if(count == 0)
+        {
+            printf("could not read the trace %s\n", argv[1]);
+            return ACR_FAILURE;
+        }
+    }
+    else
+    {
+        count = BenchGenerateTrace(&records);
+    }
+
+    printf("%lu operations\n", (unsigned long)count);
+    printf("%-16s %14s %10s %10s %16s\n", "allocator", "ops/sec", "p50 ns", "p99 ns", "peak footprint");
+    for(i = 0; i < (sizeof(g_BenchAllocators) / sizeof(g_BenchAllocators[0])); i++)
+    {
+        BenchReplay(&g_BenchAllocators[i], records, count);
+    }
+
+    free(records);
+    return ACR_SUCCESS;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/**********************************************************/
+unsigned long long BenchNanoseconds(void)
+{
+#ifdef ACR_PLATFORM_WIN
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)((counter.QuadPart * 1000000000.0) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+/**********************************************************/
+ACR_Length_t BenchReadTrace(
+    const char* path,
+    ACR_HeapTraceRecord_t** records)
+{
+    FILE* file = fopen(path, "rb");
+    ACR_Byte_t* data;
+    long length;
+    ACR_Length_t pos;
+    ACR_Length_t count = 0;
+    ACR_HeapTraceRecord_t record = {0, 0, 0, 0};
+    if(file == ACR_NULL)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (ACR_Byte_t*)malloc((size_t)length);
+    if((data == ACR_NULL) ||
+       (fread(data, 1, (size_t)length, file) != (size_t)length) ||
+       (ACR_HeapTraceReadStart(data, (ACR_Length_t)length, &pos) == ACR_BOOL_FALSE))
+    {
+        fclose(file);
+        free(data);
+        return 0;
+    }
+    fclose(file);
+
+    // every record uses at least 4 bytes
+    (*records) = (ACR_HeapTraceRecord_t*)malloc(sizeof(ACR_HeapTraceRecord_t) * (((size_t)length / 4) + 1));
+    if((*records) != ACR_NULL)
+    {
+        while(ACR_HeapTraceRead(data, (ACR_Length_t)length, &pos, &record))
+        {
+            (*records)[count++] = record;
+        }
+    }
+    free(data);
+    return count;
+}
+
+/**********************************************************/
+ACR_Length_t BenchGenerateTrace(
+    ACR_HeapTraceRecord_t** records)
+{
+    const ACR_Length_t count = 200000;
+    const ACR_Length_t maxLive = 4096;
+    ACR_Length_t live[4096];
+    ACR_Length_t liveCount = 0;
+    ACR_Length_t nextId = 1;
+    unsigned long random = 12345;
+    ACR_Length_t i;
+
+    (*records) = (ACR_HeapTraceRecord_t*)malloc(sizeof(ACR_HeapTraceRecord_t) * count);
+    if((*records) == ACR_NULL)
+    {
+        return 0;
+    }
+    for(i = 0; i < count; i++)
+    {
+        ACR_HeapTraceRecord_t* record = &(*records)[i];
+        unsigned long choice;
+        random = (random * 1103515245UL) + 12345UL;
+        choice = ((random >> 16) % 100);
+        record->m_Micro = (ACR_Time_t)i;
+        if((liveCount < maxLive) &&
+           ((liveCount == 0) || (choice < 50)))
+        {
+            // mostly small objects with a few large buffers
+            record->m_Op = ACR_HEAP_TRACE_ALLOC;
+            record->m_Size = ((choice % 10) == 0) ? (ACR_Length_t)(1024 + ((random >> 8) % 16384)) : (ACR_Length_t)(8 + ((random >> 8) % 120));
+            record->m_Id = nextId++;
+            live[liveCount++] = record->m_Id;
+        }
+        else
+        {
+            ACR_Length_t which = (ACR_Length_t)((random >> 4) % liveCount);
+            record->m_Id = live[which];
+            if(choice < 60)
+            {
+                record->m_Op = ACR_HEAP_TRACE_REALLOC;
+                record->m_Size = (ACR_Length_t)(16 + ((random >> 8) % 512));
+            }
+            else
+            {
+                record->m_Op = ACR_HEAP_TRACE_FREE;
+                record->m_Size = 0;
+                live[which] = live[--liveCount];
+            }
+        }
+    }
+    return count;
+}
+
+/** compare two times for qsort
+*/
+int BenchCompareTimes(
+    const void* a,
+    const void* b)
+{
+    unsigned long long timeA = *(const unsigned long long*)a;
+    unsigned long long timeB = *(const unsigned long long*)b;
+    return (timeA > timeB) - (timeA < timeB);
+}
+
+/**********************************************************/
+void BenchReplay(
+    const BenchAllocator_t* allocator,
+    const ACR_HeapTraceRecord_t* records,
+    ACR_Length_t count)
+{
+    ACR_Length_t maxId = 0;
+    ACR_Length_t footprint = 0;
+    ACR_Length_t timed = 0;
+    unsigned long long total = 0;
+    unsigned long long* times;
+    void** ptrs;
+    ACR_Length_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        if(records[i].m_Id > maxId)
+        {
+            maxId = records[i].m_Id;
+        }
+    }
+    ptrs = (void**)calloc((size_t)(maxId + 1), sizeof(void*));
+    times = (unsigned long long*)malloc(sizeof(unsigned long long) * (size_t)(count + 1));
+    if((ptrs == ACR_NULL) ||
+       (times == ACR_NULL))
+    {
+        printf("%-16s not enough memory to replay\n", allocator->m_Name);
+        free(ptrs);
+        free(times);
+        return;
+    }
+
+    allocator->m_Start();
+    for(i = 0; i < count; i++)
+    {
+        const ACR_HeapTraceRecord_t* record = &records[i];
+        void* ptr = ptrs[record->m_Id];
+        unsigned long long start;
+        if((record->m_Op == ACR_HEAP_TRACE_FREE) &&
+           (ptr == ACR_NULL))
+        {
+            // freed memory that was allocated
+            // before the trace was started
+            continue;
+        }
+
+        start = BenchNanoseconds();
+        switch(record->m_Op)
+        {
+            case ACR_HEAP_TRACE_ALLOC:
+                ptr = allocator->m_Alloc(record->m_Size);
+                break;
+            case ACR_HEAP_TRACE_REALLOC:
+                ptr = (ptr != ACR_NULL) ? allocator->m_Realloc(ptr, record->m_Size) : allocator->m_Alloc(record->m_Size);
+                break;
+            default:
+                allocator->m_Free(ptr);
+                ptr = ACR_NULL;
+                break;
+        }
+        times[timed] = (BenchNanoseconds() - start);
+        total += times[timed++];
+
+        if((ptr == ACR_NULL) &&
+           (record->m_Op != ACR_HEAP_TRACE_FREE))
+        {
+            // keep the old memory when realloc fails
+            printf("%-16s out of memory at operation %lu\n", allocator->m_Name, (unsigned long)i);
+            ptr = ptrs[record->m_Id];
+        }
+        else if(ptr != ACR_NULL)
+        {
+            // use the memory like a program would
+            ((ACR_Byte_t*)ptr)[0] = (ACR_Byte_t)i;
+        }
+        ptrs[record->m_Id] = ptr;
+
+        if((i % 64) == 0)
+        {
+            ACR_Length_t now = allocator->m_Footprint();
+            footprint = (now > footprint) ? now : footprint;
+        }
+    }
+    if(allocator->m_Footprint() > footprint)
+    {
+        footprint = allocator->m_Footprint();
+    }
+
+    // free everything the trace did not free
+    for(i = 0; i <= maxId; i++)
+    {
+        if(ptrs[i])
+        {
+            allocator->m_Free(ptrs[i]);
+        }
+    }
+    allocator->m_Stop();
+
+    if(timed > 0)
+    {
+        qsort(times, (size_t)timed, sizeof(unsigned long long), BenchCompareTimes);
+        printf("%-16s %14.0f %10llu %10llu %16lu\n",
+            allocator->m_Name,
+            (total > 0) ? ((double)timed * 1000000000.0 / (double)total) : 0.0,
+            times[timed / 2],
+            times[(timed * 99) / 100],
+            (unsigned long)footprint);
+    }
+    free(ptrs);
+    free(times);
+}
+
+/** \see ACR_HeapCallbackAcquireRegion_t
+*/
+void* BenchAcquireRegion(
+    ACR_Length_t length)
+{
+    return malloc((size_t)length);
+}
+
+/** \see ACR_HeapCallbackReleaseRegion_t
+*/
+void BenchReleaseRegion(
+    void* ptr,
+    ACR_Length_t length)
+{
+    ACR_UNUSED(length);
+    free(ptr);
+}
+
+/**********************************************************/
+void BenchHeapStart(void)
+{
+    ACR_HeapInit(&g_BenchHeap, ACR_NULL, 0);
+    ACR_HeapSetRegionCallbacks(&g_BenchHeap, BenchAcquireRegion, BenchReleaseRegion);
+}
+
+/**********************************************************/
+void* BenchHeapAlloc(
+    ACR_Length_t bytes)
+{
+    return ACR_HeapAlloc(&g_BenchHeap, bytes);
+}
+
+/**********************************************************/
+void BenchHeapFree(
+    void* ptr)
+{
+    ACR_HeapFree(&g_BenchHeap, ptr);
+}
+
+/**********************************************************/
+void* BenchHeapRealloc(
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    return ACR_HeapRealloc(&g_BenchHeap, ptr, bytes);
+}
+
+/**********************************************************/
+ACR_Length_t BenchHeapFootprint(void)
+{
+    // only the memory up to the unused
+    // memory of each region has been touched
+    ACR_Length_t bytes = 0;
+    ACR_HeapObj_t* region;
+    for(region = g_BenchHeap.m_NextRegion; region != ACR_NULL; region = region->m_NextRegion)
+    {
+        bytes += (ACR_HEAP_REGION_OBJECT_SIZE + region->m_NextFreePos);
+    }
+    return bytes;
+}
+
+/**********************************************************/
+void BenchHeapStop(void)
+{
+    ACR_HeapDeInit(&g_BenchHeap);
+}
+
+/** get the number of bytes the system malloc has taken from the system
+*/
+ACR_Length_t BenchMallocSystemBytes(void)
+{
+#ifdef __GLIBC__
+    struct mallinfo2 info = mallinfo2();
+    return (ACR_Length_t)(info.arena + info.hblkhd);
+#else
+    // not available
+    return 0;
+#endif
+}
+
+/**********************************************************/
+void BenchMallocStart(void)
+{
+    g_BenchMallocStartBytes = BenchMallocSystemBytes();
+}
+
+/**********************************************************/
+void* BenchMallocAlloc(
+    ACR_Length_t bytes)
+{
+    return malloc((size_t)bytes);
+}
+
+/**********************************************************/
+void BenchMallocFree(
+    void* ptr)
+{
+    free(ptr);
+}
+
+/**********************************************************/
+void* BenchMallocRealloc(
+    void* ptr,
+    ACR_Length_t bytes)
+{
+    return realloc(ptr, (size_t)bytes);
+}
+
+/**********************************************************/
+ACR_Length_t BenchMallocFootprint(void)
+{
+    ACR_Length_t bytes = BenchMallocSystemBytes();
+    return (bytes > g_BenchMallocStartBytes) ? (bytes - g_BenchMallocStartBytes) : 0;
+}
+
+/**********************************************************/
+void BenchMallocStop(void)
+{
+}
@@ -0,0 +1,238 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file bench_memory.c
+
+    application to compare the copy, set, and compare kernels
+    of ACR/memory.h with the standard C library across sizes
+    and report the bytes per second of each
+
+    usage: bench_memory
+
+    build once for each kernel, for example:
+
+        (default)                                      blocks
+        -DACR_CONFIG_MEMORY_BYTES                      bytes
+        -DACR_CONFIG_MEMORY_SIMD                       sse2 or neon
+        -DACR_CONFIG_MEMORY_SIMD -mavx2                avx2
+
+    Note: requires the standard C library for the comparison
+
+*/
+#include "ACR/memory.h"
+
+// included for ACR_Byte_t
+#include "ACR/public/public_bytes_and_flags.h"
+
+// included for ACR_UNUSED, ACR_SUCCESS, and ACR_FAILURE
+#include "ACR/public/public_functions.h"
+
+// included for printf
+#include <stdio.h>
+
+// included for malloc and free
+#include <stdlib.h>
+
+// included for memcpy, memmove, memset, and memcmp
+#include <string.h>
+
+#ifdef ACR_PLATFORM_WIN
+    // included for QueryPerformanceCounter
+    #include <windows.h>
+#else
+    // included for clock_gettime
+    #include <time.h>
+#endif
+
+//
+// PROTOTYPES
+//
+
+/** get a time in nanoseconds for measuring how long something takes
+*/
+unsigned long long BenchNanoseconds(void);
+
+/** print the bytes per second of one operation
+*/
+void BenchPrint(
+    const char* operation,
+    const char* kernel,
+    ACR_Length_t length,
+    ACR_Length_t repeat,
+    unsigned long long elapsed);
+
+/** time each operation of both kernels at one size
+    \param offset added to the source so that it is not aligned with the destination
+*/
+void BenchSize(
+    ACR_Byte_t* dest,
+    ACR_Byte_t* src,
+    ACR_Length_t length,
+    ACR_Length_t offset);
+
+//
+// MAIN
+//
+
+/** the number of bytes copied at each size
+*/
+#define BENCH_BYTES_PER_SIZE (256UL * 1024UL * 1024UL)
+
+/** the largest size
+*/
+#define BENCH_MAX_LENGTH (1024UL * 1024UL)
+
+/** a result of ACR_MemoryCompare() and memcmp() so
+    that the compiler does not remove the calls
+*/
+volatile int g_BenchSink;
+
+int main(int argc, char** argv)
+{
+    ACR_Byte_t* dest = (ACR_Byte_t*)malloc(BENCH_MAX_LENGTH + 64);
+    ACR_Byte_t* src = (ACR_Byte_t*)malloc(BENCH_MAX_LENGTH + 64);
+    ACR_Length_t length;
+
+    ACR_UNUSED(argc);
+    ACR_UNUSED(argv);
+
+    if((dest == ACR_NULL) ||
+       (src == ACR_NULL))
+    {
+        printf("could not allocate memory\n");
+        free(dest);
+        free(src);
+        return ACR_FAILURE;
+    }
+    memset(src, 0x5A, BENCH_MAX_LENGTH + 64);
+    memset(dest, 0x5A, BENCH_MAX_LENGTH + 64);
+
+    printf("ACR kernel is %s\n", ACR_MemoryKernelName());
+    printf("%-9s %-6s %10s %12s\n", "op", "kernel", "bytes", "MB/sec");
+    for(length = 16; length <= BENCH_MAX_LENGTH; length *= 4)
+    {
+        BenchSize(dest, src, length, 0);
+        BenchSize(dest, src, length, 3);
+    }
+
+    free(dest);
+    free(src);
+    return ACR_SUCCESS;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/**********************************************************/
+unsigned long long BenchNanoseconds(void)
+{
+#ifdef ACR_PLATFORM_WIN
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long long)((counter.QuadPart * 1000000000.0) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+/**********************************************************/
+void BenchPrint(
+    const char* operation,
+    const char* kernel,
+    ACR_Length_t length,
+    ACR_Length_t repeat,
+    unsigned long long elapsed)
+{
+    if(elapsed == 0)
+    {
+        elapsed = 1;
+    }
+    printf("%-9s %-6s %10lu %12.1f\n",
+        operation,
+        kernel,
+        (unsigned long)length,
+        (((double)length * (double)repeat) / (1024.0 * 1024.0)) / ((double)elapsed / 1000000000.0));
+}
+
+/** time a statement run repeat times and print the result
+*/
+#define BENCH_TIME(operation, kernel, statement)\
+    {\
+        unsigned long long start = BenchNanoseconds();\
+        for(i = 0; i < repeat; i++)\
+        {\
+            statement;\
+        }\
+        BenchPrint(operation, kernel, length, repeat, BenchNanoseconds() - start);\
+    }
+
+/**********************************************************/
+void BenchSize(
+    ACR_Byte_t* dest,
+    ACR_Byte_t* src,
+    ACR_Length_t length,
+    ACR_Length_t offset)
+{
+    ACR_Length_t repeat = (BENCH_BYTES_PER_SIZE / length);
+    ACR_Length_t i;
+    const char* copyName = ((offset == 0) ? "copy" : "copy+3");
+    const char* compareName = ((offset == 0) ? "compare" : "compare+3");
+
+    BENCH_TIME(copyName, "acr", ACR_MemoryCopy(dest, &src[offset], length));
+    BENCH_TIME(copyName, "libc", memcpy(dest, &src[offset], (size_t)length));
+    if(offset != 0)
+    {
+        // move and set already cover a misaligned source or only use the destination
+        BENCH_TIME(compareName, "acr", g_BenchSink += ACR_MemoryCompare(dest, &src[offset], length));
+        BENCH_TIME(compareName, "libc", g_BenchSink += memcmp(dest, &src[offset], (size_t)length));
+        return;
+    }
+    BENCH_TIME("move", "acr", ACR_MemoryMove(&dest[1], dest, length));
+    BENCH_TIME("move", "libc", memmove(&dest[1], dest, (size_t)length));
+    BENCH_TIME("set", "acr", ACR_MemorySet(dest, (int)(i & 0xFF), length));
+    BENCH_TIME("set", "libc", memset(dest, (int)(i & 0xFF), (size_t)length));
+    memset(dest, 0x5A, (size_t)length);
+    BENCH_TIME(compareName, "acr", g_BenchSink += ACR_MemoryCompare(dest, src, length));
+    BENCH_TIME(compareName, "libc", g_BenchSink += memcmp(dest, src, (size_t)length));
+}
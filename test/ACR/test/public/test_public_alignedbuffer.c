@@ -120,6 +120,22 @@ int main(int argc, char** argv)
         ACR_DEBUG_PRINT(7, "ERROR %dbit aligned buffer pointer is %p but expected %p", bits, alignedPointer, alignedBufferPointer0);
     }
 
+    bits = 64;
+    ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO(alignedBuffer, 100, bits);
+    alignedPointer = (char*)ACR_ALIGNED_BUFFER_GET_MEMORY(alignedBuffer);
+    lengthAvailable = ACR_ALIGNED_BUFFER_GET_LENGTH(alignedBuffer);
+    if((alignedPointer != ACR_NULL) &&
+       (((ACR_PointerValue_t)alignedPointer % bits) == 0) &&
+       (lengthAvailable == 100))
+    {
+        ACR_DEBUG_PRINT(8, "OK %d byte aligned buffer allocated at %p", bits, alignedPointer);
+    }
+    else
+    {
+        ACR_DEBUG_PRINT(9, "ERROR %d byte aligned buffer allocated at %p with length %d", bits, alignedPointer, (int)lengthAvailable);
+        result = ACR_FAILURE;
+    }
+
 	ACR_ALIGNED_BUFFER_FREE(alignedBuffer);
 
 	return result;
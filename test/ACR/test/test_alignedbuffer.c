@@ -0,0 +1,273 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_alignedbuffer.c
+
+    application to test allocating aligned buffers
+
+*/
+#include "ACR/alignedbuffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** allocate small memory aligned to a cache line
+*/
+int CacheLineTest(void);
+
+/** allocate memory aligned to a page and a huge page
+    with each option and release it
+*/
+int PageTest(void);
+
+/** free mapped memory and allocate the buffer again
+    through each function that releases it
+*/
+int ReleaseTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= CacheLineTest();
+	result |= PageTest();
+	result |= ReleaseTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** determine if ptr is a multiple of alignment
+*/
+#define TEST_IS_ALIGNED(ptr, alignment) ((((ACR_PointerValue_t)(ptr)) % (alignment)) == 0)
+
+/**********************************************************/
+int CacheLineTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ALIGNED_BUFFER(buffer);
+
+	if((ACR_AlignedBufferAllocatePages(&buffer, 100, ACR_ALIGN_TO_CACHE_LINE, ACR_ALIGNED_BUFFER_OPTIONS_NONE) != ACR_INFO_OK) ||
+	   (TEST_IS_ALIGNED(ACR_ALIGNED_BUFFER_GET_MEMORY(buffer), ACR_ALIGN_TO_CACHE_LINE) == 0) ||
+	   (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != 100) ||
+	   (ACR_HAS_FLAG(buffer.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED)) ||
+	   (ACR_AlignedBufferAllocatePages(&buffer, 100, 48, ACR_ALIGNED_BUFFER_OPTIONS_NONE) != ACR_INFO_ERROR))
+	{
+		ACR_DEBUG_PRINT(1, "FAIL small memory was not aligned to a cache line");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(2, "PASS small memory was aligned to a cache line");
+	}
+	ACR_AlignedBufferDeInit(&buffer);
+
+	return result;
+}
+
+/**********************************************************/
+int PageTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ALIGNED_BUFFER(buffer);
+	ACR_Length_t pageLength = ACR_AlignedBufferGetPageLength();
+	ACR_Byte_t* memory;
+
+	if((pageLength == 0) ||
+	   ((pageLength & (pageLength - 1)) != 0) ||
+	   (ACR_AlignedBufferAllocatePages(&buffer, pageLength + 1, pageLength, ACR_ALIGNED_BUFFER_PREFAULT) != ACR_INFO_OK) ||
+	   (TEST_IS_ALIGNED(ACR_ALIGNED_BUFFER_GET_MEMORY(buffer), pageLength) == 0) ||
+	   (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != (pageLength + 1)))
+	{
+		ACR_DEBUG_PRINT(3, "FAIL memory was not aligned to a page");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		memory = (ACR_Byte_t*)ACR_ALIGNED_BUFFER_GET_MEMORY(buffer);
+		memory[pageLength] = 42;
+		ACR_DEBUG_PRINT(4, "PASS memory was aligned to a page");
+	}
+
+#ifndef ACR_CONFIG_NO_LIBC
+	// replacing the memory releases the pages
+	if((ACR_AlignedBufferAllocatePages(&buffer, ACR_ALIGN_TO_HUGE_PAGE, ACR_ALIGN_TO_HUGE_PAGE, ACR_ALIGNED_BUFFER_HUGE_PAGES | ACR_ALIGNED_BUFFER_PREFAULT) != ACR_INFO_OK) ||
+	   (TEST_IS_ALIGNED(ACR_ALIGNED_BUFFER_GET_MEMORY(buffer), ACR_ALIGN_TO_HUGE_PAGE) == 0) ||
+	   (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != ACR_ALIGN_TO_HUGE_PAGE))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL memory was not aligned to a huge page");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		memory = (ACR_Byte_t*)ACR_ALIGNED_BUFFER_GET_MEMORY(buffer);
+		memory[ACR_ALIGN_TO_HUGE_PAGE - 1] = 42;
+		ACR_DEBUG_PRINT(6, "PASS memory was aligned to a huge page");
+	}
+#else
+	// OK - the fixed size heap is too small for a huge page
+	ACR_DEBUG_PRINT(9, "TEST skipped huge pages without libc");
+#endif // #ifndef ACR_CONFIG_NO_LIBC
+
+	ACR_AlignedBufferDeInit(&buffer);
+	if((ACR_ALIGNED_BUFFER_GET_MEMORY(buffer) != ACR_NULL) ||
+	   (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != 0) ||
+	   (buffer.m_UnalignedBuffer.m_Pointer != ACR_NULL))
+	{
+		ACR_DEBUG_PRINT(7, "FAIL pages were not released");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(8, "PASS pages were released");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int ReleaseTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ALIGNED_BUFFER(buffer);
+	ACR_AlignedBuffer_t* newBuffer = ACR_NULL;
+	ACR_Length_t pageLength = ACR_AlignedBufferGetPageLength();
+	ACR_Bool_t expectMapped = ACR_BOOL_TRUE;
+	ACR_Bool_t wasMapped;
+	ACR_Byte_t* memory;
+
+#ifdef ACR_CONFIG_NO_LIBC
+	// the fixed size heap is used instead
+	expectMapped = ACR_BOOL_FALSE;
+#endif
+
+	// free the mapped memory and map it again
+	ACR_AlignedBufferAllocatePages(&buffer, pageLength, pageLength, ACR_ALIGNED_BUFFER_OPTIONS_NONE);
+	wasMapped = ACR_HAS_FLAG(buffer.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED) ? ACR_BOOL_TRUE : ACR_BOOL_FALSE;
+	ACR_AlignedBufferDeInit(&buffer);
+	if((wasMapped != expectMapped) ||
+	   (ACR_ALIGNED_BUFFER_GET_MEMORY(buffer) != ACR_NULL) ||
+	   (buffer.m_UnalignedBuffer.m_Flags != ACR_BUFFER_FLAGS_NONE) ||
+	   (ACR_AlignedBufferAllocatePages(&buffer, pageLength, pageLength, ACR_ALIGNED_BUFFER_OPTIONS_NONE) != ACR_INFO_OK) ||
+	   (TEST_IS_ALIGNED(ACR_ALIGNED_BUFFER_GET_MEMORY(buffer), pageLength) == 0))
+	{
+		ACR_DEBUG_PRINT(10, "FAIL mapped memory was not freed and mapped again");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		memory = (ACR_Byte_t*)ACR_ALIGNED_BUFFER_GET_MEMORY(buffer);
+		memory[pageLength - 1] = 42;
+		ACR_DEBUG_PRINT(11, "PASS mapped memory was freed and mapped again");
+	}
+
+	// the macros cannot unmap memory so they leave it alone
+	memory = (ACR_Byte_t*)ACR_ALIGNED_BUFFER_GET_MEMORY(buffer);
+	ACR_ALIGNED_BUFFER_FREE(buffer);
+	ACR_ALIGNED_BUFFER_ALLOC_ALIGNED_TO(buffer, 100, ACR_ALIGN_TO_CACHE_LINE);
+	if(expectMapped == ACR_BOOL_FALSE)
+	{
+		// the memory came from the heap so the macros replaced it
+		ACR_DEBUG_PRINT(12, "TEST skipped macros on mapped memory without libc");
+	}
+	else if((ACR_ALIGNED_BUFFER_GET_MEMORY(buffer) != memory) ||
+	        (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != pageLength) ||
+	        (ACR_HAS_FLAG(buffer.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED) == ACR_BOOL_FALSE) ||
+	        (memory[pageLength - 1] != 42))
+	{
+		ACR_DEBUG_PRINT(13, "FAIL macros changed a buffer of mapped memory");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(14, "PASS macros left a buffer of mapped memory unchanged");
+	}
+
+	// replace the mapped memory with heap memory
+	if((ACR_AlignedBufferAllocate(&buffer, 100, ACR_ALIGN_TO_CACHE_LINE) != ACR_INFO_OK) ||
+	   (ACR_HAS_FLAG(buffer.m_UnalignedBuffer.m_Flags, ACR_BUFFER_IS_MAPPED)) ||
+	   (TEST_IS_ALIGNED(ACR_ALIGNED_BUFFER_GET_MEMORY(buffer), ACR_ALIGN_TO_CACHE_LINE) == 0) ||
+	   (ACR_ALIGNED_BUFFER_GET_LENGTH(buffer) != 100))
+	{
+		ACR_DEBUG_PRINT(15, "FAIL mapped memory was not replaced by heap memory");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(16, "PASS mapped memory was replaced by heap memory");
+	}
+	ACR_AlignedBufferDeInit(&buffer);
+
+	// a buffer from the heap releases its mapped memory when deleted
+	if((ACR_AlignedBufferNew(&newBuffer) != ACR_INFO_OK) ||
+	   (ACR_AlignedBufferAllocatePages(newBuffer, pageLength, pageLength, ACR_ALIGNED_BUFFER_PREFAULT) != ACR_INFO_OK))
+	{
+		ACR_DEBUG_PRINT(17, "FAIL could not map memory for a new buffer");
+		result = ACR_FAILURE;
+	}
+	ACR_AlignedBufferDelete(&newBuffer);
+	if(newBuffer != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(18, "FAIL new buffer was not deleted");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(19, "PASS new buffer was deleted");
+	}
+
+	return result;
+}
@@ -0,0 +1,338 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_allocator.c
+
+    application to test objects created with an allocator interface
+
+*/
+#include "ACR/allocator.h"
+
+// included for ACR_BufferNewWithAllocator()
+#include "ACR/buffer.h"
+
+// included for ACR_StringNewWithAllocator()
+#include "ACR/string.h"
+
+// included for ACR_ArenaInitAllocator()
+#include "ACR/arena.h"
+
+// included for ACR_ArenaObj_t
+#include "ACR/private/private_arena.h"
+
+// included for ACR_PoolInitAllocator()
+#include "ACR/pool.h"
+
+// included for ACR_BufferObj_t
+#include "ACR/private/private_buffer.h"
+
+// included for ACR_HEAP_ALIGNMENT
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** a buffer object and its memory come from a custom allocator
+*/
+int CustomTest(void);
+
+/** objects are allocated from an arena
+*/
+int ArenaTest(void);
+
+/** objects created without an allocator use ACR_MALLOC
+*/
+int DefaultTest(void);
+
+/** buffer objects come from a pool and their memory from ACR_MALLOC
+*/
+int PoolTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= CustomTest();
+	result |= ArenaTest();
+	result |= DefaultTest();
+	result |= PoolTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of bytes of memory used by the tests
+*/
+#define TEST_ALLOCATOR_MEMORY_SIZE 1024
+
+/** memory used by the tests so that they also
+    run when malloc is not available
+*/
+ACR_Byte_t g_TestMemory[TEST_ALLOCATOR_MEMORY_SIZE];
+
+/** allocator that counts its calls
+*/
+typedef struct TestCounter_s
+{
+	ACR_ArenaObj_t m_Arena;
+	int m_AllocCount;
+	int m_FreeCount;
+} TestCounter_t;
+
+/**********************************************************/
+void* TestCounterAlloc(
+	ACR_Length_t bytes,
+	void* userPtr)
+{
+	TestCounter_t* counter = (TestCounter_t*)userPtr;
+	counter->m_AllocCount++;
+	return ACR_ArenaAlloc(&counter->m_Arena, bytes);
+}
+
+/**********************************************************/
+void TestCounterFree(
+	void* ptr,
+	void* userPtr)
+{
+	TestCounter_t* counter = (TestCounter_t*)userPtr;
+	ACR_UNUSED(ptr);
+	counter->m_FreeCount++;
+}
+
+/**********************************************************/
+int CustomTest(void)
+{
+	int result = ACR_SUCCESS;
+	TestCounter_t counter;
+	ACR_ALLOCATOR_INTERFACE(allocator);
+	ACR_BufferObj_t* buffer;
+
+	ACR_ArenaInit(&counter.m_Arena, g_TestMemory, sizeof(g_TestMemory));
+	counter.m_AllocCount = 0;
+	counter.m_FreeCount = 0;
+	allocator.m_Alloc = TestCounterAlloc;
+	allocator.m_Free = TestCounterFree;
+	allocator.m_User = &counter;
+
+	if(ACR_BufferNewWithAllocator(&buffer, &allocator) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL buffer not allocated");
+		return ACR_FAILURE;
+	}
+	if((counter.m_AllocCount != 1) ||
+	   (ACR_AllocatorOf(buffer) != &allocator) ||
+	   ((((ACR_Byte_t*)buffer) - g_TestMemory) % ACR_HEAP_ALIGNMENT) != 0)
+	{
+		ACR_DEBUG_PRINT(2, "FAIL buffer not allocated from the allocator");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(3, "PASS buffer allocated from the allocator");
+	}
+
+	ACR_BufferSetDataAllocator(buffer, &allocator);
+	if((ACR_BufferAllocate(buffer, 16) != ACR_INFO_OK) ||
+	   (counter.m_AllocCount != 2))
+	{
+		ACR_DEBUG_PRINT(4, "FAIL buffer memory not allocated from the allocator");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(5, "PASS buffer memory allocated from the allocator");
+	}
+
+	ACR_BufferDelete(&buffer);
+	if((buffer != ACR_NULL) ||
+	   (counter.m_FreeCount != 2))
+	{
+		ACR_DEBUG_PRINT(6, "FAIL buffer not freed to the allocator");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(7, "PASS buffer freed to the allocator");
+	}
+
+	ACR_ArenaDeInit(&counter.m_Arena);
+
+	return result;
+}
+
+/**********************************************************/
+int ArenaTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ArenaObj_t arena;
+	ACR_ALLOCATOR_INTERFACE(allocator);
+	ACR_String_t* str;
+	ACR_Length_t available;
+
+	ACR_ArenaInit(&arena, g_TestMemory, sizeof(g_TestMemory));
+	ACR_ArenaInitAllocator(&arena, &allocator);
+	available = ACR_ArenaAvailable(&arena);
+
+	if(ACR_StringNewWithAllocator(&str, &allocator) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(8, "FAIL string not allocated");
+		return ACR_FAILURE;
+	}
+	if((ACR_ArenaAvailable(&arena) >= available) ||
+	   (str->m_Count != ACR_ZERO_COUNT))
+	{
+		ACR_DEBUG_PRINT(9, "FAIL string not allocated from the arena");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(10, "PASS string allocated from the arena");
+	}
+
+	// the arena keeps the memory until it is reset
+	ACR_StringDelete(&str);
+	if(ACR_AllocatorRealloc(&allocator, g_TestMemory, 8) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(11, "FAIL arena memory was reallocated");
+		result = ACR_FAILURE;
+	}
+
+	ACR_ArenaDeInit(&arena);
+
+	return result;
+}
+
+/**********************************************************/
+int DefaultTest(void)
+{
+	int result = ACR_SUCCESS;
+#if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+	ACR_BufferObj_t* buffer;
+
+	if(ACR_BufferNew(&buffer) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(12, "FAIL buffer not allocated");
+		return ACR_FAILURE;
+	}
+	if((ACR_AllocatorOf(buffer) != ACR_NULL) ||
+	   (ACR_BufferAllocate(buffer, 16) != ACR_INFO_OK))
+	{
+		ACR_DEBUG_PRINT(13, "FAIL buffer did not use ACR_MALLOC");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(14, "PASS buffer used ACR_MALLOC");
+	}
+	ACR_BufferDelete(&buffer);
+#else
+	if(ACR_AllocatorAlloc(ACR_NULL, 16) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(12, "FAIL allocated without malloc");
+		result = ACR_FAILURE;
+	}
+#endif
+	return result;
+}
+
+/**********************************************************/
+int PoolTest(void)
+{
+	int result = ACR_SUCCESS;
+#if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+	ACR_PoolObj_t* pool;
+	ACR_ALLOCATOR_INTERFACE(allocator);
+	ACR_BufferObj_t* buffer;
+
+	if(ACR_PoolNew(&pool, ACR_ALLOCATOR_NEW_BYTES(sizeof(ACR_BufferObj_t)), 4) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(15, "FAIL pool not allocated");
+		return ACR_FAILURE;
+	}
+	ACR_PoolInitAllocator(pool, &allocator);
+
+	if((ACR_BufferNewWithAllocator(&buffer, &allocator) != ACR_INFO_OK) ||
+	   (buffer == ACR_NULL) ||
+	   (ACR_AllocatorOf(buffer) != &allocator) ||
+	   (ACR_PoolCount(pool) != 1))
+	{
+		ACR_DEBUG_PRINT(16, "FAIL buffer not allocated from the pool");
+		result = ACR_FAILURE;
+	}
+	else if((ACR_BufferAllocate(buffer, 100) != ACR_INFO_OK) ||
+	        (ACR_BufferGetLength(buffer) != 100) ||
+	        (ACR_PoolCount(pool) != 1))
+	{
+		ACR_DEBUG_PRINT(17, "FAIL buffer memory not allocated with ACR_MALLOC");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(18, "PASS buffer allocated from the pool");
+	}
+
+	ACR_BufferDelete(&buffer);
+	if((buffer != ACR_NULL) ||
+	   (ACR_PoolCount(pool) != 0))
+	{
+		ACR_DEBUG_PRINT(19, "FAIL buffer not freed to the pool");
+		result = ACR_FAILURE;
+	}
+
+	ACR_PoolDelete(&pool);
+#endif
+	return result;
+}
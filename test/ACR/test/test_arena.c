@@ -0,0 +1,198 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_arena.c
+
+    application to test the arena allocator
+
+*/
+#include "ACR/arena.h"
+
+// included for ACR_ArenaInit
+#include "ACR/private/private_arena.h"
+
+// included for ACR_NEW_BY_TYPE_FROM
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** allocations are released back to a mark
+*/
+int MarkAndRewindTest(void);
+
+/** an arena allocated on the heap can be used by the macros
+*/
+int NewAndDeleteTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= MarkAndRewindTest();
+	result |= NewAndDeleteTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** memory used for the arena in each test
+*/
+ACR_Block_t g_TestArenaMemory[1024/sizeof(ACR_Block_t)];
+
+/**********************************************************/
+int MarkAndRewindTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ArenaObj_t arena;
+	ACR_ArenaMark_t mark;
+	ACR_Length_t available;
+	void* first;
+	void* second;
+
+	ACR_ArenaInit(&arena, g_TestArenaMemory, sizeof(g_TestArenaMemory));
+	available = ACR_ArenaAvailable(&arena);
+	if(available != sizeof(g_TestArenaMemory))
+	{
+		ACR_DEBUG_PRINT(1, "FAIL available is %d", (int)available);
+		result = ACR_FAILURE;
+	}
+
+	first = ACR_ArenaAlloc(&arena, 10);
+	mark = ACR_ArenaMark(&arena);
+	second = ACR_ArenaAlloc(&arena, 100);
+	if((first == ACR_NULL) ||
+	   (second == ACR_NULL) ||
+	   (((ACR_PointerValue_t)second % ACR_HEAP_ALIGNMENT) != 0))
+	{
+		ACR_DEBUG_PRINT(2, "FAIL allocations are not aligned");
+		result = ACR_FAILURE;
+	}
+
+	ACR_ArenaRewind(&arena, mark);
+	if(ACR_ArenaAlloc(&arena, 100) != second)
+	{
+		ACR_DEBUG_PRINT(3, "FAIL rewind did not release memory");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(4, "PASS rewind released memory");
+	}
+
+	if(ACR_ArenaAlloc(&arena, sizeof(g_TestArenaMemory)) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(5, "FAIL allocated more than the arena has");
+		result = ACR_FAILURE;
+	}
+
+	ACR_ArenaReset(&arena);
+	if(ACR_ArenaAvailable(&arena) != available)
+	{
+		ACR_DEBUG_PRINT(6, "FAIL reset did not release memory");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(7, "PASS reset released memory");
+	}
+
+	ACR_ArenaDeInit(&arena);
+
+	return result;
+}
+
+/**********************************************************/
+int NewAndDeleteTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_ArenaObj_t* arena;
+
+	if(ACR_ArenaNew(&arena, 200) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(8, "FAIL arena not allocated");
+		return ACR_FAILURE;
+	}
+
+	{
+		ACR_NEW_BY_COUNT_FROM(numbers, int, 10, ACR_Arena, arena);
+		if(numbers == ACR_NULL)
+		{
+			ACR_DEBUG_PRINT(9, "FAIL numbers not allocated");
+			result = ACR_FAILURE;
+		}
+		else if((numbers[0] != 0) ||
+		        (numbers[9] != 0))
+		{
+			ACR_DEBUG_PRINT(10, "FAIL numbers not cleared");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(11, "PASS numbers allocated from arena");
+		}
+		ACR_DELETE_FROM(numbers, ACR_Arena, arena);
+	}
+
+	ACR_ArenaDelete(&arena);
+	if(arena != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(12, "FAIL arena not deleted");
+		result = ACR_FAILURE;
+	}
+
+	return result;
+}
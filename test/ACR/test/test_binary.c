@@ -0,0 +1,249 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_binary.c
+
+    application to test reading and writing typed values
+
+*/
+#include "ACR/binary.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** write every type in one byte order and read it back
+    \param isBigEndian the byte order to test
+*/
+int RoundTripTest(
+	ACR_Bool_t isBigEndian);
+
+/** check the bytes written for each byte order
+*/
+int ByteOrderTest(void);
+
+/** reads and writes past the end fail once and keep failing
+*/
+int OverflowTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= RoundTripTest(ACR_BOOL_TRUE);
+	result |= RoundTripTest(ACR_BOOL_FALSE);
+	result |= ByteOrderTest();
+	result |= OverflowTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of bytes in the memory used by the tests
+*/
+#define TEST_BINARY_LENGTH 128
+
+/**********************************************************/
+int RoundTripTest(
+	ACR_Bool_t isBigEndian)
+{
+	int result = ACR_SUCCESS;
+	ACR_Byte_t data[TEST_BINARY_LENGTH];
+	ACR_BUFFER_FROM_DATA(buffer, data, sizeof(data));
+	ACR_BINARY(writer);
+	ACR_BINARY(reader);
+	ACR_BUFFER(blob);
+	ACR_Unsigned_16bit_t shorts[3] = {1, 0x1234, 0xFFFF};
+	ACR_Unsigned_32bit_t longs[3] = {1, 0x12345678UL, 0xFFFFFFFFUL};
+	ACR_Unsigned_16bit_t shortsOut[3] = {0, 0, 0};
+	ACR_Unsigned_32bit_t longsOut[3] = {0, 0, 0};
+	ACR_Bool_t valuesMatch;
+
+	ACR_BinaryInit(&writer, buffer, isBigEndian);
+	ACR_BinaryWriteU8(&writer, 0xFE);
+	ACR_BinaryWriteU16(&writer, 0xFFFE);
+	ACR_BinaryWriteU32(&writer, 0xFFFFFFFEUL);
+	ACR_BinaryWriteF32(&writer, 1.5f);
+	ACR_BinaryWriteBlob(&writer, "blob", 4);
+	ACR_BinaryWriteU16Array(&writer, shorts, 3);
+	ACR_BinaryWriteU32Array(&writer, longs, 3);
+
+	ACR_BinaryInit(&reader, buffer, isBigEndian);
+	valuesMatch = ((ACR_BinaryReadI8(&reader) == -2) &&
+		(ACR_BinaryReadI16(&reader) == -2) &&
+		(ACR_BinaryReadI32(&reader) == -2) &&
+		(ACR_BinaryReadF32(&reader) == 1.5f));
+	ACR_BinaryReadBlob(&reader, &blob);
+	ACR_BinaryReadU16Array(&reader, shortsOut, 3);
+	ACR_BinaryReadU32Array(&reader, longsOut, 3);
+	if((ACR_BinaryResult(&writer) != ACR_INFO_OK) ||
+	   (ACR_BinaryResult(&reader) != ACR_INFO_OK) ||
+	   (valuesMatch == ACR_BOOL_FALSE) ||
+	   (blob.m_Length != 4) ||
+	   (((ACR_Byte_t*)blob.m_Pointer)[3] != 'b') ||
+	   (shortsOut[1] != 0x1234) ||
+	   (shortsOut[2] != 0xFFFF) ||
+	   (longsOut[1] != 0x12345678UL) ||
+	   (longsOut[2] != 0xFFFFFFFFUL))
+	{
+		ACR_DEBUG_PRINT(1, "FAIL values did not round trip big endian %d", (int)isBigEndian);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(2, "PASS values round trip big endian %d", (int)isBigEndian);
+	}
+
+#if ACR_USE_64BIT == ACR_BOOL_TRUE
+	{
+		ACR_Unsigned_64bit_t values[2] = {0x0102030405060708ULL, 0xFFFFFFFFFFFFFFFEULL};
+		ACR_Unsigned_64bit_t valuesOut[2] = {0, 0};
+
+		ACR_BinaryInit(&writer, buffer, isBigEndian);
+		ACR_BinaryWriteU64(&writer, 0xFFFFFFFFFFFFFFFEULL);
+		ACR_BinaryWriteF64(&writer, -2.25);
+		ACR_BinaryWriteU64Array(&writer, values, 2);
+
+		ACR_BinaryInit(&reader, buffer, isBigEndian);
+		valuesMatch = ((ACR_BinaryReadI64(&reader) == -2) &&
+			(ACR_BinaryReadF64(&reader) == -2.25));
+		ACR_BinaryReadU64Array(&reader, valuesOut, 2);
+		if((ACR_BinaryResult(&reader) != ACR_INFO_OK) ||
+		   (valuesMatch == ACR_BOOL_FALSE) ||
+		   (valuesOut[0] != values[0]) ||
+		   (valuesOut[1] != values[1]))
+		{
+			ACR_DEBUG_PRINT(3, "FAIL 64 bit values did not round trip big endian %d", (int)isBigEndian);
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(4, "PASS 64 bit values round trip big endian %d", (int)isBigEndian);
+		}
+	}
+#endif // #if ACR_USE_64BIT == ACR_BOOL_TRUE
+
+	return result;
+}
+
+/**********************************************************/
+int ByteOrderTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Byte_t big[6];
+	ACR_Byte_t little[6];
+	ACR_BUFFER_FROM_DATA(bigBuffer, big, sizeof(big));
+	ACR_BUFFER_FROM_DATA(littleBuffer, little, sizeof(little));
+	ACR_BINARY(bigWriter);
+	ACR_BINARY(littleWriter);
+
+	ACR_BinaryInit(&bigWriter, bigBuffer, ACR_BOOL_TRUE);
+	ACR_BinaryInit(&littleWriter, littleBuffer, ACR_BOOL_FALSE);
+	ACR_BinaryWriteU16(&bigWriter, 0x0102);
+	ACR_BinaryWriteU32(&bigWriter, 0x03040506UL);
+	ACR_BinaryWriteU16(&littleWriter, 0x0102);
+	ACR_BinaryWriteU32(&littleWriter, 0x03040506UL);
+	if((big[0] != 1) || (big[1] != 2) || (big[2] != 3) || (big[5] != 6) ||
+	   (little[0] != 2) || (little[1] != 1) || (little[2] != 6) || (little[5] != 3))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL bytes were not in order");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS bytes were in order");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int OverflowTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Byte_t data[6] = {0, 0, 0, 9, 1, 2};
+	ACR_BUFFER_FROM_DATA(buffer, data, sizeof(data));
+	ACR_BINARY(reader);
+	ACR_BUFFER(blob);
+	ACR_Unsigned_32bit_t values[2];
+
+	// the blob claims 9 bytes but only 2 remain
+	ACR_BinaryInit(&reader, buffer, ACR_BOOL_TRUE);
+	ACR_BinaryReadBlob(&reader, &blob);
+	if((ACR_BinaryResult(&reader) != ACR_INFO_ERROR) ||
+	   (blob.m_Pointer != ACR_NULL) ||
+	   (ACR_BinaryReadU8(&reader) != 0) ||
+	   (ACR_BinaryRemaining(&reader) != 2))
+	{
+		ACR_DEBUG_PRINT(7, "FAIL blob past the end was read");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_BinaryInit(&reader, buffer, ACR_BOOL_TRUE);
+		ACR_BinaryReadU32Array(&reader, values, 2);
+		if(ACR_BinaryResult(&reader) != ACR_INFO_ERROR)
+		{
+			ACR_DEBUG_PRINT(7, "FAIL array past the end was read");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(8, "PASS reads past the end failed");
+		}
+	}
+
+	return result;
+}
@@ -58,6 +58,9 @@
 // included for ACR_DEBUG_PRINT
 #include "ACR/public/public_debug.h"
 
+// included for ACR_FileReadView
+#include "ACR/file.h"
+
 //
 // PROTOTYPES
 //
@@ -74,6 +77,14 @@ int FileInterfaceTest(void);
 */
 int StackTest(void);
 
+/** shift a buffer with wrap by many lengths and distances
+*/
+int WrapTest(void);
+
+/** read and write a buffer through a cursor
+*/
+int CursorTest(void);
+
 /** use a buffer at a low level
 */
 int LowLevelTest(void);
@@ -106,6 +117,8 @@ int main(int argc, char** argv)
 
 	result |= HeapTest();
 	result |= FileInterfaceTest();
+	result |= WrapTest();
+	result |= CursorTest();
 
 	return result;
 }
@@ -217,7 +230,38 @@ int FileInterfaceTest(void)
 		ACR_FileInterface_t* bufferAsFile;
 		if(ACR_BufferNewFileInterface(bufferPtr, &bufferAsFile) == ACR_INFO_OK)
 		{
-			
+			ACR_FileInterface_t copyOnly;
+			ACR_Byte_t scratchMemory[16];
+			ACR_VAR_BUFFER(scratch);
+			ACR_BUFFER(view);
+			ACR_STRING(path);
+
+			scratch.m_Buffer.m_Pointer = scratchMemory;
+			scratch.m_MaxLength = sizeof(scratchMemory);
+			((ACR_Byte_t*)bufferPtr->m_Base.m_Pointer)[sizeof(scratchMemory)] = 42;
+
+			// the buffer lends its own memory
+			// and a file without m_Borrow copies
+			copyOnly = (*bufferAsFile);
+			copyOnly.m_Borrow = ACR_NULL;
+			if((bufferAsFile->m_Open(path, ACR_INFO_READ, bufferAsFile->m_User) != ACR_INFO_OK) ||
+			   (ACR_FileReadView(bufferAsFile, &scratch, &view) != ACR_INFO_OK) ||
+			   (view.m_Pointer != bufferPtr->m_Base.m_Pointer) ||
+			   (view.m_Length != sizeof(scratchMemory)) ||
+			   (ACR_FileReadView(&copyOnly, &scratch, &view) != ACR_INFO_OK) ||
+			   (view.m_Pointer != (void*)scratchMemory) ||
+			   (view.m_Length != sizeof(scratchMemory)) ||
+			   (scratchMemory[0] != 42) ||
+			   (bufferAsFile->m_Position(bufferAsFile->m_User) != (2 * sizeof(scratchMemory))) ||
+			   (bufferAsFile->m_Close(bufferAsFile->m_User) != ACR_INFO_OK))
+			{
+				ACR_DEBUG_PRINT(12, "FAIL read view did not borrow or copy");
+				result = ACR_FAILURE;
+			}
+			else
+			{
+				ACR_DEBUG_PRINT(13, "PASS read view borrowed and copied");
+			}
 
 			if(ACR_BufferDeleteFileInterface(bufferPtr, &bufferAsFile) != ACR_INFO_OK)
 			{
@@ -350,3 +394,135 @@ int VerboseTest(void)
 
 	return ACR_SUCCESS;
 }
+
+/** the largest buffer used by WrapTest()
+*/
+#define TEST_BUFFER_WRAP_LENGTH 1000
+
+/**********************************************************/
+int WrapTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_BufferObj_t* bufferPtr;
+	static ACR_Byte_t data[TEST_BUFFER_WRAP_LENGTH];
+	const ACR_Length_t lengths[] = {1, 7, 64, 65, 200, TEST_BUFFER_WRAP_LENGTH};
+	const ACR_Length_t shifts[] = {0, 1, 63, 64, 65, 100, 333, 999, 2500};
+	ACR_Length_t lengthIndex;
+	ACR_Length_t shiftIndex;
+	ACR_Length_t i;
+	int direction;
+
+	if(ACR_BufferNew(&bufferPtr) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(9, "FAIL buffer not allocated");
+		return ACR_FAILURE;
+	}
+
+	for(lengthIndex = 0; lengthIndex < (sizeof(lengths) / sizeof(lengths[0])); lengthIndex++)
+	{
+		ACR_Length_t length = lengths[lengthIndex];
+		ACR_BufferSetData(bufferPtr, data, length);
+		for(shiftIndex = 0; shiftIndex < (sizeof(shifts) / sizeof(shifts[0])); shiftIndex++)
+		{
+			ACR_Length_t shiftBytes = shifts[shiftIndex];
+			for(direction = 0; direction < 2; direction++)
+			{
+				for(i = 0; i < length; i++)
+				{
+					data[i] = (ACR_Byte_t)(i % 251);
+				}
+				ACR_BufferShift(bufferPtr, shiftBytes, (direction == 0) ? ACR_INFO_LEFT : ACR_INFO_RIGHT, ACR_BOOL_TRUE);
+				for(i = 0; i < length; i++)
+				{
+					// the byte that should have moved to position i
+					ACR_Length_t from = (direction == 0) ? ((i + shiftBytes) % length) : ((i + length - (shiftBytes % length)) % length);
+					if(data[i] != (ACR_Byte_t)(from % 251))
+					{
+						ACR_DEBUG_PRINT(10, "FAIL length %d shift %d direction %d byte %d", (int)length, (int)shiftBytes, direction, (int)i);
+						result = ACR_FAILURE;
+						break;
+					}
+				}
+			}
+		}
+	}
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(11, "PASS shift with wrap");
+	}
+
+	ACR_BufferDelete(&bufferPtr);
+
+	return result;
+}
+
+/**********************************************************/
+int CursorTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_BufferObj_t* bufferPtr;
+	ACR_Byte_t data[16];
+	ACR_Byte_t copy[4];
+	ACR_BUFFER_FROM_DATA(view, data, sizeof(data));
+	ACR_CURSOR(writer);
+	ACR_CURSOR(reader);
+
+	ACR_BufferNew(&bufferPtr);
+	ACR_BufferSetData(bufferPtr, data, sizeof(data));
+	if((ACR_BufferGetCursor(bufferPtr, 4, sizeof(data), &writer) != ACR_INFO_GREATER) ||
+	   (ACR_BufferGetCursor(bufferPtr, 0, sizeof(data), &writer) != ACR_INFO_OK) ||
+	   (ACR_CURSOR_REMAINING(writer) != sizeof(data)))
+	{
+		ACR_DEBUG_PRINT(14, "FAIL cursor range was not checked");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		// write each kind of value then read them back
+		ACR_CURSOR_WRITE_BYTE(writer, 1);
+		ACR_CURSOR_WRITE_16_BIG(writer, 0x0203);
+		ACR_CURSOR_WRITE_16_LITTLE(writer, 0x0504);
+		ACR_CURSOR_WRITE_32_BIG(writer, 0x06070809UL);
+		ACR_CURSOR_WRITE_32_LITTLE(writer, 0x0D0C0B0AUL);
+		ACR_CURSOR_WRITE_COPY(writer, "ABC", 3);
+
+		ACR_CURSOR_FROM_BUFFER(reader, view);
+		if((ACR_CURSOR_REMAINING(writer) != 0) ||
+		   (ACR_CURSOR_HAS(writer, 1) != ACR_BOOL_FALSE) ||
+		   (data[2] != 3) ||
+		   (data[3] != 4) ||
+		   (data[5] != 6) ||
+		   (data[9] != 10) ||
+		   (ACR_CURSOR_PEEK_BYTE(reader, 1) != 2) ||
+		   (ACR_CURSOR_READ_BYTE(reader) != 1) ||
+		   (ACR_CURSOR_READ_16_BIG(reader) != 0x0203) ||
+		   (ACR_CURSOR_READ_16_LITTLE(reader) != 0x0504) ||
+		   (ACR_CURSOR_PEEK_32_BIG(reader, 0) != 0x06070809UL) ||
+		   (ACR_CURSOR_READ_32_BIG(reader) != 0x06070809UL) ||
+		   (ACR_CURSOR_READ_32_LITTLE(reader) != 0x0D0C0B0AUL) ||
+		   (ACR_CURSOR_REMAINING(reader) != 3))
+		{
+			ACR_DEBUG_PRINT(14, "FAIL cursor values were not in order");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_CURSOR_SKIP(reader, 1);
+			ACR_CURSOR_READ_COPY(reader, copy, 2);
+			if((copy[0] != 'B') ||
+			   (copy[1] != 'C') ||
+			   (ACR_CURSOR_REMAINING(reader) != 0))
+			{
+				ACR_DEBUG_PRINT(14, "FAIL cursor copy did not match");
+				result = ACR_FAILURE;
+			}
+			else
+			{
+				ACR_DEBUG_PRINT(15, "PASS cursor read and wrote values");
+			}
+		}
+	}
+	ACR_BufferDelete(&bufferPtr);
+
+	return result;
+}
@@ -0,0 +1,363 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_bufferchain.c
+
+    application to test chains of buffer references
+
+*/
+#include "ACR/bufferchain.h"
+
+// included for ACR_FileWriteChain()
+#include "ACR/file.h"
+
+// included for ACR_BufferNewFileInterface()
+#include "ACR/buffer.h"
+
+// included for ACR_BufferObj_t
+#include "ACR/private/private_buffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** append links, visit them, and run out of links
+*/
+int AppendTest(void);
+
+/** slice and copy ranges that cross links
+*/
+int SliceTest(void);
+
+/** linearize one link without a copy and several with one copy
+*/
+int LinearizeTest(void);
+
+/** write a chain to a file with and without m_WriteChain
+*/
+int WriteTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= AppendTest();
+	result |= SliceTest();
+	result |= LinearizeTest();
+	result |= WriteTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of links available to the tests
+*/
+#define TEST_CHAIN_LINKS 4
+
+/**********************************************************/
+int AppendTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Buffer_t links[TEST_CHAIN_LINKS];
+	ACR_BUFFER_CHAIN(chain, links, TEST_CHAIN_LINKS);
+	ACR_BUFFER(link);
+	char header[] = "head";
+	char payload[] = "payload";
+	char trailer[] = "end";
+	ACR_Count_t index;
+	ACR_Length_t visited = 0;
+
+	if((ACR_BufferChainAppend(&chain, header, 4) != ACR_INFO_OK) ||
+	   (ACR_BufferChainAppend(&chain, payload, 0) != ACR_INFO_OK) ||
+	   (ACR_BufferChainAppend(&chain, payload, 7) != ACR_INFO_OK) ||
+	   (ACR_BufferChainAppend(&chain, trailer, 3) != ACR_INFO_OK) ||
+	   (ACR_BufferChainGetCount(&chain) != 3) ||
+	   (ACR_BufferChainGetLength(&chain) != 14))
+	{
+		ACR_DEBUG_PRINT(1, "FAIL chain did not count links and bytes");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(2, "PASS chain counted links and bytes");
+	}
+
+	// every link refers to the original memory
+	for(index = 0; index < ACR_BufferChainGetCount(&chain); index++)
+	{
+		if(ACR_BufferChainGetLink(&chain, index, &link) == ACR_INFO_OK)
+		{
+			visited += link.m_Length;
+		}
+	}
+	if((visited != 14) ||
+	   (ACR_BufferChainGetLink(&chain, 1, &link) != ACR_INFO_OK) ||
+	   (link.m_Pointer != (void*)payload) ||
+	   (ACR_BufferChainGetLink(&chain, 3, &link) != ACR_INFO_ERROR))
+	{
+		ACR_DEBUG_PRINT(3, "FAIL links did not refer to the original memory");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(4, "PASS links referred to the original memory");
+	}
+
+	if((ACR_BufferChainAppend(&chain, header, 4) != ACR_INFO_OK) ||
+	   (ACR_BufferChainAppend(&chain, header, 4) != ACR_INFO_ERROR) ||
+	   (ACR_BufferChainGetLength(&chain) != 18))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL chain did not stop at the last link");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS chain stopped at the last link");
+	}
+
+	ACR_BufferChainClear(&chain);
+	if((ACR_BufferChainGetCount(&chain) != 0) ||
+	   (ACR_BufferChainGetLength(&chain) != 0))
+	{
+		ACR_DEBUG_PRINT(7, "FAIL chain did not clear");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(8, "PASS chain cleared");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int SliceTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Buffer_t links[TEST_CHAIN_LINKS];
+	ACR_Buffer_t sliceLinks[TEST_CHAIN_LINKS];
+	ACR_Buffer_t shortLinks[1];
+	ACR_BUFFER_CHAIN(chain, links, TEST_CHAIN_LINKS);
+	ACR_BUFFER_CHAIN(slice, sliceLinks, TEST_CHAIN_LINKS);
+	ACR_BUFFER_CHAIN(shortSlice, shortLinks, 1);
+	ACR_BUFFER(link);
+	char header[] = "head";
+	char payload[] = "payload";
+	char trailer[] = "end";
+	char copy[16];
+
+	ACR_BufferChainAppend(&chain, header, 4);
+	ACR_BufferChainAppend(&chain, payload, 7);
+	ACR_BufferChainAppend(&chain, trailer, 3);
+
+	// "adpayloade" starts in the header and ends in the trailer
+	if((ACR_BufferChainSlice(&chain, 2, 10, &slice) != ACR_INFO_OK) ||
+	   (ACR_BufferChainGetCount(&slice) != 3) ||
+	   (ACR_BufferChainGetLength(&slice) != 10) ||
+	   (ACR_BufferChainGetLink(&slice, 0, &link) != ACR_INFO_OK) ||
+	   (link.m_Pointer != (void*)&header[2]) ||
+	   (link.m_Length != 2) ||
+	   (ACR_BufferChainGetLink(&slice, 2, &link) != ACR_INFO_OK) ||
+	   (link.m_Pointer != (void*)trailer) ||
+	   (link.m_Length != 1) ||
+	   (ACR_BufferChainCopyTo(&slice, 0, copy, sizeof(copy)) != 10) ||
+	   (ACR_MEMCMP(copy, "adpayloade", 10) != 0))
+	{
+		ACR_DEBUG_PRINT(9, "FAIL slice did not refer to the range");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(10, "PASS slice referred to the range");
+	}
+
+	if((ACR_BufferChainSlice(&chain, 5, 3, &shortSlice) != ACR_INFO_OK) ||
+	   (ACR_BufferChainCopyTo(&shortSlice, 0, copy, sizeof(copy)) != 3) ||
+	   (ACR_MEMCMP(copy, "ayl", 3) != 0) ||
+	   (ACR_BufferChainSlice(&chain, 2, 4, &shortSlice) != ACR_INFO_ERROR) ||
+	   (ACR_BufferChainGetCount(&shortSlice) != 0) ||
+	   (ACR_BufferChainSlice(&chain, 10, 5, &slice) != ACR_INFO_ERROR) ||
+	   (ACR_BufferChainCopyTo(&chain, 12, copy, sizeof(copy)) != 2) ||
+	   (ACR_BufferChainCopyTo(&chain, 14, copy, sizeof(copy)) != 0))
+	{
+		ACR_DEBUG_PRINT(11, "FAIL ranges past the links or the end were not rejected");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(12, "PASS ranges past the links or the end were rejected");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int LinearizeTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Buffer_t links[TEST_CHAIN_LINKS];
+	ACR_BUFFER_CHAIN(chain, links, TEST_CHAIN_LINKS);
+	ACR_Byte_t scratchMemory[16];
+	ACR_VAR_BUFFER(scratch);
+	ACR_BUFFER(view);
+	char header[] = "head";
+	char payload[] = "payload";
+
+	ACR_VAR_BUFFER_SET_MEMORY(scratch, scratchMemory, sizeof(scratchMemory));
+
+	// one link is already contiguous
+	ACR_BufferChainAppend(&chain, payload, 7);
+	if((ACR_BufferChainLinearize(&chain, &scratch, &view) != ACR_INFO_OK) ||
+	   (view.m_Pointer != (void*)payload) ||
+	   (view.m_Length != 7))
+	{
+		ACR_DEBUG_PRINT(13, "FAIL one link was copied");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(14, "PASS one link was not copied");
+	}
+
+	// several links are copied once into scratch
+	ACR_BufferChainClear(&chain);
+	ACR_BufferChainAppend(&chain, header, 4);
+	ACR_BufferChainAppend(&chain, payload, 7);
+	if((ACR_BufferChainLinearize(&chain, &scratch, &view) != ACR_INFO_OK) ||
+	   (view.m_Pointer != (void*)scratchMemory) ||
+	   (view.m_Length != 11) ||
+	   (scratch.m_Buffer.m_Length != 11) ||
+	   (ACR_MEMCMP(scratchMemory, "headpayload", 11) != 0))
+	{
+		ACR_DEBUG_PRINT(15, "FAIL links were not copied into scratch");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(16, "PASS links were copied into scratch");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int WriteTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_BufferObj_t* bufferPtr;
+
+	ACR_BufferNew(&bufferPtr);
+	if(ACR_BufferAllocate(bufferPtr, 8) == ACR_INFO_OK)
+	{
+		ACR_FileInterface_t* bufferAsFile;
+		if(ACR_BufferNewFileInterface(bufferPtr, &bufferAsFile) == ACR_INFO_OK)
+		{
+			ACR_FileInterface_t writeOnly;
+			ACR_Buffer_t links[TEST_CHAIN_LINKS];
+			ACR_BUFFER_CHAIN(chain, links, TEST_CHAIN_LINKS);
+			ACR_Length_t written = 0;
+			ACR_Length_t writtenOneByOne = 0;
+			char header[] = "head";
+			char payload[] = "payload";
+			char trailer[] = "end";
+			ACR_STRING(path);
+
+			ACR_BufferChainAppend(&chain, header, 4);
+			ACR_BufferChainAppend(&chain, payload, 7);
+			ACR_BufferChainAppend(&chain, trailer, 3);
+
+			// the buffer takes the chain in one call
+			// and a file without m_WriteChain takes
+			// one link at a time. both stop when full
+			writeOnly = (*bufferAsFile);
+			writeOnly.m_WriteChain = ACR_NULL;
+			if((bufferAsFile->m_Open(path, ACR_INFO_WRITE, bufferAsFile->m_User) != ACR_INFO_OK) ||
+			   (ACR_FileWriteChain(bufferAsFile, &chain, &written) != ACR_INFO_OK) ||
+			   (bufferAsFile->m_Seek(0, ACR_INFO_FIRST, bufferAsFile->m_User) != ACR_INFO_OK) ||
+			   (ACR_FileWriteChain(&writeOnly, &chain, &writtenOneByOne) != ACR_INFO_OK) ||
+			   (bufferAsFile->m_Close(bufferAsFile->m_User) != ACR_INFO_OK) ||
+			   (written != 8) ||
+			   (writtenOneByOne != 8) ||
+			   (ACR_MEMCMP(bufferPtr->m_Base.m_Pointer, "headpayl", 8) != 0))
+			{
+				ACR_DEBUG_PRINT(17, "FAIL chain was not written in order");
+				result = ACR_FAILURE;
+			}
+			else
+			{
+				ACR_DEBUG_PRINT(18, "PASS chain was written in order");
+			}
+
+			if(ACR_BufferDeleteFileInterface(bufferPtr, &bufferAsFile) != ACR_INFO_OK)
+			{
+				// failed to delete file interface
+				result = ACR_FAILURE;
+			}
+		}
+		else
+		{
+			// failed to create file interface
+			result = ACR_FAILURE;
+		}
+	}
+	else
+	{
+		// failed to allocate 8 bytes
+		result = ACR_FAILURE;
+	}
+	ACR_BufferDelete(&bufferPtr);
+
+	return result;
+}
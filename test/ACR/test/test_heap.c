@@ -0,0 +1,1254 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_heap.c
+
+    application to test the heap used when ACR_CONFIG_NO_LIBC is set
+
+*/
+#include "ACR/heap.h"
+
+// included for ACR_HeapObj_t
+#include "ACR/private/private_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+#if defined(ACR_CONFIG_HEAP_THREADS) && (ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE) && !defined(ACR_PLATFORM_WIN)
+    // included for pthread_create and pthread_join
+    #include <pthread.h>
+    #define TEST_HEAP_THREADS
+#endif
+
+//
+// PROTOTYPES
+//
+
+/** freed memory is reused without adding headers
+*/
+int FreeListTest(void);
+
+/** all memory is available again after freeing all
+*/
+int FreeAllTest(void);
+
+/** large free blocks are split and neighbouring free blocks are merged
+*/
+int SplitAndMergeTest(void);
+
+/** realloc grows and shrinks without moving when possible
+*/
+int ReallocTest(void);
+
+/** aligned allocations free the bytes skipped to align them
+*/
+int AlignedTest(void);
+
+/** a full heap adds regions and gives back empty ones
+*/
+int RegionTest(void);
+
+/** statistics count allocations and can be written to a file
+*/
+int StatsTest(void);
+
+/** many threads can use the global heap at the same time
+*/
+int ThreadTest(void);
+
+/** large allocations get a region of their own that is resized
+*/
+int LargeTest(void);
+
+/** the largest free block is kept as blocks are freed and reused
+*/
+int LargestFreeTest(void);
+
+/** realloc grows into free memory on both sides of an allocation
+*/
+int ReallocNeighboursTest(void);
+
+/** each region added is larger than the last and
+    allocations start with the region used last
+*/
+int RegionGrowthTest(void);
+
+/** fill an allocation with values that can be checked after it moves
+*/
+void TestHeapFill(
+	ACR_Byte_t* ptr,
+	ACR_Length_t bytes);
+
+/** check the values set by TestHeapFill()
+	\returns ACR_BOOL_TRUE if the values are unchanged
+*/
+ACR_Bool_t TestHeapIsFilled(
+	const ACR_Byte_t* ptr,
+	ACR_Length_t bytes);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= FreeListTest();
+	result |= FreeAllTest();
+	result |= SplitAndMergeTest();
+	result |= ReallocTest();
+	result |= AlignedTest();
+	result |= RegionTest();
+	result |= StatsTest();
+	result |= ThreadTest();
+	result |= LargeTest();
+	result |= LargestFreeTest();
+	result |= ReallocNeighboursTest();
+	result |= RegionGrowthTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of allocations made by each test
+*/
+#define TEST_HEAP_ALLOC_COUNT 1000
+
+/** memory used for each test heap
+*/
+ACR_Block_t g_TestHeapMemory[(64*1024)/sizeof(ACR_Block_t)];
+
+/**********************************************************/
+int FreeListTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	void* ptrs[TEST_HEAP_ALLOC_COUNT];
+	int i;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+
+	// fill the heap with allocations of many different sizes
+	for(i = 0; i < TEST_HEAP_ALLOC_COUNT; i++)
+	{
+		ptrs[i] = ACR_HeapAlloc(&heap, (ACR_Length_t)(1 + (i % 40)));
+		if(ptrs[i] == ACR_NULL)
+		{
+			ACR_DEBUG_PRINT(1, "FAIL allocation %d", i);
+			return ACR_FAILURE;
+		}
+	}
+	ACR_DEBUG_PRINT(2, "PASS %d allocations", TEST_HEAP_ALLOC_COUNT);
+
+	// free every other allocation
+	for(i = 0; i < TEST_HEAP_ALLOC_COUNT; i += 2)
+	{
+		ACR_HeapFree(&heap, ptrs[i]);
+	}
+	if(heap.m_FreeCount != (TEST_HEAP_ALLOC_COUNT / 2))
+	{
+		ACR_DEBUG_PRINT(3, "FAIL free count is %d", (int)heap.m_FreeCount);
+		result = ACR_FAILURE;
+	}
+
+	// allocate the same sizes again, which must
+	// reuse the freed memory instead of adding headers
+	for(i = 0; i < TEST_HEAP_ALLOC_COUNT; i += 2)
+	{
+		ptrs[i] = ACR_HeapAlloc(&heap, (ACR_Length_t)(1 + (i % 40)));
+		if(ptrs[i] == ACR_NULL)
+		{
+			ACR_DEBUG_PRINT(4, "FAIL reallocation %d", i);
+			return ACR_FAILURE;
+		}
+	}
+	if((heap.m_FreeCount != 0) ||
+	   (heap.m_HeaderCount != TEST_HEAP_ALLOC_COUNT))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL free count is %d and header count is %d", (int)heap.m_FreeCount, (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS freed memory was reused");
+	}
+
+	// a freed block is found by size
+	ACR_HeapFree(&heap, ptrs[39]);
+	if(ACR_HeapAlloc(&heap, 40) != ptrs[39])
+	{
+		ACR_DEBUG_PRINT(7, "FAIL freed block was not found");
+		result = ACR_FAILURE;
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int FreeAllTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Length_t available;
+	void* ptr;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	available = ACR_HeapAvailable(&heap);
+
+	ptr = ACR_HeapAlloc(&heap, 100);
+	ACR_HeapFree(&heap, ptr);
+	ACR_HeapFreeAll(&heap);
+	if(ACR_HeapAvailable(&heap) != available)
+	{
+		ACR_DEBUG_PRINT(8, "FAIL available is %d but expected %d", (int)ACR_HeapAvailable(&heap), (int)available);
+		result = ACR_FAILURE;
+	}
+	else if(ACR_HeapFindFree(&heap, 0, ACR_NULL))
+	{
+		ACR_DEBUG_PRINT(9, "FAIL free lists are not empty");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(10, "PASS all memory is available");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int SplitAndMergeTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Length_t available;
+	void* ptrs[4];
+	void* guard;
+	void* ptr;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	available = ACR_HeapAvailable(&heap);
+
+	// a small allocation from a large free block
+	// only uses the start of the block
+	ptr = ACR_HeapAlloc(&heap, 1000);
+	guard = ACR_HeapAlloc(&heap, 8);
+	ACR_HeapFree(&heap, ptr);
+	if(ACR_HeapAlloc(&heap, 100) != ptr)
+	{
+		ACR_DEBUG_PRINT(11, "FAIL large free block was not used");
+		result = ACR_FAILURE;
+	}
+	else if((heap.m_FreeCount != 1) ||
+	        (heap.m_HeaderCount != 3))
+	{
+		ACR_DEBUG_PRINT(12, "FAIL free count is %d and header count is %d", (int)heap.m_FreeCount, (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(13, "PASS large free block was split");
+	}
+	ACR_HeapFree(&heap, ptr);
+	ACR_HeapFree(&heap, guard);
+	if((heap.m_HeaderCount != 0) ||
+	   (ACR_HeapAvailable(&heap) != available))
+	{
+		ACR_DEBUG_PRINT(14, "FAIL header count is %d after freeing everything", (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+
+	// free blocks next to each other become one block
+	ptrs[0] = ACR_HeapAlloc(&heap, 100);
+	ptrs[1] = ACR_HeapAlloc(&heap, 100);
+	ptrs[2] = ACR_HeapAlloc(&heap, 100);
+	ptrs[3] = ACR_HeapAlloc(&heap, 100);
+	ACR_HeapFree(&heap, ptrs[0]);
+	ACR_HeapFree(&heap, ptrs[2]);
+	if(ACR_HeapFragmentation(&heap) <= 0)
+	{
+		ACR_DEBUG_PRINT(15, "FAIL fragmentation not detected");
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFree(&heap, ptrs[1]);
+	if((heap.m_FreeCount != 1) ||
+	   (heap.m_HeaderCount != 2) ||
+	   (ACR_HeapFindFree(&heap, 300, ACR_NULL) == ACR_BOOL_FALSE))
+	{
+		ACR_DEBUG_PRINT(16, "FAIL free count is %d and header count is %d", (int)heap.m_FreeCount, (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(17, "PASS neighbouring free blocks were merged");
+	}
+
+	// freeing the last block gives everything back
+	ACR_HeapFree(&heap, ptrs[3]);
+	if((heap.m_FreeCount != 0) ||
+	   (heap.m_HeaderCount != 0) ||
+	   (ACR_HeapAvailable(&heap) != available) ||
+	   (ACR_HeapFragmentation(&heap) != 0))
+	{
+		ACR_DEBUG_PRINT(18, "FAIL memory was not returned to the end of the heap");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(19, "PASS all memory is available");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int ReallocTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Length_t available;
+	ACR_Byte_t* ptr;
+	void* next;
+	void* guard;
+	int i;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	available = ACR_HeapAvailable(&heap);
+
+	// the last allocation grows into the unused memory
+	ptr = (ACR_Byte_t*)ACR_HeapRealloc(&heap, ACR_NULL, 10);
+	for(i = 0; i < 10; i++)
+	{
+		ptr[i] = (ACR_Byte_t)i;
+	}
+	for(i = 20; i <= 2000; i += 20)
+	{
+		if(ACR_HeapRealloc(&heap, ptr, (ACR_Length_t)i) != ptr)
+		{
+			ACR_DEBUG_PRINT(20, "FAIL last allocation moved at %d bytes", i);
+			return ACR_FAILURE;
+		}
+	}
+	ACR_DEBUG_PRINT(21, "PASS last allocation grew in place");
+
+	// a free neighbour is used to grow
+	next = ACR_HeapAlloc(&heap, 500);
+	guard = ACR_HeapAlloc(&heap, 8);
+	ACR_HeapFree(&heap, next);
+	if(ACR_HeapRealloc(&heap, ptr, 2200) != ptr)
+	{
+		ACR_DEBUG_PRINT(22, "FAIL allocation moved instead of using free neighbour");
+		result = ACR_FAILURE;
+	}
+	else if((heap.m_FreeCount != 1) ||
+	        (heap.m_HeaderCount != 3))
+	{
+		ACR_DEBUG_PRINT(23, "FAIL free count is %d and header count is %d", (int)heap.m_FreeCount, (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(24, "PASS allocation grew into free neighbour");
+	}
+
+	// shrinking gives the extra bytes back
+	if(ACR_HeapRealloc(&heap, ptr, 10) != ptr)
+	{
+		ACR_DEBUG_PRINT(25, "FAIL allocation moved when shrinking");
+		result = ACR_FAILURE;
+	}
+	else if(ACR_HeapFindFree(&heap, 2000, ACR_NULL) == ACR_BOOL_FALSE)
+	{
+		ACR_DEBUG_PRINT(26, "FAIL extra bytes were not freed");
+		result = ACR_FAILURE;
+	}
+	for(i = 0; i < 10; i++)
+	{
+		if(ptr[i] != (ACR_Byte_t)i)
+		{
+			ACR_DEBUG_PRINT(27, "FAIL data changed at %d", i);
+			result = ACR_FAILURE;
+			break;
+		}
+	}
+
+	ACR_HeapFree(&heap, guard);
+	ACR_HeapFree(&heap, ptr);
+	if((heap.m_HeaderCount != 0) ||
+	   (ACR_HeapAvailable(&heap) != available))
+	{
+		ACR_DEBUG_PRINT(28, "FAIL header count is %d after freeing everything", (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(29, "PASS all memory is available");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int AlignedTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Length_t available;
+	ACR_Length_t alignment;
+	void* small;
+	void* ptr;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	available = ACR_HeapAvailable(&heap);
+
+	for(alignment = 16; alignment <= 4096; alignment *= 2)
+	{
+		small = ACR_HeapAlloc(&heap, 1);
+		ptr = ACR_HeapAllocAligned(&heap, 100, alignment);
+		if((ptr == ACR_NULL) ||
+		   (((ACR_PointerValue_t)ptr % alignment) != 0))
+		{
+			ACR_DEBUG_PRINT(30, "FAIL %d byte alignment returned %p", (int)alignment, ptr);
+			result = ACR_FAILURE;
+		}
+		ACR_HeapFree(&heap, small);
+		ACR_HeapFree(&heap, ptr);
+		if((heap.m_HeaderCount != 0) ||
+		   (ACR_HeapAvailable(&heap) != available))
+		{
+			ACR_DEBUG_PRINT(31, "FAIL %d byte alignment did not free all memory", (int)alignment);
+			result = ACR_FAILURE;
+		}
+	}
+
+	if(ACR_HeapAllocAligned(&heap, 100, 24) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(32, "FAIL alignment that is not a power of two was allowed");
+		result = ACR_FAILURE;
+	}
+
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(33, "PASS aligned allocations");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/** number of regions that can be acquired by the test
+*/
+#define TEST_HEAP_REGION_COUNT 3
+
+/** memory for each region acquired by the test
+    Note: regions are twice the normal size so that
+          a region larger than normal can be acquired
+*/
+ACR_Block_t g_TestRegionMemory[TEST_HEAP_REGION_COUNT][(2*ACR_CONFIG_HEAP_REGION_SIZE)/sizeof(ACR_Block_t)];
+
+/** set for each region that is in use
+*/
+ACR_Bool_t g_TestRegionUsed[TEST_HEAP_REGION_COUNT];
+
+/** \see ACR_HeapCallbackAcquireRegion_t
+*/
+void* TestAcquireRegion(
+	ACR_Length_t length)
+{
+	int i;
+	if(length > sizeof(g_TestRegionMemory[0]))
+	{
+		return ACR_NULL;
+	}
+	for(i = 0; i < TEST_HEAP_REGION_COUNT; i++)
+	{
+		if(g_TestRegionUsed[i] == ACR_BOOL_FALSE)
+		{
+			g_TestRegionUsed[i] = ACR_BOOL_TRUE;
+			return g_TestRegionMemory[i];
+		}
+	}
+	return ACR_NULL;
+}
+
+/** \see ACR_HeapCallbackReleaseRegion_t
+*/
+void TestReleaseRegion(
+	void* ptr,
+	ACR_Length_t length)
+{
+	int i;
+	ACR_UNUSED(length);
+	for(i = 0; i < TEST_HEAP_REGION_COUNT; i++)
+	{
+		if(ptr == g_TestRegionMemory[i])
+		{
+			g_TestRegionUsed[i] = ACR_BOOL_FALSE;
+		}
+	}
+}
+
+/** number of times TestResizeRegion() moved a region
+*/
+int g_TestResizeCount;
+
+/** \see ACR_HeapCallbackResizeRegion_t
+    Note: the region is always moved so that the
+          heap must follow it to its new memory
+*/
+void* TestResizeRegion(
+	void* ptr,
+	ACR_Length_t length,
+	ACR_Length_t newLength)
+{
+	void* newPtr;
+	if(newLength > sizeof(g_TestRegionMemory[0]))
+	{
+		return ACR_NULL;
+	}
+	newPtr = TestAcquireRegion(newLength);
+	if(newPtr)
+	{
+		ACR_MEMCPY(newPtr, ptr, ((length < newLength) ? length : newLength));
+		TestReleaseRegion(ptr, length);
+		g_TestResizeCount++;
+	}
+	return newPtr;
+}
+
+/**********************************************************/
+int RegionTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	void* first;
+	void* second;
+	void* grown;
+	ACR_Length_t pos;
+
+	// start with a heap that is too small for anything
+	ACR_HeapInit(&heap, g_TestHeapMemory, 64);
+	ACR_HeapSetRegionCallbacks(&heap, TestAcquireRegion, TestReleaseRegion);
+	first = ACR_HeapAlloc(&heap, 1000);
+	second = ACR_HeapAlloc(&heap, 1000);
+	if((first == ACR_NULL) ||
+	   (second == ACR_NULL) ||
+	   (ACR_HeapPointerRegion(&heap, first, ACR_NULL) != heap.m_NextRegion) ||
+	   (ACR_HeapPointerRegion(&heap, second, &pos) != heap.m_NextRegion) ||
+	   (g_TestRegionUsed[1] == ACR_BOOL_TRUE))
+	{
+		ACR_DEBUG_PRINT(34, "FAIL allocations were not made in one new region");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(35, "PASS region was added to the heap");
+	}
+
+	// too large for the region so it moves to another one
+	grown = ACR_HeapRealloc(&heap, first, ACR_CONFIG_HEAP_REGION_SIZE);
+	if((grown == ACR_NULL) ||
+	   (g_TestRegionUsed[1] == ACR_BOOL_FALSE) ||
+	   (ACR_HeapPointerRegion(&heap, grown, ACR_NULL) == ACR_HeapPointerRegion(&heap, second, ACR_NULL)))
+	{
+		ACR_DEBUG_PRINT(36, "FAIL reallocation did not add a region");
+		result = ACR_FAILURE;
+	}
+
+	// empty regions are given back
+	ACR_HeapFree(&heap, second);
+	if(g_TestRegionUsed[0] == ACR_BOOL_TRUE)
+	{
+		ACR_DEBUG_PRINT(37, "FAIL empty region was not released");
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFreeAll(&heap);
+	if((g_TestRegionUsed[1] == ACR_BOOL_TRUE) ||
+	   (heap.m_NextRegion != ACR_NULL))
+	{
+		ACR_DEBUG_PRINT(38, "FAIL free all did not release regions");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(39, "PASS regions were released");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/** text written by TestWriteStats()
+*/
+char g_TestStatsText[1024];
+
+/** number of characters in g_TestStatsText
+*/
+ACR_Length_t g_TestStatsLength;
+
+/** \see ACR_FileCallbackWrite_t
+*/
+ACR_Info_t TestWriteStats(
+	ACR_VarBuffer_t* src,
+	void* userPtr)
+{
+	ACR_UNUSED(userPtr);
+	if(src->m_MaxLength > (sizeof(g_TestStatsText) - g_TestStatsLength))
+	{
+		return ACR_INFO_ERROR;
+	}
+	ACR_MEMCPY(&g_TestStatsText[g_TestStatsLength], src->m_Buffer.m_Pointer, src->m_MaxLength);
+	g_TestStatsLength += src->m_MaxLength;
+	src->m_Buffer.m_Length = src->m_MaxLength;
+	return ACR_INFO_OK;
+}
+
+/** check if the text written by TestWriteStats() has this line
+*/
+ACR_Bool_t TestStatsHasLine(
+	const char* line)
+{
+	ACR_Length_t start;
+	for(start = 0; start < g_TestStatsLength; start++)
+	{
+		ACR_Length_t i = 0;
+		while(((start + i) < g_TestStatsLength) &&
+		      (line[i] != '\0') &&
+		      (g_TestStatsText[start + i] == line[i]))
+		{
+			i++;
+		}
+		if((line[i] == '\0') &&
+		   ((start + i) < g_TestStatsLength) &&
+		   (g_TestStatsText[start + i] == '\n') &&
+		   ((start == 0) || (g_TestStatsText[start - 1] == '\n')))
+		{
+			return ACR_BOOL_TRUE;
+		}
+	}
+	return ACR_BOOL_FALSE;
+}
+
+/**********************************************************/
+int StatsTest(void)
+{
+	int result = ACR_SUCCESS;
+#ifndef ACR_CONFIG_NO_HEAP_STATS
+	ACR_HeapObj_t heap;
+	ACR_HeapStats_t stats;
+	ACR_FILE_INTERFACE(file);
+	void* first;
+	void* second;
+	void* grown;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	first = ACR_HeapAlloc(&heap, 100);
+	second = ACR_HeapAlloc(&heap, 5);
+	grown = ACR_HeapRealloc(&heap, second, 50);
+	ACR_HeapFree(&heap, first);
+	ACR_HeapFree(&heap, first);
+	if((ACR_HeapGetStats(&heap, &stats) == ACR_BOOL_FALSE) ||
+	   (grown == ACR_NULL) ||
+	   (stats.m_AllocCount != 2) ||
+	   (stats.m_FreeCount != 1) ||
+	   (stats.m_ReallocCount != 1) ||
+	   (stats.m_FailCount != 0) ||
+	   (stats.m_SizeCount[6] != 1) ||
+	   (stats.m_SizeCount[2] != 1) ||
+	   (stats.m_LargestFree != ACR_HeapLargestFree(&heap)))
+	{
+		ACR_DEBUG_PRINT(40, "FAIL allocations were not counted");
+		result = ACR_FAILURE;
+	}
+	else if((stats.m_LiveBytes < 50) ||
+	        (stats.m_PeakBytes < (stats.m_LiveBytes + 100)))
+	{
+		ACR_DEBUG_PRINT(41, "FAIL live bytes %lu peak bytes %lu", (unsigned long)stats.m_LiveBytes, (unsigned long)stats.m_PeakBytes);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(42, "PASS statistics were counted");
+	}
+
+	// failures are counted separately
+	if((ACR_HeapAlloc(&heap, sizeof(g_TestHeapMemory)) != ACR_NULL) ||
+	   (ACR_HeapGetStats(&heap, &stats) == ACR_BOOL_FALSE) ||
+	   (stats.m_FailCount != 1) ||
+	   (stats.m_AllocCount != 2))
+	{
+		ACR_DEBUG_PRINT(43, "FAIL failed allocation was not counted");
+		result = ACR_FAILURE;
+	}
+
+	file.m_Write = TestWriteStats;
+	g_TestStatsLength = 0;
+	if((ACR_HeapWriteStats(&heap, &file) != ACR_INFO_OK) ||
+	   (TestStatsHasLine("alloc_count=2") == ACR_BOOL_FALSE) ||
+	   (TestStatsHasLine("fail_count=1") == ACR_BOOL_FALSE) ||
+	   (TestStatsHasLine("size_2^06=1") == ACR_BOOL_FALSE))
+	{
+		ACR_DEBUG_PRINT(44, "FAIL statistics were not written");
+		result = ACR_FAILURE;
+	}
+
+	// everything but the live bytes starts over
+	ACR_HeapResetStats(&heap);
+	ACR_HeapFree(&heap, grown);
+	if((ACR_HeapGetStats(&heap, &stats) == ACR_BOOL_FALSE) ||
+	   (stats.m_LiveBytes != 0) ||
+	   (stats.m_FreeCount != 1) ||
+	   (stats.m_AllocCount != 0))
+	{
+		ACR_DEBUG_PRINT(45, "FAIL statistics were not reset");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(46, "PASS statistics were written and reset");
+	}
+
+	ACR_HeapDeInit(&heap);
+#endif
+	return result;
+}
+
+#ifdef TEST_HEAP_THREADS
+
+/** number of threads started at once by ThreadTest()
+*/
+#define TEST_HEAP_THREAD_COUNT 16
+
+/** number of allocations made by each thread
+*/
+#define TEST_HEAP_THREAD_ALLOC_COUNT 200
+
+/** allocations made by each thread
+*/
+unsigned char* g_TestThreadPtrs[TEST_HEAP_THREAD_COUNT][TEST_HEAP_THREAD_ALLOC_COUNT];
+
+/** ACR_BOOL_FALSE if any thread found memory that was changed by another thread
+*/
+ACR_Bool_t g_TestThreadOk[TEST_HEAP_THREAD_COUNT];
+
+/** allocate memory and fill it with the index of the thread
+*/
+void* TestThreadAlloc(
+	void* arg)
+{
+	int thread = (int)(ACR_PointerValue_t)arg;
+	int i;
+	for(i = 0; i < TEST_HEAP_THREAD_ALLOC_COUNT; i++)
+	{
+		ACR_Length_t bytes = (ACR_Length_t)(1 + ((i * 7) % 300));
+		g_TestThreadPtrs[thread][i] = (unsigned char*)ACR_GlobalHeapAlloc(bytes);
+		if(g_TestThreadPtrs[thread][i] != ACR_NULL)
+		{
+			ACR_MEMSET(g_TestThreadPtrs[thread][i], thread, bytes);
+		}
+		else
+		{
+			g_TestThreadOk[thread] = ACR_BOOL_FALSE;
+		}
+
+		// free some right away so that
+		// the cache of the thread is reused
+		if((i % 3) == 0)
+		{
+			ACR_GlobalHeapFree(g_TestThreadPtrs[thread][i]);
+			g_TestThreadPtrs[thread][i] = ACR_NULL;
+		}
+	}
+	return ACR_NULL;
+}
+
+/** check and free the memory allocated by the next thread
+*/
+void* TestThreadFree(
+	void* arg)
+{
+	int thread = (int)(ACR_PointerValue_t)arg;
+	int owner = ((thread + 1) % TEST_HEAP_THREAD_COUNT);
+	int i;
+	for(i = 0; i < TEST_HEAP_THREAD_ALLOC_COUNT; i++)
+	{
+		unsigned char* ptr = g_TestThreadPtrs[owner][i];
+		if(ptr != ACR_NULL)
+		{
+			ACR_Length_t bytes = (ACR_Length_t)(1 + ((i * 7) % 300));
+			if((ptr[0] != owner) || (ptr[bytes - 1] != owner))
+			{
+				g_TestThreadOk[thread] = ACR_BOOL_FALSE;
+			}
+			ACR_GlobalHeapFree(ptr);
+		}
+	}
+	return ACR_NULL;
+}
+
+/** run one function on every thread at the same time
+*/
+void TestThreadRun(
+	void* (*func)(void*))
+{
+	pthread_t threads[TEST_HEAP_THREAD_COUNT];
+	int i;
+	for(i = 0; i < TEST_HEAP_THREAD_COUNT; i++)
+	{
+		pthread_create(&threads[i], ACR_NULL, func, (void*)(ACR_PointerValue_t)i);
+	}
+	for(i = 0; i < TEST_HEAP_THREAD_COUNT; i++)
+	{
+		pthread_join(threads[i], ACR_NULL);
+	}
+}
+
+#endif // #ifdef TEST_HEAP_THREADS
+
+/**********************************************************/
+int ThreadTest(void)
+{
+	int result = ACR_SUCCESS;
+#ifdef TEST_HEAP_THREADS
+	ACR_HeapStats_t stats;
+	int round;
+	int i;
+
+	for(i = 0; i < TEST_HEAP_THREAD_COUNT; i++)
+	{
+		g_TestThreadOk[i] = ACR_BOOL_TRUE;
+	}
+
+	for(round = 0; round < 4; round++)
+	{
+		TestThreadRun(TestThreadAlloc);
+		TestThreadRun(TestThreadFree);
+	}
+	ACR_GlobalHeapGetStats(&stats);
+
+	for(i = 0; i < TEST_HEAP_THREAD_COUNT; i++)
+	{
+		if(g_TestThreadOk[i] == ACR_BOOL_FALSE)
+		{
+			ACR_DEBUG_PRINT(47, "FAIL thread %d memory was not allocated or was changed", i);
+			result = ACR_FAILURE;
+		}
+	}
+
+	// every block is given back when it is freed or when
+	// its thread ends so only the caches are left, which
+	// are never freed but are reused by new threads
+	if(stats.m_LiveBytes > (2 * TEST_HEAP_THREAD_COUNT * sizeof(ACR_HeapThreadCache_t)))
+	{
+		ACR_DEBUG_PRINT(48, "FAIL %lu bytes are still allocated", (unsigned long)stats.m_LiveBytes);
+		result = ACR_FAILURE;
+	}
+	else if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(49, "PASS threads used the global heap");
+	}
+#endif
+	return result;
+}
+
+/**********************************************************/
+int LargeTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Byte_t* large;
+	ACR_Byte_t* grown;
+	ACR_Byte_t* shrunk;
+	void* small;
+	ACR_HeapObj_t* region;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+	ACR_HeapSetRegionCallbacks(&heap, TestAcquireRegion, TestReleaseRegion);
+	ACR_HeapSetResizeRegionCallback(&heap, TestResizeRegion);
+	large = (ACR_Byte_t*)ACR_HeapAlloc(&heap, ACR_CONFIG_HEAP_LARGE_SIZE);
+	small = ACR_HeapAlloc(&heap, 1000);
+	region = ACR_HeapPointerRegion(&heap, large, ACR_NULL);
+	if((large == ACR_NULL) ||
+	   (region == ACR_NULL) ||
+	   (region == &heap) ||
+	   (region->m_IsLarge == ACR_BOOL_FALSE) ||
+	   (ACR_HeapPointerRegion(&heap, small, ACR_NULL) != &heap))
+	{
+		ACR_DEBUG_PRINT(50, "FAIL large allocation did not get a region of its own");
+		return ACR_FAILURE;
+	}
+	large[0] = 1;
+	large[ACR_CONFIG_HEAP_LARGE_SIZE - 1] = 2;
+
+	// growing moves the region instead of copying the allocation
+	g_TestResizeCount = 0;
+	grown = (ACR_Byte_t*)ACR_HeapRealloc(&heap, large, (2 * ACR_CONFIG_HEAP_LARGE_SIZE));
+	region = ACR_HeapPointerRegion(&heap, grown, ACR_NULL);
+	if((grown == ACR_NULL) ||
+	   (g_TestResizeCount != 1) ||
+	   (region == ACR_NULL) ||
+	   (region->m_IsLarge == ACR_BOOL_FALSE) ||
+	   (grown[0] != 1) ||
+	   (grown[ACR_CONFIG_HEAP_LARGE_SIZE - 1] != 2))
+	{
+		ACR_DEBUG_PRINT(51, "FAIL large allocation region was not resized");
+		return ACR_FAILURE;
+	}
+
+	// shrinking gives memory back
+	shrunk = (ACR_Byte_t*)ACR_HeapRealloc(&heap, grown, ACR_CONFIG_HEAP_LARGE_SIZE);
+	if((shrunk == ACR_NULL) ||
+	   (g_TestResizeCount != 2) ||
+	   (shrunk[0] != 1) ||
+	   (shrunk[ACR_CONFIG_HEAP_LARGE_SIZE - 1] != 2))
+	{
+		ACR_DEBUG_PRINT(52, "FAIL large allocation region was not made smaller");
+		result = ACR_FAILURE;
+	}
+
+	// too small to be large so it is moved and the region is given back
+	small = ACR_HeapRealloc(&heap, shrunk, 1000);
+	if((small == ACR_NULL) ||
+	   (ACR_HeapPointerRegion(&heap, small, ACR_NULL) != &heap) ||
+	   (((ACR_Byte_t*)small)[0] != 1) ||
+	   (heap.m_NextRegion != ACR_NULL))
+	{
+		ACR_DEBUG_PRINT(53, "FAIL large region was not released");
+		result = ACR_FAILURE;
+	}
+	else if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(54, "PASS large allocations used regions of their own");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+#if defined(ACR_CONFIG_HEAP_MMAP) && (ACR_HEAP_IS_GLOBAL == ACR_BOOL_TRUE)
+	// the global heap maps memory for large allocations
+	large = (ACR_Byte_t*)ACR_MALLOC(ACR_CONFIG_HEAP_LARGE_SIZE);
+	if(large)
+	{
+		large[ACR_CONFIG_HEAP_LARGE_SIZE - 1] = 3;
+	}
+	grown = (ACR_Byte_t*)ACR_REALLOC(large, (4 * ACR_CONFIG_HEAP_LARGE_SIZE));
+	if((grown == ACR_NULL) ||
+	   (grown[ACR_CONFIG_HEAP_LARGE_SIZE - 1] != 3))
+	{
+		ACR_DEBUG_PRINT(55, "FAIL global heap did not resize a large allocation");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(56, "PASS global heap resized a large allocation");
+	}
+	ACR_FREE(grown);
+#endif
+
+	return result;
+}
+
+/**********************************************************/
+int LargestFreeTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Length_t sizes[4] = {968, 984, 1016, 1000};
+	void* ptrs[4];
+	void* guards[4];
+	void* filler;
+	ACR_Count_t i;
+
+	// these sizes are all in the same free list
+	ACR_HeapInit(&heap, g_TestHeapMemory, (8*1024));
+	for(i = 0; i < 4; i++)
+	{
+		ptrs[i] = ACR_HeapAlloc(&heap, sizes[i]);
+		guards[i] = ACR_HeapAlloc(&heap, 8);
+	}
+
+	// use the rest of the heap so that only
+	// the free lists have free blocks
+	filler = ACR_HeapAlloc(&heap, ACR_HeapAvailable(&heap));
+	ACR_HeapFree(&heap, ptrs[0]);
+	ACR_HeapFree(&heap, ptrs[1]);
+	ACR_HeapFree(&heap, ptrs[3]);
+	if((filler == ACR_NULL) ||
+	   (ACR_HeapLargestFree(&heap) != 1000))
+	{
+		ACR_DEBUG_PRINT(57, "FAIL largest free is %d but expected 1000", (int)ACR_HeapLargestFree(&heap));
+		result = ACR_FAILURE;
+	}
+
+	// a larger block is found as soon as it is freed
+	// and the next largest is found after it is reused
+	ACR_HeapFree(&heap, ptrs[2]);
+	if(ACR_HeapLargestFree(&heap) != 1016)
+	{
+		ACR_DEBUG_PRINT(58, "FAIL largest free is %d but expected 1016", (int)ACR_HeapLargestFree(&heap));
+		result = ACR_FAILURE;
+	}
+	ptrs[2] = ACR_HeapAlloc(&heap, 900);
+	if((ptrs[2] == ACR_NULL) ||
+	   (ACR_HeapLargestFree(&heap) != 1000) ||
+	   (ACR_HeapLargestFree(&heap) != 1000))
+	{
+		ACR_DEBUG_PRINT(58, "FAIL largest free is %d but expected 1000", (int)ACR_HeapLargestFree(&heap));
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFree(&heap, ptrs[2]);
+	for(i = 0; i < 4; i++)
+	{
+		ACR_HeapFree(&heap, guards[i]);
+	}
+	ACR_HeapFree(&heap, filler);
+	if(heap.m_HeaderCount != 0)
+	{
+		ACR_DEBUG_PRINT(58, "FAIL header count is %d after freeing everything", (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(59, "PASS largest free block was kept");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int ReallocNeighboursTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	ACR_Byte_t* prev;
+	ACR_Byte_t* ptr;
+	ACR_Byte_t* next;
+	ACR_Byte_t* newPtr;
+	void* guard;
+
+	ACR_HeapInit(&heap, g_TestHeapMemory, sizeof(g_TestHeapMemory));
+
+	// a free header before the allocation is used by moving into it
+	prev = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 500);
+	ptr = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 100);
+	guard = ACR_HeapAlloc(&heap, 8);
+	TestHeapFill(ptr, 100);
+	ACR_HeapFree(&heap, prev);
+	newPtr = (ACR_Byte_t*)ACR_HeapRealloc(&heap, ptr, 600);
+	if((newPtr != prev) ||
+	   (TestHeapIsFilled(newPtr, 100) == ACR_BOOL_FALSE) ||
+	   (heap.m_FreeCount != 0) ||
+	   (heap.m_HeaderCount != 2))
+	{
+		ACR_DEBUG_PRINT(60, "FAIL allocation did not move into the free header before it");
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFree(&heap, newPtr);
+	ACR_HeapFree(&heap, guard);
+
+	// free headers on both sides are used together
+	prev = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 200);
+	ptr = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 200);
+	next = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 200);
+	guard = ACR_HeapAlloc(&heap, 8);
+	TestHeapFill(ptr, 200);
+	ACR_HeapFree(&heap, prev);
+	ACR_HeapFree(&heap, next);
+	newPtr = (ACR_Byte_t*)ACR_HeapRealloc(&heap, ptr, 600);
+	if((newPtr != prev) ||
+	   (TestHeapIsFilled(newPtr, 200) == ACR_BOOL_FALSE) ||
+	   (heap.m_FreeCount != 1) ||
+	   (heap.m_HeaderCount != 3))
+	{
+		ACR_DEBUG_PRINT(60, "FAIL allocation did not use the free headers on both sides");
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFree(&heap, newPtr);
+	ACR_HeapFree(&heap, guard);
+
+	// the last allocation uses the free header before it
+	// together with the unused memory at the end
+	prev = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 200);
+	ptr = (ACR_Byte_t*)ACR_HeapAlloc(&heap, 100);
+	TestHeapFill(ptr, 100);
+	ACR_HeapFree(&heap, prev);
+	newPtr = (ACR_Byte_t*)ACR_HeapRealloc(&heap, ptr, (ACR_HeapAvailable(&heap) + 200));
+	if((newPtr != prev) ||
+	   (TestHeapIsFilled(newPtr, 100) == ACR_BOOL_FALSE) ||
+	   (heap.m_FreeCount != 0) ||
+	   (heap.m_HeaderCount != 1))
+	{
+		ACR_DEBUG_PRINT(61, "FAIL last allocation did not use the free header before it");
+		result = ACR_FAILURE;
+	}
+	ACR_HeapFree(&heap, newPtr);
+	if(heap.m_HeaderCount != 0)
+	{
+		ACR_DEBUG_PRINT(61, "FAIL header count is %d after freeing everything", (int)heap.m_HeaderCount);
+		result = ACR_FAILURE;
+	}
+	else if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(62, "PASS realloc used free headers on both sides");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+int RegionGrowthTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapObj_t heap;
+	void* ptrs[32];
+	ACR_HeapObj_t* first;
+	ACR_HeapObj_t* second = ACR_NULL;
+	void* ptr;
+	int count = 0;
+	int i;
+
+	// fill the first region until a second one is added
+	ACR_HeapInit(&heap, g_TestHeapMemory, 64);
+	ACR_HeapSetRegionCallbacks(&heap, TestAcquireRegion, TestReleaseRegion);
+	ptrs[count++] = ACR_HeapAlloc(&heap, 1000);
+	first = ACR_HeapPointerRegion(&heap, ptrs[0], ACR_NULL);
+	while((first != ACR_NULL) &&
+	      (second == ACR_NULL) &&
+	      (count < 32))
+	{
+		ptrs[count] = ACR_HeapAlloc(&heap, (ACR_CONFIG_HEAP_LARGE_SIZE / 2));
+		second = ACR_HeapPointerRegion(&heap, ptrs[count], ACR_NULL);
+		count++;
+		if(second == first)
+		{
+			second = ACR_NULL;
+		}
+	}
+	if((second == ACR_NULL) ||
+	   (first->m_HeapLength > ACR_CONFIG_HEAP_REGION_SIZE) ||
+	   (second->m_HeapLength <= ACR_CONFIG_HEAP_REGION_SIZE))
+	{
+		ACR_DEBUG_PRINT(63, "FAIL second region is not larger than the first");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		// memory freed in the first region is not
+		// used while the second region has room
+		ACR_HeapFree(&heap, ptrs[1]);
+		ptr = ACR_HeapAlloc(&heap, 1000);
+		if(ACR_HeapPointerRegion(&heap, ptr, ACR_NULL) != second)
+		{
+			ACR_DEBUG_PRINT(64, "FAIL allocation did not start with the last region used");
+			result = ACR_FAILURE;
+		}
+		ptrs[1] = ptr;
+	}
+
+	for(i = 0; i < count; i++)
+	{
+		ACR_HeapFree(&heap, ptrs[i]);
+	}
+	if((heap.m_NextRegion != ACR_NULL) ||
+	   (g_TestRegionUsed[0] == ACR_BOOL_TRUE) ||
+	   (g_TestRegionUsed[1] == ACR_BOOL_TRUE))
+	{
+		ACR_DEBUG_PRINT(64, "FAIL regions were not released");
+		result = ACR_FAILURE;
+	}
+	else if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(65, "PASS regions grew and the last one used was tried first");
+	}
+
+	ACR_HeapDeInit(&heap);
+
+	return result;
+}
+
+/**********************************************************/
+void TestHeapFill(
+	ACR_Byte_t* ptr,
+	ACR_Length_t bytes)
+{
+	ACR_Length_t i;
+	for(i = 0; i < bytes; i++)
+	{
+		ptr[i] = (ACR_Byte_t)(i + 1);
+	}
+}
+
+/**********************************************************/
+ACR_Bool_t TestHeapIsFilled(
+	const ACR_Byte_t* ptr,
+	ACR_Length_t bytes)
+{
+	ACR_Length_t i;
+	for(i = 0; i < bytes; i++)
+	{
+		if(ptr[i] != (ACR_Byte_t)(i + 1))
+		{
+			return ACR_BOOL_FALSE;
+		}
+	}
+	return ACR_BOOL_TRUE;
+}
@@ -0,0 +1,339 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_heapfile.c
+
+    application to test the heap kept in a memory mapped file
+
+*/
+#include "ACR/heapfile.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+#ifndef ACR_CONFIG_NO_LIBC
+// included for remove
+#include <stdio.h>
+#endif
+
+//
+// PROTOTYPES
+//
+
+/** a heap attached at a different address
+    keeps its allocations and root
+*/
+int AttachTest(void);
+
+/** memory that is not a valid heap is not attached
+*/
+int InvalidTest(void);
+
+/** a heap file is attached again after it is closed
+*/
+int FileTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= AttachTest();
+	result |= InvalidTest();
+	result |= FileTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** memory for the heaps that are not in a file
+    Note: ACR_Block_t is used so that the memory
+          is aligned to ACR_HEAP_ALIGNMENT
+*/
+ACR_Block_t g_TestMemory[2][(ACR_HEAP_FILE_HEADER_SIZE + 4096) / sizeof(ACR_Block_t)];
+
+/** data kept in the heap by the tests
+*/
+typedef struct TestRoot_s
+{
+	ACR_Length_t m_Value;
+	ACR_Length_t m_NextPos;
+} TestRoot_t;
+
+/**********************************************************/
+int AttachTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapFileHeader_t* header;
+	TestRoot_t* root;
+	TestRoot_t* next;
+
+	header = ACR_HeapFileInitMemory(g_TestMemory[0], sizeof(g_TestMemory[0]));
+	if(header == ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL ACR_HeapFileInitMemory()");
+		return ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(1, "PASS");
+	}
+
+	root = (TestRoot_t*)ACR_HeapAlloc(ACR_HeapFileHeap(header), sizeof(TestRoot_t));
+	next = (TestRoot_t*)ACR_HeapAlloc(ACR_HeapFileHeap(header), sizeof(TestRoot_t));
+	if((root == ACR_NULL) ||
+	   (next == ACR_NULL))
+	{
+		ACR_DEBUG_PRINT(2, "FAIL ACR_HeapAlloc()");
+		return ACR_FAILURE;
+	}
+	root->m_Value = 1234;
+	root->m_NextPos = ACR_HeapFilePos(header, next);
+	next->m_Value = 5678;
+	next->m_NextPos = 0;
+	ACR_HeapFileSetRoot(header, root);
+	if(ACR_HeapFileGetRoot(header) != root)
+	{
+		ACR_DEBUG_PRINT(2, "FAIL ACR_HeapFileGetRoot()");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(2, "PASS");
+	}
+
+	// move the memory
+	ACR_MEMCPY(g_TestMemory[1], g_TestMemory[0], sizeof(g_TestMemory[0]));
+	ACR_MEMSET(g_TestMemory[0], 0, sizeof(g_TestMemory[0]));
+	header = ACR_HeapFileAttachMemory(g_TestMemory[1], sizeof(g_TestMemory[1]));
+	if(header == ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(3, "FAIL ACR_HeapFileAttachMemory()");
+		return ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(3, "PASS");
+	}
+
+	root = (TestRoot_t*)ACR_HeapFileGetRoot(header);
+	next = (root != ACR_NULL) ? (TestRoot_t*)ACR_HeapFilePointer(header, root->m_NextPos) : ACR_NULL;
+	if((root == ACR_NULL) ||
+	   ((void*)root < (void*)g_TestMemory[1]) ||
+	   (root->m_Value != 1234) ||
+	   (next == ACR_NULL) ||
+	   (next->m_Value != 5678))
+	{
+		ACR_DEBUG_PRINT(4, "FAIL root was not kept");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(4, "PASS");
+	}
+
+	// the attached heap can still allocate and free
+	ACR_HeapFree(ACR_HeapFileHeap(header), next);
+	next = (TestRoot_t*)ACR_HeapAlloc(ACR_HeapFileHeap(header), 1024);
+	if((next == ACR_NULL) ||
+	   (ACR_HeapPointerRegion(ACR_HeapFileHeap(header), next, ACR_NULL) != ACR_HeapFileHeap(header)))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL ACR_HeapAlloc() after attaching");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(5, "PASS");
+	}
+
+	ACR_HeapFileSetRoot(header, ACR_NULL);
+	if(ACR_HeapFileGetRoot(header) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(6, "FAIL root was not removed");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int InvalidTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapFileHeader_t* header;
+
+	if(ACR_HeapFileInitMemory(g_TestMemory[0], ACR_HEAP_FILE_HEADER_SIZE) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(7, "FAIL memory without room for a heap was used");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(7, "PASS");
+	}
+
+	header = ACR_HeapFileInitMemory(g_TestMemory[0], sizeof(g_TestMemory[0]));
+	if(ACR_HeapFileAttachMemory(g_TestMemory[0], sizeof(g_TestMemory[0]) - ACR_HEAP_ALIGNMENT) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(8, "FAIL attached with the wrong length");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(8, "PASS");
+	}
+
+	header->m_Layout++;
+	if(ACR_HeapFileAttachMemory(g_TestMemory[0], sizeof(g_TestMemory[0])) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(9, "FAIL attached with a different layout");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(9, "PASS");
+	}
+
+	header->m_Layout--;
+	header->m_Magic[0] = 0;
+	if(ACR_HeapFileAttachMemory(g_TestMemory[0], sizeof(g_TestMemory[0])) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(10, "FAIL attached without the magic bytes");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(10, "PASS");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int FileTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HEAP_FILE(file);
+	const char* path = "test_heapfile.heap";
+	ACR_Length_t* value;
+
+#ifndef ACR_CONFIG_NO_LIBC
+	remove(path);
+	if(ACR_HeapFileOpen(&file, path, 64 * 1024) != ACR_INFO_NEW)
+	{
+		ACR_DEBUG_PRINT(11, "FAIL ACR_HeapFileOpen() new file");
+		return ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(11, "PASS");
+	}
+
+	value = (ACR_Length_t*)ACR_HeapAlloc(ACR_HeapFileHeap(file.m_Header), sizeof(ACR_Length_t));
+	if(value != ACR_NULL)
+	{
+		(*value) = 42;
+	}
+	ACR_HeapFileSetRoot(file.m_Header, value);
+	if(ACR_HeapFileSync(&file) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(12, "FAIL ACR_HeapFileSync()");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(12, "PASS");
+	}
+	ACR_HeapFileClose(&file);
+
+	if(ACR_HeapFileOpen(&file, path, 0) != ACR_INFO_OLD)
+	{
+		ACR_DEBUG_PRINT(13, "FAIL ACR_HeapFileOpen() existing file");
+		remove(path);
+		return ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(13, "PASS");
+	}
+
+	value = (ACR_Length_t*)ACR_HeapFileGetRoot(file.m_Header);
+	if((value == ACR_NULL) ||
+	   ((*value) != 42))
+	{
+		ACR_DEBUG_PRINT(14, "FAIL root was not kept in the file");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(14, "PASS");
+	}
+	ACR_HeapFileClose(&file);
+	remove(path);
+#else
+	ACR_UNUSED(value);
+	if(ACR_HeapFileOpen(&file, path, 64 * 1024) != ACR_INFO_ERROR)
+	{
+		ACR_DEBUG_PRINT(11, "FAIL ACR_HeapFileOpen() without libc");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(11, "PASS");
+	}
+#endif
+
+	return result;
+}
@@ -0,0 +1,225 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_heaptrace.c
+
+    application to test the allocation trace recorder
+
+    Note: define ACR_CONFIG_HEAP_TRACE to test recording
+
+*/
+#include "ACR/heaptrace.h"
+
+// included for ACR_MALLOC, ACR_FREE, and ACR_REALLOC
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** every allocation call is recorded and can be read back
+*/
+int RecordTest(void);
+
+/** incomplete traces are not read
+*/
+int ReadTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= RecordTest();
+	result |= ReadTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** trace written by TestWriteTrace()
+*/
+ACR_Byte_t g_TestTrace[1024];
+
+/** number of bytes in g_TestTrace
+*/
+ACR_Length_t g_TestTraceLength;
+
+/** \see ACR_FileCallbackWrite_t
+*/
+ACR_Info_t TestWriteTrace(
+	ACR_VarBuffer_t* src,
+	void* userPtr)
+{
+	ACR_UNUSED(userPtr);
+	if(src->m_MaxLength > (sizeof(g_TestTrace) - g_TestTraceLength))
+	{
+		return ACR_INFO_ERROR;
+	}
+	ACR_MEMCPY(&g_TestTrace[g_TestTraceLength], src->m_Buffer.m_Pointer, src->m_MaxLength);
+	g_TestTraceLength += src->m_MaxLength;
+	src->m_Buffer.m_Length = src->m_MaxLength;
+	return ACR_INFO_OK;
+}
+
+/**********************************************************/
+int RecordTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_FILE_INTERFACE(file);
+	file.m_Write = TestWriteTrace;
+#ifdef ACR_CONFIG_HEAP_TRACE
+	ACR_HeapTraceRecord_t record = {0, 0, 0, 0};
+	ACR_Length_t pos;
+	ACR_Length_t firstId;
+	char* first;
+	char* second;
+
+	// allocations made before recording can
+	// still be freed while recording
+	second = (char*)ACR_MALLOC(10);
+
+	g_TestTraceLength = 0;
+	if(ACR_HeapTraceStart(&file) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL trace did not start");
+		return ACR_FAILURE;
+	}
+	first = (char*)ACR_MALLOC(100);
+	first[0] = 'a';
+	first[99] = 'z';
+	first = (char*)ACR_REALLOC(first, 300);
+	ACR_FREE(second);
+	if((first == ACR_NULL) ||
+	   (first[0] != 'a') ||
+	   (first[99] != 'z'))
+	{
+		ACR_DEBUG_PRINT(2, "FAIL reallocation lost the data");
+		result = ACR_FAILURE;
+	}
+	ACR_FREE(first);
+	if(ACR_HeapTraceStop() != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(3, "FAIL trace did not stop");
+		result = ACR_FAILURE;
+	}
+
+	// the free of second is recorded with an
+	// id that was never allocated in the trace
+	if((ACR_HeapTraceReadStart(g_TestTrace, g_TestTraceLength, &pos) == ACR_BOOL_FALSE) ||
+	   (ACR_HeapTraceRead(g_TestTrace, g_TestTraceLength, &pos, &record) == ACR_BOOL_FALSE) ||
+	   (record.m_Op != ACR_HEAP_TRACE_ALLOC) ||
+	   (record.m_Size != 100))
+	{
+		ACR_DEBUG_PRINT(4, "FAIL allocation was not recorded");
+		return ACR_FAILURE;
+	}
+	firstId = record.m_Id;
+	if((ACR_HeapTraceRead(g_TestTrace, g_TestTraceLength, &pos, &record) == ACR_BOOL_FALSE) ||
+	   (record.m_Op != ACR_HEAP_TRACE_REALLOC) ||
+	   (record.m_Size != 300) ||
+	   (record.m_Id != firstId) ||
+	   (ACR_HeapTraceRead(g_TestTrace, g_TestTraceLength, &pos, &record) == ACR_BOOL_FALSE) ||
+	   (record.m_Op != ACR_HEAP_TRACE_FREE) ||
+	   (record.m_Id != (firstId - 1)) ||
+	   (ACR_HeapTraceRead(g_TestTrace, g_TestTraceLength, &pos, &record) == ACR_BOOL_FALSE) ||
+	   (record.m_Op != ACR_HEAP_TRACE_FREE) ||
+	   (record.m_Id != firstId) ||
+	   (ACR_HeapTraceRead(g_TestTrace, g_TestTraceLength, &pos, &record) == ACR_BOOL_TRUE))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL records do not match the calls");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS calls were recorded");
+	}
+#else
+	if(ACR_HeapTraceStart(&file) != ACR_INFO_ERROR)
+	{
+		ACR_DEBUG_PRINT(7, "FAIL trace started without ACR_CONFIG_HEAP_TRACE");
+		result = ACR_FAILURE;
+	}
+#endif
+	return result;
+}
+
+/**********************************************************/
+int ReadTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_HeapTraceRecord_t record = {0, 0, 0, 0};
+	ACR_Length_t pos;
+	const ACR_Byte_t trace[] = {'A', 'C', 'R', 'H', 'T', '1', ACR_HEAP_TRACE_ALLOC, 0x80, 0x01, 0x05, 0x02, ACR_HEAP_TRACE_FREE, 0x00, 0x05};
+	if((ACR_HeapTraceReadStart(trace, 5, &pos) == ACR_BOOL_TRUE) ||
+	   (ACR_HeapTraceReadStart(trace, sizeof(trace), &pos) == ACR_BOOL_FALSE) ||
+	   (ACR_HeapTraceRead(trace, sizeof(trace), &pos, &record) == ACR_BOOL_FALSE) ||
+	   (record.m_Size != 128) ||
+	   (record.m_Id != 5) ||
+	   (record.m_Micro != 2))
+	{
+		ACR_DEBUG_PRINT(8, "FAIL complete record was not read");
+		result = ACR_FAILURE;
+	}
+	else if(ACR_HeapTraceRead(trace, sizeof(trace), &pos, &record) == ACR_BOOL_TRUE)
+	{
+		ACR_DEBUG_PRINT(9, "FAIL incomplete record was read");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(10, "PASS records were read");
+	}
+	return result;
+}
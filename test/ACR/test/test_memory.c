@@ -0,0 +1,430 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_memory.c
+
+    application to test the memory functions used
+    when ACR_CONFIG_NO_LIBC is defined
+
+*/
+#include "ACR/memory.h"
+
+// included for ACR_Byte_t
+#include "ACR/public/public_bytes_and_flags.h"
+
+// included for ACR_BYTES_PER_BLOCK
+#include "ACR/public/public_blocks.h"
+
+// included for ACR_MALLOC and ACR_FREE
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** copy and move memory at every alignment
+*/
+int CopyTest(void);
+
+/** set and compare memory at every alignment
+*/
+int SetCompareTest(void);
+
+/** copy every short length from every misaligned source into
+    memory of exact size so that reading past the source is caught
+*/
+int ShortCopyTest(void);
+
+/** move memory forward by every misaligned amount within
+    memory of exact size so that reading before the source is caught
+*/
+int ShiftedMoveTest(void);
+
+/** compare memory at every pair of alignments within memory of
+    exact size with a different byte at every position
+*/
+int ShiftedCompareTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	ACR_DEBUG_PRINT(1, "TEST %s kernel", ACR_MemoryKernelName());
+
+	result |= CopyTest();
+	result |= SetCompareTest();
+	result |= ShortCopyTest();
+	result |= ShiftedMoveTest();
+	result |= ShiftedCompareTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of bytes of memory used by the tests
+*/
+#define TEST_MEMORY_LENGTH 200
+
+/** offsets and lengths cover the head, chunks, and tail of every kernel
+*/
+#define TEST_MEMORY_MAX_OFFSET 33
+
+/** memory used by the tests
+*/
+ACR_Byte_t g_TestMemory[TEST_MEMORY_LENGTH];
+
+/** expected memory
+*/
+ACR_Byte_t g_TestExpected[TEST_MEMORY_LENGTH];
+
+/**********************************************************/
+void TestMemoryFill(void)
+{
+	int i;
+	for(i = 0; i < TEST_MEMORY_LENGTH; i++)
+	{
+		g_TestMemory[i] = (ACR_Byte_t)(i + 1);
+		g_TestExpected[i] = (ACR_Byte_t)(i + 1);
+	}
+}
+
+/**********************************************************/
+int TestMemoryIsExpected(void)
+{
+	int i;
+	for(i = 0; i < TEST_MEMORY_LENGTH; i++)
+	{
+		if(g_TestMemory[i] != g_TestExpected[i])
+		{
+			return ACR_FAILURE;
+		}
+	}
+	return ACR_SUCCESS;
+}
+
+/**********************************************************/
+int CopyTest(void)
+{
+	int result = ACR_SUCCESS;
+	int dest;
+	int src;
+	int length;
+	int i;
+
+	for(dest = 0; (dest < TEST_MEMORY_MAX_OFFSET) && (result == ACR_SUCCESS); dest++)
+	{
+		for(src = 0; (src < TEST_MEMORY_MAX_OFFSET) && (result == ACR_SUCCESS); src++)
+		{
+			for(length = 0; (length < ((TEST_MEMORY_LENGTH / 2) - TEST_MEMORY_MAX_OFFSET)) && (result == ACR_SUCCESS); length += 7)
+			{
+				// overlapping in both directions
+				TestMemoryFill();
+				ACR_MemoryMove(&g_TestMemory[dest], &g_TestMemory[src], (ACR_Length_t)length);
+				if(dest <= src)
+				{
+					for(i = 0; i < length; i++)
+					{
+						g_TestExpected[dest + i] = g_TestExpected[src + i];
+					}
+				}
+				else
+				{
+					for(i = length; i > 0; i--)
+					{
+						g_TestExpected[dest + i - 1] = g_TestExpected[src + i - 1];
+					}
+				}
+				if(TestMemoryIsExpected() != ACR_SUCCESS)
+				{
+					ACR_DEBUG_PRINT(2, "FAIL move %d bytes from %d to %d", length, src, dest);
+					result = ACR_FAILURE;
+				}
+
+				// not overlapping
+				TestMemoryFill();
+				ACR_MemoryCopy(&g_TestMemory[dest + TEST_MEMORY_MAX_OFFSET + length], &g_TestMemory[src], (ACR_Length_t)length);
+				for(i = 0; i < length; i++)
+				{
+					g_TestExpected[dest + TEST_MEMORY_MAX_OFFSET + length + i] = g_TestExpected[src + i];
+				}
+				if(TestMemoryIsExpected() != ACR_SUCCESS)
+				{
+					ACR_DEBUG_PRINT(3, "FAIL copy %d bytes from %d to %d", length, src, dest);
+					result = ACR_FAILURE;
+				}
+			}
+		}
+	}
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(4, "PASS copied and moved memory");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int SetCompareTest(void)
+{
+	int result = ACR_SUCCESS;
+	int offset;
+	int length;
+	int i;
+
+	for(offset = 0; (offset < TEST_MEMORY_MAX_OFFSET) && (result == ACR_SUCCESS); offset++)
+	{
+		for(length = 0; (length < (TEST_MEMORY_LENGTH - TEST_MEMORY_MAX_OFFSET)) && (result == ACR_SUCCESS); length += 5)
+		{
+			TestMemoryFill();
+			ACR_MemorySet(&g_TestMemory[offset], 0xA5, (ACR_Length_t)length);
+			for(i = 0; i < length; i++)
+			{
+				g_TestExpected[offset + i] = 0xA5;
+			}
+			if(TestMemoryIsExpected() != ACR_SUCCESS)
+			{
+				ACR_DEBUG_PRINT(5, "FAIL set %d bytes at %d", length, offset);
+				result = ACR_FAILURE;
+			}
+
+			// the same memory at different alignments
+			// and then one byte different at the end
+			if(ACR_MemoryCompare(&g_TestMemory[offset], &g_TestExpected[offset], (ACR_Length_t)length) != 0)
+			{
+				ACR_DEBUG_PRINT(6, "FAIL %d bytes at %d are not the same", length, offset);
+				result = ACR_FAILURE;
+			}
+			if(length > 0)
+			{
+				g_TestExpected[offset + length - 1] = 0xA6;
+				if((ACR_MemoryCompare(&g_TestMemory[offset], &g_TestExpected[offset], (ACR_Length_t)length) >= 0) ||
+				   (ACR_MemoryCompare(&g_TestExpected[offset], &g_TestMemory[offset], (ACR_Length_t)length) <= 0) ||
+				   (ACR_MemoryCompare(&g_TestMemory[offset], &g_TestExpected[offset], (ACR_Length_t)(length - 1)) != 0))
+				{
+					ACR_DEBUG_PRINT(7, "FAIL last of %d bytes at %d is not different", length, offset);
+					result = ACR_FAILURE;
+				}
+			}
+		}
+	}
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(8, "PASS set and compared memory");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int ShortCopyTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Length_t offset;
+	ACR_Length_t length;
+	ACR_Length_t i;
+
+	for(offset = 1; offset < ACR_BYTES_PER_BLOCK; offset++)
+	{
+		for(length = 1; length <= (2 * ACR_BYTES_PER_BLOCK); length++)
+		{
+			ACR_Byte_t* src = (ACR_Byte_t*)ACR_MALLOC(offset + length);
+			ACR_Byte_t* dest = (ACR_Byte_t*)ACR_MALLOC(length);
+			if((src == ACR_NULL) ||
+			   (dest == ACR_NULL))
+			{
+				ACR_DEBUG_PRINT(9, "FAIL could not allocate %d bytes", (int)(offset + length));
+				result = ACR_FAILURE;
+			}
+			else
+			{
+				for(i = 0; i < (offset + length); i++)
+				{
+					src[i] = (ACR_Byte_t)(i + 1);
+				}
+				ACR_MemoryCopy(dest, &src[offset], length);
+				for(i = 0; i < length; i++)
+				{
+					if(dest[i] != src[offset + i])
+					{
+						ACR_DEBUG_PRINT(10, "FAIL copy %d bytes from offset %d", (int)length, (int)offset);
+						result = ACR_FAILURE;
+						break;
+					}
+				}
+			}
+			ACR_FREE(src);
+			ACR_FREE(dest);
+		}
+	}
+
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(11, "PASS copied short memory from every offset");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int ShiftedMoveTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Length_t shift;
+	ACR_Length_t length;
+	ACR_Length_t i;
+
+	for(shift = 1; shift < ACR_BYTES_PER_BLOCK; shift++)
+	{
+		for(length = 1; length <= (4 * ACR_BYTES_PER_BLOCK); length++)
+		{
+			ACR_Byte_t* memory = (ACR_Byte_t*)ACR_MALLOC(shift + length);
+			if(memory == ACR_NULL)
+			{
+				ACR_DEBUG_PRINT(12, "FAIL could not allocate %d bytes", (int)(shift + length));
+				result = ACR_FAILURE;
+			}
+			else
+			{
+				for(i = 0; i < (shift + length); i++)
+				{
+					memory[i] = (ACR_Byte_t)(i + 1);
+				}
+				ACR_MemoryMove(&memory[shift], memory, length);
+				for(i = 0; i < length; i++)
+				{
+					if(memory[shift + i] != (ACR_Byte_t)(i + 1))
+					{
+						ACR_DEBUG_PRINT(13, "FAIL move %d bytes forward by %d", (int)length, (int)shift);
+						result = ACR_FAILURE;
+						break;
+					}
+				}
+			}
+			ACR_FREE(memory);
+		}
+	}
+
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(14, "PASS moved memory forward by every misaligned amount");
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int ShiftedCompareTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Length_t firstOffset;
+	ACR_Length_t secondOffset;
+	ACR_Length_t length;
+	ACR_Length_t i;
+
+	for(firstOffset = 0; firstOffset < ACR_BYTES_PER_BLOCK; firstOffset++)
+	{
+		for(secondOffset = 0; secondOffset < ACR_BYTES_PER_BLOCK; secondOffset++)
+		{
+			for(length = 0; length <= (4 * ACR_BYTES_PER_BLOCK); length++)
+			{
+				ACR_Byte_t* firstMemory = (ACR_Byte_t*)ACR_MALLOC(firstOffset + length + 1);
+				ACR_Byte_t* secondMemory = (ACR_Byte_t*)ACR_MALLOC(secondOffset + length + 1);
+				if((firstMemory == ACR_NULL) ||
+				   (secondMemory == ACR_NULL))
+				{
+					ACR_DEBUG_PRINT(15, "FAIL could not allocate %d bytes", (int)(firstOffset + length + 1));
+					result = ACR_FAILURE;
+				}
+				else
+				{
+					// the memory ends where the allocation ends
+					ACR_Byte_t* first = &firstMemory[firstOffset + 1];
+					ACR_Byte_t* second = &secondMemory[secondOffset + 1];
+					for(i = 0; i < length; i++)
+					{
+						first[i] = (ACR_Byte_t)(i + 1);
+						second[i] = (ACR_Byte_t)(i + 1);
+					}
+					if(ACR_MemoryCompare(first, second, length) != 0)
+					{
+						ACR_DEBUG_PRINT(16, "FAIL %d bytes at %d and %d are not the same", (int)length, (int)firstOffset, (int)secondOffset);
+						result = ACR_FAILURE;
+					}
+					for(i = 0; i < length; i++)
+					{
+						second[i]++;
+						if((ACR_MemoryCompare(first, second, length) >= 0) ||
+						   (ACR_MemoryCompare(second, first, length) <= 0) ||
+						   (ACR_MemoryCompare(first, second, i) != 0))
+						{
+							ACR_DEBUG_PRINT(16, "FAIL byte %d of %d bytes at %d and %d is not different", (int)i, (int)length, (int)firstOffset, (int)secondOffset);
+							result = ACR_FAILURE;
+						}
+						second[i]--;
+					}
+				}
+				ACR_FREE(firstMemory);
+				ACR_FREE(secondMemory);
+			}
+		}
+	}
+
+	if(result == ACR_SUCCESS)
+	{
+		ACR_DEBUG_PRINT(17, "PASS compared memory at every alignment");
+	}
+
+	return result;
+}
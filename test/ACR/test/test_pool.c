@@ -0,0 +1,162 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_pool.c
+
+    application to test the pool allocator
+
+*/
+#include "ACR/pool.h"
+
+// included for ACR_PoolObj_t
+#include "ACR/private/private_pool.h"
+
+// included for ACR_NEW_BY_TYPE_FROM
+#include "ACR/public/public_heap.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** freed objects are reused and new slabs are added when needed
+*/
+int ReuseTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= ReuseTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** object type used by the test
+*/
+typedef struct TestObject_s
+{
+	ACR_Length_t m_Length;
+	ACR_Byte_t m_Value;
+} TestObject_t;
+
+/** number of objects in each slab
+*/
+#define TEST_POOL_OBJECTS_PER_SLAB 4
+
+/**********************************************************/
+int ReuseTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_PoolObj_t* pool;
+	TestObject_t* objects[TEST_POOL_OBJECTS_PER_SLAB + 1];
+	int i;
+
+	if(ACR_PoolNew(&pool, sizeof(TestObject_t), TEST_POOL_OBJECTS_PER_SLAB) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL pool not allocated");
+		return ACR_FAILURE;
+	}
+
+	// one more object than fits in a slab
+	for(i = 0; i <= TEST_POOL_OBJECTS_PER_SLAB; i++)
+	{
+		objects[i] = (TestObject_t*)ACR_PoolAlloc(pool, sizeof(TestObject_t));
+		if(objects[i] == ACR_NULL)
+		{
+			ACR_DEBUG_PRINT(2, "FAIL object %d not allocated", i);
+			ACR_PoolDelete(&pool);
+			return ACR_FAILURE;
+		}
+		objects[i]->m_Value = (ACR_Byte_t)i;
+	}
+	if((ACR_PoolCount(pool) != (TEST_POOL_OBJECTS_PER_SLAB + 1)) ||
+	   (objects[1] != &objects[0][1]))
+	{
+		ACR_DEBUG_PRINT(3, "FAIL objects are not next to each other");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(4, "PASS objects allocated from slabs");
+	}
+
+	// the last freed object is the next one allocated
+	ACR_PoolFree(pool, objects[2]);
+	{
+		ACR_NEW_BY_TYPE_FROM(reused, TestObject_t, ACR_Pool, pool);
+		if((reused != objects[2]) ||
+		   (reused->m_Value != 0))
+		{
+			ACR_DEBUG_PRINT(5, "FAIL freed object was not reused");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(6, "PASS freed object was reused");
+		}
+		ACR_DELETE_FROM(reused, ACR_Pool, pool);
+	}
+
+	if(ACR_PoolAlloc(pool, sizeof(TestObject_t) + ACR_HEAP_ALIGNMENT) != ACR_NULL)
+	{
+		ACR_DEBUG_PRINT(7, "FAIL allocated an object larger than the pool object size");
+		result = ACR_FAILURE;
+	}
+
+	ACR_PoolDelete(&pool);
+
+	return result;
+}
@@ -0,0 +1,290 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_ring.c
+
+    application to test the ring buffer
+
+*/
+#include "ACR/ring.h"
+
+// included for ACR_RingObj_t
+#include "ACR/private/private_ring.h"
+
+// included for ACR_VarBuffer_t
+#include "ACR/public/public_varbuffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+//
+// PROTOTYPES
+//
+
+/** bytes wrap around the end of the ring and are read in order
+*/
+int WrapTest(void);
+
+/** read and write the ring through a file interface
+*/
+int FileInterfaceTest(void);
+
+/** readable bytes of a mirrored ring are a single segment
+*/
+int MirrorTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+	result |= WrapTest();
+	result |= FileInterfaceTest();
+	result |= MirrorTest();
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of bytes in the rings used by the tests
+*/
+#define TEST_RING_LENGTH 8
+
+/**********************************************************/
+int WrapTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_RingObj_t* ring;
+	ACR_Byte_t data[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+	ACR_Byte_t out[TEST_RING_LENGTH];
+	ACR_BUFFER(first);
+	ACR_BUFFER(second);
+	void* headPtr;
+	int i;
+
+	if(ACR_RingNew(&ring, TEST_RING_LENGTH) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL ring not allocated");
+		return ACR_FAILURE;
+	}
+
+	// consuming only moves the head
+	ACR_RingWrite(ring, data, 6);
+	ACR_RingPeek(ring, &first, &second);
+	headPtr = first.m_Pointer;
+	ACR_RingConsume(ring, 4);
+	ACR_RingPeek(ring, &first, &second);
+	if((first.m_Pointer != &((ACR_Byte_t*)headPtr)[4]) ||
+	   (((ACR_Byte_t*)first.m_Pointer)[0] != 5) ||
+	   (ACR_RingUsed(ring) != 2))
+	{
+		ACR_DEBUG_PRINT(2, "FAIL consumed bytes were moved");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(3, "PASS consumed bytes without moving the rest");
+	}
+
+	// 6 more bytes wrap to the start of the memory and
+	// the 7th does not fit
+	if((ACR_RingWrite(ring, &data[6], 6) != 6) ||
+	   (ACR_RingAvailable(ring) != 0) ||
+	   (ACR_RingWrite(ring, data, 1) != 0))
+	{
+		ACR_DEBUG_PRINT(4, "FAIL ring did not fill up");
+		result = ACR_FAILURE;
+	}
+	if((ACR_RingPeek(ring, &first, &second) != TEST_RING_LENGTH) ||
+	   (first.m_Length != 4) ||
+	   (second.m_Length != 4) ||
+	   (second.m_Pointer != headPtr))
+	{
+		ACR_DEBUG_PRINT(5, "FAIL bytes are not in two segments");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(6, "PASS bytes wrapped into a second segment");
+	}
+
+	if(ACR_RingRead(ring, out, sizeof(out)) != TEST_RING_LENGTH)
+	{
+		ACR_DEBUG_PRINT(7, "FAIL bytes not read");
+		result = ACR_FAILURE;
+	}
+	for(i = 0; i < TEST_RING_LENGTH; i++)
+	{
+		if(out[i] != data[i + 4])
+		{
+			ACR_DEBUG_PRINT(8, "FAIL byte %d is %d", i, (int)out[i]);
+			result = ACR_FAILURE;
+			break;
+		}
+	}
+
+	// an empty ring starts over at the beginning of the memory
+	if((ACR_RingReserve(ring, &first, &second) != TEST_RING_LENGTH) ||
+	   (first.m_Pointer != headPtr) ||
+	   (second.m_Length != 0))
+	{
+		ACR_DEBUG_PRINT(9, "FAIL empty ring was not reset");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_MEMCPY(first.m_Pointer, data, 3);
+		ACR_RingProduce(ring, 3);
+		if((ACR_RingRead(ring, out, sizeof(out)) != 3) ||
+		   (out[2] != 3))
+		{
+			ACR_DEBUG_PRINT(10, "FAIL reserved bytes not produced");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(11, "PASS wrote bytes directly into the ring");
+		}
+	}
+
+	ACR_RingDelete(&ring);
+
+	return result;
+}
+
+/**********************************************************/
+int FileInterfaceTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_RingObj_t* ring;
+	ACR_FILE_INTERFACE(ringAsFile);
+	ACR_STRING(path);
+	ACR_Byte_t data[4] = {1, 2, 3, 4};
+	ACR_Byte_t out[4] = {0, 0, 0, 0};
+	ACR_VAR_BUFFER(src);
+	ACR_VAR_BUFFER(dest);
+
+	if(ACR_RingNew(&ring, TEST_RING_LENGTH) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(12, "FAIL ring not allocated");
+		return ACR_FAILURE;
+	}
+	ACR_RingInitFileInterface(ring, &ringAsFile);
+
+	src.m_Buffer.m_Pointer = data;
+	src.m_MaxLength = sizeof(data);
+	dest.m_Buffer.m_Pointer = out;
+	dest.m_MaxLength = sizeof(out);
+	if((ringAsFile.m_Open(path, ACR_INFO_READ_WRITE, ringAsFile.m_User) != ACR_INFO_OK) ||
+	   (ringAsFile.m_Write(&src, ringAsFile.m_User) != ACR_INFO_OK) ||
+	   (src.m_Buffer.m_Length != sizeof(data)) ||
+	   (ringAsFile.m_Position(ringAsFile.m_User) != sizeof(data)) ||
+	   (ringAsFile.m_Seek(1, ACR_INFO_CURRENT, ringAsFile.m_User) != ACR_INFO_OK) ||
+	   (ringAsFile.m_Read(&dest, ringAsFile.m_User) != ACR_INFO_OK) ||
+	   (dest.m_Buffer.m_Length != 3) ||
+	   (out[0] != 2) ||
+	   (ringAsFile.m_Seek(0, ACR_INFO_FIRST, ringAsFile.m_User) != ACR_INFO_ERROR) ||
+	   (ringAsFile.m_Close(ringAsFile.m_User) != ACR_INFO_OK))
+	{
+		ACR_DEBUG_PRINT(13, "FAIL file interface did not use the ring");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(14, "PASS file interface used the ring");
+	}
+
+	ACR_RingDelete(&ring);
+
+	return result;
+}
+
+/**********************************************************/
+int MirrorTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_RingObj_t* ring;
+	ACR_BUFFER(first);
+	ACR_BUFFER(second);
+	ACR_Byte_t data[TEST_RING_LENGTH] = {1, 2, 3, 4, 5, 6, 7, 8};
+	ACR_Length_t capacity;
+
+	if(ACR_RingNewMirrored(&ring, TEST_RING_LENGTH) != ACR_INFO_OK)
+	{
+		// OK - the platform cannot map memory twice
+		ACR_DEBUG_PRINT(15, "TEST skipped mirrored ring");
+		return ACR_SUCCESS;
+	}
+
+	// move the head close to the end of the memory
+	capacity = ACR_RingCapacity(ring);
+	ring->m_Head = (capacity - 4);
+	ACR_RingWrite(ring, data, TEST_RING_LENGTH);
+
+	ACR_RingPeek(ring, &first, &second);
+	if((ACR_RingIsMirrored(ring) == ACR_BOOL_FALSE) ||
+	   (first.m_Length != TEST_RING_LENGTH) ||
+	   (second.m_Length != 0) ||
+	   (((ACR_Byte_t*)first.m_Pointer)[7] != 8) ||
+	   (((ACR_Byte_t*)ring->m_Buffer.m_Pointer)[3] != 8))
+	{
+		ACR_DEBUG_PRINT(16, "FAIL mirrored bytes are not contiguous");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(17, "PASS mirrored bytes are contiguous");
+	}
+
+	ACR_RingDelete(&ring);
+
+	return result;
+}
@@ -0,0 +1,258 @@
+/*
+
+    ********** DO NOT REMOVE THIS INFORMATION ************
+
+    ACR - A set of C functions in a git Repository
+    Copyright (C) 2018 - 2022 Adam C. Rosenberg
+
+    Please read LICENSE before using this code
+
+    Please read README.md for instructions on including
+    this code in your project and where to find examples
+
+    If you contribute to this code, Please add your name
+    and email address to the AUTHORS list below so that
+    we know who to thank!
+
+    AUTHORS
+
+    Adam Rosenberg <adam@sirspot.com>
+
+    LICENSE
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+    ******************************************************
+
+*/
+/** \file test_sharedbuffer.c
+
+    application to test sharing, slicing, and copy-on-write of shared buffers
+
+*/
+#include "ACR/sharedbuffer.h"
+
+// included for ACR_UNUSED
+#include "ACR/public/public_functions.h"
+
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
+// included for ACR_HAS_MALLOC
+#include "ACR/public/public_heap.h"
+
+//
+// PROTOTYPES
+//
+
+/** hand the same payload to several consumers without a copy
+*/
+int FanOutTest(void);
+
+/** a slice keeps the memory alive after the original is released
+*/
+int SliceTest(void);
+
+/** changing shared memory copies it first and only then
+*/
+int CopyOnWriteTest(void);
+
+//
+// MAIN
+//
+
+int main(int argc, char** argv)
+{
+	int result = ACR_SUCCESS;
+
+	ACR_UNUSED(argc);
+	ACR_UNUSED(argv);
+
+#if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+	result |= FanOutTest();
+	result |= SliceTest();
+	result |= CopyOnWriteTest();
+#else
+	ACR_DEBUG_PRINT(13, "TEST skipped shared buffers without malloc");
+#endif
+
+	return result;
+}
+
+//
+// IMPLEMENTATION
+//
+
+/** number of consumers in the fan out test
+*/
+#define TEST_SHARED_CONSUMERS 3
+
+/**********************************************************/
+int FanOutTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_SHARED_BUFFER(payload);
+	ACR_SharedBuffer_t consumers[TEST_SHARED_CONSUMERS];
+	ACR_Bool_t allShared = ACR_BOOL_TRUE;
+	int index;
+
+	if(ACR_SharedBufferCopyFrom(&payload, "payload", 7) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(1, "FAIL could not allocate a shared buffer");
+		return ACR_FAILURE;
+	}
+
+	for(index = 0; index < TEST_SHARED_CONSUMERS; index++)
+	{
+		ACR_SHARED_BUFFER(consumer);
+		consumers[index] = consumer;
+		if((ACR_SharedBufferShare(&payload, &consumers[index]) != ACR_INFO_OK) ||
+		   (ACR_SHARED_BUFFER_GET_MEMORY(consumers[index]) != ACR_SHARED_BUFFER_GET_MEMORY(payload)) ||
+		   (ACR_SHARED_BUFFER_GET_LENGTH(consumers[index]) != 7))
+		{
+			allShared = ACR_BOOL_FALSE;
+		}
+	}
+	if((allShared == ACR_BOOL_FALSE) ||
+	   (ACR_SharedBufferGetShareCount(&payload) != (TEST_SHARED_CONSUMERS + 1)) ||
+	   (ACR_SharedBufferIsUnique(&payload) != ACR_BOOL_FALSE))
+	{
+		ACR_DEBUG_PRINT(2, "FAIL consumers did not share the payload");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(3, "PASS consumers shared the payload");
+	}
+
+	// the consumers outlive the original
+	ACR_SharedBufferRelease(&payload);
+	if((ACR_SHARED_BUFFER_GET_MEMORY(payload) != ACR_NULL) ||
+	   (ACR_SharedBufferGetShareCount(&payload) != 0) ||
+	   (ACR_SharedBufferGetShareCount(&consumers[0]) != TEST_SHARED_CONSUMERS) ||
+	   (ACR_MEMCMP(ACR_SHARED_BUFFER_GET_MEMORY(consumers[TEST_SHARED_CONSUMERS - 1]), "payload", 7) != 0))
+	{
+		ACR_DEBUG_PRINT(4, "FAIL consumers did not keep the payload");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(5, "PASS consumers kept the payload");
+	}
+
+	for(index = 0; index < TEST_SHARED_CONSUMERS; index++)
+	{
+		ACR_SharedBufferRelease(&consumers[index]);
+	}
+
+	return result;
+}
+
+/**********************************************************/
+int SliceTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_SHARED_BUFFER(message);
+	ACR_SHARED_BUFFER(body);
+	ACR_SHARED_BUFFER(bad);
+	void* memory;
+
+	if(ACR_SharedBufferCopyFrom(&message, "headbodyend", 11) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(6, "FAIL could not allocate a shared buffer");
+		return ACR_FAILURE;
+	}
+	if((ACR_SharedBufferSlice(&message, 4, 4, &body) != ACR_INFO_OK) ||
+	   (ACR_SHARED_BUFFER_GET_MEMORY(body) != (void*)(((ACR_Byte_t*)ACR_SHARED_BUFFER_GET_MEMORY(message)) + 4)) ||
+	   (ACR_SHARED_BUFFER_GET_LENGTH(body) != 4) ||
+	   (ACR_SharedBufferSlice(&message, 8, 4, &bad) != ACR_INFO_ERROR) ||
+	   (ACR_SharedBufferSlice(&message, 12, 0, &bad) != ACR_INFO_ERROR))
+	{
+		ACR_DEBUG_PRINT(6, "FAIL slice did not refer to the range");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(7, "PASS slice referred to the range");
+	}
+	if(ACR_SHARED_BUFFER_GET_MEMORY(body) == ACR_NULL)
+	{
+		// nothing to check without the slice
+		ACR_SharedBufferRelease(&message);
+		return result;
+	}
+
+	// once the slice is the only owner it can
+	// be changed without a copy
+	ACR_SharedBufferRelease(&message);
+	memory = ACR_SHARED_BUFFER_GET_MEMORY(body);
+	if((ACR_SharedBufferIsUnique(&body) != ACR_BOOL_TRUE) ||
+	   (ACR_SharedBufferMakeWritable(&body) != ACR_INFO_OK) ||
+	   (ACR_SHARED_BUFFER_GET_MEMORY(body) != memory) ||
+	   (ACR_MEMCMP(memory, "body", 4) != 0))
+	{
+		ACR_DEBUG_PRINT(8, "FAIL slice did not keep the memory alive");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(9, "PASS slice kept the memory alive");
+	}
+	ACR_SharedBufferRelease(&body);
+
+	return result;
+}
+
+/**********************************************************/
+int CopyOnWriteTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_SHARED_BUFFER(original);
+	ACR_SHARED_BUFFER(shared);
+
+	if(ACR_SharedBufferCopyFrom(&original, "data", 4) != ACR_INFO_OK)
+	{
+		ACR_DEBUG_PRINT(10, "FAIL could not allocate a shared buffer");
+		return ACR_FAILURE;
+	}
+	if((ACR_SharedBufferShare(&original, &shared) != ACR_INFO_OK) ||
+	   (ACR_SharedBufferMakeWritable(&shared) != ACR_INFO_OK) ||
+	   (ACR_SHARED_BUFFER_GET_MEMORY(shared) == ACR_SHARED_BUFFER_GET_MEMORY(original)) ||
+	   (ACR_SharedBufferGetShareCount(&original) != 1) ||
+	   (ACR_SharedBufferGetShareCount(&shared) != 1))
+	{
+		ACR_DEBUG_PRINT(10, "FAIL shared memory was not copied before a change");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		((ACR_Byte_t*)ACR_SHARED_BUFFER_GET_MEMORY(shared))[0] = 'D';
+		if((ACR_MEMCMP(ACR_SHARED_BUFFER_GET_MEMORY(original), "data", 4) != 0) ||
+		   (ACR_MEMCMP(ACR_SHARED_BUFFER_GET_MEMORY(shared), "Data", 4) != 0))
+		{
+			ACR_DEBUG_PRINT(11, "FAIL a change to the copy was seen by the original");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(12, "PASS shared memory was copied before a change");
+		}
+	}
+
+	ACR_SharedBufferRelease(&original);
+	ACR_SharedBufferRelease(&shared);
+
+	return result;
+}
@@ -45,6 +45,9 @@
 // included for ACR_UNUSED
 #include "ACR/public/public_functions.h"
 
+// included for ACR_DEBUG_PRINT
+#include "ACR/public/public_debug.h"
+
 //
 // PROTOTYPES
 //
@@ -53,6 +56,10 @@
 */
 int StackTest(void);
 
+/** short strings stay inline and long strings use the heap
+*/
+int SmallTest(void);
+
 //
 // MAIN
 //
@@ -65,6 +72,7 @@ int main(int argc, char** argv)
 	ACR_UNUSED(argv);
 
 	result |= StackTest();
+	result |= SmallTest();
 
 	return result;
 }
@@ -85,3 +93,48 @@ int StackTest(void)
 	return result;
 }
 
+/**********************************************************/
+int SmallTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_SMALL_STRING(str);
+	const char* longText = "this text is longer than the inline memory of a small string";
+	ACR_Length_t longLength = 0;
+
+	while(longText[longLength] != 0)
+	{
+		longLength++;
+	}
+
+	// "h\xC3\xA9" is 3 bytes and 2 characters
+	if((ACR_SmallStringSet(&str, "h\xC3\xA9", 3) != ACR_INFO_OK) ||
+	   (str.m_String.m_Buffer.m_Pointer != (void*)str.m_Inline) ||
+	   (str.m_String.m_Buffer.m_Length != 3) ||
+	   (str.m_String.m_Count != 2) ||
+	   (str.m_Inline[3] != 0))
+	{
+		ACR_DEBUG_PRINT(1, "FAIL short string was not inline");
+		result = ACR_FAILURE;
+	}
+	else if(ACR_SmallStringSet(&str, longText, longLength) != ACR_INFO_OK)
+	{
+		// OK - malloc is not available
+		ACR_DEBUG_PRINT(2, "TEST skipped long small string without malloc");
+	}
+	else if((str.m_String.m_Buffer.m_Pointer == (void*)str.m_Inline) ||
+	   (str.m_String.m_Buffer.m_Length != longLength) ||
+	   (str.m_String.m_Count != longLength) ||
+	   (ACR_SmallStringSet(&str, "ok", 2) != ACR_INFO_OK) ||
+	   (str.m_String.m_Buffer.m_Pointer != (void*)str.m_Inline))
+	{
+		ACR_DEBUG_PRINT(3, "FAIL long string did not use the heap");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(4, "PASS small string used inline memory");
+	}
+	ACR_SmallStringDeInit(&str);
+
+	return result;
+}
@@ -63,6 +63,18 @@ int HeapTest(void);
 */
 int LowLevelTest(void);
 
+/** appends grow the max length by a factor and keep the data
+*/
+int GrowTest(void);
+
+/** prepend headers in front of data without moving the data
+*/
+int PrependTest(void);
+
+/** short data stays inline and long data moves to the heap
+*/
+int SmallTest(void);
+
 /** a more complex test that takes into account malloc
     option and prints debug messages as the test is run
 */
@@ -84,6 +96,9 @@ int main(int argc, char** argv)
 	result |= LowLevelTest();
 
 	result |= VerboseTest();
+	result |= GrowTest();
+	result |= PrependTest();
+	result |= SmallTest();
 
 	return result;
 }
@@ -232,3 +247,220 @@ int VerboseTest(void)
 
 	return ACR_SUCCESS;
 }
+
+/**********************************************************/
+int GrowTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Byte_t memory[4] = {1, 2, 3, 4};
+	ACR_VarBuffer_t varbuffer;
+	void* lastPtr;
+	int moves = 0;
+	int i;
+
+	ACR_VarBufferInit(&varbuffer);
+	ACR_VarBufferSetMemory(&varbuffer, memory, sizeof(memory));
+	ACR_VarBufferAppend(&varbuffer, memory, 2);
+	if(ACR_VarBufferAppend(&varbuffer, memory, 4) != ACR_INFO_ERROR)
+	{
+		ACR_DEBUG_PRINT(9, "FAIL fixed buffer grew");
+		ACR_VarBufferDeInit(&varbuffer);
+		return ACR_FAILURE;
+	}
+
+	ACR_VarBufferSetGrowable(&varbuffer, ACR_BOOL_TRUE);
+	lastPtr = varbuffer.m_Buffer.m_Pointer;
+	for(i = 0; i < 100000; i++)
+	{
+		ACR_Byte_t value = (ACR_Byte_t)i;
+		if(ACR_VarBufferAppend(&varbuffer, &value, 1) != ACR_INFO_OK)
+		{
+			break;
+		}
+		if(varbuffer.m_Buffer.m_Pointer != lastPtr)
+		{
+			lastPtr = varbuffer.m_Buffer.m_Pointer;
+			moves++;
+		}
+	}
+
+	if(ACR_VarBufferReserve(&varbuffer, 200000) != ACR_INFO_OK)
+	{
+		// OK - malloc is not available
+		ACR_DEBUG_PRINT(10, "TEST skipped growable buffer without malloc");
+	}
+	else if((i != 100000) ||
+	   (varbuffer.m_Buffer.m_Length != 100002) ||
+	   (varbuffer.m_MaxLength != 200000) ||
+	   (((ACR_Byte_t*)varbuffer.m_Buffer.m_Pointer)[1] != 2) ||
+	   (((ACR_Byte_t*)varbuffer.m_Buffer.m_Pointer)[100001] != (ACR_Byte_t)99999) ||
+	   (varbuffer.m_Buffer.m_Pointer == (void*)memory) ||
+	   (moves > 40))
+	{
+		ACR_DEBUG_PRINT(11, "FAIL growable buffer has length %d after moving %d times", (int)varbuffer.m_Buffer.m_Length, moves);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(12, "PASS growable buffer moved %d times", moves);
+	}
+	ACR_VarBufferDeInit(&varbuffer);
+
+	return result;
+}
+
+/**********************************************************/
+int PrependTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_Byte_t memory[16];
+	ACR_VarBuffer_t varbuffer;
+	ACR_Byte_t* data;
+	ACR_Byte_t* body;
+	void* lastPtr;
+	int moves = 0;
+	int i;
+
+	// prepend to memory that cannot grow
+	ACR_VarBufferInit(&varbuffer);
+	ACR_VarBufferSetMemory(&varbuffer, memory, sizeof(memory));
+	ACR_VarBufferAppend(&varbuffer, "body", 4);
+	ACR_VarBufferReserveHeadroom(&varbuffer, 4);
+	body = (ACR_Byte_t*)varbuffer.m_Buffer.m_Pointer;
+	ACR_VarBufferPrepend(&varbuffer, "hd", 2);
+	ACR_VarBufferPrepend(&varbuffer, "<", 1);
+	data = (ACR_Byte_t*)varbuffer.m_Buffer.m_Pointer;
+	if((varbuffer.m_Buffer.m_Length != 7) ||
+	   (body != (data + 3)) ||
+	   (data[0] != '<') ||
+	   (data[1] != 'h') ||
+	   (data[3] != 'b') ||
+	   (data[6] != 'y') ||
+	   (ACR_VarBufferPrepend(&varbuffer, memory, 10) != ACR_INFO_ERROR) ||
+	   (ACR_VarBufferAppend(&varbuffer, "!", 1) != ACR_INFO_OK) ||
+	   (data[7] != '!'))
+	{
+		ACR_DEBUG_PRINT(13, "FAIL prepend did not keep the data");
+		ACR_VarBufferDeInit(&varbuffer);
+		return ACR_FAILURE;
+	}
+	ACR_DEBUG_PRINT(14, "PASS prepend kept the data");
+
+	// many prepends only move the data a few times
+	ACR_VarBufferSetGrowable(&varbuffer, ACR_BOOL_TRUE);
+	lastPtr = varbuffer.m_Buffer.m_Pointer;
+	for(i = 0; i < 100000; i++)
+	{
+		ACR_Byte_t value = (ACR_Byte_t)i;
+		if(ACR_VarBufferPrepend(&varbuffer, &value, 1) != ACR_INFO_OK)
+		{
+			break;
+		}
+		if(varbuffer.m_Buffer.m_Pointer != ((ACR_Byte_t*)lastPtr - 1))
+		{
+			moves++;
+		}
+		lastPtr = varbuffer.m_Buffer.m_Pointer;
+	}
+	data = (ACR_Byte_t*)varbuffer.m_Buffer.m_Pointer;
+	if(i != 100000)
+	{
+		// OK - malloc is not available
+		ACR_DEBUG_PRINT(15, "TEST skipped growable prepend without malloc");
+	}
+	else if((varbuffer.m_Buffer.m_Length != 100008) ||
+	   (data[0] != (ACR_Byte_t)99999) ||
+	   (data[99999] != 0) ||
+	   (data[100000] != '<') ||
+	   (data[100007] != '!') ||
+	   (moves > 40))
+	{
+		ACR_DEBUG_PRINT(16, "FAIL growable prepend has length %d after moving %d times", (int)varbuffer.m_Buffer.m_Length, moves);
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(17, "PASS growable prepend moved %d times", moves);
+	}
+	ACR_VarBufferDeInit(&varbuffer);
+
+	return result;
+}
+
+/**********************************************************/
+int SmallTest(void)
+{
+	int result = ACR_SUCCESS;
+	ACR_SMALL_VAR_BUFFER(small);
+	ACR_Byte_t data[ACR_CONFIG_SMALL_BUFFER_LENGTH];
+	ACR_Length_t i;
+
+	for(i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (ACR_Byte_t)i;
+	}
+
+	// the existing macros work on the inline memory
+	ACR_VAR_BUFFER_APPEND(small.m_VarBuffer, data, 4);
+	if((small.m_VarBuffer.m_Buffer.m_Pointer != (void*)small.m_Inline) ||
+	   (ACR_VAR_BUFFER_GET_LENGTH(small.m_VarBuffer) != 4) ||
+	   (small.m_Inline[3] != 3))
+	{
+		ACR_DEBUG_PRINT(18, "FAIL short data was not inline");
+		return ACR_FAILURE;
+	}
+
+	if(ACR_VarBufferAppend(&small.m_VarBuffer, data, sizeof(data)) != ACR_INFO_OK)
+	{
+		// OK - malloc is not available
+		ACR_DEBUG_PRINT(19, "TEST skipped small buffer without malloc");
+	}
+	else if((small.m_VarBuffer.m_Buffer.m_Pointer == (void*)small.m_Inline) ||
+	   (ACR_VAR_BUFFER_GET_LENGTH(small.m_VarBuffer) != (4 + sizeof(data))) ||
+	   (((ACR_Byte_t*)small.m_VarBuffer.m_Buffer.m_Pointer)[3] != 3) ||
+	   (((ACR_Byte_t*)small.m_VarBuffer.m_Buffer.m_Pointer)[4 + sizeof(data) - 1] != (ACR_Byte_t)(sizeof(data) - 1)))
+	{
+		ACR_DEBUG_PRINT(20, "FAIL long data did not move to the heap");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		// use the inline memory again
+		ACR_VarBufferDeInit(&small.m_VarBuffer);
+		ACR_SmallVarBufferInit(&small);
+		if((small.m_VarBuffer.m_Buffer.m_Pointer != (void*)small.m_Inline) ||
+		   (ACR_VarBufferAppend(&small.m_VarBuffer, data, 2) != ACR_INFO_OK) ||
+		   (small.m_VarBuffer.m_Buffer.m_Pointer != (void*)small.m_Inline))
+		{
+			ACR_DEBUG_PRINT(20, "FAIL inline memory was not used again");
+			result = ACR_FAILURE;
+		}
+		else
+		{
+			ACR_DEBUG_PRINT(21, "PASS small buffer used inline memory");
+		}
+	}
+	ACR_VarBufferDeInit(&small.m_VarBuffer);
+
+	// changing the max length copies the inline data
+	ACR_SmallVarBufferInit(&small);
+	ACR_VarBufferAppend(&small.m_VarBuffer, "hello world", 11);
+	ACR_VAR_BUFFER_CHANGE_MAX_LENGTH(small.m_VarBuffer, 100);
+#if ACR_HAS_MALLOC == ACR_BOOL_TRUE
+	if((small.m_VarBuffer.m_Buffer.m_Pointer == (void*)small.m_Inline) ||
+	   (small.m_VarBuffer.m_MaxLength != 100) ||
+	   (ACR_VAR_BUFFER_GET_LENGTH(small.m_VarBuffer) != 11) ||
+	   (ACR_MEMCMP(small.m_VarBuffer.m_Buffer.m_Pointer, "hello world", 11) != 0))
+	{
+		ACR_DEBUG_PRINT(22, "FAIL inline data was not kept when the max length changed");
+		result = ACR_FAILURE;
+	}
+	else
+	{
+		ACR_DEBUG_PRINT(23, "PASS inline data was kept when the max length changed");
+	}
+#endif
+	ACR_VarBufferDeInit(&small.m_VarBuffer);
+
+	return result;
+}